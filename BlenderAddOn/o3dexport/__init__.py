@@ -11,6 +11,7 @@ SPDX-License-Identifier: Apache-2.0 OR MIT
 
 import os
 import sys
+import time
 from datetime import datetime
 from typing import TextIO
 
@@ -33,6 +34,7 @@ bl_info = {
 
 if __package__ is None or __package__ == "":
     # When running as a standalone script from Blender Text View "Run Script"
+    import dirtytracker
     import export_settings
     import exporter
     import fileutils
@@ -42,6 +44,7 @@ if __package__ is None or __package__ == "":
 else:
     # When running as an installed AddOn, then it runs in package mode.
     from . import (
+        dirtytracker,
         export_settings,
         exporter,
         fileutils,
@@ -54,6 +57,8 @@ else:
 if "bpy" in locals():
     from importlib import reload
 
+    if "dirtytracker" in locals():
+        reload(dirtytracker)
     if "export_settings" in locals():
         reload(export_settings)
     if "exporter" in locals():
@@ -102,6 +107,13 @@ VALID_AXIS_OPTIONS = [
 ]
 
 
+# The modal export operator wakes up at this interval, and advances the export
+# until it has spent MODAL_STEP_TIME_BUDGET_SECONDS, then gives control back to
+# Blender so the UI stays responsive.
+MODAL_TIMER_INTERVAL_SECONDS = 0.01
+MODAL_STEP_TIME_BUDGET_SECONDS = 0.05
+
+
 def _ValidateAxisOptions(forward: str, up: str) -> bool:
     forward = forward.replace("-", "")
     up = up.replace("-", "")
@@ -146,6 +158,12 @@ class O3matPropertyGroup(bpy.types.PropertyGroup):
         description="O3DE Material option for Normals: Flip Y Channel. Enabled by default, because Blender uses OpenGL convention and O3DE uses DX12 convention.",
         default=True,
     )
+    textureMemoryBudgetMB: bpy.props.IntProperty(
+        name="Texture Budget (MB)",
+        description="Projected GPU memory, after compression, for all the textures of the scene. The textures with the highest pixel density on screen are downscaled until they fit. Zero means unlimited.",
+        default=0,
+        min=0,
+    )
     overwriteMeshes: bpy.props.BoolProperty(
         name="Overwrite Meshes",
         description="If enabled, existing FBX/GLTF will be overwritten",
@@ -156,6 +174,11 @@ class O3matPropertyGroup(bpy.types.PropertyGroup):
         description="If enabled, existing SGR files will be overwritten",
         default=False,
     )
+    exportTransformTracks: bpy.props.BoolProperty(
+        name="Export Transform Tracks",
+        description="If enabled, the objects with an animation Action get their local transform sampled once per frame, keyframe reduced, and written to the SceneGraph as a 'track'",
+        default=False,
+    )
     forwardAxisOption: bpy.props.EnumProperty(
         name="Forward Axis",
         description="Forward Axis",
@@ -218,6 +241,8 @@ class ModalExportSceneOperator(bpy.types.Operator):
     _progressUpdated = False
     _exportIterator = None
     _exportCtx = None
+    _startTime = 0.0
+    _isDirtyTrackingSuspended = False
     sceneName: str
     exportDir: str
     objectToExport: bpy.types.Object
@@ -228,19 +253,29 @@ class ModalExportSceneOperator(bpy.types.Operator):
     def modal(self, context, event):
         context.area.tag_redraw()
         if event.type in {"ESC"}:
-            self.finish(context)
+            self.finish(context, succeeded=False)
             return {"CANCELLED"}
+        if event.type != "TIMER":
+            return {"PASS_THROUGH"}
+        # Drain as many export steps as fit in the time budget. Most steps (e.g. skipped
+        # assets) take a fraction of a millisecond, so one step per timer tick would spend
+        # most of the export idling.
+        deadline = time.perf_counter() + MODAL_STEP_TIME_BUDGET_SECONDS
+        msg = ""
         try:
-            msg = next(self._exportIterator)
-            self.report({"INFO"}, msg)
-            self._progressWorkCount += 1
+            while True:
+                msg = next(self._exportIterator)
+                self._progressWorkCount += 1
+                if time.perf_counter() >= deadline:
+                    break
         except StopIteration:
             self.finish(context)
             return {"FINISHED"}
         except Exception as e:
             self.report({"ERROR_INVALID_INPUT"}, "Error: " + str(e))
-            self.finish(context)
+            self.finish(context, succeeded=False)
             return {"CANCELLED"}
+        self.report({"INFO"}, msg)
         progress = self._progressWorkCount / self._expectedWorkCount
         myprops = context.scene.o3mat
         myprops.progressBar = int(progress * 100)
@@ -253,15 +288,28 @@ class ModalExportSceneOperator(bpy.types.Operator):
         self.logfileObj.close()
         self.logfileObj = None
 
+    def EndDirtyTracking(self, succeeded: bool):
+        if not self._isDirtyTrackingSuspended:
+            return
+        dirtytracker.GetTracker().EndExport(succeeded)
+        self._isDirtyTrackingSuspended = False
+
     def cancel(self, context):
+        self.EndDirtyTracking(succeeded=False)
         self.CloseStdout()
 
-    def finish(self, context):
+    def finish(self, context, succeeded: bool = True):
         wm = context.window_manager
         wm.event_timer_remove(self._timer)
+        self.EndDirtyTracking(succeeded)
         now = datetime.now()
         current_time = now.strftime("%H:%M:%S")
-        finalMsg = f"[{current_time}] Asset '[{self._progressWorkCount}/{self._expectedWorkCount}]' exported successfully"
+        elapsedSeconds = max(time.perf_counter() - self._startTime, 1e-6)
+        finalMsg = (
+            f"[{current_time}] Asset '[{self._progressWorkCount}/{self._expectedWorkCount}]' exported successfully "
+            f"in {elapsedSeconds:.2f} seconds ({self._progressWorkCount / elapsedSeconds:.1f} assets/s)"
+        )
+        print(finalMsg)
         self.report({"INFO"}, finalMsg)
         _ShowMessageBox(finalMsg)
         myprops = context.scene.o3mat
@@ -281,9 +329,15 @@ class ModalExportSceneOperator(bpy.types.Operator):
             myprops.overwriteSceneGraph,
             myprops.materialsNormalFlipXChannel,
             myprops.materialsNormalFlipYChannel,
+            myprops.textureMemoryBudgetMB,
+            myprops.exportTransformTracks,
         )
+        tracker = dirtytracker.GetTracker()
         sceneGraph = scenegraph.SceneGraph(
-            self.objectsToExport, recursive=(not self.exportSelected)
+            self.objectsToExport,
+            recursive=(not self.exportSelected),
+            materialCache=tracker.GetMaterialCache(),
+            exportTransformTracks=self._exportCtx.GetFlagExportTransformTracks(),
         )
         textureCount = sceneGraph.CalculateTextureCount()
         materialCount = len(sceneGraph.GetMaterialsDictionary())
@@ -294,17 +348,20 @@ class ModalExportSceneOperator(bpy.types.Operator):
         # + len(objectAndMaterialsList)
         self._progressWorkCount = 0
         myprops.progressBar = 0
-        self._exportIterator = exporter.ExportAssetsAndSceneGraph(
-            self._exportCtx, sceneGraph
-        )
-
         if self._expectedWorkCount < 1:
             _ShowMessageBox("There's nothing to export in this scene!")
             return {"FINISHED"}
 
+        tracker.BeginExport(self._exportCtx.GetFingerprint())
+        self._isDirtyTrackingSuspended = True
+        self._exportIterator = exporter.ExportAssetsAndSceneGraph(
+            self._exportCtx, sceneGraph, tracker
+        )
+
         # Define the Timer
         wm = context.window_manager
-        self._timer = wm.event_timer_add(0.1, window=context.window)
+        self._startTime = time.perf_counter()
+        self._timer = wm.event_timer_add(MODAL_TIMER_INTERVAL_SECONDS, window=context.window)
         wm.modal_handler_add(self)
 
         return {"RUNNING_MODAL"}
@@ -399,6 +456,8 @@ class O3DEXPORT_VIEW_3D_PT_scene_export(bpy.types.Panel):
 
         row = layout.row()
         row.prop(scene.o3mat, "overwriteTextures")
+        row = layout.row()
+        row.prop(scene.o3mat, "textureMemoryBudgetMB")
 
         # Material options
         row = layout.row()
@@ -417,6 +476,8 @@ class O3DEXPORT_VIEW_3D_PT_scene_export(bpy.types.Panel):
         row.prop(scene.o3mat, "overwriteMeshes")
         row = layout.row()
         row.prop(scene.o3mat, "overwriteSceneGraph")
+        row = layout.row()
+        row.prop(scene.o3mat, "exportTransformTracks")
 
         row = layout.row()
         col = row.column(align=True)
@@ -458,9 +519,11 @@ def register():
     for class_ in classes:
         bpy.utils.register_class(class_)
     bpy.types.Scene.o3mat = bpy.props.PointerProperty(type=O3matPropertyGroup)
+    dirtytracker.register()
 
 
 def unregister():
+    dirtytracker.unregister()
     for class_ in classes:
         bpy.utils.unregister_class(class_)
     del bpy.types.Scene.o3mat
@@ -0,0 +1,239 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Created by Galib Arrieta (aka galibzon@github, lumbermixalot@github)
+# under contract with Meta Platforms, Inc.
+# Donated by Meta Platforms, Inc as an open source project.
+
+import os
+
+import bpy
+from bpy.app.handlers import persistent
+
+# o3dexport modules
+if __package__ is None or __package__ == "":
+    # When running as a standalone script from Blender Text View "Run Script"
+    import o3material
+else:
+    # When running as an installed AddOn, then it runs in package mode.
+    from . import o3material
+
+
+# The kinds of data blocks that are tracked.
+class Kind:
+    OBJECT = "OBJECT"
+    MESH = "MESH"
+    MATERIAL = "MATERIAL"
+    IMAGE = "IMAGE"
+
+    ALL = (OBJECT, MESH, MATERIAL, IMAGE)
+
+    def __init__(self):
+        pass
+
+
+class DirtyTracker:
+    """
+    Listens to the depsgraph updates, and remembers which Objects, Meshes, Materials and Images
+    changed since the last completed export. With that information:
+    1. Parsed materials (O3Material) are reused between exports until their Blender material changes.
+    2. Assets that didn't change since the last export, with the same ExportSettings, are not
+       written again, even if the overwrite flags are enabled.
+    Changes made outside of Blender (e.g. an image file edited in another application) can't
+    be seen until the data block is reloaded in Blender.
+    The export runs in a modal operator, so the user can keep editing while it runs. Those changes
+    are kept aside, and become dirty when the export ends, whether or not the export wrote the
+    data blocks before they changed.
+    """
+
+    def __init__(self):
+        self._suspendCount = 0
+        # When True, nothing is known about what changed, e.g. right after loading a .blend.
+        self._isEverythingDirty = True
+        # key: Kind. value: set of data block names.
+        self._dirtyNames = {kind: set() for kind in Kind.ALL}
+        # Parsed materials, shared by all the SceneGraphs.
+        #     key: Material name.
+        #     value: o3material.O3Material
+        self._materialCache = {}
+        # What the last completed export wrote to disk.
+        #     key: Kind.
+        #     value: dict. key: data block name. value: export key (see CanSkip()).
+        self._exportedKeys = {kind: {} for kind in Kind.ALL}
+        self._exportedFingerprint = None
+        # State of the export in progress.
+        self._exportFingerprint = None
+        self._exportDirtyNames = None
+        self._exportIsEverythingDirty = True
+        self._exportKeys = None
+        # Changes recorded while an export is in progress, see EndExport().
+        self._pendingDirtyNames = {kind: set() for kind in Kind.ALL}
+        self._areAllMaterialsPending = False
+        self._isResetPending = False
+
+    def Reset(self):
+        if self.IsSuspended():
+            self._isResetPending = True
+            return
+        self._isEverythingDirty = True
+        for dirtyNames in self._dirtyNames.values():
+            dirtyNames.clear()
+        self._materialCache.clear()
+        self._exportedKeys = {kind: {} for kind in Kind.ALL}
+        self._exportedFingerprint = None
+
+    def IsSuspended(self) -> bool:
+        return self._suspendCount > 0
+
+    def MarkDirty(self, kind: str, name: str):
+        if self.IsSuspended():
+            self._pendingDirtyNames[kind].add(name)
+            return
+        self._dirtyNames[kind].add(name)
+        if kind == Kind.MATERIAL:
+            self._materialCache.pop(name, None)
+
+    def MarkAllMaterialsDirty(self):
+        if self.IsSuspended():
+            self._areAllMaterialsPending = True
+            return
+        self._dirtyNames[Kind.MATERIAL].update(self._materialCache.keys())
+        self._dirtyNames[Kind.MATERIAL].update(self._exportedKeys[Kind.MATERIAL].keys())
+        self._materialCache.clear()
+
+    def GetMaterialCache(self) -> dict[str, o3material.O3Material]:
+        """
+        To be passed to o3material.GetMaterialsFromObject().
+        """
+        return self._materialCache
+
+    def GetDirtyCountsString(self) -> str:
+        if self._isEverythingDirty:
+            return "everything"
+        return ", ".join(
+            [f"{len(self._dirtyNames[kind])} {kind.lower()}(s)" for kind in Kind.ALL]
+        )
+
+    def BeginExport(self, exportFingerprint: tuple):
+        """
+        Takes ownership of the changes recorded so far. The changes recorded from now on, by the
+        user or by the export itself (selection, transforms, etc), are kept aside until EndExport().
+        @param exportFingerprint Everything in the ExportSettings that shapes the exported files.
+        """
+        print(f"O3DEXPORT: Changed since the last export: {self.GetDirtyCountsString()}")
+        self._suspendCount += 1
+        self._exportFingerprint = exportFingerprint
+        self._exportIsEverythingDirty = self._isEverythingDirty or (
+            exportFingerprint != self._exportedFingerprint
+        )
+        self._exportDirtyNames = self._dirtyNames
+        self._dirtyNames = {kind: set() for kind in Kind.ALL}
+        self._exportKeys = {kind: dict(self._exportedKeys[kind]) for kind in Kind.ALL}
+
+    def EndExport(self, succeeded: bool):
+        """
+        The changes recorded during the export become dirty, so the next export writes them
+        even if this one wrote those data blocks already.
+        """
+        self._suspendCount -= 1
+        if succeeded:
+            self._isEverythingDirty = False
+            self._exportedKeys = self._exportKeys
+            self._exportedFingerprint = self._exportFingerprint
+        else:
+            # Unknown what made it to disk. Start over.
+            self._isEverythingDirty = True
+            for kind in Kind.ALL:
+                self._dirtyNames[kind].update(self._exportDirtyNames[kind])
+        self._exportDirtyNames = None
+        self._exportKeys = None
+        if self.IsSuspended():
+            return
+        pendingDirtyNames = self._pendingDirtyNames
+        self._pendingDirtyNames = {kind: set() for kind in Kind.ALL}
+        if self._isResetPending:
+            self._isResetPending = False
+            self._areAllMaterialsPending = False
+            self.Reset()
+            return
+        for kind, names in pendingDirtyNames.items():
+            for name in names:
+                self.MarkDirty(kind, name)
+        if self._areAllMaterialsPending:
+            self._areAllMaterialsPending = False
+            self.MarkAllMaterialsDirty()
+
+    def CanSkip(self, kind: str, name: str, exportKey: tuple, outputFilePaths: list[str]) -> bool:
+        """
+        Must be called between BeginExport() and EndExport().
+        @param name The name of the data block that the asset is exported from.
+        @param exportKey Anything else that shapes the exported files, e.g. the sanitized names.
+        @returns True if the asset was exported by the last completed export with the same key and
+            settings, the data block didn't change since then, and all the files are still there.
+        """
+        if self._exportIsEverythingDirty or (name in self._exportDirtyNames[kind]):
+            return False
+        if self._exportedKeys[kind].get(name) != exportKey:
+            return False
+        return all([os.path.exists(filePath) for filePath in outputFilePaths])
+
+    def MarkExported(self, kind: str, name: str, exportKey: tuple):
+        self._exportKeys[kind][name] = exportKey
+
+
+_tracker = DirtyTracker()
+
+
+def GetTracker() -> DirtyTracker:
+    return _tracker
+
+
+@persistent
+def _OnDepsgraphUpdatePost(scene: bpy.types.Scene, depsgraph: bpy.types.Depsgraph):
+    for update in depsgraph.updates:
+        dataBlock = update.id.original
+        if isinstance(dataBlock, bpy.types.Object):
+            _tracker.MarkDirty(Kind.OBJECT, dataBlock.name)
+            if update.is_updated_geometry and (dataBlock.type == "MESH"):
+                # Modifiers and material slots end up in the exported mesh too.
+                _tracker.MarkDirty(Kind.MESH, dataBlock.data.name)
+        elif isinstance(dataBlock, bpy.types.Mesh):
+            _tracker.MarkDirty(Kind.MESH, dataBlock.name)
+        elif isinstance(dataBlock, bpy.types.Material):
+            _tracker.MarkDirty(Kind.MATERIAL, dataBlock.name)
+        elif isinstance(dataBlock, bpy.types.Image):
+            _tracker.MarkDirty(Kind.IMAGE, dataBlock.name)
+        elif isinstance(dataBlock, bpy.types.ShaderNodeTree):
+            # A node group may be shared by any number of materials.
+            _tracker.MarkAllMaterialsDirty()
+
+
+@persistent
+def _OnFileLoadedOrUndone(*args):
+    # Data blocks may have been replaced without depsgraph updates.
+    _tracker.Reset()
+
+
+_HANDLERS = (
+    (bpy.app.handlers.depsgraph_update_post, _OnDepsgraphUpdatePost),
+    (bpy.app.handlers.load_post, _OnFileLoadedOrUndone),
+    (bpy.app.handlers.undo_post, _OnFileLoadedOrUndone),
+    (bpy.app.handlers.redo_post, _OnFileLoadedOrUndone),
+)
+
+
+def register():
+    for handlerList, handler in _HANDLERS:
+        if handler not in handlerList:
+            handlerList.append(handler)
+    _tracker.Reset()
+
+
+def unregister():
+    for handlerList, handler in _HANDLERS:
+        if handler in handlerList:
+            handlerList.remove(handler)
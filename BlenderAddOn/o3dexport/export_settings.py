@@ -15,10 +15,9 @@ import os
 if __package__ is None or __package__ == "":
     # When running as a standalone script from Blender Text View "Run Script"
     import fileutils
-    import o3material
 else:
     # When running as an installed AddOn, then it runs in package mode.
-    from . import fileutils, o3material
+    from . import fileutils
 
 
 class ExportSettings:
@@ -39,6 +38,8 @@ class ExportSettings:
         overwriteSceneGraph: bool,
         materialsNormalFlipXChannel: bool,
         materialsNormalFlipYChannel: bool,
+        textureMemoryBudgetMB: int = 0,
+        exportTransformTracks: bool = False,
     ):
         """
         @param outputDir is typically the root of the game project
@@ -46,6 +47,9 @@ class ExportSettings:
                enum in ['X', 'Y', 'Z', '-X', '-Y', '-Z']
         @param upAxisOption: Axis string name as required by bpy.ops.export_scene.fbx
                enum in ['X', 'Y', 'Z', '-X', '-Y', '-Z']
+        @param textureMemoryBudgetMB Projected GPU memory (MiB) that all the exported textures
+               of the scene should fit in. Zero means unlimited.
+        @param exportTransformTracks If True, the animated objects get a "track" in the SceneGraph.
         """
         self._sceneName = sceneName
         self._assetsRelativeSceneDir = os.path.join(
@@ -78,6 +82,8 @@ class ExportSettings:
         self._overwriteSceneGraph = overwriteSceneGraph
         self._materialsNormalFlipXChannel = materialsNormalFlipXChannel
         self._materialsNormalFlipYChannel = materialsNormalFlipYChannel
+        self._textureMemoryBudgetMB = textureMemoryBudgetMB
+        self._exportTransformTracks = exportTransformTracks
 
     def CreateOutputDirs(self) -> bool:
         return (
@@ -140,13 +146,8 @@ class ExportSettings:
         )
         return outputFilePath
 
-    def GetO3DEMaterialExportPath(
-        self, material: o3material.O3Material, assetRootRelative: bool = False
-    ) -> str:
-        outputFilePath = os.path.join(
-            self.GetMaterialAssetsDirectory(assetRootRelative),
-            f"{material.GetName()}.material",
-        )
+    def GetMaterialDescriptionsExportPath(self) -> str:
+        outputFilePath = os.path.join(self._absoluteSceneDir, f"{self._sceneName}.o3mat")
         return outputFilePath
 
     def GetSceneGraphExportPath(self) -> str:
@@ -174,5 +175,29 @@ class ExportSettings:
     def GetFlagOverwriteSceneGraph(self) -> bool:
         return self._overwriteSceneGraph
 
+    def GetFlagExportTransformTracks(self) -> bool:
+        return self._exportTransformTracks
+
     def GetMaterialNormalFlipChannelOptions(self) -> tuple[bool, bool]:
         return self._materialsNormalFlipXChannel, self._materialsNormalFlipYChannel
+
+    def GetTextureMemoryBudgetBytes(self) -> int:
+        """
+        @returns Zero if the texture memory budget is unlimited.
+        """
+        return self._textureMemoryBudgetMB * 1024 * 1024
+
+    def GetFingerprint(self) -> tuple:
+        """
+        @returns Everything that shapes the content of the exported files. The overwrite
+            flags are not part of it, because they only decide if files are written.
+        """
+        return (
+            self._absoluteSceneDir,
+            self._forwardAxisOption,
+            self._upAxisOption,
+            self._materialsNormalFlipXChannel,
+            self._materialsNormalFlipYChannel,
+            self._textureMemoryBudgetMB,
+            self._exportTransformTracks,
+        )
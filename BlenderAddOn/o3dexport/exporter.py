@@ -16,50 +16,172 @@ import bpy
 
 # o3dexport modules
 if __package__ is None or __package__ == "":
+    import dirtytracker
     import export_settings
+    import fileutils
     import mesh_exporter
 
     # When running as a standalone script from Blender Text View "Run Script"
     import o3material
     import scenegraph
+    import texture_budget
     import texture_exporter
-    import textureasset
 else:
     # When running as an installed AddOn, then it runs in package mode.
     from . import (
+        dirtytracker,
         export_settings,
+        fileutils,
         mesh_exporter,
         o3material,
         scenegraph,
+        texture_budget,
         texture_exporter,
-        textureasset,
     )
 
-
-def _ExportMaterial(
+def _ExportMaterials(
     exportSettings: export_settings.ExportSettings,
-    material: o3material.O3Material,
-    texturesDict: dict[str, textureasset.TextureAsset],
-):
+    sceneGraph: scenegraph.SceneGraph,
+) -> Iterator[str]:
     """
-    @param texturesDict A Dictionary that contains all TextureAssets in the scene, organized by texture name.
+    Only dumps the description of each material in the <Scene>.o3mat file, the o3dimport Gem writes the
+    .material files from it, in parallel, before importing the scene.
+    One message is yielded per material, in the order of the materials dictionary.
     """
-    overwriteMaterials = exportSettings.GetFlagOverwriteMaterials()
-    materialPath = exportSettings.GetO3DEMaterialExportPath(material)
+    texturePaths = o3material.TexturePathResolver(
+        exportSettings.GetTextureAssetsDirectory(assetRootRelative=True),
+        sceneGraph.GetTexturesDictionary(),
+    )
+    descriptions = {}
+    for material in sceneGraph.GetMaterialsDictionary().values():
+        descriptions[material.GetName()] = material.GetDescription(texturePaths)
+        yield f"O3DEXPORT: Exported Material '{material.GetName()}'"
+    # Always written, it is small. The Gem doesn't write again the .material files whose content didn't change.
+    descriptionsPath = exportSettings.GetMaterialDescriptionsExportPath()
     flipXChannel, flipYChannel = exportSettings.GetMaterialNormalFlipChannelOptions()
-    if overwriteMaterials or (not os.path.exists(materialPath)):
-        material.texturesDictionary = texturesDict
-        if not o3material.SaveAsO3DEMaterial(
-            material,
-            materialPath,
-            exportSettings.GetTextureAssetsDirectory(assetRootRelative=True),
-            flipXChannel,
-            flipYChannel,
-        ):
-            raise Exception(f"Failed to save O3DE material as '{materialPath}'")
-        print(f"Created material file '{materialPath}'")
-    else:
-        print(f"Skipped material file '{materialPath}'")
+    if not o3material.SaveMaterialDescriptions(
+        descriptionsPath,
+        descriptions,
+        exportSettings.GetFlagOverwriteMaterials(),
+        flipXChannel,
+        flipYChannel,
+        merge=not sceneGraph.IsRecursive(),
+    ):
+        raise Exception(f"Failed to save the material descriptions as '{descriptionsPath}'")
+    print(f"Created material descriptions file '{descriptionsPath}'")
+
+
+def _ExportTextures(
+    exportSettings: export_settings.ExportSettings,
+    sceneGraph: scenegraph.SceneGraph,
+    dirtyTracker: dirtytracker.DirtyTracker,
+) -> Iterator[str]:
+    textureResolutions, budgetEntries = _PlanTextureResolutions(exportSettings, sceneGraph)
+    # Target resolution of the downscaled textures whose files on disk have it, and how many of them this export wrote.
+    downscaledResolutions = {}
+    downscaledWriteCount = 0
+    for textureName, textureAsset in sceneGraph.GetTexturesDictionary().items():
+        targetResolution = textureResolutions.get(textureName)
+        sampledChannels = sorted(textureAsset.GetSampledChannels())
+        exportKey = (textureAsset.GetSanitizedName(), tuple(sampledChannels), targetResolution)
+        outputFileNames = [textureAsset.GetSanitizedName()] + [
+            fileutils.GetResampledSanitizedFilenameExtension(textureAsset.GetSanitizedName(), colorChannel)
+            for colorChannel in sampledChannels
+        ]
+        outputFilePaths = [
+            os.path.join(exportSettings.GetTextureAssetsDirectory(), fileName) for fileName in outputFileNames
+        ]
+        if dirtyTracker and dirtyTracker.CanSkip(dirtytracker.Kind.IMAGE, textureName, exportKey, outputFilePaths):
+            # One message per file, same as texture_exporter.ExportTextureAsset().
+            for outputFilePath in outputFilePaths:
+                msg = f"O3DEXPORT: Skipped texture '{outputFilePath}' because it didn't change since the last export"
+                print(msg)
+                yield msg
+            if targetResolution is not None:
+                downscaledResolutions[textureName] = targetResolution
+        else:
+            # Same conditions as texture_exporter.ExportTextureAsset() to write the file.
+            image = bpy.data.images.get(textureName)
+            isWritten = (image is not None) and image.has_data and (
+                exportSettings.GetFlagOverwriteTextures() or (not os.path.exists(outputFilePaths[0]))
+            )
+            for itor in texture_exporter.ExportTextureAsset(exportSettings, textureAsset, targetResolution):
+                yield itor
+            if (targetResolution is not None) and isWritten:
+                downscaledResolutions[textureName] = targetResolution
+                downscaledWriteCount += 1
+        if dirtyTracker:
+            dirtyTracker.MarkExported(dirtytracker.Kind.IMAGE, textureName, exportKey)
+    if downscaledWriteCount > 0:
+        afterBytes = texture_budget.CalculateTotalGpuBytes(budgetEntries, downscaledResolutions)
+        print(
+            f"O3DEXPORT: Projected GPU texture memory: {afterBytes / (1024 * 1024):.1f} MiB after downscaling "
+            f"{len(downscaledResolutions)} texture(s), {downscaledWriteCount} written by this export."
+        )
+
+
+def _ExportMeshes(
+    exportSettings: export_settings.ExportSettings,
+    sceneGraph: scenegraph.SceneGraph,
+    dirtyTracker: dirtytracker.DirtyTracker,
+) -> Iterator[str]:
+    for meshName, meshAsset in sceneGraph.GetMeshesDictionary().items():
+        obj = meshAsset.GetOwnerObject()
+        exportKey = (meshAsset.GetSanitizedName(), obj.name)
+        outputFilePath = exportSettings.GetMeshFbxExportPath(meshAsset.GetSanitizedName())
+        if dirtyTracker and dirtyTracker.CanSkip(dirtytracker.Kind.MESH, meshName, exportKey, [outputFilePath]):
+            msg = f"O3DEXPORT: Skipped mesh '{meshName}' because it didn't change since the last export"
+            print(msg)
+        else:
+            bpy.context.view_layer.objects.active = obj
+            obj.select_set(True)
+            mesh_exporter.ExportMeshAsFbx(exportSettings, meshAsset.GetSanitizedName(), obj)
+            obj.select_set(False)
+            msg = f"O3DEXPORT: Exported mesh '{meshName}' with sanitized name '{meshAsset.GetSanitizedName()}' from object '{obj.name}'"
+        if dirtyTracker:
+            dirtyTracker.MarkExported(dirtytracker.Kind.MESH, meshName, exportKey)
+        yield msg
+
+
+def _PlanTextureResolutions(
+    exportSettings: export_settings.ExportSettings, sceneGraph: scenegraph.SceneGraph
+) -> tuple[dict[str, tuple[int, int]], list[texture_budget.TextureBudgetEntry]]:
+    """
+    The memory after downscaling is reported by _ExportTextures(), once the files are written.
+    @returns The target resolution of the textures that must be downscaled
+        to fit in the texture memory budget, organized by original texture name,
+        and the budget entries of all the textures.
+    """
+    budgetBytes = exportSettings.GetTextureMemoryBudgetBytes()
+    if budgetBytes <= 0:
+        return {}, []
+    usageByTextureName = sceneGraph.CalculateTextureUsage()
+    entries = []
+    for textureName, textureAsset in sceneGraph.GetTexturesDictionary().items():
+        image = bpy.data.images.get(textureName)
+        if (image is None) or (not image.has_data):
+            continue
+        worldSize, useCount = usageByTextureName.get(textureName, (0.0, 1))
+        bytesPerTexel = texture_budget.GetBytesPerTexel(
+            textureAsset.IsNormalMap(), image.channels, len(textureAsset.GetSampledChannels())
+        )
+        entries.append(
+            texture_budget.TextureBudgetEntry(
+                textureName, image.size[0], image.size[1], bytesPerTexel, worldSize, useCount
+            )
+        )
+    resolutions = texture_budget.PlanTextureResolutions(entries, budgetBytes)
+    mebibyte = 1024 * 1024
+    beforeBytes = texture_budget.CalculateTotalGpuBytes(entries)
+    print(
+        f"O3DEXPORT: Projected GPU texture memory: {beforeBytes / mebibyte:.1f} MiB before downscaling "
+        f"{len(resolutions)} texture(s). Budget is {budgetBytes / mebibyte:.1f} MiB."
+    )
+    if texture_budget.CalculateTotalGpuBytes(entries, resolutions) > budgetBytes:
+        print(
+            f"WARNING: Can't fit the textures in the budget without going below {texture_budget.MIN_RESOLUTION} pixels."
+        )
+    return resolutions, entries
 
 
 def _ExportSceneGraph(
@@ -76,7 +198,9 @@ def _ExportSceneGraph(
 
 
 def ExportAssetsAndSceneGraph(
-    exportSettings: export_settings.ExportSettings, sceneGraph: scenegraph.SceneGraph
+    exportSettings: export_settings.ExportSettings,
+    sceneGraph: scenegraph.SceneGraph,
+    dirtyTracker: dirtytracker.DirtyTracker = None,
 ) -> Iterator[str]:
     """
     Generator function that yields a message for each exported asset.
@@ -84,29 +208,21 @@ def ExportAssetsAndSceneGraph(
     In order to avoid blocking the UI when a scene is being exported, this function was made
     as a Generator, and the caller can choose to update the UI each time this function
     yields.
+    @param dirtyTracker Optional. If provided, DirtyTracker.BeginExport() must have been called, and the
+           assets that didn't change since the last export are not written again.
     """
     if not exportSettings.CreateOutputDirs():
         raise Exception("Failed to create output directories")
     print("O3DEXPORT: Created output directories")
     # First, export the materials
-    # We export materials before textures because when exporting material we may update
-    # some TextureAsset(s) as Normal Maps, which changes their sanitized name.
-    for materialName, material in sceneGraph.GetMaterialsDictionary().items():
-        _ExportMaterial(exportSettings, material, sceneGraph.GetTexturesDictionary())
-        yield f"O3DEXPORT: Exported Material '{materialName}'"
+    for itor in _ExportMaterials(exportSettings, sceneGraph):
+        yield itor
     # Next, let's export the textures
-    for _, textureAsset in sceneGraph.GetTexturesDictionary().items():
-        for itor in texture_exporter.ExportTextureAsset(exportSettings, textureAsset):
-            yield itor
-
+    for itor in _ExportTextures(exportSettings, sceneGraph, dirtyTracker):
+        yield itor
     # Next, export the meshes
-    for meshName, meshAsset in sceneGraph.GetMeshesDictionary().items():
-        obj = meshAsset.GetOwnerObject()
-        bpy.context.view_layer.objects.active = obj
-        obj.select_set(True)
-        mesh_exporter.ExportMeshAsFbx(exportSettings, meshAsset.GetSanitizedName(), obj)
-        obj.select_set(False)
-        yield f"O3DEXPORT: Exported mesh '{meshName}' with sanitized name '{meshAsset.GetSanitizedName()}' from object '{obj.name}'"
+    for itor in _ExportMeshes(exportSettings, sceneGraph, dirtyTracker):
+        yield itor
     # Finally, create the SceneGraph only if the whole scene is being exported.
     if not sceneGraph.IsRecursive():
         msg = "O3DEXPORT: Completed exporting all assets only."
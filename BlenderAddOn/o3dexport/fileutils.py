@@ -11,6 +11,8 @@ SPDX-License-Identifier: Apache-2.0 OR MIT
 
 import os
 import pathlib
+import shutil
+import sys
 import time
 
 import bpy
@@ -24,6 +26,16 @@ SUPPORTED_BLENDER_IMAGE_TYPES = {
     "JPEG": ".jpeg",
 }
 SUPPORTED_IMAGE_FILE_EXTENSIONS = {".png", ".jpg", ".jpeg", ".bmp"}
+# Blender image.file_format, organized by file extension.
+IMAGE_FILE_FORMAT_BY_EXTENSION = {
+    ".bmp": "BMP",
+    ".png": "PNG",
+    ".jpg": "JPEG",
+    ".jpeg": "JPEG",
+}
+
+# From linux/fs.h: _IOW(0x94, 9, int)
+_FICLONE = 0x40049409
 
 
 def GetBlendFilenameStem() -> str:
@@ -134,3 +146,68 @@ def GetExportLogFilepath(sceneName: str) -> str:
     local_time = time.localtime()
     formatted_time = time.strftime("%Y-%m-%d_%H-%M-%S", local_time)
     return os.path.join(folder, f"{sceneName}_{formatted_time}.log")
+
+
+def _CloneFile(srcFileObj, dstFileObj) -> bool:
+    """
+    Makes @dstFileObj share the data blocks of @srcFileObj (copy on write), on file
+    systems that support it (Btrfs, XFS, ...). Nothing is read nor written.
+    """
+    if not sys.platform.startswith("linux"):
+        return False
+    try:
+        import fcntl
+
+        fcntl.ioctl(dstFileObj.fileno(), _FICLONE, srcFileObj.fileno())
+        return True
+    except OSError:
+        return False
+
+
+def _CopyFileRange(srcFileObj, dstFileObj) -> bool:
+    """
+    The copy happens inside the kernel, without going through user space buffers.
+    """
+    if not hasattr(os, "copy_file_range"):
+        return False
+    remainingBytes = os.fstat(srcFileObj.fileno()).st_size
+    try:
+        while remainingBytes > 0:
+            copiedBytes = os.copy_file_range(
+                srcFileObj.fileno(), dstFileObj.fileno(), remainingBytes
+            )
+            if copiedBytes == 0:
+                break
+            remainingBytes -= copiedBytes
+    except OSError:
+        return False
+    return remainingBytes == 0
+
+
+def TransferFile(srcFilePath: str, dstFilePath: str) -> str:
+    """
+    Places a byte for byte copy of @srcFilePath at @dstFilePath, with the cheapest
+    method available: reflink, copy_file_range and, finally, a regular copy.
+    Hard links are never used, because Blender (e.g. image.save()) or the user may
+    modify one of the files later, which would silently modify the other one too.
+    The copy is written to a temporary file first, so readers of @dstFilePath (like
+    the O3DE Asset Processor) never see a partially written file.
+    @returns The name of the method that was used.
+    """
+    tmpFilePath = f"{dstFilePath}.tmp"
+    method = ""
+    try:
+        with open(srcFilePath, "rb") as srcFileObj, open(tmpFilePath, "wb") as dstFileObj:
+            if _CloneFile(srcFileObj, dstFileObj):
+                method = "reflink"
+            elif _CopyFileRange(srcFileObj, dstFileObj):
+                method = "copy_file_range"
+        if not method:
+            shutil.copyfile(srcFilePath, tmpFilePath)
+            method = "copy"
+        os.replace(tmpFilePath, dstFilePath)
+    except Exception:
+        if os.path.exists(tmpFilePath):
+            os.remove(tmpFilePath)
+        raise
+    return method
@@ -21,6 +21,37 @@ def CreateImageBufFromColorChannel(imageBuf: oiio.ImageBuf, channel: int) -> oii
     singleChannelImageBuf = oiio.ImageBufAlgo.channels(imageBuf, (channel,))
     return singleChannelImageBuf
 
+def LoadImageFileAsFloatImageBuf(imageFilePath: str) -> oiio.ImageBuf:
+    """
+    Reads the whole image in memory, as 32 bits floats, so it is safe to
+    overwrite @imageFilePath afterwards, and resampling doesn't add banding.
+    """
+    imageBuf = oiio.ImageBuf(imageFilePath)
+    if not imageBuf.read(0, 0, True, oiio.FLOAT):
+        raise Exception(f"Failed to read image '{imageFilePath}': {imageBuf.geterror()}")
+    return imageBuf
+
+def ResizeImageBuf(imageBuf: oiio.ImageBuf, width: int, height: int, isColorData: bool) -> oiio.ImageBuf:
+    """
+    Resizes with a filtered (Lanczos by default) resampler, using all the cores.
+    Color data is filtered in linear space, otherwise averaging sRGB values darkens
+    the highlights of the downscaled image. Non-color data (normals, roughness, etc)
+    is filtered as is.
+    """
+    roi = oiio.ROI(0, width, 0, height, 0, 1, 0, imageBuf.nchannels)
+    if not isColorData:
+        return oiio.ImageBufAlgo.resize(imageBuf, roi=roi)
+    linearImageBuf = oiio.ImageBufAlgo.colorconvert(imageBuf, "sRGB", "linear")
+    resizedImageBuf = oiio.ImageBufAlgo.resize(linearImageBuf, roi=roi)
+    return oiio.ImageBufAlgo.colorconvert(resizedImageBuf, "linear", "sRGB")
+
+def WriteImageBuf(imageBuf: oiio.ImageBuf, imageFilePath: str):
+    """
+    Writes @imageBuf as 8 bits per channel, like the textures saved by Blender.
+    """
+    if not imageBuf.write(imageFilePath, oiio.UINT8):
+        raise Exception(f"Failed to write image '{imageFilePath}': {imageBuf.geterror()}")
+
 # Old version using PIL, but required manual installation of `pillow`
 # inside Python for Blender. See newer version with OpenImageIO which ships
 # with Blender.
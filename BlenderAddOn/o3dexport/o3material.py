@@ -27,6 +27,8 @@ else:
 
 # Should use unix/posix file separator
 PROJECT_ROOT = "@projectroot@"
+# Bump it, here and in MaterialGenerator.h of the o3dimport Gem, when the format of the .o3mat file changes.
+MATERIAL_DESCRIPTIONS_VERSION = 1
 
 
 def _get_values_from_keys_with_name(dictionary: dict, key_name: str) -> list[str]:
@@ -65,6 +67,41 @@ def DumpNodeLink(indentation: str, nodeLink: bpy.types.NodeLink):
     DumpNodeInputs(f"{indentation}  ", nodeLink.from_node)
 
 
+class TexturePathResolver:
+    """
+    Maps the original texture names referenced by materials to the
+    project relative paths of the exported texture files.
+    """
+
+    def __init__(
+        self,
+        assetsRelativeTexturePath: str,
+        texturesDictionary: dict[str, textureasset.TextureAsset],
+    ):
+        """
+        @param texturesDictionary A Dictionary that contains all TextureAssets in the scene, organized by texture name.
+               Normal maps must have been renamed already with TextureAsset.SanitizeNameAsNormalMap().
+        """
+        self._posixAssetsRelativeTexturePath = assetsRelativeTexturePath.replace(
+            os.sep, posixpath.sep
+        )
+        self._texturesDictionary = texturesDictionary
+
+    def GetSanitizedTexturePath(self, textureName: str, colorChannel: str) -> str:
+        if textureName == "":
+            return textureName
+        sanitizedTextureName = self._texturesDictionary[textureName].GetSanitizedName()
+        if colorChannel != "":
+            # This is a per channel sampled texture.
+            # We need to figure out the path in which the new sampled texture was created.
+            sanitizedTextureName = fileutils.GetResampledSanitizedFilenameExtension(
+                sanitizedTextureName, colorChannel
+            )
+        return posixpath.join(
+            PROJECT_ROOT, self._posixAssetsRelativeTexturePath, sanitizedTextureName
+        )
+
+
 class O3Material:
     """
     The O3DEXPORT Material represents all the data from a single bpy.Types.Material
@@ -309,15 +346,31 @@ class O3Material:
     def GetName(self) -> str:
         return self._name
 
+    def GetTextureNames(self) -> list[str]:
+        """
+        @returns The original (unsanitized) names of all textures referenced by this material.
+        """
+        textureNameList = _get_values_from_keys_with_name(self._data, "textureName")
+        # Sorted, because the iteration order of a set of strings changes between
+        # Python sessions, and the discovery order decides sanitized names.
+        return sorted(set(textureNameList))
+
+    def GetNormalMapTextureNames(self) -> list[str]:
+        """
+        @returns The original (unsanitized) names of the textures used as normal maps by this material.
+        """
+        if O3Material.PROPERTY_NORMAL not in self._data:
+            return []
+        return _get_values_from_keys_with_name(
+            self._data[O3Material.PROPERTY_NORMAL], "textureName"
+        )
+
     def BuildTextureList(self) -> list[textureasset.TextureAsset]:
         """
         @returns A list of all TextureAssets found in this material.
         """
         retList = []
-        textureNameList = _get_values_from_keys_with_name(self._data, "textureName")
-        textureNameSet = set(textureNameList)
-        textureNameList = list(textureNameSet)
-        for textureName in textureNameList:
+        for textureName in self.GetTextureNames():
             newTexAsset = textureasset.TextureAsset(textureName)
             if textureName in self._texturesSampledPerChannel:
                 newTexAsset._sampledChannels = self._texturesSampledPerChannel[
@@ -330,251 +383,29 @@ class O3Material:
         jsonStr = json.dumps(self._data, indent=4)
         return jsonStr
 
-    def _GetSanitizedTexturePath(
-        self, posixAssetsRelativeTexturePath: str, textureName: str, colorChannel: str, isNormalMap: bool = False
-    ) -> str:
-        if textureName == "":
-            return textureName
-        if isNormalMap:
-            self.texturesDictionary[
-                textureName
-            ].SanitizeNameAsNormalMap()
-        if colorChannel == "":
-            # This is a regular texture that is sampled for all available color channels
-            sanitizedTextureName = self.texturesDictionary[
-                textureName
-            ].GetSanitizedName()
-        else:
-            # This is a per channel sampled texture.
-            # We need to figure out the path in which the new sampled texture was created.
-            sanitizedTextureName = fileutils.GetResampledSanitizedFilenameExtension(
-                self.texturesDictionary[textureName].GetSanitizedName(), colorChannel
-            )
-        sanitizedTexturePath = posixpath.join(
-            PROJECT_ROOT, posixAssetsRelativeTexturePath, sanitizedTextureName
-        )
-        return sanitizedTexturePath
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/BaseColorPropertyGroup.json
-    def _AddO3deBaseColorProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                dstDict["baseColor.color"] = v
-                continue
-            if k == "textureName" and len(v) > 0:
-                textureName = v
-                colorChannel = (
-                    srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                    if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                    else ""
-                )
-                dstDict["baseColor.textureMap"] = self._GetSanitizedTexturePath(
-                    posixAssetsRelativeTexturePath, textureName, colorChannel
-                )
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/MetallicPropertyGroup.json
-    def _AddO3deMetallicProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                dstDict["metallic.factor"] = v
-                continue
-            if k == "textureName":
-                if len(v) > 0:
-                    textureName = v
-                    colorChannel = (
-                        srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                        if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                        else ""
-                    )
-                    dstDict["metallic.textureMap"] = self._GetSanitizedTexturePath(
-                        posixAssetsRelativeTexturePath, textureName, colorChannel
-                    )
-                    dstDict["metallic.useTexture"] = True
-                else:
-                    dstDict["metallic.useTexture"] = False
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/RoughnessPropertyGroup.json
-    def _AddO3deRoughnessProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                dstDict["roughness.factor"] = v
-                continue
-            if k == "textureName":
-                if len(v) > 0:
-                    textureName = v
-                    colorChannel = (
-                        srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                        if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                        else ""
-                    )
-                    dstDict["roughness.textureMap"] = self._GetSanitizedTexturePath(
-                        posixAssetsRelativeTexturePath, textureName, colorChannel
-                    )
-                    dstDict["roughness.useTexture"] = True
-                else:
-                    dstDict["roughness.useTexture"] = False
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/NormalPropertyGroup.json
-    def _AddO3deNormalMapProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "strength":
-                dstDict["normal.factor"] = v
-                continue
-            if k == "textureName":
-                if len(v) > 0:
-                    textureName = v
-                    colorChannel = (
-                        srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                        if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                        else ""
-                    )
-                    dstDict["normal.textureMap"] = self._GetSanitizedTexturePath(
-                        posixAssetsRelativeTexturePath, textureName, colorChannel, isNormalMap=True
-                    )
-                    dstDict["normal.useTexture"] = True
-                else:
-                    dstDict["normal.useTexture"] = False
-
-    def _AddO3deNormalFlipChannelsProperties(
-        self, normalFlipXChannel: bool, normalFlipYChannel: bool, dstDict: dict
-    ):
-        dstDict["normal.flipX"] = normalFlipXChannel
-        dstDict["normal.flipY"] = normalFlipYChannel
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/OpacityPropertyGroup.json
-    def _AddO3deAlphaProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                dstDict["opacity.factor"] = v
-                if v > 0.98:
-                    dstDict["opacity.mode"] = "Opaque"
-                else:
-                    dstDict["opacity.mode"] = "Blended"
-                continue
-            if k == "textureName":
-                if len(v) > 0:
-                    textureName = v
-                    colorChannel = (
-                        srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                        if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                        else ""
-                    )
-                    dstDict["opacity.textureMap"] = self._GetSanitizedTexturePath(
-                        posixAssetsRelativeTexturePath, textureName, colorChannel
-                    )
-                    dstDict["opacity.useTexture"] = True
-                else:
-                    dstDict["opacity.useTexture"] = False
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/SpecularPropertyGroup.json
-    def _AddO3deSpecularF0Property(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                dstDict["specularF0.factor"] = v
-                continue
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/SpecularPropertyGroup.json
-    def _AddO3deSpecularColorProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
+    def GetDescription(self, texturePaths: TexturePathResolver) -> dict:
         """
-        Applicable for Metals only, because dielectrics only reflect shades of white
+        @returns The sockets of the Principled BSDF node, with the project relative "texturePath" of each
+            linked texture. The o3dimport Gem turns it into the O3DE .material file, see MaterialGenerator.h.
         """
-        for k, v in srcDict.items():
-            if k == "color":
-                continue  # Nothing to do here.
-            if k == "textureName" and len(v) > 0:
-                textureName = v
-                colorChannel = (
-                    srcDict[O3Material.OUT_PROP_TEXTURE_CHANNEL]
-                    if O3Material.OUT_PROP_TEXTURE_CHANNEL in srcDict
-                    else ""
-                )
-                dstDict["specularF0.textureMap"] = self._GetSanitizedTexturePath(
-                    posixAssetsRelativeTexturePath, textureName, colorChannel
-                )
-                dstDict["specularF0.useTexture"] = True
-            else:
-                dstDict["specularF0.useTexture"] = False
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs/SpecularPropertyGroup.json
-    def _AddO3deMultiscatterCompensationProperty(
-        self, srcDict: dict, posixAssetsRelativeTexturePath: str, dstDict: dict
-    ):
-        for k, v in srcDict.items():
-            if k == "value":
-                if v > 0.5:
-                    dstDict["specularF0.enableMultiScatterCompensation"] = True
-
-    # https://github.com/o3de/o3de/blob/development/Gems/Atom/Feature/Common/Assets/Materials/Types/StandardPBR.materialtype
-    # https://github.com/o3de/o3de/tree/development/Gems/Atom/Feature/Common/Assets/Materials/Types/MaterialInputs
-    def GetDataAsO3DEMaterial(self, posixAssetsRelativeTexturePath: str) -> dict:
-        o3deMaterial = {
-            "materialType": "@gemroot:Atom_Feature_Common@/Assets/Materials/Types/StandardPBR.materialtype",
-            "materialTypeVersion": 5,
-            "propertyValues": {},
-        }
-        propertyValues = o3deMaterial["propertyValues"]
-        for key, valueDict in self._data.items():
-            match key:
-                case O3Material.PROPERTY_BASECOLOR:
-                    self._AddO3deBaseColorProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_METALLIC:
-                    self._AddO3deMetallicProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_ROUGHNESS:
-                    self._AddO3deRoughnessProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_ALPHA:
-                    self._AddO3deAlphaProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_SPECULAR_IOR:
-                    self._AddO3deSpecularF0Property(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_SPECULAR_TINT:  # Applicable for Metals only, because dielectrics only reflect shades of white
-                    self._AddO3deSpecularColorProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.ENABLE_MULTISCATTER_COMPENSATION:
-                    self._AddO3deMultiscatterCompensationProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                case O3Material.PROPERTY_NORMAL:
-                    self._AddO3deNormalMapProperty(
-                        valueDict, posixAssetsRelativeTexturePath, propertyValues
-                    )
-                    self._AddO3deNormalFlipChannelsProperties(
-                        self.normalFlipXChannel, self.normalFlipYChannel, propertyValues
-                    )
-        return o3deMaterial
-
-    def GetDataAsO3DEMaterialJsonString(
-        self, posixAssetsRelativeTexturePath: str
-    ) -> str:
-        o3deMaterialDict = self.GetDataAsO3DEMaterial(posixAssetsRelativeTexturePath)
-        jsonStr = json.dumps(o3deMaterialDict, indent=4)
-        return jsonStr
-
-
-def GetMaterialsFromObject(obj: bpy.types.Object) -> list[O3Material]:
+        description = {}
+        for socketName, socketDict in self._data.items():
+            socketDescription = dict(socketDict)
+            textureName = socketDict.get("textureName", "")
+            if textureName:
+                colorChannel = socketDict.get(O3Material.OUT_PROP_TEXTURE_CHANNEL, "")
+                socketDescription["texturePath"] = texturePaths.GetSanitizedTexturePath(textureName, colorChannel)
+            description[socketName] = socketDescription
+        return description
+
+
+def GetMaterialsFromObject(
+    obj: bpy.types.Object, materialCache: dict[str, O3Material] = None
+) -> list[O3Material]:
+    """
+    @param materialCache Optional. Materials already parsed, organized by material name.
+           Materials not found in the cache are parsed and added to it.
+    """
     retList = []
     parsedMaterials = {}  # key: materialName, value: O3Material
     for materialSlot in obj.material_slots:
@@ -589,37 +420,60 @@ def GetMaterialsFromObject(obj: bpy.types.Object) -> list[O3Material]:
                 f"WARNING For slot {materialSlot.slot_index}, a material with name '{materialSlot.name}' already exists at slot {o3material.GetSlotIndex()}"
             )
 
+        elif (materialCache is not None) and (materialSlot.name in materialCache):
+            o3material = materialCache[materialSlot.name]
+            parsedMaterials[materialSlot.name] = o3material
         else:
             o3material = O3Material(
                 materialSlot.slot_index, materialSlot.name, materialSlot.material
             )
             parsedMaterials[materialSlot.name] = o3material
+            if materialCache is not None:
+                materialCache[materialSlot.name] = o3material
         retList.append(o3material)
     return retList
 
 
-def SaveAsO3DEMaterial(
-    o3material: O3Material,
+def SaveMaterialDescriptions(
     filePath: str,
-    assetsRelativeTexturePath: str,
+    descriptions: dict[str, dict],
+    overwrite: bool,
     normalFlipXChannel: bool,
     normalFlipYChannel: bool,
+    merge: bool,
 ) -> bool:
+    """
+    Writes the <Scene>.o3mat file, from which the o3dimport Gem writes the .material files in parallel.
+    @param descriptions key: material name, value: O3Material.GetDescription().
+    @param overwrite False to keep the .material files that already exist.
+    @param merge True to keep the descriptions of the materials that are not in @descriptions,
+        for exports of the selected objects only.
+    """
+    materials = {}
+    if merge and os.path.exists(filePath):
+        try:
+            with open(filePath, "r") as file:
+                previousData = json.load(file)
+            if previousData.get("version") == MATERIAL_DESCRIPTIONS_VERSION:
+                materials = previousData["materials"]
+        except Exception as e:
+            print(f"WARNING: Ignoring the previous material descriptions at path '{filePath}'. Error: {e}")
+    materials.update(descriptions)
+    data = {
+        "version": MATERIAL_DESCRIPTIONS_VERSION,
+        "overwrite": overwrite,
+        "normalFlipX": normalFlipXChannel,
+        "normalFlipY": normalFlipYChannel,
+        "materials": materials,
+    }
+    # The file is replaced at once, the importer may read it while the next export is running.
+    tmpFilePath = f"{filePath}.tmp"
     try:
-        o3material.normalFlipXChannel = normalFlipXChannel
-        o3material.normalFlipYChannel = normalFlipYChannel
-        assetsRelativeTexturePath = assetsRelativeTexturePath.replace(
-            os.sep, posixpath.sep
-        )
-        with open(filePath, "w") as file:
-            o3deJsonStr = o3material.GetDataAsO3DEMaterialJsonString(
-                assetsRelativeTexturePath
-            )
-            file.write(o3deJsonStr)
+        with open(tmpFilePath, "w") as file:
+            json.dump(data, file, indent=4)
+        os.replace(tmpFilePath, filePath)
     except Exception as e:
-        print(
-            f"Error trying to save as O3DE material '{o3material.GetName()}' at path '{filePath}'. Error: {e}"
-        )
+        print(f"Error trying to save the material descriptions at path '{filePath}'. Error: {e}")
         return False
     return True
 
@@ -10,8 +10,8 @@ SPDX-License-Identifier: Apache-2.0 OR MIT
 # Donated by Meta Platforms, Inc as an open source project.
 
 import copy
-import json
 import math
+import os
 
 import bpy
 import mathutils
@@ -22,10 +22,12 @@ if __package__ is None or __package__ == "":
 
     # When running as a standalone script from Blender Text View "Run Script"
     import o3material
+    import scenegraph_writer
     import textureasset
+    import transform_track
 else:
     # When running as an installed AddOn, then it runs in package mode.
-    from . import meshasset, o3material, textureasset
+    from . import meshasset, o3material, scenegraph_writer, textureasset, transform_track
 
 
 # The following class works as namespace for some Blender String Constants that
@@ -48,6 +50,27 @@ class RotationModes:
         pass
 
 
+def _SortedByName(objects) -> list[bpy.types.Object]:
+    """
+    Objects are always visited in the order of their names. The order in which Blender
+    reports selected objects, or root objects, changes between sessions, and the order of
+    discovery decides the sanitized names of textures that collide. Visiting
+    in canonical order makes two exports of the same .blend byte for byte identical.
+    """
+    return sorted(objects, key=lambda obj: obj.name)
+
+
+def _CalculateWorldSize(obj: bpy.types.Object) -> float:
+    """
+    @returns The largest side of the world space bounding box of @obj.
+    """
+    corners = [obj.matrix_world @ mathutils.Vector(corner) for corner in obj.bound_box]
+    return max(
+        max([corner[axis] for corner in corners]) - min([corner[axis] for corner in corners])
+        for axis in range(3)
+    )
+
+
 class SceneGraph:
     """
     From a list of Objects, discovers and organizes
@@ -59,10 +82,23 @@ class SceneGraph:
     4. The scene hierarchy (exported as a JSON file).
     """
 
-    def __init__(self, objects: list[bpy.types.Object], recursive: bool):
-        # Original flat list of all the objects to export.
-        self._objects = objects
+    def __init__(
+        self,
+        objects: list[bpy.types.Object],
+        recursive: bool,
+        materialCache: dict[str, o3material.O3Material] = None,
+        exportTransformTracks: bool = False,
+    ):
+        """
+        @param materialCache Optional. Materials parsed by previous SceneGraphs, organized by material name.
+               See dirtytracker.DirtyTracker.GetMaterialCache().
+        @param exportTransformTracks If True, objects with an animation Action get a "track" property
+               with their sampled, keyframe reduced, local transforms.
+        """
+        # Original flat list of all the objects to export, in canonical order.
+        self._objects = _SortedByName(objects)
         self._recursive = recursive
+        self._materialCache = materialCache
         # A dictionary of all the Meshes organized by Mesh Name
         #     key: Mesh name
         #     value: MeshAsset object (Remark: A single Mesh may be referenced by several Objects).
@@ -79,7 +115,15 @@ class SceneGraph:
         #     key: Original (unsanitized) Texture name
         #     value: textureasset.TextureAsset
         self._texturesByTextureName = {}
-        self._DiscoverAssetsFromObjects(objects)
+        # Sanitized texture names must only be unique within this SceneGraph, otherwise
+        # exporting twice in the same Blender session would produce different names.
+        textureasset.TextureAsset.ResetUniqueSanitizedNames()
+        self._DiscoverAssetsFromObjects(self._objects)
+        # A dictionary of the "track" property of the animated objects, organized by Object name.
+        # Only the recursive export writes the SceneGraph, so it's the only one that needs the tracks.
+        self._tracksByObjectName = (
+            self._BuildTransformTracks() if exportTransformTracks and recursive else {}
+        )
 
     def IsRecursive(self) -> bool:
         return self._recursive
@@ -105,16 +149,44 @@ class SceneGraph:
             count += 1 + len(textureAsset.GetSampledChannels())
         return count
 
+    def CalculateTextureUsage(self) -> dict[str, tuple[float, int]]:
+        """
+        For each texture, finds how big the objects that use it are, and how many of them there are.
+        @returns A dictionary organized by original (unsanitized) texture name.
+            value: (Largest world space extent among the objects that use the texture, Count of objects)
+        """
+        usageByTextureName = {}
+        for objName, materialList in self._materialsByObjectName.items():
+            worldSize = _CalculateWorldSize(bpy.data.objects[objName])
+            textureNames = set()
+            for material in materialList:
+                textureNames.update(material.GetTextureNames())
+            for textureName in textureNames:
+                prevWorldSize, prevCount = usageByTextureName.get(textureName, (0.0, 0))
+                usageByTextureName[textureName] = (max(prevWorldSize, worldSize), prevCount + 1)
+        return usageByTextureName
+
     def SaveToFile(self, sceneName: str, outputFilePath: str) -> bool:
-        sceneDictionary = self._BuildSceneDictionary(sceneName)
-        jsonString = json.dumps(sceneDictionary, indent=4)
+        """
+        The SceneGraph is streamed to disk one object at a time, so memory usage
+        stays flat regardless of the number of objects in the scene.
+        It is written to a temporary file first, so a failed export never leaves
+        a truncated SceneGraph behind.
+        """
+        tmpFilePath = f"{outputFilePath}.tmp"
         try:
-            with open(outputFilePath, "w") as file:
-                file.write(jsonString)
+            with open(tmpFilePath, "w") as file:
+                writer = scenegraph_writer.SceneGraphStreamWriter(file)
+                writer.BeginScene(sceneName)
+                self._WriteObjectListRecursive(writer, self._objects)
+                writer.EndScene()
+            os.replace(tmpFilePath, outputFilePath)
         except Exception as e:
             print(
                 f"Error trying to save scene '{sceneName}' at path '{outputFilePath}'. Error: {e}"
             )
+            if os.path.exists(tmpFilePath):
+                os.remove(tmpFilePath)
             return False
         return True
 
@@ -126,18 +198,80 @@ class SceneGraph:
         for obj in objectList:
             if obj.type != ObjType.MESH:
                 if self._recursive:
-                    self._DiscoverAssetsFromObjects(obj.children)
+                    self._DiscoverAssetsFromObjects(_SortedByName(obj.children))
                 continue
             meshName = obj.data.name
             self._meshesByMeshName[meshName] = meshasset.MeshAsset(meshName, obj)
-            objMaterials = o3material.GetMaterialsFromObject(obj)
+            objMaterials = o3material.GetMaterialsFromObject(obj, self._materialCache)
             for material in objMaterials:
                 self._materialsByMaterialName[material.GetName()] = material
                 textureList = material.BuildTextureList()
                 self._UpdateTexturesDictionary(textureList, self._texturesByTextureName)
+                self._MarkNormalMaps(material)
             self._materialsByObjectName[obj.name] = objMaterials
             if self._recursive:
-                self._DiscoverAssetsFromObjects(obj.children)
+                self._DiscoverAssetsFromObjects(_SortedByName(obj.children))
+
+    def _CollectAnimatedObjects(
+        self, objectList: list[bpy.types.Object], animatedObjectsOut: list[bpy.types.Object]
+    ):
+        """
+        Visits the same objects as _DiscoverAssetsFromObjects().
+        """
+        for obj in objectList:
+            if obj.animation_data is not None and obj.animation_data.action is not None:
+                animatedObjectsOut.append(obj)
+            if self._recursive:
+                self._CollectAnimatedObjects(_SortedByName(obj.children), animatedObjectsOut)
+
+    def _BuildTransformTracks(self) -> dict[str, dict]:
+        """
+        Samples the local transform of every animated object once per frame, over the
+        frame range of all their Actions together. Each frame is evaluated only once for all
+        the objects, because changing the current frame re-evaluates the whole scene.
+        """
+        animatedObjects = []
+        self._CollectAnimatedObjects(self._objects, animatedObjects)
+        if len(animatedObjects) == 0:
+            return {}
+        scene = bpy.context.scene
+        frameRanges = [obj.animation_data.action.frame_range for obj in animatedObjects]
+        frameStart = int(math.floor(min(frameRange[0] for frameRange in frameRanges)))
+        frameEnd = int(math.ceil(max(frameRange[1] for frameRange in frameRanges)))
+        framesPerSecond = scene.render.fps / scene.render.fps_base
+
+        samplesByObjectName = {obj.name: ([], [], []) for obj in animatedObjects}
+        originalFrame = scene.frame_current
+        try:
+            for frame in range(frameStart, frameEnd + 1):
+                scene.frame_set(frame)
+                for obj in animatedObjects:
+                    translation, rotation, scale = obj.matrix_basis.decompose()
+                    translations, rotations, scales = samplesByObjectName[obj.name]
+                    translations.append(tuple(translation))
+                    rotations.append((rotation.x, rotation.y, rotation.z, rotation.w))
+                    scales.append(tuple(scale))
+        finally:
+            scene.frame_set(originalFrame)
+
+        times = [(frame - frameStart) / framesPerSecond for frame in range(frameStart, frameEnd + 1)]
+        tracksByObjectName = {}
+        for objName, (translations, rotations, scales) in samplesByObjectName.items():
+            track = transform_track.BuildTrackDictionary(times, translations, rotations, scales)
+            if track is not None:
+                tracksByObjectName[objName] = track
+        return tracksByObjectName
+
+    def _MarkNormalMaps(self, material: o3material.O3Material):
+        """
+        Textures used as normal maps are renamed as "XXX_normal.XXX" here, before any
+        material or texture is exported, so the exported materials don't depend on
+        the order in which they are written.
+        """
+        for textureName in material.GetNormalMapTextureNames():
+            textureAsset = self._texturesByTextureName[textureName]
+            if not textureAsset.IsNormalMap():
+                textureAsset.SanitizeNameAsNormalMap()
 
     def _UpdateTexturesDictionary(
         self,
@@ -158,22 +292,16 @@ class SceneGraph:
                     textureAsset
                 )
 
-    def _BuildSceneDictionary(self, sceneName: str) -> dict:
-        # This will be a recursive process starting from the root objects
-        outputDict = {
-            "name": sceneName,
-            "children": self._BuildObjectListRecursive(self._objects),
-        }
-        return outputDict
-
-    def _BuildObjectListRecursive(self, objectList: list[bpy.types.Object]) -> list:
-        retList = []
+    def _WriteObjectListRecursive(
+        self,
+        writer: scenegraph_writer.SceneGraphStreamWriter,
+        objectList: list[bpy.types.Object],
+    ):
         for obj in objectList:
-            objDictionary = self._BuildObjectDictionary(obj)
+            writer.BeginNode(self._BuildObjectDictionary(obj))
             if len(obj.children) > 0:
-                objDictionary["children"] = self._BuildObjectListRecursive(obj.children)
-            retList.append(objDictionary)
-        return retList
+                self._WriteObjectListRecursive(writer, _SortedByName(obj.children))
+            writer.EndNode()
 
     def _BuildObjectDictionary(self, obj: bpy.types.Object) -> dict:
         retDict = {
@@ -190,6 +318,8 @@ class SceneGraph:
             for material in materialList:
                 materialsNameList.append(material.GetName())
             retDict["materials"] = materialsNameList
+        if obj.name in self._tracksByObjectName:
+            retDict["track"] = self._tracksByObjectName[obj.name]
         return retDict
 
     def _BuildLocalTransformDictionary(self, obj: bpy.types.Object) -> dict:
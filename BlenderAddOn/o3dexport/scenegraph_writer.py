@@ -0,0 +1,267 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Created by Galib Arrieta (aka galibzon@github, lumbermixalot@github)
+# under contract with Meta Platforms, Inc.
+# Donated by Meta Platforms, Inc as an open source project.
+
+import json
+
+# REMARK: This module must not import bpy, so it can be benchmarked
+# outside of Blender. See _Benchmark() at the bottom of this file.
+
+# The writer accumulates small strings and hands them to the file
+# in writes of, at least, this many characters.
+DEFAULT_CHUNK_SIZE = 1024 * 1024
+
+INDENT = "    "
+
+
+def _FormatFloat(value: float) -> str:
+    # Same rules as the json module.
+    if value != value:
+        return "NaN"
+    if value == float("inf"):
+        return "Infinity"
+    if value == -float("inf"):
+        return "-Infinity"
+    return float.__repr__(value)
+
+
+def _FormatValue(value, level: int) -> str:
+    """
+    Same output as json.dumps(value, indent=4) for a value nested at indentation @level,
+    but without going through the (slow) pure python encoder that the json module
+    uses whenever indentation is requested.
+    """
+    if isinstance(value, str):
+        return json.dumps(value)
+    if value is True:
+        return "true"
+    if value is False:
+        return "false"
+    if value is None:
+        return "null"
+    if isinstance(value, int):
+        return int.__repr__(value)
+    if isinstance(value, float):
+        return _FormatFloat(value)
+    if isinstance(value, (list, tuple)):
+        if len(value) == 0:
+            return "[]"
+        itemIndent = f"\n{INDENT * (level + 1)}"
+        items = f",{itemIndent}".join([_FormatValue(item, level + 1) for item in value])
+        return f"[{itemIndent}{items}\n{INDENT * level}]"
+    if isinstance(value, dict):
+        if len(value) == 0:
+            return "{}"
+        itemIndent = f"\n{INDENT * (level + 1)}"
+        items = f",{itemIndent}".join(
+            [f"{json.dumps(str(k))}: {_FormatValue(v, level + 1)}" for k, v in value.items()]
+        )
+        return f"{{{itemIndent}{items}\n{INDENT * level}}}"
+    # Anything else (e.g. mathutils types) goes through the json module.
+    return json.dumps(value, indent=4).replace("\n", f"\n{INDENT * level}")
+
+
+class _OpenNode:
+    """
+    Bookkeeping for a JSON object that has been opened by the writer but not closed yet.
+    """
+
+    __slots__ = ("level", "fieldCount", "isChildrenListOpen")
+
+    def __init__(self, level: int):
+        # Indentation level of the fields of this object.
+        self.level = level
+        self.fieldCount = 0
+        self.isChildrenListOpen = False
+
+
+class SceneGraphStreamWriter:
+    """
+    Writes a SceneGraph (.sgr) file one node at a time, without ever building
+    the dictionary of the whole scene in memory.
+    The output is byte for byte identical to json.dumps(sceneDictionary, indent=4).
+    Usage:
+        writer = SceneGraphStreamWriter(fileObj)
+        writer.BeginScene("MyScene")
+        writer.BeginNode({"name": "Parent", "transform": {...}})
+        writer.BeginNode({"name": "Child", "transform": {...}})
+        writer.EndNode()
+        writer.EndNode()
+        writer.EndScene()
+    """
+
+    def __init__(self, fileObj, chunkSize: int = DEFAULT_CHUNK_SIZE):
+        self._fileObj = fileObj
+        self._chunkSize = chunkSize
+        self._chunks = []
+        self._chunksLength = 0
+        self._openNodes = []
+        self.bytesWritten = 0
+
+    def _Write(self, text: str):
+        self._chunks.append(text)
+        self._chunksLength += len(text)
+        if self._chunksLength >= self._chunkSize:
+            self.Flush()
+
+    def Flush(self):
+        if not self._chunks:
+            return
+        chunk = "".join(self._chunks)
+        self._fileObj.write(chunk)
+        self.bytesWritten += len(chunk)
+        self._chunks.clear()
+        self._chunksLength = 0
+
+    def _WriteKey(self, openNode: _OpenNode, key: str):
+        if openNode.fieldCount > 0:
+            self._Write(",")
+        self._Write(f"\n{INDENT * openNode.level}{json.dumps(key)}: ")
+        openNode.fieldCount += 1
+
+    def _WriteField(self, openNode: _OpenNode, key: str, value):
+        self._WriteKey(openNode, key)
+        self._Write(_FormatValue(value, openNode.level))
+
+    def _WriteFields(self, openNode: _OpenNode, fields: dict):
+        for key, value in fields.items():
+            if key == "children":
+                raise Exception("Children must be written with BeginNode()/EndNode()")
+            self._WriteField(openNode, key, value)
+
+    def BeginScene(self, sceneName: str):
+        if self._openNodes:
+            raise Exception("BeginScene() can only be called once")
+        self._Write("{")
+        sceneNode = _OpenNode(1)
+        self._openNodes.append(sceneNode)
+        self._WriteField(sceneNode, "name", sceneName)
+
+    def EndScene(self):
+        if len(self._openNodes) != 1:
+            raise Exception(f"EndScene() called with {len(self._openNodes) - 1} node(s) still open")
+        sceneNode = self._openNodes.pop()
+        if sceneNode.isChildrenListOpen:
+            self._Write(f"\n{INDENT * sceneNode.level}]")
+        else:
+            # The scene always has a "children" list, even if empty.
+            self._WriteField(sceneNode, "children", [])
+        self._Write("\n}")
+        self.Flush()
+
+    def BeginNode(self, fields: dict):
+        """
+        Opens a new node as the last child of the most recently opened node (or the scene).
+        @param fields All the properties of the node, except "children".
+        """
+        parentNode = self._openNodes[-1]
+        if parentNode.isChildrenListOpen:
+            self._Write(",")
+        else:
+            self._WriteKey(parentNode, "children")
+            self._Write("[")
+            parentNode.isChildrenListOpen = True
+        self._Write(f"\n{INDENT * (parentNode.level + 1)}{{")
+        openNode = _OpenNode(parentNode.level + 2)
+        self._openNodes.append(openNode)
+        self._WriteFields(openNode, fields)
+
+    def EndNode(self):
+        if len(self._openNodes) < 2:
+            raise Exception("EndNode() called without a matching BeginNode()")
+        openNode = self._openNodes.pop()
+        if openNode.isChildrenListOpen:
+            self._Write(f"\n{INDENT * openNode.level}]")
+        self._Write(f"\n{INDENT * (openNode.level - 1)}}}")
+
+
+def _Benchmark(nodeCount: int = 100000, childrenPerNode: int = 4):
+    """
+    Compares building the whole scene dictionary + json.dumps() (DOM) against
+    SceneGraphStreamWriter (Streaming), for a synthetic tree of @nodeCount nodes.
+    """
+    import hashlib
+    import time
+    import tracemalloc
+
+    class HashingSink:
+        # Stands in for a file. Only keeps a digest, so the output itself
+        # doesn't count towards the measured peak memory.
+        def __init__(self):
+            self.hasher = hashlib.sha256()
+
+        def write(self, text: str):
+            self.hasher.update(text.encode("utf-8"))
+
+    def MakeFields(index: int) -> dict:
+        return {
+            "name": f"Node.{index:06}",
+            "transform": {
+                "translate": (index * 0.5, index * 0.25, 1.0),
+                "rotate": (0.0, 90.0, index % 360 * 1.0),
+                "scale": (1.0, 1.0, 1.0),
+            },
+            "mesh": f"Mesh_{index % 97:03}",
+            "materials": [f"Material.{index % 31:03}"],
+        }
+
+    def Visit(index: int, onBegin, onEnd):
+        # Nodes are numbered in breadth first order of a complete tree.
+        stack = [(index, False)]
+        while stack:
+            nodeIndex, isClosing = stack.pop()
+            if isClosing:
+                onEnd()
+                continue
+            onBegin(nodeIndex)
+            stack.append((nodeIndex, True))
+            firstChild = nodeIndex * childrenPerNode + 1
+            for childIndex in reversed(range(firstChild, min(firstChild + childrenPerNode, nodeCount))):
+                stack.append((childIndex, False))
+
+    def WriteWithDom(fileObj):
+        scene = {"name": "Benchmark", "children": []}
+        nodeStack = [scene]
+
+        def OnBegin(nodeIndex):
+            node = MakeFields(nodeIndex)
+            nodeStack[-1].setdefault("children", []).append(node)
+            nodeStack.append(node)
+
+        def OnEnd():
+            nodeStack.pop()
+
+        Visit(0, OnBegin, OnEnd)
+        fileObj.write(json.dumps(scene, indent=4))
+
+    def WriteWithStream(fileObj):
+        writer = SceneGraphStreamWriter(fileObj)
+        writer.BeginScene("Benchmark")
+        Visit(0, lambda nodeIndex: writer.BeginNode(MakeFields(nodeIndex)), writer.EndNode)
+        writer.EndScene()
+
+    digests = {}
+    for label, writeFunction in (("DOM", WriteWithDom), ("Streaming", WriteWithStream)):
+        sink = HashingSink()
+        startTime = time.perf_counter()
+        writeFunction(sink)
+        elapsedTime = time.perf_counter() - startTime
+        digests[label] = sink.hasher.hexdigest()
+        # Measured on a second run, tracemalloc slows down the first one too much.
+        tracemalloc.start()
+        writeFunction(HashingSink())
+        _, peakBytes = tracemalloc.get_traced_memory()
+        tracemalloc.stop()
+        print(f"{label:>10}: {nodeCount} nodes in {elapsedTime:.3f} seconds. Peak memory = {peakBytes / (1024 * 1024):.1f} MiB")
+    print(f"Identical output: {digests['DOM'] == digests['Streaming']}")
+
+
+if __name__ == "__main__":
+    _Benchmark()
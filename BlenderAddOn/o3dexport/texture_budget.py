@@ -0,0 +1,145 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Created by Galib Arrieta (aka galibzon@github, lumbermixalot@github)
+# under contract with Meta Platforms, Inc.
+# Donated by Meta Platforms, Inc as an open source project.
+
+import heapq
+import math
+
+# REMARK: This module must not import bpy. It only does the bookkeeping
+# of how much GPU memory the exported textures will need once the O3DE
+# Asset Processor compresses them, and decides which ones must be downscaled.
+
+# Textures are never downscaled below this size (in pixels) on their largest side.
+MIN_RESOLUTION = 64
+
+# Approximate bytes per texel after compression by the O3DE Image Builder.
+# BC1 (Albedo without alpha) and BC4 (single channel) use half a byte per texel.
+# BC3/BC7 (Albedo with alpha) and BC5 (Normals) use one byte per texel.
+BYTES_PER_TEXEL_BC1 = 0.5
+BYTES_PER_TEXEL_BC4 = 0.5
+BYTES_PER_TEXEL_BC5 = 1.0
+BYTES_PER_TEXEL_BC7 = 1.0
+
+# A full mip chain adds one third to the size of the top mip.
+MIP_CHAIN_FACTOR = 4.0 / 3.0
+
+
+def EstimateGpuBytes(width: int, height: int, bytesPerTexel: float) -> int:
+    return int(width * height * bytesPerTexel * MIP_CHAIN_FACTOR)
+
+
+def GetBytesPerTexel(isNormalMap: bool, channelCount: int, sampledChannelCount: int) -> float:
+    """
+    @param sampledChannelCount Each sampled color channel is exported as its own single channel
+           texture, with the same resolution as the original texture.
+    @returns The combined bytes per texel of all the texture files exported for one TextureAsset.
+    """
+    if isNormalMap:
+        bytesPerTexel = BYTES_PER_TEXEL_BC5
+    elif channelCount >= 4:
+        bytesPerTexel = BYTES_PER_TEXEL_BC7
+    elif channelCount == 1:
+        bytesPerTexel = BYTES_PER_TEXEL_BC4
+    else:
+        bytesPerTexel = BYTES_PER_TEXEL_BC1
+    return bytesPerTexel + sampledChannelCount * BYTES_PER_TEXEL_BC4
+
+
+class TextureBudgetEntry:
+    """
+    What the planner needs to know about one texture.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        width: int,
+        height: int,
+        bytesPerTexel: float,
+        worldSize: float,
+        useCount: int,
+    ):
+        """
+        @param worldSize Largest world space extent (in meters) among the objects that use the texture.
+        @param useCount How many objects use the texture.
+        """
+        self.name = name
+        self.width = width
+        self.height = height
+        self.bytesPerTexel = bytesPerTexel
+        self.worldSize = worldSize
+        self.useCount = useCount
+
+    def GetGpuBytes(self) -> int:
+        return EstimateGpuBytes(self.width, self.height, self.bytesPerTexel)
+
+
+def _CalculateTexelDensity(width: int, height: int, worldSize: float, useCount: int) -> float:
+    """
+    Pixels per meter of the largest side of the texture, on the largest object that uses it.
+    Textures used by many objects are more likely to be seen up close somewhere, so their
+    density is discounted by the square root of the use count.
+    """
+    worldSize = max(worldSize, 0.01)
+    return max(width, height) / (worldSize * math.sqrt(max(useCount, 1)))
+
+
+def PlanTextureResolutions(
+    entries: list[TextureBudgetEntry],
+    budgetBytes: int,
+    minResolution: int = MIN_RESOLUTION,
+) -> dict[str, tuple[int, int]]:
+    """
+    Greedily halves the resolution of the texture with the highest texel density
+    until the projected GPU memory of all textures fits in @budgetBytes, or no
+    texture can be halved anymore.
+    The plan only depends on the input, so two exports of the same scene produce
+    the same resolutions.
+    @returns A dictionary of target resolutions, organized by texture name.
+        Only the textures that must be downscaled are present.
+    """
+    resolutions = {entry.name: (entry.width, entry.height) for entry in entries}
+    totalBytes = sum([entry.GetGpuBytes() for entry in entries])
+    # Max-heap by texel density. The name breaks ties deterministically.
+    heap = []
+    for entry in entries:
+        if max(entry.width, entry.height) // 2 >= minResolution:
+            density = _CalculateTexelDensity(entry.width, entry.height, entry.worldSize, entry.useCount)
+            heap.append((-density, entry.name, entry))
+    heapq.heapify(heap)
+    while totalBytes > budgetBytes and heap:
+        _, name, entry = heapq.heappop(heap)
+        width, height = resolutions[name]
+        newWidth, newHeight = max(width // 2, 1), max(height // 2, 1)
+        totalBytes -= EstimateGpuBytes(width, height, entry.bytesPerTexel)
+        totalBytes += EstimateGpuBytes(newWidth, newHeight, entry.bytesPerTexel)
+        resolutions[name] = (newWidth, newHeight)
+        if max(newWidth, newHeight) // 2 >= minResolution:
+            density = _CalculateTexelDensity(newWidth, newHeight, entry.worldSize, entry.useCount)
+            heapq.heappush(heap, (-density, name, entry))
+    return {
+        entry.name: resolutions[entry.name]
+        for entry in entries
+        if resolutions[entry.name] != (entry.width, entry.height)
+    }
+
+
+def CalculateTotalGpuBytes(
+    entries: list[TextureBudgetEntry], resolutions: dict[str, tuple[int, int]] = None
+) -> int:
+    """
+    @param resolutions Optional target resolutions, as returned by PlanTextureResolutions().
+    """
+    resolutions = resolutions or {}
+    totalBytes = 0
+    for entry in entries:
+        width, height = resolutions.get(entry.name, (entry.width, entry.height))
+        totalBytes += EstimateGpuBytes(width, height, entry.bytesPerTexel)
+    return totalBytes
@@ -62,7 +62,7 @@ def _CreateResampledTextures(
         print(msg)
         raise Exception(msg)
     overwriteTextures = exportSettings.GetFlagOverwriteTextures()
-    for colorChannel in colorChannels:
+    for colorChannel in sorted(colorChannels):
         resampledFinalOutputName = fileutils.GetResampledSanitizedFilenameExtension(
             sanitizedTextureName, colorChannel
         )
@@ -85,9 +85,59 @@ def _CreateResampledTextures(
         yield msg
 
 
+def IsColorData(image: bpy.types.Image) -> bool:
+    """
+    @returns False for images that store data (normals, roughness, etc) instead of colors.
+    """
+    return image.colorspace_settings.name not in ("Non-Color", "Linear Rec.709", "Raw")
+
+
+def _GetPassthroughSourceFilePath(image: bpy.types.Image, finalOutputPath: str) -> str:
+    """
+    @returns The path of the file that @image was loaded from, if that file can be copied as is
+        to @finalOutputPath instead of encoding the pixels again. Otherwise returns "".
+    """
+    if (image.source != "FILE") or (image.packed_file is not None) or image.is_dirty:
+        return ""
+    sourceFilePath = bpy.path.abspath(image.filepath, library=image.library)
+    if not os.path.isfile(sourceFilePath):
+        return ""
+    _, sourceExt = os.path.splitext(sourceFilePath)
+    _, outputExt = os.path.splitext(finalOutputPath)
+    sourceFormat = fileutils.IMAGE_FILE_FORMAT_BY_EXTENSION.get(sourceExt.lower())
+    if (sourceFormat is None) or (sourceFormat != image.file_format):
+        return ""
+    if sourceFormat != fileutils.IMAGE_FILE_FORMAT_BY_EXTENSION.get(outputExt.lower()):
+        return ""
+    return sourceFilePath
+
+
+def _SaveDownscaledImage(
+    image: bpy.types.Image,
+    textureAsset: textureasset.TextureAsset,
+    finalOutputPath: str,
+    targetResolution: tuple[int, int],
+):
+    """
+    Writes @image at @finalOutputPath, resized to @targetResolution.
+    The original image in Blender is never modified.
+    """
+    sourceFilePath = bpy.path.abspath(image.filepath, library=image.library) if image.packed_file is None else ""
+    if (not sourceFilePath) or (not os.path.isfile(sourceFilePath)) or image.is_dirty:
+        # The pixels only exist in Blender. Save them at full resolution first.
+        image.save(filepath=finalOutputPath)
+        sourceFilePath = finalOutputPath
+    imageBuf = imageutils.LoadImageFileAsFloatImageBuf(sourceFilePath)
+    isColorData = IsColorData(image) and (not textureAsset.IsNormalMap())
+    width, height = targetResolution
+    resizedImageBuf = imageutils.ResizeImageBuf(imageBuf, width, height, isColorData)
+    imageutils.WriteImageBuf(resizedImageBuf, finalOutputPath)
+
+
 def ExportTextureAsset(
     exportSettings: export_settings.ExportSettings,
     textureAsset: textureasset.TextureAsset,
+    targetResolution: tuple[int, int] = None,
 ) -> Iterator[str]:
     """
     Typically only one Texture file is exported for each  TextureAsset object,
@@ -101,6 +151,7 @@ def ExportTextureAsset(
         [2] Green Channel Texture (Optional).
         [3] Blue Channel Texture (Optional).
         [4] Alpha Channel Texture (Optional).
+    @param targetResolution If not None, the exported texture files are downscaled to this size.
     """
     originalTextureName = textureAsset.GetName()
     if originalTextureName not in bpy.data.images:
@@ -117,13 +168,35 @@ def ExportTextureAsset(
     )
     overwriteTextures = exportSettings.GetFlagOverwriteTextures()
     if overwriteTextures or (not os.path.exists(finalOutputPath)):
-        try:
-            image.save(filepath=finalOutputPath)
-        except Exception as e:
-            msg = f"Got exception when calling image.save('{finalOutputPath}'): {e}"
-            print(msg)
-            raise Exception(msg)
-        msg = f"Exported texture '{originalTextureName}' As: {finalOutputPath}"
+        if (targetResolution is not None) and (tuple(targetResolution) != tuple(image.size)):
+            try:
+                _SaveDownscaledImage(image, textureAsset, finalOutputPath, targetResolution)
+            except Exception as e:
+                msg = f"Got exception when downscaling '{originalTextureName}' into '{finalOutputPath}': {e}"
+                print(msg)
+                raise Exception(msg)
+            msg = f"Exported texture '{originalTextureName}' As: {finalOutputPath}, downscaled from {tuple(image.size)} to {tuple(targetResolution)}"
+        elif sourceFilePath := _GetPassthroughSourceFilePath(image, finalOutputPath):
+            # The file on disk already has the exact bytes we want. Copying it is much
+            # faster than encoding the pixels again, and keeps the output byte for byte stable.
+            if os.path.exists(finalOutputPath) and os.path.samefile(sourceFilePath, finalOutputPath):
+                method = "in place"
+            else:
+                try:
+                    method = fileutils.TransferFile(sourceFilePath, finalOutputPath)
+                except Exception as e:
+                    msg = f"Got exception when copying '{sourceFilePath}' into '{finalOutputPath}': {e}"
+                    print(msg)
+                    raise Exception(msg)
+            msg = f"Exported texture '{originalTextureName}' As: {finalOutputPath}, copied from '{sourceFilePath}' ({method})"
+        else:
+            try:
+                image.save(filepath=finalOutputPath)
+            except Exception as e:
+                msg = f"Got exception when calling image.save('{finalOutputPath}'): {e}"
+                print(msg)
+                raise Exception(msg)
+            msg = f"Exported texture '{originalTextureName}' As: {finalOutputPath}"
         print(msg)
     else:
         msg = f"Skipped exporting texture '{originalTextureName}' As: {finalOutputPath} because texture overwrite is disabled."
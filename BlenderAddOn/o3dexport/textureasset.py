@@ -144,6 +144,10 @@ class TextureAsset:
         self._sampledChannels = set()
         self._isNormalMap = False
 
+    @staticmethod
+    def ResetUniqueSanitizedNames():
+        TextureAsset._uniqueSanitizedNames.clear()
+
     def _GetUniqueSanitizedTextureName(self, name) -> str:
         sanitizedName = _SanitizeTextureName(name)
         while sanitizedName in TextureAsset._uniqueSanitizedNames:
@@ -0,0 +1,165 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Created by Galib Arrieta (aka galibzon@github, lumbermixalot@github)
+# under contract with Meta Platforms, Inc.
+# Donated by Meta Platforms, Inc as an open source project.
+
+import math
+
+# REMARK: This module must not import bpy. It turns the sampled local transforms
+# of an animated object into the compact "track" property of a SceneGraph node.
+# See docs_o3dexport/SceneGraph.md, and the reader in Code/Source/Tools/TransformTrackSet.cpp.
+
+# Largest error, per component, that keyframe reduction may introduce.
+TRANSLATION_TOLERANCE = 0.001  # Meters.
+ROTATION_TOLERANCE = 0.0005  # Quaternion component units, about 0.06 degrees.
+SCALE_TOLERANCE = 0.001
+
+# "Smallest three" quaternion quantization: the largest component is dropped, and
+# rebuilt from the unit length. The other three are always in [-1/sqrt(2), 1/sqrt(2)],
+# and are stored in 15 bits each. The two bits of the index of the dropped component
+# are the top bits of the first and second values.
+MAX_SMALLEST_COMPONENT = 1.0 / math.sqrt(2.0)
+MAX_QUANTIZED_COMPONENT = 0x7FFF
+
+
+def QuantizeQuaternion(quat: tuple[float, float, float, float]) -> tuple[int, int, int]:
+    """
+    @param quat Unit quaternion as (x, y, z, w).
+    """
+    droppedIndex = max(range(4), key=lambda index: abs(quat[index]))
+    # q and -q are the same rotation, so the dropped component is always positive.
+    sign = -1.0 if quat[droppedIndex] < 0.0 else 1.0
+    values = []
+    for index in range(4):
+        if index == droppedIndex:
+            continue
+        component = max(-MAX_SMALLEST_COMPONENT, min(MAX_SMALLEST_COMPONENT, quat[index] * sign))
+        normalized = (component / MAX_SMALLEST_COMPONENT + 1.0) * 0.5
+        values.append(int(round(normalized * MAX_QUANTIZED_COMPONENT)))
+    values[0] |= (droppedIndex >> 1) << 15
+    values[1] |= (droppedIndex & 1) << 15
+    return tuple(values)
+
+
+def DequantizeQuaternion(values: tuple[int, int, int]) -> tuple[float, float, float, float]:
+    droppedIndex = ((values[0] >> 15) << 1) | (values[1] >> 15)
+    smallest = [
+        ((value & MAX_QUANTIZED_COMPONENT) / MAX_QUANTIZED_COMPONENT * 2.0 - 1.0) * MAX_SMALLEST_COMPONENT
+        for value in values
+    ]
+    droppedComponent = math.sqrt(max(0.0, 1.0 - sum(value * value for value in smallest)))
+    components = smallest[:droppedIndex] + [droppedComponent] + smallest[droppedIndex:]
+    length = math.sqrt(sum(component * component for component in components))
+    return tuple(component / length for component in components)
+
+
+def MakeHemisphereContinuous(quats: list[tuple[float, float, float, float]]) -> list[tuple[float, float, float, float]]:
+    """
+    Flips the sign of the quaternions that are in the opposite hemisphere of the previous one,
+    so interpolating between consecutive keys always takes the short path.
+    """
+    result = []
+    for quat in quats:
+        if result and sum(a * b for a, b in zip(result[-1], quat)) < 0.0:
+            quat = tuple(-component for component in quat)
+        result.append(tuple(quat))
+    return result
+
+
+def _Lerp(a: tuple, b: tuple, weight: float, normalize: bool) -> tuple:
+    value = tuple(x + (y - x) * weight for x, y in zip(a, b))
+    if normalize:
+        length = math.sqrt(sum(component * component for component in value))
+        if length > 0.0:
+            value = tuple(component / length for component in value)
+    return value
+
+
+def ReduceKeys(times: list[float], values: list[tuple], tolerance: float, normalize: bool = False) -> list[int]:
+    """
+    Ramer-Douglas-Peucker keyframe reduction. A key is removed when interpolating between the
+    keys that are kept reproduces every removed sample within @tolerance, per component.
+    @param normalize True for quaternions, which are interpolated with normalized lerp.
+    @returns The indices of the keys to keep, in order. Constant channels reduce to a single key.
+    """
+    if len(times) <= 1:
+        return list(range(len(times)))
+    if all(
+        abs(component - firstComponent) <= tolerance
+        for value in values
+        for component, firstComponent in zip(value, values[0])
+    ):
+        return [0]
+
+    keep = {0, len(times) - 1}
+    # Iterative instead of recursive, long tracks would hit the python recursion limit.
+    pending = [(0, len(times) - 1)]
+    while pending:
+        first, last = pending.pop()
+        worstIndex = -1
+        worstError = tolerance
+        for index in range(first + 1, last):
+            weight = (times[index] - times[first]) / (times[last] - times[first])
+            interpolated = _Lerp(values[first], values[last], weight, normalize)
+            error = max(abs(x - y) for x, y in zip(interpolated, values[index]))
+            if error > worstError:
+                worstIndex = index
+                worstError = error
+        if worstIndex >= 0:
+            keep.add(worstIndex)
+            pending.append((first, worstIndex))
+            pending.append((worstIndex, last))
+    return sorted(keep)
+
+
+def _RoundVector(vector: tuple) -> list[float]:
+    return [round(component, 6) for component in vector]
+
+
+def _BuildChannelDictionary(times: list[float], values: list[tuple], keyIndices: list[int], encode) -> dict:
+    flatValues = []
+    for index in keyIndices:
+        flatValues.extend(encode(values[index]))
+    return {
+        "times": [round(times[index], 6) for index in keyIndices],
+        "values": flatValues,
+    }
+
+
+def BuildTrackDictionary(
+    times: list[float],
+    translations: list[tuple[float, float, float]],
+    rotations: list[tuple[float, float, float, float]],
+    scales: list[tuple[float, float, float]],
+) -> dict:
+    """
+    @param times Seconds of each sample since the start of the animation, increasing.
+    @param rotations Unit quaternions as (x, y, z, w).
+    @returns The "track" property of a SceneGraph node, or None if nothing moves.
+    """
+    if len(times) < 2:
+        return None
+
+    # Rotations are reduced on the values the importer will decode, so the
+    # quantization error counts against the tolerance too.
+    quantizedRotations = [QuantizeQuaternion(quat) for quat in MakeHemisphereContinuous(rotations)]
+    decodedRotations = MakeHemisphereContinuous([DequantizeQuaternion(values) for values in quantizedRotations])
+
+    translationKeys = ReduceKeys(times, translations, TRANSLATION_TOLERANCE)
+    rotationKeys = ReduceKeys(times, decodedRotations, ROTATION_TOLERANCE, normalize=True)
+    scaleKeys = ReduceKeys(times, scales, SCALE_TOLERANCE)
+    if len(translationKeys) == 1 and len(rotationKeys) == 1 and len(scaleKeys) == 1:
+        return None
+
+    return {
+        "duration": round(times[-1], 6),
+        "translate": _BuildChannelDictionary(times, translations, translationKeys, _RoundVector),
+        "rotate": _BuildChannelDictionary(times, quantizedRotations, rotationKeys, list),
+        "scale": _BuildChannelDictionary(times, scales, scaleKeys, _RoundVector),
+    }
@@ -3,8 +3,12 @@
 
 #include <o3dimport/o3dimportTypeIds.h>
 
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Component/EntityId.h>
 #include <AzCore/EBus/EBus.h>
 #include <AzCore/Interface/Interface.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
 
 namespace o3dimport
 {
@@ -13,7 +17,103 @@ namespace o3dimport
     public:
         AZ_RTTI(o3dimportRequests, o3dimportRequestsTypeId);
         virtual ~o3dimportRequests() = default;
-        // Put your public methods here
+
+        //! Parses the SceneGraph (.sgr) file and draws a proxy for each one of its nodes in the main viewport,
+        //! so the layout of the scene can be seen before any entity is created or asset is assigned.
+        //! Replaces the previous preview, if any.
+        //! @returns false if the file could not be parsed.
+        virtual bool ShowSceneGraphPreview(const AZStd::string& sceneGraphFilePath) = 0;
+        //! Binds the node at @nodePath ("Root/Child/Node") to the entity imported for it. The proxy of a node with a mesh
+        //! is removed when the model of the entity is ready, the proxy of any other node right away.
+        //! The preview is cleared automatically when all the proxies have been removed.
+        virtual void AttachSceneGraphPreviewNode(const AZStd::string& nodePath, const AZ::EntityId& entityId) = 0;
+        virtual void ClearSceneGraphPreview() = 0;
+
+        //! Lazy mode. The model is only assigned while the entity is inside the Editor camera frustum,
+        //! up to the o3dimport_lazyMaxResidentEntities cap, and for real when MaterializeLazyAssets() is called.
+        //! @returns false, and does nothing, if the entity already uses @modelAssetId.
+        virtual bool RegisterLazyModelAsset(const AZ::EntityId& entityId, const AZ::Data::AssetId& modelAssetId) = 0;
+        //! Same as RegisterLazyModelAsset() for the material of the model slot labeled @slotLabel.
+        virtual void RegisterLazyMaterialAsset(
+            const AZ::EntityId& entityId, const AZStd::string& slotLabel, const AZ::Data::AssetId& materialAssetId) = 0;
+        //! Assigns all the lazily registered assets in one undo batch, so they are saved with the level.
+        //! Runs automatically before exporting the level and before entering game mode.
+        //! @returns The number of entities that got their assets assigned.
+        virtual AZ::u32 MaterializeLazyAssets() = 0;
+        virtual AZ::u32 GetLazyAssetCount() = 0;
+
+        //! Creates, in parallel, the entities of the SceneGraph (.sgr) file that don't exist yet in the level,
+        //! with their Transform, NonUniformScale, Mesh and Material components, and the model asset already assigned.
+        //! They are added to the focused prefab instance of the level, in a single undo step.
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products.
+        //! @returns One id per node, parents before children and siblings in file order: the id of the entity
+        //!          that was created, or an invalid id if the entity already existed. Empty if the file could not be parsed
+        //!          or no level is open.
+        virtual AZStd::vector<AZ::EntityId> BuildSceneGraphEntities(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder) = 0;
+
+        //! Parses the SceneGraph (.sgr) file and writes its node names, parent indices and world transforms
+        //! as flat arrays in @modelFilePath, that python maps in memory (see SceneGraphModelFile.h for the layout).
+        //! @returns false if the file could not be parsed or written.
+        virtual bool ExportSceneGraphModel(const AZStd::string& sceneGraphFilePath, const AZStd::string& modelFilePath) = 0;
+
+        //! Compares the editor entities of the level against the SceneGraph (.sgr) file: parent, local transform,
+        //! model asset, and the material asset of each labeled slot.
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products.
+        //! @param materialProductFolder Folder, relative to the project, of the .azmaterial products.
+        //! @param tolerance Used for each translation and scale component.
+        //! @param angleToleranceDegrees Maximum angle between the expected and the actual local rotation.
+        //! @returns A compact report of the mismatches, its first line has the counts per kind of mismatch, and the
+        //!     number of nodes whose materials could not be verified yet. Empty if the file could not be parsed.
+        virtual AZStd::string VerifySceneGraphEntities(
+            const AZStd::string& sceneGraphFilePath,
+            const AZStd::string& meshProductFolder,
+            const AZStd::string& materialProductFolder,
+            float tolerance,
+            float angleToleranceDegrees) = 0;
+
+        //! Projects the GPU and disk memory of the scene from the files in the folder of the SceneGraph (.sgr) file:
+        //! texture headers (dimensions, channels, mip chain), material texture references, and the sizes of the
+        //! processed mesh buffers. Assets shared by several nodes are split evenly among them.
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products. Resolved in the asset cache.
+        //! @param maxDepth Deepest level of the SceneGraph with its own line in the subtree breakdown.
+        //! @returns The report. Empty if the file could not be parsed.
+        virtual AZStd::string ReportSceneMemory(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, AZ::u32 maxDepth) = 0;
+
+        //! Finds the scenes, and the nodes within them, that reference a mesh or material product. Uses a reverse index of all
+        //! the <Scene>/<Scene>.sgr files in @scenesFolder, persisted in @indexFilePath, where only the SceneGraph files
+        //! that changed since the previous call are parsed again.
+        //! @param scenesFolder Absolute path of a folder of the project. The products of a scene are in the folder of its
+        //!     SceneGraph, relative to the project.
+        //! @param productPath Product path relative to the project, e.g. Assets/Scenes/Town/Materials/Brick.azmaterial.
+        //!     The source path of a mesh (.fbx) or material (.material) is accepted too.
+        //! @returns A report, its first line has the counts, then one "<Scene>: <node path>" line per reference.
+        virtual AZStd::string FindSceneAssetReferences(
+            const AZStd::string& scenesFolder, const AZStd::string& indexFilePath, const AZStd::string& productPath) = 0;
+
+        //! Finds the files in the Meshes/, Materials/ and Textures/ folders next to the SceneGraph (.sgr) file that the
+        //! SceneGraph no longer references, directly or through its materials, like textures replaced by a newer version.
+        //! @param removeFiles false for a dry run that only reports the orphaned files.
+        //! @returns The report, its first line has the counts. Empty if the file could not be parsed.
+        virtual AZStd::string CollectOrphanedSceneAssets(const AZStd::string& sceneGraphFilePath, bool removeFiles) = 0;
+
+        //! Builds hierarchical LOD proxies in the HLOD/ folder next to the SceneGraph (.sgr) file. The subtrees of the SceneGraph
+        //! are grouped into square cells, and the models of each cell are merged in world space, simplified, and written as
+        //! one model with one packed material. HLOD/HLOD.json lists the cells, their bounds and their nodes.
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products.
+        //! @param cellSize Side of the cells, in meters.
+        //! @param maxError Largest distance, in meters, that simplification may move a vertex.
+        //! @returns The report, its first line has the counts. Empty if the file could not be parsed.
+        virtual AZStd::string BuildSceneHlodProxies(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, float cellSize, float maxError) = 0;
+
+        //! Writes, in parallel, the StandardPBR .material files described by the <Scene>.o3mat file that the o3dexport
+        //! Blender AddOn dumps next to the SceneGraph (.sgr) file. Files whose content didn't change are not written again.
+        //! @param materialsFolder Absolute folder of the .material source files.
+        //! @returns The report, its first line has the counts. Empty if the descriptions could not be read.
+        virtual AZStd::string GenerateSceneMaterials(
+            const AZStd::string& materialDescriptionsFilePath, const AZStd::string& materialsFolder) = 0;
     };
 
     class o3dimportBusTraits
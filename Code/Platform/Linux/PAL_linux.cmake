@@ -1,4 +1,4 @@
 
 set(PAL_TRAIT_O3DIMPORT_SUPPORTED TRUE)
 set(PAL_TRAIT_O3DIMPORT_TEST_SUPPORTED FALSE)
-set(PAL_TRAIT_O3DIMPORT_EDITOR_TEST_SUPPORTED FALSE)
+set(PAL_TRAIT_O3DIMPORT_EDITOR_TEST_SUPPORTED TRUE)
@@ -0,0 +1,705 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "HlodProxyBuilder.h"
+#include "MaterialFile.h"
+#include "SceneGraph.h"
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Asset/AssetManagerBus.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/JSON/document.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Serialization/Json/JsonUtils.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/hash.h>
+#include <AzCore/std/math.h>
+#include <AzCore/std/sort.h>
+
+#include <QColor>
+#include <QImage>
+
+namespace o3dimport
+{
+    namespace
+    {
+        constexpr AZ::u32 MaxReportedCells = 20;
+        constexpr const char* ManifestFileName = "HLOD.json";
+        constexpr AZStd::string_view CellFilePrefix = "Cell_";
+        constexpr AZStd::string_view PaletteFileSuffix = "_basecolor";
+
+        AZ::s32 ToCellCoordinate(float value, float cellSize)
+        {
+            return static_cast<AZ::s32>(AZStd::floor(value / cellSize));
+        }
+
+        struct ClusterKey
+        {
+            AZ::s32 m_x;
+            AZ::s32 m_y;
+            AZ::s32 m_z;
+
+            bool operator==(const ClusterKey& other) const
+            {
+                return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+            }
+        };
+
+        struct ClusterKeyHash
+        {
+            size_t operator()(const ClusterKey& key) const
+            {
+                size_t hash = 0;
+                AZStd::hash_combine(hash, key.m_x, key.m_y, key.m_z);
+                return hash;
+            }
+        };
+
+        //! The vertices of a triangle, rotated so the smallest index comes first. The winding is kept,
+        //! so the two sides of a thin wall are not mistaken for duplicates.
+        struct TriangleKey
+        {
+            AZ::u32 m_indices[3];
+
+            TriangleKey(AZ::u32 first, AZ::u32 second, AZ::u32 third)
+            {
+                if (second < first && second < third)
+                {
+                    m_indices[0] = second;
+                    m_indices[1] = third;
+                    m_indices[2] = first;
+                }
+                else if (third < first && third < second)
+                {
+                    m_indices[0] = third;
+                    m_indices[1] = first;
+                    m_indices[2] = second;
+                }
+                else
+                {
+                    m_indices[0] = first;
+                    m_indices[1] = second;
+                    m_indices[2] = third;
+                }
+            }
+
+            bool operator==(const TriangleKey& other) const
+            {
+                return m_indices[0] == other.m_indices[0] && m_indices[1] == other.m_indices[1] && m_indices[2] == other.m_indices[2];
+            }
+        };
+
+        struct TriangleKeyHash
+        {
+            size_t operator()(const TriangleKey& key) const
+            {
+                size_t hash = 0;
+                AZStd::hash_combine(hash, key.m_indices[0], key.m_indices[1], key.m_indices[2]);
+                return hash;
+            }
+        };
+
+        //! Position and indices of the first LOD of the model. Runs on the main thread, the asset must be ready.
+        HlodMeshGeometry ReadGeometry(const AZ::RPI::ModelAsset& modelAsset)
+        {
+            HlodMeshGeometry geometry;
+            if (modelAsset.GetLodAssets().empty() || !modelAsset.GetLodAssets()[0].IsReady())
+            {
+                return geometry;
+            }
+            static const AZ::Name PositionSemantic("POSITION");
+            for (const AZ::RPI::ModelLodAsset::Mesh& mesh : modelAsset.GetLodAssets()[0]->GetMeshes())
+            {
+                const auto positions = mesh.GetSemanticBufferTyped<AZ::PackedVector3f>(PositionSemantic);
+                if (positions.empty())
+                {
+                    continue;
+                }
+                HlodMeshGeometry::SubMesh& subMesh = geometry.m_subMeshes.emplace_back();
+                subMesh.m_materialName = modelAsset.FindMaterialSlot(mesh.GetMaterialSlotId()).m_displayName.GetStringView();
+                subMesh.m_positions.reserve(positions.size());
+                for (const AZ::PackedVector3f& position : positions)
+                {
+                    subMesh.m_positions.emplace_back(position.GetX(), position.GetY(), position.GetZ());
+                }
+                if (mesh.GetIndexBufferAssetView().GetBufferViewDescriptor().m_elementSize == sizeof(AZ::u16))
+                {
+                    const auto indices = mesh.GetIndexBufferTyped<AZ::u16>();
+                    subMesh.m_indices.assign(indices.begin(), indices.end());
+                }
+                else
+                {
+                    const auto indices = mesh.GetIndexBufferTyped<AZ::u32>();
+                    subMesh.m_indices.assign(indices.begin(), indices.end());
+                }
+            }
+            return geometry;
+        }
+
+        //! The flat color that stands for a material at a distance: the base color, times the average of its
+        //! base color texture, in sRGB. White if the material can't be read.
+        AZ::Color CalculateMaterialColor(const AZStd::string& sceneFolder, const AZStd::string& materialName)
+        {
+            auto readOutcome =
+                MaterialFile::ReadBaseColor(AZStd::string::format("%s/Materials/%s.material", sceneFolder.c_str(), materialName.c_str()));
+            if (!readOutcome.IsSuccess())
+            {
+                return AZ::Color::CreateOne();
+            }
+            const MaterialBaseColor& baseColor = readOutcome.GetValue();
+            AZ::Color color = (baseColor.m_color * baseColor.m_factor).LinearToGamma();
+            if (!baseColor.m_textureFileName.empty())
+            {
+                const AZStd::string texturePath =
+                    AZStd::string::format("%s/Textures/%s", sceneFolder.c_str(), baseColor.m_textureFileName.c_str());
+                const QImage image(QString::fromUtf8(texturePath.c_str()));
+                if (!image.isNull())
+                {
+                    // Smooth downscaling averages all the texels.
+                    const QColor average = image.scaled(1, 1, Qt::IgnoreAspectRatio, Qt::SmoothTransformation).pixelColor(0, 0);
+                    color *= AZ::Color(
+                        aznumeric_cast<float>(average.redF()), aznumeric_cast<float>(average.greenF()),
+                        aznumeric_cast<float>(average.blueF()), 1.0f);
+                }
+            }
+            color.SetA(1.0f);
+            return color;
+        }
+
+        AZStd::string GetNodePath(const SceneGraph& sceneGraph, AZ::u32 nodeIndex)
+        {
+            const AZStd::vector<SceneGraphNode>& nodes = sceneGraph.GetNodes();
+            AZStd::string nodePath = nodes[nodeIndex].m_name;
+            for (AZ::u32 parentIndex = nodes[nodeIndex].m_parentIndex; parentIndex != SceneGraphNode::InvalidIndex;
+                 parentIndex = nodes[parentIndex].m_parentIndex)
+            {
+                nodePath = nodes[parentIndex].m_name + "/" + nodePath;
+            }
+            return nodePath;
+        }
+
+        AZ::Outcome<void, AZStd::string> WriteTextFile(const AZStd::string& filePath, const AZStd::string& text)
+        {
+            AZ::IO::SystemFile file;
+            if (!file.Open(
+                    filePath.c_str(),
+                    AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+            {
+                return AZ::Failure(AZStd::string::format("Failed to open '%s' for writing", filePath.c_str()));
+            }
+            if (file.Write(text.data(), text.size()) != text.size())
+            {
+                return AZ::Failure(AZStd::string::format("Failed to write '%s'", filePath.c_str()));
+            }
+            return AZ::Success();
+        }
+
+        rapidjson::Value ToJson(const AZ::Vector3& vector, rapidjson::Document::AllocatorType& allocator)
+        {
+            rapidjson::Value array(rapidjson::kArrayType);
+            array.PushBack(vector.GetX(), allocator);
+            array.PushBack(vector.GetY(), allocator);
+            array.PushBack(vector.GetZ(), allocator);
+            return array;
+        }
+    } // namespace
+
+    AZStd::vector<HlodCell> HlodProxyBuilder::GroupIntoCells(const SceneGraph& sceneGraph, float cellSize)
+    {
+        const AZStd::vector<SceneGraphNode>& nodes = sceneGraph.GetNodes();
+        const AZ::u32 nodeCount = aznumeric_cast<AZ::u32>(nodes.size());
+
+        // Parents come before their children, so one backwards pass gathers the bounds of the mesh nodes of every
+        // subtree, and the end of every subtree in the depth first order.
+        AZStd::vector<AZ::Aabb> subtreeBounds(nodeCount, AZ::Aabb::CreateNull());
+        AZStd::vector<AZ::u32> subtreeEnds(nodeCount);
+        for (AZ::u32 nodeIndex = nodeCount; nodeIndex-- > 0;)
+        {
+            const SceneGraphNode& node = nodes[nodeIndex];
+            subtreeEnds[nodeIndex] = AZStd::max(subtreeEnds[nodeIndex], nodeIndex + 1);
+            if (!node.m_mesh.empty())
+            {
+                subtreeBounds[nodeIndex].AddPoint(node.m_worldTranslation);
+            }
+            if (node.m_parentIndex != SceneGraphNode::InvalidIndex)
+            {
+                subtreeBounds[node.m_parentIndex].AddAabb(subtreeBounds[nodeIndex]);
+                subtreeEnds[node.m_parentIndex] = AZStd::max(subtreeEnds[node.m_parentIndex], subtreeEnds[nodeIndex]);
+            }
+        }
+
+        AZStd::unordered_map<AZ::u64, HlodCell> cellsByKey;
+        auto addToCell = [&cellsByKey, &nodes, cellSize](const AZ::Vector3& position, AZ::u32 firstNode, AZ::u32 endNode)
+        {
+            const AZ::s32 cellX = ToCellCoordinate(position.GetX(), cellSize);
+            const AZ::s32 cellY = ToCellCoordinate(position.GetY(), cellSize);
+            HlodCell& cell = cellsByKey[(AZ::u64(AZ::u32(cellY)) << 32) | AZ::u32(cellX)];
+            cell.m_x = cellX;
+            cell.m_y = cellY;
+            for (AZ::u32 nodeIndex = firstNode; nodeIndex < endNode; ++nodeIndex)
+            {
+                if (!nodes[nodeIndex].m_mesh.empty())
+                {
+                    cell.m_nodeIndices.push_back(nodeIndex);
+                }
+            }
+        };
+
+        for (AZ::u32 nodeIndex = 0; nodeIndex < nodeCount;)
+        {
+            const AZ::Aabb& bounds = subtreeBounds[nodeIndex];
+            if (!bounds.IsValid())
+            {
+                nodeIndex = subtreeEnds[nodeIndex];
+                continue;
+            }
+            const AZ::Vector3 extents = bounds.GetExtents();
+            if (extents.GetX() <= cellSize && extents.GetY() <= cellSize)
+            {
+                addToCell(bounds.GetCenter(), nodeIndex, subtreeEnds[nodeIndex]);
+                nodeIndex = subtreeEnds[nodeIndex];
+                continue;
+            }
+            // Too large for one cell. The node itself goes where it is, and its children are grouped one by one.
+            if (!nodes[nodeIndex].m_mesh.empty())
+            {
+                addToCell(nodes[nodeIndex].m_worldTranslation, nodeIndex, nodeIndex + 1);
+            }
+            ++nodeIndex;
+        }
+
+        AZStd::vector<HlodCell> cells;
+        cells.reserve(cellsByKey.size());
+        for (auto& [key, cell] : cellsByKey)
+        {
+            AZStd::sort(cell.m_nodeIndices.begin(), cell.m_nodeIndices.end());
+            cells.push_back(AZStd::move(cell));
+        }
+        AZStd::sort(
+            cells.begin(), cells.end(),
+            [](const HlodCell& lhs, const HlodCell& rhs)
+            {
+                return lhs.m_y != rhs.m_y ? lhs.m_y < rhs.m_y : lhs.m_x < rhs.m_x;
+            });
+        return cells;
+    }
+
+    HlodProxyMesh HlodProxyBuilder::MergeCell(
+        const SceneGraph& sceneGraph, const HlodCell& cell, const AZStd::unordered_map<AZStd::string, HlodMeshGeometry>& geometryByMesh)
+    {
+        HlodProxyMesh merged;
+        for (AZ::u32 nodeIndex : cell.m_nodeIndices)
+        {
+            const SceneGraphNode& node = sceneGraph.GetNodes()[nodeIndex];
+            auto geometryIter = geometryByMesh.find(node.m_mesh);
+            if (geometryIter == geometryByMesh.end())
+            {
+                continue;
+            }
+            for (const HlodMeshGeometry::SubMesh& subMesh : geometryIter->second.m_subMeshes)
+            {
+                auto materialIter = AZStd::find(merged.m_materialNames.begin(), merged.m_materialNames.end(), subMesh.m_materialName);
+                const AZ::u32 materialIndex = aznumeric_cast<AZ::u32>(materialIter - merged.m_materialNames.begin());
+                if (materialIter == merged.m_materialNames.end())
+                {
+                    merged.m_materialNames.push_back(subMesh.m_materialName);
+                }
+
+                const AZ::u32 firstVertex = aznumeric_cast<AZ::u32>(merged.m_positions.size());
+                for (const AZ::Vector3& position : subMesh.m_positions)
+                {
+                    merged.m_positions.push_back(node.m_worldTransform.TransformPoint(position));
+                }
+                for (size_t index = 0; index + 2 < subMesh.m_indices.size(); index += 3)
+                {
+                    merged.m_indices.push_back(firstVertex + subMesh.m_indices[index]);
+                    merged.m_indices.push_back(firstVertex + subMesh.m_indices[index + 1]);
+                    merged.m_indices.push_back(firstVertex + subMesh.m_indices[index + 2]);
+                    merged.m_triangleMaterials.push_back(materialIndex);
+                }
+            }
+        }
+        return merged;
+    }
+
+    HlodProxyMesh HlodProxyBuilder::Simplify(const HlodProxyMesh& mesh, float maxError)
+    {
+        if (maxError <= 0.0f)
+        {
+            return mesh;
+        }
+        // The average of the vertices of a grid cell stays inside it, so no vertex moves further than the diagonal.
+        const float gridSize = maxError / AZStd::sqrt(3.0f);
+
+        HlodProxyMesh simplified;
+        simplified.m_materialNames = mesh.m_materialNames;
+        AZStd::unordered_map<ClusterKey, AZ::u32, ClusterKeyHash> clusterIndices;
+        AZStd::vector<AZ::u32> vertexClusters(mesh.m_positions.size());
+        AZStd::vector<AZ::u32> clusterVertexCounts;
+        for (size_t vertexIndex = 0; vertexIndex < mesh.m_positions.size(); ++vertexIndex)
+        {
+            const AZ::Vector3& position = mesh.m_positions[vertexIndex];
+            const ClusterKey key{ ToCellCoordinate(position.GetX(), gridSize), ToCellCoordinate(position.GetY(), gridSize),
+                                  ToCellCoordinate(position.GetZ(), gridSize) };
+            auto [clusterIter, isNew] = clusterIndices.emplace(key, aznumeric_cast<AZ::u32>(simplified.m_positions.size()));
+            if (isNew)
+            {
+                simplified.m_positions.push_back(AZ::Vector3::CreateZero());
+                clusterVertexCounts.push_back(0);
+            }
+            vertexClusters[vertexIndex] = clusterIter->second;
+            simplified.m_positions[clusterIter->second] += position;
+            ++clusterVertexCounts[clusterIter->second];
+        }
+        for (size_t clusterIndex = 0; clusterIndex < simplified.m_positions.size(); ++clusterIndex)
+        {
+            simplified.m_positions[clusterIndex] /= aznumeric_cast<float>(clusterVertexCounts[clusterIndex]);
+        }
+
+        AZStd::unordered_set<TriangleKey, TriangleKeyHash> triangles;
+        for (size_t triangleIndex = 0; triangleIndex < mesh.GetTriangleCount(); ++triangleIndex)
+        {
+            const AZ::u32 first = vertexClusters[mesh.m_indices[triangleIndex * 3]];
+            const AZ::u32 second = vertexClusters[mesh.m_indices[triangleIndex * 3 + 1]];
+            const AZ::u32 third = vertexClusters[mesh.m_indices[triangleIndex * 3 + 2]];
+            if (first == second || second == third || third == first || !triangles.emplace(first, second, third).second)
+            {
+                continue;
+            }
+            simplified.m_indices.push_back(first);
+            simplified.m_indices.push_back(second);
+            simplified.m_indices.push_back(third);
+            simplified.m_triangleMaterials.push_back(mesh.m_triangleMaterials[triangleIndex]);
+        }
+
+        // Clusters that only had collapsed triangles are not written.
+        AZStd::vector<AZ::u32> remappedIndices(simplified.m_positions.size(), SceneGraphNode::InvalidIndex);
+        AZStd::vector<AZ::Vector3> usedPositions;
+        for (AZ::u32& index : simplified.m_indices)
+        {
+            if (remappedIndices[index] == SceneGraphNode::InvalidIndex)
+            {
+                remappedIndices[index] = aznumeric_cast<AZ::u32>(usedPositions.size());
+                usedPositions.push_back(simplified.m_positions[index]);
+            }
+            index = remappedIndices[index];
+        }
+        simplified.m_positions = AZStd::move(usedPositions);
+        return simplified;
+    }
+
+    AZStd::string HlodProxyBuilder::GetCellName(const HlodCell& cell)
+    {
+        return AZStd::string::format("Cell_%d_%d", cell.m_x, cell.m_y);
+    }
+
+    AZ::u32 HlodProxyBuilder::RemoveStaleProxies(const AZStd::string& outputFolder, const AZStd::unordered_set<AZStd::string>& cellNames)
+    {
+        AZStd::vector<AZStd::string> staleFileNames;
+        AZ::IO::SystemFile::FindFiles(
+            AZStd::string::format("%s/%.*s*", outputFolder.c_str(), AZ_STRING_ARG(CellFilePrefix)).c_str(),
+            [&](const char* fileName, bool isFile)
+            {
+                if (!isFile)
+                {
+                    return true;
+                }
+                // Cell_<x>_<y>.obj, Cell_<x>_<y>.material and Cell_<x>_<y>_basecolor.png.
+                AZStd::string_view cellName(fileName);
+                cellName = cellName.substr(0, cellName.rfind('.'));
+                if (cellName.ends_with(PaletteFileSuffix))
+                {
+                    cellName.remove_suffix(PaletteFileSuffix.size());
+                }
+                if (!cellNames.contains(AZStd::string(cellName)))
+                {
+                    staleFileNames.emplace_back(fileName);
+                }
+                return true;
+            });
+
+        AZ::u32 removedCount = 0;
+        for (const AZStd::string& fileName : staleFileNames)
+        {
+            const AZStd::string filePath = AZStd::string::format("%s/%s", outputFolder.c_str(), fileName.c_str());
+            if (AZ::IO::SystemFile::Delete(filePath.c_str()))
+            {
+                ++removedCount;
+            }
+            else
+            {
+                AZ_Warning("o3dimport", false, "Failed to remove the stale HLOD file '%s'.", filePath.c_str());
+            }
+        }
+        return removedCount;
+    }
+
+    AZ::Outcome<void, AZStd::string> HlodProxyBuilder::WriteProxy(
+        const HlodProxyMesh& mesh,
+        const HlodCell& cell,
+        const AZStd::vector<AZ::Color>& materialColors,
+        const AZStd::string& outputFolder)
+    {
+        const AZStd::string cellName = GetCellName(cell);
+
+        // The palette is a square grid of blocks, one flat color per material. Every corner of a triangle samples
+        // the center of the block of its material, so the model needs neither normals nor real UVs.
+        const AZ::u32 blocksPerSide =
+            AZStd::max(1u, aznumeric_cast<AZ::u32>(AZStd::ceil(AZStd::sqrt(aznumeric_cast<float>(materialColors.size())))));
+        const int textureSize = aznumeric_cast<int>(blocksPerSide * PaletteBlockSize);
+        QImage palette(textureSize, textureSize, QImage::Format_RGB888);
+        palette.fill(Qt::white);
+        for (AZ::u32 materialIndex = 0; materialIndex < materialColors.size(); ++materialIndex)
+        {
+            const AZ::Color& color = materialColors[materialIndex];
+            const QColor blockColor = QColor::fromRgbF(color.GetR(), color.GetG(), color.GetB());
+            const int blockX = aznumeric_cast<int>((materialIndex % blocksPerSide) * PaletteBlockSize);
+            const int blockY = aznumeric_cast<int>((materialIndex / blocksPerSide) * PaletteBlockSize);
+            for (int y = blockY; y < blockY + aznumeric_cast<int>(PaletteBlockSize); ++y)
+            {
+                for (int x = blockX; x < blockX + aznumeric_cast<int>(PaletteBlockSize); ++x)
+                {
+                    palette.setPixelColor(x, y, blockColor);
+                }
+            }
+        }
+        AZ::IO::SystemFile::CreateDir(outputFolder.c_str());
+        const AZStd::string textureFileName = cellName + "_basecolor.png";
+        const AZStd::string texturePath = AZStd::string::format("%s/%s", outputFolder.c_str(), textureFileName.c_str());
+        if (!palette.save(QString::fromUtf8(texturePath.c_str()), "PNG"))
+        {
+            return AZ::Failure(AZStd::string::format("Failed to write '%s'", texturePath.c_str()));
+        }
+
+        AZStd::string obj = AZStd::string::format("# HLOD proxy of %zu material(s)\nusemtl %s\n", materialColors.size(), cellName.c_str());
+        for (const AZ::Vector3& position : mesh.m_positions)
+        {
+            obj += AZStd::string::format("v %.4f %.4f %.4f\n", position.GetX(), position.GetY(), position.GetZ());
+        }
+        for (AZ::u32 materialIndex = 0; materialIndex < materialColors.size(); ++materialIndex)
+        {
+            // obj texture coordinates start at the bottom.
+            const float u = ((materialIndex % blocksPerSide) + 0.5f) / blocksPerSide;
+            const float v = 1.0f - ((materialIndex / blocksPerSide) + 0.5f) / blocksPerSide;
+            obj += AZStd::string::format("vt %.6f %.6f\n", u, v);
+        }
+        for (size_t triangleIndex = 0; triangleIndex < mesh.GetTriangleCount(); ++triangleIndex)
+        {
+            // obj indices start at one.
+            const AZ::u32 uvIndex = mesh.m_triangleMaterials[triangleIndex] + 1;
+            obj += AZStd::string::format(
+                "f %u/%u %u/%u %u/%u\n", mesh.m_indices[triangleIndex * 3] + 1, uvIndex, mesh.m_indices[triangleIndex * 3 + 1] + 1, uvIndex,
+                mesh.m_indices[triangleIndex * 3 + 2] + 1, uvIndex);
+        }
+        auto writeOutcome = WriteTextFile(AZStd::string::format("%s/%s.obj", outputFolder.c_str(), cellName.c_str()), obj);
+        if (!writeOutcome.IsSuccess())
+        {
+            return writeOutcome;
+        }
+
+        // Same material type as the materials written by the o3dexport Blender AddOn.
+        const AZStd::string material = AZStd::string::format(
+            "{\n"
+            "    \"materialType\": \"@gemroot:Atom_Feature_Common@/Assets/Materials/Types/StandardPBR.materialtype\",\n"
+            "    \"materialTypeVersion\": 5,\n"
+            "    \"propertyValues\": {\n"
+            "        \"baseColor.textureMap\": \"%s\",\n"
+            "        \"metallic.factor\": 0.0,\n"
+            "        \"roughness.factor\": 1.0\n"
+            "    }\n"
+            "}\n",
+            textureFileName.c_str());
+        return WriteTextFile(AZStd::string::format("%s/%s.material", outputFolder.c_str(), cellName.c_str()), material);
+    }
+
+    AZStd::string HlodProxyBuilder::Build(
+        const SceneGraph& sceneGraph,
+        const AZStd::string& sceneFolder,
+        const AZStd::string& meshProductFolder,
+        float cellSize,
+        float maxError)
+    {
+        const auto startTime = AZStd::chrono::steady_clock::now();
+        const AZStd::vector<HlodCell> cells = GroupIntoCells(sceneGraph, cellSize);
+
+        // Request all the models first, so they load in parallel, and then wait for each one of them.
+        AZStd::unordered_map<AZStd::string, AZ::Data::Asset<AZ::RPI::ModelAsset>> modelAssets;
+        AZStd::vector<AZStd::string> missingModels;
+        for (const HlodCell& cell : cells)
+        {
+            for (AZ::u32 nodeIndex : cell.m_nodeIndices)
+            {
+                const AZStd::string& meshName = sceneGraph.GetNodes()[nodeIndex].m_mesh;
+                if (modelAssets.contains(meshName) ||
+                    AZStd::find(missingModels.begin(), missingModels.end(), meshName) != missingModels.end())
+                {
+                    continue;
+                }
+                const AZStd::string productPath = AZStd::string::format("%s/%s.fbx.azmodel", meshProductFolder.c_str(), meshName.c_str());
+                AZ::Data::AssetId modelAssetId;
+                AZ::Data::AssetCatalogRequestBus::BroadcastResult(
+                    modelAssetId, &AZ::Data::AssetCatalogRequests::GetAssetIdByPath, productPath.c_str(),
+                    azrtti_typeid<AZ::RPI::ModelAsset>(), false);
+                if (!modelAssetId.IsValid())
+                {
+                    missingModels.push_back(meshName);
+                    continue;
+                }
+                modelAssets.emplace(
+                    meshName,
+                    AZ::Data::AssetManager::Instance().GetAsset<AZ::RPI::ModelAsset>(modelAssetId, AZ::Data::AssetLoadBehavior::PreLoad));
+            }
+        }
+        AZStd::unordered_map<AZStd::string, HlodMeshGeometry> geometryByMesh;
+        for (auto& [meshName, modelAsset] : modelAssets)
+        {
+            modelAsset.BlockUntilLoadComplete();
+            if (!modelAsset.IsReady())
+            {
+                missingModels.push_back(meshName);
+                continue;
+            }
+            geometryByMesh.emplace(meshName, ReadGeometry(*modelAsset));
+        }
+        modelAssets.clear();
+        AZStd::sort(missingModels.begin(), missingModels.end());
+
+        // One job per cell. Each job only writes its own slot.
+        AZStd::vector<HlodProxyMesh> proxies(cells.size());
+        AZStd::vector<size_t> sourceTriangleCounts(cells.size(), 0);
+        AZ::JobCompletion jobCompletion;
+        for (size_t cellIndex = 0; cellIndex < cells.size(); ++cellIndex)
+        {
+            AZ::Job* job = AZ::CreateJobFunction(
+                [&sceneGraph, &cell = cells[cellIndex], &geometryByMesh, maxError, &proxy = proxies[cellIndex],
+                 &sourceTriangleCount = sourceTriangleCounts[cellIndex]]()
+                {
+                    const HlodProxyMesh merged = MergeCell(sceneGraph, cell, geometryByMesh);
+                    sourceTriangleCount = merged.GetTriangleCount();
+                    proxy = Simplify(merged, maxError);
+                },
+                true);
+            job->SetDependent(&jobCompletion);
+            job->Start();
+        }
+        jobCompletion.StartAndWaitForCompletion();
+
+        // Written on this thread: reading the textures of the materials is shared between cells.
+        const AZStd::string outputFolder = sceneFolder + "/HLOD";
+        AZStd::unordered_map<AZStd::string, AZ::Color> colorsByMaterial;
+        rapidjson::Document manifest;
+        manifest.SetObject();
+        auto& allocator = manifest.GetAllocator();
+        rapidjson::Value cellsValue(rapidjson::kArrayType);
+        AZStd::unordered_set<AZStd::string> writtenCellNames;
+        AZStd::string cellLines;
+        size_t sourceTriangleTotal = 0;
+        size_t proxyTriangleTotal = 0;
+        size_t nodeTotal = 0;
+        AZ::u32 failedCount = 0;
+        for (size_t cellIndex = 0; cellIndex < cells.size(); ++cellIndex)
+        {
+            const HlodCell& cell = cells[cellIndex];
+            const HlodProxyMesh& proxy = proxies[cellIndex];
+            if (proxy.GetTriangleCount() == 0)
+            {
+                continue;
+            }
+            AZStd::vector<AZ::Color> materialColors;
+            materialColors.reserve(proxy.m_materialNames.size());
+            for (const AZStd::string& materialName : proxy.m_materialNames)
+            {
+                auto colorIter = colorsByMaterial.find(materialName);
+                if (colorIter == colorsByMaterial.end())
+                {
+                    colorIter = colorsByMaterial.emplace(materialName, CalculateMaterialColor(sceneFolder, materialName)).first;
+                }
+                materialColors.push_back(colorIter->second);
+            }
+            auto writeOutcome = WriteProxy(proxy, cell, materialColors, outputFolder);
+            if (!writeOutcome.IsSuccess())
+            {
+                AZ_Error("o3dimport", false, "%s", writeOutcome.GetError().c_str());
+                ++failedCount;
+                continue;
+            }
+
+            const AZStd::string cellName = GetCellName(cell);
+            writtenCellNames.insert(cellName);
+            AZ::Aabb bounds = AZ::Aabb::CreateNull();
+            for (const AZ::Vector3& position : proxy.m_positions)
+            {
+                bounds.AddPoint(position);
+            }
+            rapidjson::Value nodesValue(rapidjson::kArrayType);
+            for (AZ::u32 nodeIndex : cell.m_nodeIndices)
+            {
+                const AZStd::string nodePath = GetNodePath(sceneGraph, nodeIndex);
+                nodesValue.PushBack(
+                    rapidjson::Value(nodePath.c_str(), aznumeric_cast<rapidjson::SizeType>(nodePath.size()), allocator), allocator);
+            }
+            rapidjson::Value cellValue(rapidjson::kObjectType);
+            cellValue.AddMember("x", cell.m_x, allocator);
+            cellValue.AddMember("y", cell.m_y, allocator);
+            cellValue.AddMember("min", ToJson(bounds.GetMin(), allocator), allocator);
+            cellValue.AddMember("max", ToJson(bounds.GetMax(), allocator), allocator);
+            cellValue.AddMember("model", rapidjson::Value((cellName + ".obj").c_str(), allocator), allocator);
+            cellValue.AddMember("material", rapidjson::Value((cellName + ".material").c_str(), allocator), allocator);
+            cellValue.AddMember("sourceTriangleCount", aznumeric_cast<uint64_t>(sourceTriangleCounts[cellIndex]), allocator);
+            cellValue.AddMember("triangleCount", aznumeric_cast<uint64_t>(proxy.GetTriangleCount()), allocator);
+            cellValue.AddMember("nodes", nodesValue, allocator);
+            cellsValue.PushBack(cellValue, allocator);
+
+            if (cellsValue.Size() <= MaxReportedCells)
+            {
+                cellLines += AZStd::string::format(
+                    "    %s: %zu node(s), %zu -> %zu triangle(s), %zu material(s)\n", cellName.c_str(), cell.m_nodeIndices.size(),
+                    sourceTriangleCounts[cellIndex], proxy.GetTriangleCount(), proxy.m_materialNames.size());
+            }
+            sourceTriangleTotal += sourceTriangleCounts[cellIndex];
+            proxyTriangleTotal += proxy.GetTriangleCount();
+            nodeTotal += cell.m_nodeIndices.size();
+        }
+        if (cellsValue.Size() > MaxReportedCells)
+        {
+            cellLines += AZStd::string::format("    ... %u more cell(s)\n", cellsValue.Size() - MaxReportedCells);
+        }
+        for (const AZStd::string& meshName : missingModels)
+        {
+            cellLines += AZStd::string::format("    Skipped mesh '%s', its model product is not ready\n", meshName.c_str());
+        }
+
+        const rapidjson::SizeType cellCount = cellsValue.Size();
+        manifest.AddMember("version", ManifestVersion, allocator);
+        manifest.AddMember("cellSize", cellSize, allocator);
+        manifest.AddMember("maxError", maxError, allocator);
+        manifest.AddMember("cells", cellsValue, allocator);
+        const AZStd::string manifestPath = AZStd::string::format("%s/%s", outputFolder.c_str(), ManifestFileName);
+        auto writeOutcome = AZ::JsonSerializationUtils::WriteJsonFile(manifest, manifestPath);
+        AZ_Error("o3dimport", writeOutcome.IsSuccess(), "Failed to write the HLOD manifest '%s'. %s",
+            manifestPath.c_str(), writeOutcome.IsSuccess() ? "" : writeOutcome.GetError().c_str());
+        // Only once the new manifest is written, the previous one still lists the cells of the previous build.
+        if (writeOutcome.IsSuccess())
+        {
+            if (const AZ::u32 removedCount = RemoveStaleProxies(outputFolder, writtenCellNames); removedCount > 0)
+            {
+                cellLines += AZStd::string::format(
+                    "    Removed %u file(s) of cells that are not in %s anymore\n", removedCount, ManifestFileName);
+            }
+        }
+
+        const auto elapsedTime = AZStd::chrono::duration<double, AZStd::milli>(AZStd::chrono::steady_clock::now() - startTime);
+        return AZStd::string::format(
+            "Scene '%s': %u HLOD cell(s) of %.1f m from %zu mesh node(s), %zu -> %zu triangle(s), %u failed, in %.1f ms.\n",
+            sceneGraph.GetName().c_str(), cellCount, cellSize, nodeTotal, sourceTriangleTotal, proxyTriangleTotal, failedCount,
+            elapsedTime.count()) + cellLines;
+    }
+} // namespace o3dimport
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Color.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Triangles of the first LOD of a model, in model space.
+    struct HlodMeshGeometry
+    {
+        struct SubMesh
+        {
+            //! Display name of the material slot, which is the material name written by the exporter.
+            AZStd::string m_materialName;
+            AZStd::vector<AZ::Vector3> m_positions;
+            AZStd::vector<AZ::u32> m_indices;
+        };
+        AZStd::vector<SubMesh> m_subMeshes;
+    };
+
+    //! Square cell of the XY plane, with the mesh nodes whose subtrees were grouped into it.
+    struct HlodCell
+    {
+        AZ::s32 m_x = 0;
+        AZ::s32 m_y = 0;
+        //! Indices in SceneGraph::GetNodes(), in depth first order.
+        AZStd::vector<AZ::u32> m_nodeIndices;
+    };
+
+    //! The merged triangles of a cell in world space, before or after simplification.
+    struct HlodProxyMesh
+    {
+        AZStd::vector<AZ::Vector3> m_positions;
+        AZStd::vector<AZ::u32> m_indices;
+        //! One per triangle, index in m_materialNames.
+        AZStd::vector<AZ::u32> m_triangleMaterials;
+        //! The materials of the cell, each one becomes one flat color of the packed material.
+        AZStd::vector<AZStd::string> m_materialNames;
+
+        size_t GetTriangleCount() const
+        {
+            return m_triangleMaterials.size();
+        }
+    };
+
+    //! Builds hierarchical LOD proxies of an exported scene: a single model with a single material per cell,
+    //! that stands for all the meshes of the cell at a distance.
+    //! 1. The subtrees of the SceneGraph are grouped into cells. A subtree whose mesh nodes fit in one cell stays whole,
+    //!    in the cell of its center, otherwise its children are grouped one by one.
+    //! 2. The first LOD of the processed models of each cell is merged in world space.
+    //! 3. The merged mesh is simplified by vertex clustering, no vertex moves further than the target error.
+    //! 4. Each cell is written to "<scene folder>/HLOD/" as Cell_<x>_<y>.obj, with a .material whose base color texture,
+    //!    Cell_<x>_<y>_basecolor.png, is a palette with the average color of every material of the cell.
+    //! The cells, their bounds and their nodes are listed in "<scene folder>/HLOD/HLOD.json". The files of the cells that are
+    //! not in it anymore, e.g. after the cell size changed, are removed.
+    class HlodProxyBuilder
+    {
+    public:
+        static constexpr AZ::u32 ManifestVersion = 1;
+        //! Texels per side of the block of each material in the palette texture.
+        static constexpr AZ::u32 PaletteBlockSize = 4;
+
+        //! Loads the models on the calling thread, then merges and simplifies the cells in parallel.
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products.
+        //! @param cellSize Side of the cells, in meters.
+        //! @param maxError Largest distance, in meters, that simplification may move a vertex.
+        //! @returns The report, its first line has the counts.
+        static AZStd::string Build(
+            const SceneGraph& sceneGraph,
+            const AZStd::string& sceneFolder,
+            const AZStd::string& meshProductFolder,
+            float cellSize,
+            float maxError);
+
+        //! Cells are sorted by row, then by column. Nodes without a mesh are not in any cell.
+        static AZStd::vector<HlodCell> GroupIntoCells(const SceneGraph& sceneGraph, float cellSize);
+        //! Nodes whose mesh is not in @geometryByMesh are skipped.
+        static HlodProxyMesh MergeCell(
+            const SceneGraph& sceneGraph,
+            const HlodCell& cell,
+            const AZStd::unordered_map<AZStd::string, HlodMeshGeometry>& geometryByMesh);
+        //! Welds the vertices in each grid cell of side maxError / sqrt(3) into their average, then drops the
+        //! triangles that became degenerate or duplicated. Returns a copy if @maxError is not positive.
+        static HlodProxyMesh Simplify(const HlodProxyMesh& mesh, float maxError);
+        //! Writes Cell_<x>_<y>.obj, .material and _basecolor.png in @outputFolder.
+        //! @param materialColors One per material of @mesh, in sRGB.
+        static AZ::Outcome<void, AZStd::string> WriteProxy(
+            const HlodProxyMesh& mesh,
+            const HlodCell& cell,
+            const AZStd::vector<AZ::Color>& materialColors,
+            const AZStd::string& outputFolder);
+        static AZStd::string GetCellName(const HlodCell& cell);
+        //! Removes the Cell_* files of @outputFolder whose cell name is not in @cellNames.
+        //! @returns The number of removed files.
+        static AZ::u32 RemoveStaleProxies(const AZStd::string& outputFolder, const AZStd::unordered_set<AZStd::string>& cellNames);
+    };
+} // namespace o3dimport
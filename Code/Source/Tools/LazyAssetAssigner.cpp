@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "LazyAssetAssigner.h"
+
+#include <Atom/RPI.Public/View.h>
+#include <Atom/RPI.Public/ViewportContext.h>
+#include <Atom/RPI.Public/ViewportContextBus.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AtomLyIntegration/CommonFeatures/Material/MaterialComponentBus.h>
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Asset/AssetManagerBus.h>
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/NonUniformScaleBus.h>
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/Math/Frustum.h>
+#include <AzCore/Math/ShapeIntersection.h>
+#include <AzCore/Serialization/Utils.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+#include <AzToolsFramework/API/ToolsApplicationAPI.h>
+
+namespace o3dimport
+{
+    AZ_CVAR(AZ::u32, o3dimport_lazyMaxResidentEntities, 2000, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Maximum number of lazily imported entities that have their model and materials assigned at the same time.");
+    AZ_CVAR(AZ::u32, o3dimport_lazyMaxAssignmentsPerTick, 32, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Maximum number of lazily imported entities that get their model assigned in a single frame.");
+
+    LazyAssetAssigner::~LazyAssetAssigner()
+    {
+        Deactivate();
+    }
+
+    void LazyAssetAssigner::Activate()
+    {
+        AzToolsFramework::EditorEntityContextNotificationBus::Handler::BusConnect();
+        AzToolsFramework::Prefab::PrefabPublicNotificationBus::Handler::BusConnect();
+    }
+
+    void LazyAssetAssigner::Deactivate()
+    {
+        // Leave the entities the same way they are in the level.
+        for (Entry& entry : m_entries)
+        {
+            if (entry.m_isResident)
+            {
+                Evict(entry);
+            }
+        }
+        m_entries.clear();
+        m_entryIndexByEntityId.clear();
+        m_deletedEntityIds.clear();
+        AZ::TickBus::Handler::BusDisconnect();
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect();
+        AzToolsFramework::Prefab::PrefabPublicNotificationBus::Handler::BusDisconnect();
+        AzToolsFramework::EditorEntityContextNotificationBus::Handler::BusDisconnect();
+    }
+
+    bool LazyAssetAssigner::RegisterModelAsset(const AZ::EntityId& entityId, const AZ::Data::AssetId& modelAssetId)
+    {
+        if (auto entryIter = m_entryIndexByEntityId.find(entityId); entryIter != m_entryIndexByEntityId.end())
+        {
+            Entry& entry = m_entries[entryIter->second];
+            if (entry.m_modelAssetId != modelAssetId)
+            {
+                if (entry.m_isResident)
+                {
+                    Evict(entry);
+                }
+                entry.m_modelAssetId = modelAssetId;
+                entry.m_materialAssetIds.clear();
+                UpdateBoundingSphere(entry);
+                m_residencyIsStale = true;
+            }
+            return true;
+        }
+
+        AZ::Data::AssetId currentModelAssetId;
+        AZ::Render::MeshComponentRequestBus::EventResult(
+            currentModelAssetId, entityId, &AZ::Render::MeshComponentRequestBus::Events::GetModelAssetId);
+        if (currentModelAssetId == modelAssetId)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.m_entityId = entityId;
+        entry.m_modelAssetId = modelAssetId;
+        UpdateBoundingSphere(entry);
+        m_entryIndexByEntityId.emplace(entityId, m_entries.size());
+        m_entries.emplace_back(AZStd::move(entry));
+
+        m_residencyIsStale = true;
+        if (!AZ::TickBus::Handler::BusIsConnected())
+        {
+            AZ::TickBus::Handler::BusConnect();
+        }
+        return true;
+    }
+
+    void LazyAssetAssigner::RegisterMaterialAsset(
+        const AZ::EntityId& entityId, const AZStd::string& slotLabel, const AZ::Data::AssetId& materialAssetId)
+    {
+        auto entryIter = m_entryIndexByEntityId.find(entityId);
+        if (entryIter == m_entryIndexByEntityId.end())
+        {
+            AZ_Warning("o3dimport", false, "Entity %s doesn't have a lazily assigned model. Ignoring its material '%s'.",
+                entityId.ToString().c_str(), slotLabel.c_str());
+            return;
+        }
+        Entry& entry = m_entries[entryIter->second];
+        auto materialIter = AZStd::find_if(entry.m_materialAssetIds.begin(), entry.m_materialAssetIds.end(),
+            [&slotLabel](const auto& labelAndAssetId) { return labelAndAssetId.first == slotLabel; });
+        if (materialIter != entry.m_materialAssetIds.end())
+        {
+            materialIter->second = materialAssetId;
+        }
+        else
+        {
+            entry.m_materialAssetIds.emplace_back(slotLabel, materialAssetId);
+        }
+        if (entry.m_isResident)
+        {
+            AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
+            AZ::Render::MeshComponentRequestBus::EventResult(
+                modelAsset, entityId, &AZ::Render::MeshComponentRequestBus::Events::GetModelAsset);
+            if (modelAsset.IsReady())
+            {
+                ApplyMaterials(entry, *modelAsset.Get());
+            }
+            else
+            {
+                AZ::Render::MeshComponentNotificationBus::MultiHandler::BusConnect(entityId);
+            }
+        }
+    }
+
+    AZ::u32 LazyAssetAssigner::MaterializeAll()
+    {
+        RemoveDeletedEntries();
+        if (m_entries.empty())
+        {
+            return 0;
+        }
+
+        // Material slots are only known once the model asset is loaded. Request all the models
+        // first, so they load in parallel, and then wait for each one of them.
+        AZStd::unordered_map<AZ::Data::AssetId, AZ::Data::Asset<AZ::RPI::ModelAsset>> modelAssets;
+        for (const Entry& entry : m_entries)
+        {
+            if (!entry.m_materialAssetIds.empty() && !modelAssets.contains(entry.m_modelAssetId))
+            {
+                modelAssets.emplace(
+                    entry.m_modelAssetId,
+                    AZ::Data::AssetManager::Instance().GetAsset<AZ::RPI::ModelAsset>(
+                        entry.m_modelAssetId, AZ::Data::AssetLoadBehavior::PreLoad));
+            }
+        }
+
+        {
+            AzToolsFramework::ScopedUndoBatch undoBatch("Materialize lazily imported assets");
+            for (const Entry& entry : m_entries)
+            {
+                undoBatch.MarkEntityDirty(entry.m_entityId);
+                if (!entry.m_isResident)
+                {
+                    AZ::Render::MeshComponentRequestBus::Event(
+                        entry.m_entityId, &AZ::Render::MeshComponentRequestBus::Events::SetModelAssetId, entry.m_modelAssetId);
+                }
+                if (entry.m_materialAssetIds.empty())
+                {
+                    continue;
+                }
+                auto& modelAsset = modelAssets[entry.m_modelAssetId];
+                modelAsset.BlockUntilLoadComplete();
+                if (modelAsset.IsReady())
+                {
+                    ApplyMaterials(entry, *modelAsset.Get());
+                }
+                else
+                {
+                    AZ_Warning("o3dimport", false, "Failed to load model %s. The materials of entity %s were not assigned.",
+                        entry.m_modelAssetId.ToString<AZStd::string>().c_str(), entry.m_entityId.ToString().c_str());
+                }
+            }
+        }
+
+        const AZ::u32 materializedCount = aznumeric_cast<AZ::u32>(m_entries.size());
+        m_entries.clear();
+        m_entryIndexByEntityId.clear();
+        m_deletedEntityIds.clear();
+        m_residentCount = 0;
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect();
+        AZ::TickBus::Handler::BusDisconnect();
+        AZ_TracePrintf("o3dimport", "Materialized the assets of %u lazily imported entities.\n", materializedCount);
+        return materializedCount;
+    }
+
+    AZ::u32 LazyAssetAssigner::GetRegisteredCount() const
+    {
+        return aznumeric_cast<AZ::u32>(m_entries.size());
+    }
+
+    AZ::Sphere LazyAssetAssigner::CalculateBoundingSphere(
+        const AZ::Aabb& modelAabb, const AZ::Transform& worldTM, const AZ::Vector3& nonUniformScale)
+    {
+        // The non uniform scale applies in the local space of the entity, before its world transform.
+        const AZ::Vector3 center = worldTM.TransformPoint(modelAabb.GetCenter() * nonUniformScale);
+        const AZ::Vector3 halfExtents = modelAabb.GetExtents() * nonUniformScale.GetAbs() * 0.5f;
+        return AZ::Sphere(center, halfExtents.GetLength() * worldTM.GetUniformScale());
+    }
+
+    void LazyAssetAssigner::UpdateBoundingSphere(Entry& entry)
+    {
+        AZ::Transform worldTM = AZ::Transform::CreateIdentity();
+        AZ::TransformBus::EventResult(worldTM, entry.m_entityId, &AZ::TransformBus::Events::GetWorldTM);
+        AZ::Vector3 nonUniformScale = AZ::Vector3::CreateOne();
+        AZ::NonUniformScaleRequestBus::EventResult(nonUniformScale, entry.m_entityId, &AZ::NonUniformScaleRequestBus::Events::GetScale);
+        const AZ::Sphere boundingSphere = CalculateBoundingSphere(GetModelAabb(entry.m_modelAssetId), worldTM, nonUniformScale);
+        entry.m_center = boundingSphere.GetCenter();
+        entry.m_radius = boundingSphere.GetRadius();
+    }
+
+    const AZ::Aabb& LazyAssetAssigner::GetModelAabb(const AZ::Data::AssetId& modelAssetId)
+    {
+        if (auto aabbIter = m_modelAabbs.find(modelAssetId); aabbIter != m_modelAabbs.end())
+        {
+            return aabbIter->second;
+        }
+        // A model that can't be read is tested as a point at the origin of the entity.
+        AZ::Aabb& modelAabb = m_modelAabbs.emplace(modelAssetId, AZ::Aabb::CreateFromPoint(AZ::Vector3::CreateZero())).first->second;
+        AZ::Data::AssetInfo assetInfo;
+        AZ::Data::AssetCatalogRequestBus::BroadcastResult(assetInfo, &AZ::Data::AssetCatalogRequests::GetAssetInfoById, modelAssetId);
+        AZ::IO::FixedMaxPath productPath;
+        AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (assetInfo.m_relativePath.empty() || !fileIO ||
+            !fileIO->ResolvePath(productPath, AZ::IO::FixedMaxPath("@products@") / assetInfo.m_relativePath))
+        {
+            AZ_Warning("o3dimport", false, "Model %s is not in the asset catalog. Its entities are tested as points.",
+                modelAssetId.ToString<AZStd::string>().c_str());
+            return modelAabb;
+        }
+        // Only the model asset itself, its LODs and buffers are not needed for the bounds.
+        AZStd::unique_ptr<AZ::RPI::ModelAsset> modelAsset(AZ::Utils::LoadObjectFromFile<AZ::RPI::ModelAsset>(
+            productPath.String(), nullptr, AZ::ObjectStream::FilterDescriptor(&AZ::Data::AssetFilterNoAssetLoading)));
+        if (!modelAsset)
+        {
+            AZ_Warning("o3dimport", false, "Failed to read the bounds of model '%s'. Its entities are tested as points.",
+                productPath.c_str());
+            return modelAabb;
+        }
+        modelAabb = modelAsset->GetAabb();
+        return modelAabb;
+    }
+
+    void LazyAssetAssigner::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    {
+        RemoveDeletedEntries();
+        if (m_entries.empty())
+        {
+            return;
+        }
+        UpdateResidency();
+    }
+
+    void LazyAssetAssigner::UpdateResidency()
+    {
+        auto viewportContextManager = AZ::Interface<AZ::RPI::ViewportContextRequestsInterface>::Get();
+        if (!viewportContextManager)
+        {
+            return;
+        }
+        AZ::RPI::ViewportContextPtr viewportContext = viewportContextManager->GetDefaultViewportContext();
+        if (!viewportContext)
+        {
+            return;
+        }
+        AZ::RPI::ViewPtr view = viewportContext->GetDefaultView();
+        if (!view)
+        {
+            return;
+        }
+        const AZ::Matrix4x4& worldToClip = view->GetWorldToClipMatrix();
+        if (!m_residencyIsStale && worldToClip.IsClose(m_lastWorldToClip))
+        {
+            return;
+        }
+        m_lastWorldToClip = worldToClip;
+        m_residencyIsStale = false;
+
+        const AZ::Frustum frustum = AZ::Frustum::CreateFromMatrixColumnMajor(worldToClip);
+        const AZ::Vector3 cameraPosition = view->GetCameraTransform().GetTranslation();
+
+        // Visible entries, closest first, up to the resident cap.
+        using DistanceAndIndex = AZStd::pair<float, size_t>;
+        AZStd::vector<DistanceAndIndex> visibleEntries;
+        AZStd::vector<DistanceAndIndex> evictableEntries;
+        for (size_t entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+        {
+            const Entry& entry = m_entries[entryIndex];
+            const float distanceSq = entry.m_center.GetDistanceSq(cameraPosition);
+            if (AZ::ShapeIntersection::Overlaps(frustum, AZ::Sphere(entry.m_center, entry.m_radius)))
+            {
+                visibleEntries.emplace_back(distanceSq, entryIndex);
+            }
+            else if (entry.m_isResident)
+            {
+                evictableEntries.emplace_back(distanceSq, entryIndex);
+            }
+        }
+        AZStd::sort(visibleEntries.begin(), visibleEntries.end());
+        const size_t maxResidentCount = o3dimport_lazyMaxResidentEntities;
+        if (visibleEntries.size() > maxResidentCount)
+        {
+            // Visible, but too far away to fit under the cap.
+            for (size_t visibleIndex = maxResidentCount; visibleIndex < visibleEntries.size(); ++visibleIndex)
+            {
+                if (m_entries[visibleEntries[visibleIndex].second].m_isResident)
+                {
+                    evictableEntries.push_back(visibleEntries[visibleIndex]);
+                }
+            }
+            visibleEntries.resize(maxResidentCount);
+        }
+        // Closest first, so the farthest one is evicted from the back.
+        AZStd::sort(evictableEntries.begin(), evictableEntries.end());
+
+        AZ::u32 assignmentBudget = o3dimport_lazyMaxAssignmentsPerTick;
+        for (const auto& [distanceSq, entryIndex] : visibleEntries)
+        {
+            Entry& entry = m_entries[entryIndex];
+            if (entry.m_isResident)
+            {
+                continue;
+            }
+            if (assignmentBudget == 0)
+            {
+                // Continue on the next tick, even if the camera doesn't move.
+                m_residencyIsStale = true;
+                break;
+            }
+            if (m_residentCount >= maxResidentCount)
+            {
+                if (evictableEntries.empty())
+                {
+                    break;
+                }
+                Evict(m_entries[evictableEntries.back().second]);
+                evictableEntries.pop_back();
+            }
+            MakeResident(entry);
+            --assignmentBudget;
+        }
+    }
+
+    void LazyAssetAssigner::MakeResident(Entry& entry)
+    {
+        AZ::Render::MeshComponentRequestBus::Event(
+            entry.m_entityId, &AZ::Render::MeshComponentRequestBus::Events::SetModelAssetId, entry.m_modelAssetId);
+        entry.m_isResident = true;
+        ++m_residentCount;
+        if (!entry.m_materialAssetIds.empty())
+        {
+            AZ::Render::MeshComponentNotificationBus::MultiHandler::BusConnect(entry.m_entityId);
+        }
+    }
+
+    void LazyAssetAssigner::Evict(Entry& entry)
+    {
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect(entry.m_entityId);
+        AZ::Render::MeshComponentRequestBus::Event(
+            entry.m_entityId, &AZ::Render::MeshComponentRequestBus::Events::SetModelAssetId, AZ::Data::AssetId());
+        AZ::Render::MaterialComponentRequestBus::Event(entry.m_entityId, &AZ::Render::MaterialComponentRequestBus::Events::ClearMaterialMap);
+        entry.m_isResident = false;
+        --m_residentCount;
+    }
+
+    void LazyAssetAssigner::RemoveEntry(const AZ::EntityId& entityId)
+    {
+        auto entryIter = m_entryIndexByEntityId.find(entityId);
+        if (entryIter == m_entryIndexByEntityId.end())
+        {
+            return;
+        }
+        const size_t entryIndex = entryIter->second;
+        m_entryIndexByEntityId.erase(entryIter);
+        if (m_entries[entryIndex].m_isResident)
+        {
+            --m_residentCount;
+        }
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect(entityId);
+
+        // Swap with the last entry, so the other indices stay valid.
+        if (entryIndex != m_entries.size() - 1)
+        {
+            m_entries[entryIndex] = AZStd::move(m_entries.back());
+            m_entryIndexByEntityId[m_entries[entryIndex].m_entityId] = entryIndex;
+        }
+        m_entries.pop_back();
+        if (m_entries.empty())
+        {
+            AZ::TickBus::Handler::BusDisconnect();
+        }
+    }
+
+    void LazyAssetAssigner::RemoveDeletedEntries()
+    {
+        for (const AZ::EntityId& entityId : m_deletedEntityIds)
+        {
+            AZ::Entity* entity = nullptr;
+            AZ::ComponentApplicationBus::BroadcastResult(entity, &AZ::ComponentApplicationRequests::FindEntity, entityId);
+            if (!entity)
+            {
+                RemoveEntry(entityId);
+            }
+        }
+        m_deletedEntityIds.clear();
+    }
+
+    void LazyAssetAssigner::ApplyMaterials(const Entry& entry, const AZ::RPI::ModelAsset& modelAsset)
+    {
+        for (const auto& [stableId, materialSlot] : modelAsset.GetMaterialSlots())
+        {
+            for (const auto& [slotLabel, materialAssetId] : entry.m_materialAssetIds)
+            {
+                if (materialSlot.m_displayName.GetStringView() == slotLabel)
+                {
+                    AZ::Render::MaterialComponentRequestBus::Event(
+                        entry.m_entityId, &AZ::Render::MaterialComponentRequestBus::Events::SetMaterialAssetId,
+                        AZ::Render::MaterialAssignmentId::CreateFromStableIdOnly(stableId), materialAssetId);
+                    break;
+                }
+            }
+        }
+    }
+
+    void LazyAssetAssigner::OnModelReady(
+        const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, [[maybe_unused]] const AZ::Data::Instance<AZ::RPI::Model>& model)
+    {
+        // Null when called by BusConnect(), RegisterMaterialAsset() applies the materials of loaded models itself.
+        const AZ::EntityId* entityId = AZ::Render::MeshComponentNotificationBus::GetCurrentBusId();
+        if (!entityId)
+        {
+            return;
+        }
+        auto entryIter = m_entryIndexByEntityId.find(*entityId);
+        if (entryIter == m_entryIndexByEntityId.end() || !modelAsset.IsReady())
+        {
+            return;
+        }
+        const Entry& entry = m_entries[entryIter->second];
+        if (entry.m_isResident)
+        {
+            ApplyMaterials(entry, *modelAsset.Get());
+        }
+    }
+
+    void LazyAssetAssigner::OnSaveStreamForGameBegin(
+        [[maybe_unused]] AZ::IO::GenericStream& gameStream,
+        [[maybe_unused]] AZ::DataStream::StreamType streamType,
+        [[maybe_unused]] AZStd::vector<AZStd::unique_ptr<AZ::Entity>>& levelEntities)
+    {
+        MaterializeAll();
+    }
+
+    void LazyAssetAssigner::OnStartPlayInEditorBegin()
+    {
+        MaterializeAll();
+    }
+
+    void LazyAssetAssigner::OnEditorEntityDeleted(const AZ::EntityId& entityId)
+    {
+        // Prefab propagation deletes and recreates entities with the same id, so the entry is only
+        // removed if the entity is still gone on the next tick.
+        if (m_entryIndexByEntityId.contains(entityId))
+        {
+            m_deletedEntityIds.push_back(entityId);
+        }
+    }
+
+    void LazyAssetAssigner::OnPrefabInstancePropagationEnd()
+    {
+        // Propagation rebuilds entities from the level prefab, which doesn't know about the transient assignments.
+        for (Entry& entry : m_entries)
+        {
+            if (!entry.m_isResident)
+            {
+                continue;
+            }
+            AZ::Data::AssetId currentModelAssetId;
+            AZ::Render::MeshComponentRequestBus::EventResult(
+                currentModelAssetId, entry.m_entityId, &AZ::Render::MeshComponentRequestBus::Events::GetModelAssetId);
+            if (currentModelAssetId != entry.m_modelAssetId)
+            {
+                AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect(entry.m_entityId);
+                entry.m_isResident = false;
+                --m_residentCount;
+                m_residencyIsStale = true;
+            }
+        }
+    }
+} // namespace o3dimport
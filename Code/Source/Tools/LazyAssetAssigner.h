@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Component/TickBus.h>
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Matrix4x4.h>
+#include <AzCore/Math/Sphere.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+#include <AzToolsFramework/Prefab/PrefabPublicNotificationBus.h>
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentBus.h>
+
+namespace o3dimport
+{
+    //! Remembers the model and material assets that the importer wants on each entity, but only
+    //! assigns them while the entity is inside the frustum of the Editor camera, closest entities first,
+    //! up to a maximum number of resident entities (o3dimport_lazyMaxResidentEntities).
+    //! These frustum driven assignments are transient: they are not recorded in undo and they don't
+    //! modify the level prefab. MaterializeAll() assigns everything for real, in one undo batch.
+    //! MaterializeAll() runs automatically before exporting the level and before entering game mode.
+    class LazyAssetAssigner
+        : private AZ::TickBus::Handler
+        , private AZ::Render::MeshComponentNotificationBus::MultiHandler
+        , private AzToolsFramework::EditorEntityContextNotificationBus::Handler
+        , private AzToolsFramework::Prefab::PrefabPublicNotificationBus::Handler
+    {
+    public:
+        LazyAssetAssigner() = default;
+        ~LazyAssetAssigner();
+
+        void Activate();
+        void Deactivate();
+
+        //! @returns false, and does nothing, if the entity already uses @modelAssetId.
+        bool RegisterModelAsset(const AZ::EntityId& entityId, const AZ::Data::AssetId& modelAssetId);
+        //! The entity must have been registered with RegisterModelAsset().
+        void RegisterMaterialAsset(const AZ::EntityId& entityId, const AZStd::string& slotLabel, const AZ::Data::AssetId& materialAssetId);
+        //! Assigns all the registered assets, forgets about them, and returns how many entities were materialized.
+        AZ::u32 MaterializeAll();
+        AZ::u32 GetRegisteredCount() const;
+
+        //! Bounding sphere, in world space, of a model whose local bounds are @modelAabb.
+        static AZ::Sphere CalculateBoundingSphere(
+            const AZ::Aabb& modelAabb, const AZ::Transform& worldTM, const AZ::Vector3& nonUniformScale);
+
+    private:
+        struct Entry
+        {
+            AZ::EntityId m_entityId;
+            AZ::Data::AssetId m_modelAssetId;
+            AZStd::vector<AZStd::pair<AZStd::string, AZ::Data::AssetId>> m_materialAssetIds;
+            //! Bounding sphere, from the bounds of the model asset and the world transform of the entity.
+            AZ::Vector3 m_center = AZ::Vector3::CreateZero();
+            float m_radius = 0.0f;
+            bool m_isResident = false;
+        };
+
+        // AZ::TickBus
+        void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
+
+        // AZ::Render::MeshComponentNotificationBus
+        void OnModelReady(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, const AZ::Data::Instance<AZ::RPI::Model>& model) override;
+
+        // AzToolsFramework::EditorEntityContextNotificationBus
+        void OnSaveStreamForGameBegin(
+            AZ::IO::GenericStream& gameStream,
+            AZ::DataStream::StreamType streamType,
+            AZStd::vector<AZStd::unique_ptr<AZ::Entity>>& levelEntities) override;
+        void OnStartPlayInEditorBegin() override;
+        void OnEditorEntityDeleted(const AZ::EntityId& entityId) override;
+
+        // AzToolsFramework::Prefab::PrefabPublicNotificationBus
+        void OnPrefabInstancePropagationEnd() override;
+
+        void UpdateResidency();
+        void MakeResident(Entry& entry);
+        void Evict(Entry& entry);
+        //! Forgets the entry of @entityId, if any, without touching the entity.
+        void RemoveEntry(const AZ::EntityId& entityId);
+        //! Removes the entries of the entities in m_deletedEntityIds that were not recreated.
+        void RemoveDeletedEntries();
+        static void ApplyMaterials(const Entry& entry, const AZ::RPI::ModelAsset& modelAsset);
+        void UpdateBoundingSphere(Entry& entry);
+        //! The bounds of the model are read once per model, from its product, without loading the model in the asset
+        //! manager. Only residency loads the model, with its buffers.
+        const AZ::Aabb& GetModelAabb(const AZ::Data::AssetId& modelAssetId);
+
+        AZStd::vector<Entry> m_entries;
+        AZStd::unordered_map<AZ::EntityId, size_t> m_entryIndexByEntityId;
+        AZStd::unordered_map<AZ::Data::AssetId, AZ::Aabb> m_modelAabbs;
+        //! Entities deleted since the last tick, which might be recreated by prefab propagation.
+        AZStd::vector<AZ::EntityId> m_deletedEntityIds;
+        size_t m_residentCount = 0;
+        AZ::Matrix4x4 m_lastWorldToClip = AZ::Matrix4x4::CreateZero();
+        //! True when the residency must be recalculated even if the camera didn't move.
+        bool m_residencyIsStale = false;
+    };
+} // namespace o3dimport
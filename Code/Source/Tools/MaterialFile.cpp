@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "MaterialFile.h"
+
+#include <AzCore/JSON/document.h>
+#include <AzCore/Serialization/Json/JsonUtils.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        AZStd::string_view GetFileName(const rapidjson::Value& texturePathValue)
+        {
+            AZStd::string_view texturePath(texturePathValue.GetString(), texturePathValue.GetStringLength());
+            const size_t separatorIndex = texturePath.find_last_of("/\\");
+            if (separatorIndex != AZStd::string_view::npos)
+            {
+                texturePath.remove_prefix(separatorIndex + 1);
+            }
+            return texturePath;
+        }
+
+        //! @returns The "propertyValues" object, or null if the material doesn't have one.
+        const rapidjson::Value* FindPropertyValues(const rapidjson::Document& document)
+        {
+            auto propertyValuesIter = document.IsObject() ? document.FindMember("propertyValues") : document.MemberEnd();
+            if (propertyValuesIter == document.MemberEnd() || !propertyValuesIter->value.IsObject())
+            {
+                return nullptr;
+            }
+            return &propertyValuesIter->value;
+        }
+    } // namespace
+
+    AZ::Outcome<AZStd::vector<AZStd::string>, AZStd::string> MaterialFile::ReadTextureFileNames(const AZStd::string& filePath)
+    {
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonFile(filePath);
+        if (!readOutcome.IsSuccess())
+        {
+            return AZ::Failure(readOutcome.TakeError());
+        }
+        AZStd::vector<AZStd::string> textureFileNames;
+        const rapidjson::Value* propertyValues = FindPropertyValues(readOutcome.GetValue());
+        if (!propertyValues)
+        {
+            return AZ::Success(AZStd::move(textureFileNames));
+        }
+        for (const auto& property : propertyValues->GetObject())
+        {
+            const AZStd::string_view propertyName(property.name.GetString(), property.name.GetStringLength());
+            if (!propertyName.ends_with(".textureMap") || !property.value.IsString())
+            {
+                continue;
+            }
+            textureFileNames.emplace_back(GetFileName(property.value));
+        }
+        return AZ::Success(AZStd::move(textureFileNames));
+    }
+
+    AZ::Outcome<MaterialBaseColor, AZStd::string> MaterialFile::ReadBaseColor(const AZStd::string& filePath)
+    {
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonFile(filePath);
+        if (!readOutcome.IsSuccess())
+        {
+            return AZ::Failure(readOutcome.TakeError());
+        }
+        MaterialBaseColor baseColor;
+        const rapidjson::Value* propertyValues = FindPropertyValues(readOutcome.GetValue());
+        if (!propertyValues)
+        {
+            return AZ::Success(AZStd::move(baseColor));
+        }
+        if (auto colorIter = propertyValues->FindMember("baseColor.color"); colorIter != propertyValues->MemberEnd())
+        {
+            const rapidjson::Value& color = colorIter->value;
+            if (color.IsArray() && color.Size() >= 3 && color[0].IsNumber() && color[1].IsNumber() && color[2].IsNumber())
+            {
+                baseColor.m_color.Set(color[0].GetFloat(), color[1].GetFloat(), color[2].GetFloat(), 1.0f);
+            }
+        }
+        auto factorIter = propertyValues->FindMember("baseColor.factor");
+        if (factorIter != propertyValues->MemberEnd() && factorIter->value.IsNumber())
+        {
+            baseColor.m_factor = factorIter->value.GetFloat();
+        }
+        auto textureIter = propertyValues->FindMember("baseColor.textureMap");
+        if (textureIter != propertyValues->MemberEnd() && textureIter->value.IsString())
+        {
+            baseColor.m_textureFileName = GetFileName(textureIter->value);
+        }
+        return AZ::Success(AZStd::move(baseColor));
+    }
+} // namespace o3dimport
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Math/Color.h>
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    //! The "baseColor.*" properties of a material.
+    struct MaterialBaseColor
+    {
+        //! As written in the file, in linear space.
+        AZ::Color m_color = AZ::Color::CreateOne();
+        float m_factor = 1.0f;
+        //! Empty if the material doesn't have a "baseColor.textureMap".
+        AZStd::string m_textureFileName;
+    };
+
+    //! Reads the .material files written by the o3dexport Blender AddOn.
+    class MaterialFile
+    {
+    public:
+        //! The "*.textureMap" properties are paths like "@projectroot@/Assets/Scenes/<scene>/Textures/<file>".
+        //! @returns The <file> part of each one of them, as written, in property order.
+        static AZ::Outcome<AZStd::vector<AZStd::string>, AZStd::string> ReadTextureFileNames(const AZStd::string& filePath);
+        //! Properties that are not in the file keep the defaults of MaterialBaseColor.
+        static AZ::Outcome<MaterialBaseColor, AZStd::string> ReadBaseColor(const AZStd::string& filePath);
+    };
+} // namespace o3dimport
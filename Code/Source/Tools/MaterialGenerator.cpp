@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "MaterialGenerator.h"
+
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Serialization/Json/JsonUtils.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzCore/std/chrono/chrono.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        constexpr const char* MaterialType = "@gemroot:Atom_Feature_Common@/Assets/Materials/Types/StandardPBR.materialtype";
+        constexpr int MaterialTypeVersion = 5;
+        // Above it a material is considered opaque.
+        constexpr double OpaqueAlpha = 0.98;
+
+        enum class WriteResult
+        {
+            Written,
+            Unchanged,
+            Kept,
+            Failed
+        };
+
+        struct MaterialJob
+        {
+            AZStd::string m_name;
+            const rapidjson::Value* m_description = nullptr;
+            WriteResult m_result = WriteResult::Failed;
+            AZStd::string m_error;
+        };
+
+        const rapidjson::Value* FindMember(const rapidjson::Value& object, const char* name)
+        {
+            auto memberIter = object.FindMember(name);
+            return memberIter != object.MemberEnd() ? &memberIter->value : nullptr;
+        }
+
+        bool GetBool(const rapidjson::Value& object, const char* name, bool defaultValue)
+        {
+            const rapidjson::Value* value = FindMember(object, name);
+            return value && value->IsBool() ? value->GetBool() : defaultValue;
+        }
+
+        //! Sockets are objects with a "value", and "textureName" and "texturePath" when they are linked to an image.
+        class PropertyWriter
+        {
+        public:
+            PropertyWriter(rapidjson::Value& propertyValues, rapidjson::Document::AllocatorType& allocator)
+                : m_propertyValues(propertyValues)
+                , m_allocator(allocator)
+            {
+            }
+
+            void Add(const AZStd::string& propertyName, rapidjson::Value value)
+            {
+                m_propertyValues.AddMember(
+                    rapidjson::Value(propertyName.c_str(), aznumeric_cast<rapidjson::SizeType>(propertyName.size()), m_allocator),
+                    value,
+                    m_allocator);
+            }
+
+            void AddCopy(const AZStd::string& propertyName, const rapidjson::Value& socket, const char* socketMember)
+            {
+                if (const rapidjson::Value* value = FindMember(socket, socketMember))
+                {
+                    Add(propertyName, rapidjson::Value(*value, m_allocator));
+                }
+            }
+
+            //! "<group>.textureMap" when the socket has a texture. With @withUseTexture, "<group>.useTexture" too, when the
+            //! socket was linked to an image node.
+            void AddTexture(const char* group, const rapidjson::Value& socket, bool withUseTexture)
+            {
+                const bool hasTexture = HasTexture(socket);
+                if (hasTexture)
+                {
+                    Add(AZStd::string::format("%s.textureMap", group), rapidjson::Value(socket["texturePath"], m_allocator));
+                }
+                if (withUseTexture && FindMember(socket, "textureName"))
+                {
+                    Add(AZStd::string::format("%s.useTexture", group), rapidjson::Value(hasTexture));
+                }
+            }
+
+            static bool HasTexture(const rapidjson::Value& socket)
+            {
+                const rapidjson::Value* texturePath = FindMember(socket, "texturePath");
+                return texturePath && texturePath->IsString() && texturePath->GetStringLength() > 0;
+            }
+
+        private:
+            rapidjson::Value& m_propertyValues;
+            rapidjson::Document::AllocatorType& m_allocator;
+        };
+
+        double GetNumber(const rapidjson::Value& socket, const char* socketMember, double defaultValue)
+        {
+            const rapidjson::Value* value = FindMember(socket, socketMember);
+            return value && value->IsNumber() ? value->GetDouble() : defaultValue;
+        }
+
+        void WriteMaterial(
+            MaterialJob& materialJob, const AZStd::string& materialsFolder, bool overwrite, bool normalFlipX, bool normalFlipY)
+        {
+            // The name becomes a file name in the materials folder.
+            if (materialJob.m_name.empty() || materialJob.m_name.find_first_of("/\\") != AZStd::string::npos ||
+                !materialJob.m_description->IsObject())
+            {
+                materialJob.m_error = "Invalid material name or description";
+                return;
+            }
+            const AZ::IO::FixedMaxPath filePath = AZ::IO::FixedMaxPath(materialsFolder) / (materialJob.m_name + ".material");
+            const bool exists = AZ::IO::SystemFile::Exists(filePath.c_str());
+            if (exists && !overwrite)
+            {
+                materialJob.m_result = WriteResult::Kept;
+                return;
+            }
+
+            const rapidjson::Document material = MaterialGenerator::GenerateMaterial(*materialJob.m_description, normalFlipX, normalFlipY);
+            AZStd::string materialText;
+            auto writeStringOutcome = AZ::JsonSerializationUtils::WriteJsonString(material, materialText);
+            if (!writeStringOutcome.IsSuccess())
+            {
+                materialJob.m_error = writeStringOutcome.TakeError();
+                return;
+            }
+            if (exists)
+            {
+                auto readOutcome = AZ::Utils::ReadFile<AZStd::string>(filePath.Native());
+                if (readOutcome.IsSuccess() && readOutcome.GetValue() == materialText)
+                {
+                    materialJob.m_result = WriteResult::Unchanged;
+                    return;
+                }
+            }
+            auto writeOutcome = AZ::Utils::WriteFile(materialText, filePath.Native());
+            if (!writeOutcome.IsSuccess())
+            {
+                materialJob.m_error = writeOutcome.TakeError();
+                return;
+            }
+            materialJob.m_result = WriteResult::Written;
+        }
+    } // namespace
+
+    rapidjson::Document MaterialGenerator::GenerateMaterial(const rapidjson::Value& description, bool normalFlipX, bool normalFlipY)
+    {
+        rapidjson::Document material;
+        material.SetObject();
+        auto& allocator = material.GetAllocator();
+        material.AddMember("materialType", rapidjson::StringRef(MaterialType), allocator);
+        material.AddMember("materialTypeVersion", MaterialTypeVersion, allocator);
+        rapidjson::Value propertyValues(rapidjson::kObjectType);
+        PropertyWriter writer(propertyValues, allocator);
+        // Same names as the inputs of the Blender Principled BSDF node.
+        for (const auto& socketMember : description.GetObject())
+        {
+            const AZStd::string_view socketName(socketMember.name.GetString(), socketMember.name.GetStringLength());
+            const rapidjson::Value& socket = socketMember.value;
+            if (!socket.IsObject())
+            {
+                continue;
+            }
+            if (socketName == "Base Color")
+            {
+                writer.AddCopy("baseColor.color", socket, "value");
+                writer.AddTexture("baseColor", socket, false);
+            }
+            else if (socketName == "Metallic")
+            {
+                writer.AddCopy("metallic.factor", socket, "value");
+                writer.AddTexture("metallic", socket, true);
+            }
+            else if (socketName == "Roughness")
+            {
+                writer.AddCopy("roughness.factor", socket, "value");
+                writer.AddTexture("roughness", socket, true);
+            }
+            else if (socketName == "Alpha")
+            {
+                if (FindMember(socket, "value"))
+                {
+                    const double alpha = GetNumber(socket, "value", 1.0);
+                    writer.Add("opacity.factor", rapidjson::Value(alpha));
+                    writer.Add("opacity.mode", rapidjson::Value(rapidjson::StringRef(alpha > OpaqueAlpha ? "Opaque" : "Blended")));
+                }
+                writer.AddTexture("opacity", socket, true);
+            }
+            else if (socketName == "Specular IOR Level")
+            {
+                writer.AddCopy("specularF0.factor", socket, "value");
+            }
+            else if (socketName == "Specular Tint")
+            {
+                // Only metals tint the reflections, dielectrics reflect shades of white.
+                writer.AddTexture("specularF0", socket, false);
+                writer.Add("specularF0.useTexture", rapidjson::Value(PropertyWriter::HasTexture(socket)));
+            }
+            else if (socketName == "Specular MultiScatter Compensation")
+            {
+                if (GetNumber(socket, "value", 0.0) > 0.5)
+                {
+                    writer.Add("specularF0.enableMultiScatterCompensation", rapidjson::Value(true));
+                }
+            }
+            else if (socketName == "Normal")
+            {
+                writer.AddTexture("normal", socket, true);
+                writer.AddCopy("normal.factor", socket, "strength");
+                writer.Add("normal.flipX", rapidjson::Value(normalFlipX));
+                writer.Add("normal.flipY", rapidjson::Value(normalFlipY));
+            }
+        }
+        material.AddMember("propertyValues", propertyValues, allocator);
+        return material;
+    }
+
+    AZStd::string MaterialGenerator::Generate(const AZStd::string& descriptionsFilePath, const AZStd::string& materialsFolder)
+    {
+        const auto startTime = AZStd::chrono::steady_clock::now();
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonFile(descriptionsFilePath);
+        if (!readOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "Failed to read the material descriptions '%s'. %s", descriptionsFilePath.c_str(),
+                readOutcome.GetError().c_str());
+            return {};
+        }
+        const rapidjson::Document& document = readOutcome.GetValue();
+        const rapidjson::Value* version = document.IsObject() ? FindMember(document, "version") : nullptr;
+        const rapidjson::Value* materials = document.IsObject() ? FindMember(document, "materials") : nullptr;
+        if (!version || !version->IsInt() || version->GetInt() != DescriptionsVersion || !materials || !materials->IsObject())
+        {
+            AZ_Error("o3dimport", false, "'%s' is not a version %d material descriptions file. Export the scene again.",
+                descriptionsFilePath.c_str(), DescriptionsVersion);
+            return {};
+        }
+        const bool overwrite = GetBool(document, "overwrite", true);
+        const bool normalFlipX = GetBool(document, "normalFlipX", false);
+        const bool normalFlipY = GetBool(document, "normalFlipY", false);
+
+        AZStd::vector<MaterialJob> materialJobs;
+        materialJobs.reserve(materials->MemberCount());
+        for (const auto& materialMember : materials->GetObject())
+        {
+            MaterialJob& materialJob = materialJobs.emplace_back();
+            materialJob.m_name.assign(materialMember.name.GetString(), materialMember.name.GetStringLength());
+            materialJob.m_description = &materialMember.value;
+        }
+
+        AZ::IO::SystemFile::CreateDir(materialsFolder.c_str());
+        AZ::JobCompletion jobCompletion;
+        for (MaterialJob& materialJob : materialJobs)
+        {
+            AZ::Job* job = AZ::CreateJobFunction(
+                [&materialJob, &materialsFolder, overwrite, normalFlipX, normalFlipY]()
+                {
+                    WriteMaterial(materialJob, materialsFolder, overwrite, normalFlipX, normalFlipY);
+                },
+                true);
+            job->SetDependent(&jobCompletion);
+            job->Start();
+        }
+        jobCompletion.StartAndWaitForCompletion();
+
+        AZ::u32 counts[4] = {};
+        AZStd::string failureLines;
+        for (const MaterialJob& materialJob : materialJobs)
+        {
+            ++counts[static_cast<size_t>(materialJob.m_result)];
+            if (materialJob.m_result == WriteResult::Failed)
+            {
+                failureLines += AZStd::string::format("    %s: %s\n", materialJob.m_name.c_str(), materialJob.m_error.c_str());
+            }
+        }
+        const auto elapsedTime = AZStd::chrono::duration<double, AZStd::milli>(AZStd::chrono::steady_clock::now() - startTime);
+        return AZStd::string::format(
+            "Materials of '%s': %u written, %u unchanged, %u kept, %u failed, in %.1f ms.\n",
+            AZ::IO::PathView(descriptionsFilePath).Stem().String().c_str(), counts[static_cast<size_t>(WriteResult::Written)],
+            counts[static_cast<size_t>(WriteResult::Unchanged)], counts[static_cast<size_t>(WriteResult::Kept)],
+            counts[static_cast<size_t>(WriteResult::Failed)], elapsedTime.count()) + failureLines;
+    }
+} // namespace o3dimport
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/JSON/document.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    //! Writes the StandardPBR .material files of a scene from the <Scene>.o3mat file of the o3dexport Blender AddOn.
+    //! The AddOn only dumps, once per export, the sockets of the Principled BSDF node of each material, with the
+    //! project relative path of each texture already resolved. Each material is then converted and written on its own
+    //! job, and a file whose content didn't change is not written again, so the Asset Processor only processes the
+    //! materials that changed. See docs_o3dexport/SceneGraph.md for the format.
+    class MaterialGenerator
+    {
+    public:
+        //! Bump it, here and in o3material.py, when the format of the .o3mat file changes.
+        static constexpr int DescriptionsVersion = 1;
+
+        //! @param description The sockets of one material, e.g. { "Metallic": { "value": 1.0, "textureName": "Rust",
+        //!     "texturePath": "@projectroot@/Assets/Scenes/Town/Textures/Rust.png" }, ... }.
+        //! @returns The .material document.
+        static rapidjson::Document GenerateMaterial(const rapidjson::Value& description, bool normalFlipX, bool normalFlipY);
+
+        //! Writes <@materialsFolder>/<Material>.material for every material of @descriptionsFilePath, in parallel.
+        //! Existing files are kept as they are when the descriptions were exported with "overwrite" off.
+        //! @returns The report, its first line has the counts. Empty if the descriptions file could not be read.
+        static AZStd::string Generate(const AZStd::string& descriptionsFilePath, const AZStd::string& materialsFolder);
+    };
+} // namespace o3dimport
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "OrphanedAssetCollector.h"
+#include "MaterialFile.h"
+#include "SceneGraph.h"
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/sort.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        constexpr double Mebibyte = 1024.0 * 1024.0;
+        constexpr const char* ScannedFolders[] = { "Meshes", "Materials", "Textures" };
+
+        AZStd::string ToLower(AZStd::string_view text)
+        {
+            AZStd::string lowerCaseText(text);
+            AZStd::to_lower(lowerCaseText.begin(), lowerCaseText.end());
+            return lowerCaseText;
+        }
+
+        bool IsDigit(char character)
+        {
+            return character >= '0' && character <= '9';
+        }
+
+        bool IsReachable(const AZStd::unordered_set<AZStd::string>& reachablePaths, const AZStd::string& lowerCaseRelativePath)
+        {
+            if (reachablePaths.contains(lowerCaseRelativePath))
+            {
+                return true;
+            }
+            // Side car files of a reachable file: "<reachable name>.<extension>", e.g. "meshes/wall.fbx.assetinfo".
+            for (size_t dotIndex = lowerCaseRelativePath.find('.'); dotIndex != AZStd::string::npos;
+                 dotIndex = lowerCaseRelativePath.find('.', dotIndex + 1))
+            {
+                if (reachablePaths.contains(lowerCaseRelativePath.substr(0, dotIndex)))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        struct OrphanedFile
+        {
+            //! Relative to the scene folder, as found on disk.
+            AZStd::string m_relativePath;
+            AZ::u64 m_byteCount = 0;
+            //! For textures, the reachable texture that is a newer version of this one, if any.
+            AZStd::string m_newerVersion;
+        };
+    } // namespace
+
+    AZStd::string OrphanedAssetCollector::Collect(const SceneGraph& sceneGraph, const AZStd::string& sceneFolder, bool removeFiles)
+    {
+        // Lower case paths relative to the scene folder, e.g. "meshes/wall.fbx".
+        AZStd::unordered_set<AZStd::string> reachablePaths;
+        AZStd::unordered_set<AZStd::string> materialNames;
+        for (const SceneGraphNode& node : sceneGraph.GetNodes())
+        {
+            if (!node.m_mesh.empty())
+            {
+                reachablePaths.insert(ToLower(AZStd::string::format("Meshes/%s.fbx", node.m_mesh.c_str())));
+            }
+            materialNames.insert(node.m_materials.begin(), node.m_materials.end());
+        }
+
+        AZStd::vector<AZStd::string> unreadableMaterials;
+        // key: versionless name of a reachable texture, value: its file name.
+        AZStd::unordered_map<AZStd::string, AZStd::string> reachableTextureVersions;
+        for (const AZStd::string& materialName : materialNames)
+        {
+            const AZStd::string relativePath = AZStd::string::format("Materials/%s.material", materialName.c_str());
+            reachablePaths.insert(ToLower(relativePath));
+            const AZStd::string filePath = sceneFolder + "/" + relativePath;
+            if (!AZ::IO::SystemFile::Exists(filePath.c_str()))
+            {
+                // Nothing to read, the Asset Processor already reports the missing material.
+                continue;
+            }
+            auto readOutcome = MaterialFile::ReadTextureFileNames(filePath);
+            if (!readOutcome.IsSuccess())
+            {
+                unreadableMaterials.push_back(relativePath);
+                continue;
+            }
+            for (const AZStd::string& textureFileName : readOutcome.GetValue())
+            {
+                reachablePaths.insert(ToLower("Textures/" + textureFileName));
+                reachableTextureVersions.emplace(GetVersionlessName(textureFileName), textureFileName);
+            }
+        }
+
+        AZStd::vector<OrphanedFile> orphanedFiles;
+        for (const char* folderName : ScannedFolders)
+        {
+            const bool isTexturesFolder = AZStd::string_view(folderName) == "Textures";
+            if (isTexturesFolder && !unreadableMaterials.empty())
+            {
+                continue;
+            }
+            const AZStd::string folderPath = sceneFolder + "/" + folderName;
+            AZ::IO::SystemFile::FindFiles(
+                (folderPath + "/*").c_str(),
+                [&](const char* fileName, bool isFile)
+                {
+                    if (!isFile || fileName[0] == '.')
+                    {
+                        return true;
+                    }
+                    const AZStd::string relativePath = AZStd::string::format("%s/%s", folderName, fileName);
+                    if (IsReachable(reachablePaths, ToLower(relativePath)))
+                    {
+                        return true;
+                    }
+                    OrphanedFile& orphanedFile = orphanedFiles.emplace_back();
+                    orphanedFile.m_relativePath = relativePath;
+                    orphanedFile.m_byteCount = AZ::IO::SystemFile::Length((folderPath + "/" + fileName).c_str());
+                    if (isTexturesFolder)
+                    {
+                        if (auto versionIter = reachableTextureVersions.find(GetVersionlessName(fileName));
+                            versionIter != reachableTextureVersions.end())
+                        {
+                            orphanedFile.m_newerVersion = versionIter->second;
+                        }
+                    }
+                    return true;
+                });
+        }
+        AZStd::sort(
+            orphanedFiles.begin(),
+            orphanedFiles.end(),
+            [](const OrphanedFile& lhs, const OrphanedFile& rhs)
+            {
+                return lhs.m_relativePath < rhs.m_relativePath;
+            });
+
+        AZ::u64 orphanedByteCount = 0;
+        AZ::u32 removedCount = 0;
+        AZStd::string lines;
+        for (const OrphanedFile& orphanedFile : orphanedFiles)
+        {
+            orphanedByteCount += orphanedFile.m_byteCount;
+            lines += AZStd::string::format("    %s %.2f MiB", orphanedFile.m_relativePath.c_str(), orphanedFile.m_byteCount / Mebibyte);
+            if (!orphanedFile.m_newerVersion.empty())
+            {
+                lines += AZStd::string::format(", older version of %s", orphanedFile.m_newerVersion.c_str());
+            }
+            if (removeFiles)
+            {
+                if (AZ::IO::SystemFile::Delete((sceneFolder + "/" + orphanedFile.m_relativePath).c_str()))
+                {
+                    ++removedCount;
+                }
+                else
+                {
+                    lines += ", FAILED to remove";
+                }
+            }
+            lines += "\n";
+        }
+        for (const AZStd::string& relativePath : unreadableMaterials)
+        {
+            lines += AZStd::string::format("    Textures were not collected, %s can't be read.\n", relativePath.c_str());
+        }
+
+        AZStd::string report = AZStd::string::format(
+            "Scene '%s': %zu orphaned file(s), %.2f MiB.", sceneGraph.GetName().c_str(), orphanedFiles.size(), orphanedByteCount / Mebibyte);
+        report += removeFiles ? AZStd::string::format(" Removed %u.\n", removedCount) : AZStd::string(" Dry run, nothing was removed.\n");
+        return report + lines;
+    }
+
+    AZStd::string OrphanedAssetCollector::GetVersionlessName(AZStd::string_view fileName)
+    {
+        // Same split as _UpdateTextureNameVersion: the version is at the end of the part before the first '_' of the name.
+        const AZStd::string_view baseName = fileName.substr(0, fileName.find('.'));
+        const AZStd::string_view baseLeft = baseName.substr(0, baseName.find('_'));
+        size_t versionIndex = baseLeft.size();
+        while (versionIndex > 0 && IsDigit(baseLeft[versionIndex - 1]))
+        {
+            --versionIndex;
+        }
+        // A name made only of digits has no version.
+        if (versionIndex == 0)
+        {
+            versionIndex = baseLeft.size();
+        }
+        AZStd::string versionlessName(fileName.substr(0, versionIndex));
+        versionlessName += fileName.substr(baseLeft.size());
+        return ToLower(versionlessName);
+    }
+} // namespace o3dimport
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/string/string_view.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Finds the source files in the Meshes/, Materials/ and Textures/ folders of an exported scene that the
+    //! SceneGraph no longer reaches: meshes and materials of its nodes, then the textures of those materials.
+    //! Files named after a reachable file plus an extension, like "Wall.fbx.assetinfo", are reachable too.
+    //! If a reachable material can't be read, its textures are unknown, so no texture is collected.
+    class OrphanedAssetCollector
+    {
+    public:
+        //! @param removeFiles false for a dry run that only reports the orphaned files.
+        //! @returns The report, its first line has the counts.
+        static AZStd::string Collect(const SceneGraph& sceneGraph, const AZStd::string& sceneFolder, bool removeFiles);
+
+        //! The name without the version that the exporter adds to avoid texture name collisions
+        //! (_UpdateTextureNameVersion in textureasset.py), in lower case. "Image002_normal.png" -> "image_normal.png".
+        static AZStd::string GetVersionlessName(AZStd::string_view fileName);
+    };
+} // namespace o3dimport
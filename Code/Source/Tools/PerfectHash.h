@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/string/string_view.h>
+
+namespace o3dimport
+{
+    //! 32 bit FNV-1a.
+    constexpr AZ::u32 HashFnv1a(AZStd::string_view text)
+    {
+        AZ::u32 hash = 2166136261u;
+        for (char character : text)
+        {
+            hash ^= static_cast<AZ::u8>(character);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    //! Maps a fixed set of strings, known at compile time, to the values 0..KeyCount-1 of @KeyEnum.
+    //! The table size is the smallest one where every key lands in its own slot, so a lookup is
+    //! one hash, one modulo, and a single comparison that rejects strings which are not keys.
+    //! Instances are meant to be constexpr, so the table is built by the compiler.
+    template<typename KeyEnum, size_t KeyCount>
+    class PerfectHashTable
+    {
+    public:
+        static_assert(KeyCount > 0 && KeyCount < 255, "PerfectHashTable supports between 1 and 254 keys");
+        static constexpr size_t MaxTableSize = KeyCount * 16;
+
+        constexpr explicit PerfectHashTable(const AZStd::array<AZStd::string_view, KeyCount>& keyNames)
+            : m_keyNames(keyNames)
+        {
+            m_tableSize = FindTableSize(keyNames);
+            for (size_t slotIndex = 0; slotIndex < MaxTableSize; ++slotIndex)
+            {
+                m_slots[slotIndex] = EmptySlot;
+            }
+            if (m_tableSize == 0)
+            {
+                return;
+            }
+            for (size_t keyIndex = 0; keyIndex < KeyCount; ++keyIndex)
+            {
+                m_slots[HashFnv1a(keyNames[keyIndex]) % m_tableSize] = static_cast<AZ::u8>(keyIndex);
+            }
+        }
+
+        //! @returns @notFound if @text is not one of the keys.
+        constexpr KeyEnum Find(AZStd::string_view text, KeyEnum notFound) const
+        {
+            const AZ::u8 keyIndex = m_slots[HashFnv1a(text) % m_tableSize];
+            if (keyIndex == EmptySlot || m_keyNames[keyIndex] != text)
+            {
+                return notFound;
+            }
+            return static_cast<KeyEnum>(keyIndex);
+        }
+
+        //! Zero if no table of up to MaxTableSize slots is collision free. Check it with a static_assert.
+        constexpr size_t GetTableSize() const
+        {
+            return m_tableSize;
+        }
+
+    private:
+        static constexpr AZ::u8 EmptySlot = 0xFF;
+
+        static constexpr size_t FindTableSize(const AZStd::array<AZStd::string_view, KeyCount>& keyNames)
+        {
+            for (size_t tableSize = KeyCount; tableSize <= MaxTableSize; ++tableSize)
+            {
+                bool isUsed[MaxTableSize] = {};
+                bool hasCollision = false;
+                for (size_t keyIndex = 0; keyIndex < KeyCount && !hasCollision; ++keyIndex)
+                {
+                    const size_t slotIndex = HashFnv1a(keyNames[keyIndex]) % tableSize;
+                    hasCollision = isUsed[slotIndex];
+                    isUsed[slotIndex] = true;
+                }
+                if (!hasCollision)
+                {
+                    return tableSize;
+                }
+            }
+            return 0;
+        }
+
+        AZStd::array<AZStd::string_view, KeyCount> m_keyNames;
+        AZStd::array<AZ::u8, MaxTableSize> m_slots = {};
+        size_t m_tableSize = 0;
+    };
+} // namespace o3dimport
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneAssetIndex.h"
+#include "SceneGraph.h"
+
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/JSON/document.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Serialization/Json/JsonUtils.h>
+#include <AzCore/std/algorithm.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        // Bump this number when the format of the index file changes.
+        constexpr int IndexFileVersion = 2;
+
+        struct SceneFileState
+        {
+            AZStd::string m_sceneName;
+            AZStd::string m_filePath;
+            AZ::u64 m_modificationTime = 0;
+            AZ::u64 m_fileSize = 0;
+        };
+
+        AZStd::vector<SceneFileState> FindSceneFiles(const AZStd::string& scenesFolder)
+        {
+            AZStd::vector<AZStd::string> sceneNames;
+            AZ::IO::SystemFile::FindFiles(
+                (AZ::IO::FixedMaxPath(scenesFolder) / "*").c_str(),
+                [&sceneNames](const char* fileName, bool isFile)
+                {
+                    if (!isFile && fileName[0] != '.')
+                    {
+                        sceneNames.emplace_back(fileName);
+                    }
+                    return true;
+                });
+
+            AZStd::vector<SceneFileState> sceneFiles;
+            sceneFiles.reserve(sceneNames.size());
+            for (AZStd::string& sceneName : sceneNames)
+            {
+                // Same layout the importer expects: the SceneGraph is named after its folder.
+                const AZ::IO::FixedMaxPath filePath = AZ::IO::FixedMaxPath(scenesFolder) / sceneName / (sceneName + ".sgr");
+                const AZ::u64 modificationTime = AZ::IO::SystemFile::ModificationTime(filePath.c_str());
+                if (modificationTime == 0)
+                {
+                    continue;
+                }
+                SceneFileState& sceneFile = sceneFiles.emplace_back();
+                sceneFile.m_filePath = filePath.String();
+                sceneFile.m_sceneName = AZStd::move(sceneName);
+                sceneFile.m_modificationTime = modificationTime;
+                sceneFile.m_fileSize = AZ::IO::SystemFile::Length(sceneFile.m_filePath.c_str());
+            }
+            return sceneFiles;
+        }
+    } // namespace
+
+    AZ::u32 SceneAssetIndex::Update(
+        const AZStd::string& scenesFolder, const AZStd::string& projectFolder, const AZStd::string& indexFilePath)
+    {
+        const AZ::IO::PathView scenesFolderPath(scenesFolder);
+        if (!scenesFolderPath.IsRelativeTo(projectFolder))
+        {
+            AZ_Error("o3dimport", false, "The scenes folder '%s' is not in the project '%s'",
+                scenesFolder.c_str(), projectFolder.c_str());
+            m_scenesFolder.clear();
+            m_scenes.clear();
+            m_scenesByProduct.clear();
+            return 0;
+        }
+        const AZStd::string scenesProductFolder = scenesFolderPath.LexicallyRelative(projectFolder).StringAsPosix();
+        if (scenesFolder != m_scenesFolder || scenesProductFolder != m_scenesProductFolder || indexFilePath != m_indexFilePath)
+        {
+            m_scenesFolder = scenesFolder;
+            m_scenesProductFolder = scenesProductFolder;
+            m_indexFilePath = indexFilePath;
+            Load();
+        }
+
+        const AZStd::vector<SceneFileState> sceneFiles = FindSceneFiles(scenesFolder);
+        AZStd::vector<const SceneFileState*> changedFiles;
+        AZStd::unordered_set<AZStd::string> existingScenes;
+        for (const SceneFileState& sceneFile : sceneFiles)
+        {
+            existingScenes.insert(sceneFile.m_sceneName);
+            auto sceneIter = m_scenes.find(sceneFile.m_sceneName);
+            if (sceneIter == m_scenes.end() || sceneIter->second.m_modificationTime != sceneFile.m_modificationTime ||
+                sceneIter->second.m_fileSize != sceneFile.m_fileSize)
+            {
+                changedFiles.push_back(&sceneFile);
+            }
+        }
+        AZStd::vector<AZStd::string> removedScenes;
+        for (const auto& [sceneName, sceneEntry] : m_scenes)
+        {
+            if (!existingScenes.contains(sceneName))
+            {
+                removedScenes.push_back(sceneName);
+            }
+        }
+        if (changedFiles.empty() && removedScenes.empty())
+        {
+            return 0;
+        }
+
+        // One job per SceneGraph file. Each job only writes its own slot.
+        AZStd::vector<SceneEntry> parsedEntries(changedFiles.size());
+        AZ::JobCompletion jobCompletion;
+        for (size_t fileIndex = 0; fileIndex < changedFiles.size(); ++fileIndex)
+        {
+            AZ::Job* job = AZ::CreateJobFunction(
+                [sceneFile = changedFiles[fileIndex], &sceneEntry = parsedEntries[fileIndex], this]()
+                {
+                    sceneEntry.m_modificationTime = sceneFile->m_modificationTime;
+                    sceneEntry.m_fileSize = sceneFile->m_fileSize;
+                    auto loadOutcome = SceneGraph::LoadFromFile(sceneFile->m_filePath);
+                    if (!loadOutcome.IsSuccess())
+                    {
+                        // Kept in the index without references, so it's not parsed again until the file changes.
+                        AZ_Warning("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+                        return;
+                    }
+                    sceneEntry.m_references =
+                        CollectReferences(loadOutcome.GetValue(), m_scenesProductFolder + "/" + sceneFile->m_sceneName);
+                },
+                true);
+            job->SetDependent(&jobCompletion);
+            job->Start();
+        }
+        jobCompletion.StartAndWaitForCompletion();
+
+        for (const AZStd::string& sceneName : removedScenes)
+        {
+            RemoveScene(sceneName);
+        }
+        for (size_t fileIndex = 0; fileIndex < changedFiles.size(); ++fileIndex)
+        {
+            RemoveScene(changedFiles[fileIndex]->m_sceneName);
+            AddScene(changedFiles[fileIndex]->m_sceneName, AZStd::move(parsedEntries[fileIndex]));
+        }
+        Save();
+        return aznumeric_cast<AZ::u32>(changedFiles.size());
+    }
+
+    AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>> SceneAssetIndex::FindReferences(AZStd::string_view productPath) const
+    {
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>> references;
+        const AZStd::string normalizedPath = NormalizeProductPath(productPath);
+        auto productIter = m_scenesByProduct.find(normalizedPath);
+        if (productIter == m_scenesByProduct.end())
+        {
+            return references;
+        }
+        for (const AZStd::string& sceneName : productIter->second)
+        {
+            const SceneEntry& sceneEntry = m_scenes.at(sceneName);
+            for (const AZStd::string& nodePath : sceneEntry.m_references.at(normalizedPath))
+            {
+                references.emplace_back(sceneName, nodePath);
+            }
+        }
+        AZStd::sort(references.begin(), references.end());
+        return references;
+    }
+
+    size_t SceneAssetIndex::GetSceneCount() const
+    {
+        return m_scenes.size();
+    }
+
+    AZStd::string SceneAssetIndex::NormalizeProductPath(AZStd::string_view path)
+    {
+        AZStd::string normalizedPath(path);
+        AZStd::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+        AZStd::to_lower(normalizedPath.begin(), normalizedPath.end());
+        if (normalizedPath.ends_with(".fbx"))
+        {
+            normalizedPath += ".azmodel";
+        }
+        else if (normalizedPath.ends_with(".material"))
+        {
+            normalizedPath.insert(normalizedPath.size() - AZStd::string_view("material").size(), "az");
+        }
+        return normalizedPath;
+    }
+
+    SceneAssetReferences SceneAssetIndex::CollectReferences(const SceneGraph& sceneGraph, AZStd::string_view sceneProductFolder)
+    {
+        const AZStd::string sceneFolder = AZStd::string::format("%.*s/", AZ_STRING_ARG(sceneProductFolder));
+        const AZStd::vector<SceneGraphNode>& nodes = sceneGraph.GetNodes();
+        SceneAssetReferences references;
+        // Parents always come before their children, so each path extends the path of its parent.
+        AZStd::vector<AZStd::string> nodePaths(nodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            const SceneGraphNode& node = nodes[nodeIndex];
+            if (node.m_parentIndex != SceneGraphNode::InvalidIndex)
+            {
+                nodePaths[nodeIndex] = nodePaths[node.m_parentIndex] + "/";
+            }
+            nodePaths[nodeIndex] += node.m_name;
+
+            if (!node.m_mesh.empty())
+            {
+                references[NormalizeProductPath(sceneFolder + "Meshes/" + node.m_mesh + ".fbx.azmodel")].push_back(nodePaths[nodeIndex]);
+            }
+            for (const AZStd::string& material : node.m_materials)
+            {
+                AZStd::vector<AZStd::string>& materialNodePaths =
+                    references[NormalizeProductPath(sceneFolder + "Materials/" + material + ".azmaterial")];
+                // A node can use the same material in several slots.
+                if (materialNodePaths.empty() || materialNodePaths.back() != nodePaths[nodeIndex])
+                {
+                    materialNodePaths.push_back(nodePaths[nodeIndex]);
+                }
+            }
+        }
+        return references;
+    }
+
+    void SceneAssetIndex::Load()
+    {
+        m_scenes.clear();
+        m_scenesByProduct.clear();
+        if (!AZ::IO::SystemFile::Exists(m_indexFilePath.c_str()))
+        {
+            return;
+        }
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonFile(m_indexFilePath);
+        if (!readOutcome.IsSuccess())
+        {
+            AZ_Warning("o3dimport", false, "Failed to load the scene asset index. A new one will be created.\n%s", readOutcome.GetError().c_str());
+            return;
+        }
+        const rapidjson::Document& document = readOutcome.GetValue();
+        if (!document.IsObject() || !document.HasMember("version") || !document["version"].IsInt() ||
+            document["version"].GetInt() != IndexFileVersion || !document.HasMember("scenes") || !document["scenes"].IsObject())
+        {
+            return;
+        }
+        // The product paths of an index of another scenes folder don't match, every SceneGraph is parsed again.
+        if (!document.HasMember("scenesProductFolder") || !document["scenesProductFolder"].IsString() ||
+            m_scenesProductFolder != document["scenesProductFolder"].GetString())
+        {
+            return;
+        }
+        for (const auto& sceneMember : document["scenes"].GetObject())
+        {
+            const rapidjson::Value& sceneValue = sceneMember.value;
+            if (!sceneValue.IsObject() || !sceneValue.HasMember("modificationTime") || !sceneValue["modificationTime"].IsUint64() ||
+                !sceneValue.HasMember("fileSize") || !sceneValue["fileSize"].IsUint64() || !sceneValue.HasMember("references") ||
+                !sceneValue["references"].IsObject())
+            {
+                // Left out of the index, so the SceneGraph is parsed again.
+                continue;
+            }
+            SceneEntry sceneEntry;
+            sceneEntry.m_modificationTime = sceneValue["modificationTime"].GetUint64();
+            sceneEntry.m_fileSize = sceneValue["fileSize"].GetUint64();
+            for (const auto& referenceMember : sceneValue["references"].GetObject())
+            {
+                if (!referenceMember.value.IsArray())
+                {
+                    continue;
+                }
+                AZStd::vector<AZStd::string>& nodePaths =
+                    sceneEntry.m_references[AZStd::string(referenceMember.name.GetString(), referenceMember.name.GetStringLength())];
+                nodePaths.reserve(referenceMember.value.Size());
+                for (const rapidjson::Value& nodePath : referenceMember.value.GetArray())
+                {
+                    if (nodePath.IsString())
+                    {
+                        nodePaths.emplace_back(nodePath.GetString(), nodePath.GetStringLength());
+                    }
+                }
+            }
+            AddScene(AZStd::string(sceneMember.name.GetString(), sceneMember.name.GetStringLength()), AZStd::move(sceneEntry));
+        }
+    }
+
+    void SceneAssetIndex::Save() const
+    {
+        rapidjson::Document document;
+        document.SetObject();
+        auto& allocator = document.GetAllocator();
+        rapidjson::Value scenesValue(rapidjson::kObjectType);
+        for (const auto& [sceneName, sceneEntry] : m_scenes)
+        {
+            rapidjson::Value referencesValue(rapidjson::kObjectType);
+            for (const auto& [productPath, nodePaths] : sceneEntry.m_references)
+            {
+                rapidjson::Value nodePathsValue(rapidjson::kArrayType);
+                nodePathsValue.Reserve(aznumeric_cast<rapidjson::SizeType>(nodePaths.size()), allocator);
+                for (const AZStd::string& nodePath : nodePaths)
+                {
+                    nodePathsValue.PushBack(rapidjson::Value(nodePath.c_str(), aznumeric_cast<rapidjson::SizeType>(nodePath.size()), allocator), allocator);
+                }
+                referencesValue.AddMember(
+                    rapidjson::Value(productPath.c_str(), aznumeric_cast<rapidjson::SizeType>(productPath.size()), allocator),
+                    nodePathsValue,
+                    allocator);
+            }
+            rapidjson::Value sceneValue(rapidjson::kObjectType);
+            sceneValue.AddMember("modificationTime", rapidjson::Value(sceneEntry.m_modificationTime), allocator);
+            sceneValue.AddMember("fileSize", rapidjson::Value(sceneEntry.m_fileSize), allocator);
+            sceneValue.AddMember("references", referencesValue, allocator);
+            scenesValue.AddMember(
+                rapidjson::Value(sceneName.c_str(), aznumeric_cast<rapidjson::SizeType>(sceneName.size()), allocator), sceneValue, allocator);
+        }
+        document.AddMember("version", IndexFileVersion, allocator);
+        document.AddMember(
+            "scenesProductFolder",
+            rapidjson::Value(m_scenesProductFolder.c_str(), aznumeric_cast<rapidjson::SizeType>(m_scenesProductFolder.size()), allocator),
+            allocator);
+        document.AddMember("scenes", scenesValue, allocator);
+
+        AZ::IO::SystemFile::CreateDir(AZ::IO::FixedMaxPath(m_indexFilePath).ParentPath().c_str());
+        auto writeOutcome = AZ::JsonSerializationUtils::WriteJsonFile(document, m_indexFilePath);
+        AZ_Warning("o3dimport", writeOutcome.IsSuccess(), "Failed to save the scene asset index '%s'. %s",
+            m_indexFilePath.c_str(), writeOutcome.IsSuccess() ? "" : writeOutcome.GetError().c_str());
+    }
+
+    void SceneAssetIndex::AddScene(const AZStd::string& sceneName, SceneEntry&& sceneEntry)
+    {
+        for (const auto& [productPath, nodePaths] : sceneEntry.m_references)
+        {
+            m_scenesByProduct[productPath].insert(sceneName);
+        }
+        m_scenes[sceneName] = AZStd::move(sceneEntry);
+    }
+
+    void SceneAssetIndex::RemoveScene(const AZStd::string& sceneName)
+    {
+        auto sceneIter = m_scenes.find(sceneName);
+        if (sceneIter == m_scenes.end())
+        {
+            return;
+        }
+        for (const auto& [productPath, nodePaths] : sceneIter->second.m_references)
+        {
+            auto productIter = m_scenesByProduct.find(productPath);
+            if (productIter == m_scenesByProduct.end())
+            {
+                continue;
+            }
+            productIter->second.erase(sceneName);
+            if (productIter->second.empty())
+            {
+                m_scenesByProduct.erase(productIter);
+            }
+        }
+        m_scenes.erase(sceneIter);
+    }
+} // namespace o3dimport
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/string/string_view.h>
+#include <AzCore/std/utility/pair.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! key: normalized product path, value: paths ("Root/Child/Node") of the nodes of one scene that reference it.
+    using SceneAssetReferences = AZStd::unordered_map<AZStd::string, AZStd::vector<AZStd::string>>;
+
+    //! Reverse index, for all the scenes of the project, from mesh and material product to the scenes
+    //! and nodes that reference it. The index is persisted as JSON, and each Update() only parses,
+    //! in parallel, the SceneGraph (.sgr) files that changed since the previous one. Unchanged files
+    //! cost a single stat, so impact queries on hundreds of scenes are answered in milliseconds.
+    class SceneAssetIndex
+    {
+    public:
+        //! Brings the index up to date with the <Scene>/<Scene>.sgr files in @scenesFolder. The first call
+        //! loads @indexFilePath, and any call that changed the index writes it back.
+        //! @param projectFolder The products of a scene are in the folder of its SceneGraph, relative to it.
+        //!     @scenesFolder must be within it.
+        //! @returns The number of SceneGraph files that were parsed.
+        AZ::u32 Update(const AZStd::string& scenesFolder, const AZStd::string& projectFolder, const AZStd::string& indexFilePath);
+
+        //! @returns (scene name, node path) pairs, sorted, of the nodes that reference @productPath.
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>> FindReferences(AZStd::string_view productPath) const;
+        size_t GetSceneCount() const;
+
+        //! Lower case with forward slashes, the way the asset cache stores products. Source paths of meshes
+        //! (.fbx) and materials (.material) are converted to the paths of their products.
+        static AZStd::string NormalizeProductPath(AZStd::string_view path);
+        //! Product paths of the meshes and materials referenced by the nodes of @sceneGraph, with the same layout as
+        //! AssetPaths in o3dimport.py: <@sceneProductFolder>/Meshes/<Mesh>.fbx.azmodel and .../Materials/<Material>.azmaterial.
+        //! @param sceneProductFolder Folder of the SceneGraph relative to the project, e.g. Assets/Scenes/Town.
+        static SceneAssetReferences CollectReferences(const SceneGraph& sceneGraph, AZStd::string_view sceneProductFolder);
+
+    private:
+        struct SceneEntry
+        {
+            AZ::u64 m_modificationTime = 0;
+            AZ::u64 m_fileSize = 0;
+            SceneAssetReferences m_references;
+        };
+
+        void Load();
+        void Save() const;
+        void AddScene(const AZStd::string& sceneName, SceneEntry&& sceneEntry);
+        void RemoveScene(const AZStd::string& sceneName);
+
+        AZStd::string m_scenesFolder;
+        //! @m_scenesFolder relative to the project, e.g. Assets/Scenes.
+        AZStd::string m_scenesProductFolder;
+        AZStd::string m_indexFilePath;
+        //! key: scene name.
+        AZStd::unordered_map<AZStd::string, SceneEntry> m_scenes;
+        //! key: normalized product path, value: names of the scenes that reference it.
+        AZStd::unordered_map<AZStd::string, AZStd::unordered_set<AZStd::string>> m_scenesByProduct;
+    };
+} // namespace o3dimport
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraph.h"
+#include "SceneGraphKeys.h"
+
+#include <AzCore/JSON/document.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Serialization/Json/JsonUtils.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        AZStd::string_view GetMemberName(const rapidjson::Value::ConstMember& member)
+        {
+            return AZStd::string_view(member.name.GetString(), member.name.GetStringLength());
+        }
+
+        bool ReadVector3(const rapidjson::Value& array, AZ::Vector3& outVector)
+        {
+            if (!array.IsArray() || array.Size() != 3 || !array[0].IsNumber() || !array[1].IsNumber() || !array[2].IsNumber())
+            {
+                return false;
+            }
+            outVector.Set(array[0].GetFloat(), array[1].GetFloat(), array[2].GetFloat());
+            return true;
+        }
+
+        // Same rotation order as o3dimport.py: Z * Y * X, with the angles in degrees.
+        AZ::Quaternion CreateRotationFromEulerDegrees(const AZ::Vector3& eulerDegrees)
+        {
+            return AZ::Quaternion::CreateRotationZ(AZ::DegToRad(eulerDegrees.GetZ())) *
+                AZ::Quaternion::CreateRotationY(AZ::DegToRad(eulerDegrees.GetY())) *
+                AZ::Quaternion::CreateRotationX(AZ::DegToRad(eulerDegrees.GetX()));
+        }
+
+        // Field handlers. Each key of the perfect hash tables has its own specialization.
+        template<SceneGraphTransformKey Key>
+        struct TransformField;
+
+        template<>
+        struct TransformField<SceneGraphTransformKey::Translate>
+        {
+            static bool Read(const rapidjson::Value& value, SceneGraphNode& node)
+            {
+                return ReadVector3(value, node.m_localTranslation);
+            }
+        };
+
+        template<>
+        struct TransformField<SceneGraphTransformKey::Rotate>
+        {
+            static bool Read(const rapidjson::Value& value, SceneGraphNode& node)
+            {
+                AZ::Vector3 eulerDegrees;
+                if (!ReadVector3(value, eulerDegrees))
+                {
+                    return false;
+                }
+                node.m_localRotation = CreateRotationFromEulerDegrees(eulerDegrees);
+                return true;
+            }
+        };
+
+        template<>
+        struct TransformField<SceneGraphTransformKey::Scale>
+        {
+            static bool Read(const rapidjson::Value& value, SceneGraphNode& node)
+            {
+                return ReadVector3(value, node.m_localScale);
+            }
+        };
+
+        //! A node while its members are being read.
+        struct NodeReadState
+        {
+            SceneGraphNode m_node;
+            bool m_hasName = false;
+            //! Read after the node is added, so the children come after their parent.
+            const rapidjson::Value* m_children = nullptr;
+            //! Read after the transform, which is the rest pose of the channels that are not animated.
+            const rapidjson::Value* m_track = nullptr;
+        };
+
+        template<SceneGraphNodeKey Key>
+        struct NodeField;
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Name>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                if (!value.IsString())
+                {
+                    return false;
+                }
+                state.m_node.m_name.assign(value.GetString(), value.GetStringLength());
+                state.m_hasName = true;
+                return true;
+            }
+        };
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Transform>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                if (!value.IsObject())
+                {
+                    return false;
+                }
+                for (auto memberIter = value.MemberBegin(); memberIter != value.MemberEnd(); ++memberIter)
+                {
+                    bool isValid = true;
+                    switch (SceneGraphTransformKeys.Find(GetMemberName(*memberIter), SceneGraphTransformKey::Count))
+                    {
+                    case SceneGraphTransformKey::Translate:
+                        isValid = TransformField<SceneGraphTransformKey::Translate>::Read(memberIter->value, state.m_node);
+                        break;
+                    case SceneGraphTransformKey::Rotate:
+                        isValid = TransformField<SceneGraphTransformKey::Rotate>::Read(memberIter->value, state.m_node);
+                        break;
+                    case SceneGraphTransformKey::Scale:
+                        isValid = TransformField<SceneGraphTransformKey::Scale>::Read(memberIter->value, state.m_node);
+                        break;
+                    default:
+                        break;
+                    }
+                    if (!isValid)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Mesh>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                if (value.IsString())
+                {
+                    state.m_node.m_mesh.assign(value.GetString(), value.GetStringLength());
+                }
+                return true;
+            }
+        };
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Materials>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                if (!value.IsArray())
+                {
+                    return true;
+                }
+                state.m_node.m_materials.reserve(value.Size());
+                for (const rapidjson::Value& material : value.GetArray())
+                {
+                    if (material.IsString())
+                    {
+                        state.m_node.m_materials.emplace_back(material.GetString(), material.GetStringLength());
+                    }
+                }
+                return true;
+            }
+        };
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Children>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                state.m_children = &value;
+                return true;
+            }
+        };
+
+        template<>
+        struct NodeField<SceneGraphNodeKey::Track>
+        {
+            static bool Read(const rapidjson::Value& value, NodeReadState& state)
+            {
+                state.m_track = &value;
+                return true;
+            }
+        };
+
+        //! Reads all the members of a node, or of the root object, in a single pass.
+        //! @returns The name of the first invalid member, or an empty string.
+        AZStd::string_view ReadNodeMembers(const rapidjson::Value& object, NodeReadState& state)
+        {
+            for (auto memberIter = object.MemberBegin(); memberIter != object.MemberEnd(); ++memberIter)
+            {
+                const AZStd::string_view memberName = GetMemberName(*memberIter);
+                bool isValid = true;
+                switch (SceneGraphNodeKeys.Find(memberName, SceneGraphNodeKey::Count))
+                {
+                case SceneGraphNodeKey::Name:
+                    isValid = NodeField<SceneGraphNodeKey::Name>::Read(memberIter->value, state);
+                    break;
+                case SceneGraphNodeKey::Transform:
+                    isValid = NodeField<SceneGraphNodeKey::Transform>::Read(memberIter->value, state);
+                    break;
+                case SceneGraphNodeKey::Mesh:
+                    isValid = NodeField<SceneGraphNodeKey::Mesh>::Read(memberIter->value, state);
+                    break;
+                case SceneGraphNodeKey::Materials:
+                    isValid = NodeField<SceneGraphNodeKey::Materials>::Read(memberIter->value, state);
+                    break;
+                case SceneGraphNodeKey::Children:
+                    isValid = NodeField<SceneGraphNodeKey::Children>::Read(memberIter->value, state);
+                    break;
+                case SceneGraphNodeKey::Track:
+                    isValid = NodeField<SceneGraphNodeKey::Track>::Read(memberIter->value, state);
+                    break;
+                default:
+                    // Unknown keys are ignored, the same way the python importer does.
+                    break;
+                }
+                if (!isValid)
+                {
+                    return memberName;
+                }
+            }
+            return {};
+        }
+
+        AZ::Outcome<void, AZStd::string> ReadNodesRecursive(
+            const rapidjson::Value& children,
+            AZ::u32 parentIndex,
+            AZStd::vector<SceneGraphNode>& outNodes,
+            TransformTrackSet& outTransformTracks)
+        {
+            if (!children.IsArray())
+            {
+                return AZ::Failure(AZStd::string("'children' must be an array"));
+            }
+            for (const rapidjson::Value& child : children.GetArray())
+            {
+                if (!child.IsObject())
+                {
+                    return AZ::Failure(AZStd::string("Found a node that is not an object"));
+                }
+                NodeReadState state;
+                if (const AZStd::string_view invalidMember = ReadNodeMembers(child, state); !invalidMember.empty())
+                {
+                    return AZ::Failure(AZStd::string::format(
+                        "Node '%s' has an invalid '%.*s'", state.m_node.m_name.c_str(), AZ_STRING_ARG(invalidMember)));
+                }
+                if (!state.m_hasName)
+                {
+                    return AZ::Failure(AZStd::string("Found a node without a 'name'"));
+                }
+
+                SceneGraphNode& node = state.m_node;
+                node.m_parentIndex = parentIndex;
+                if (state.m_track)
+                {
+                    TransformTrackPose restPose;
+                    restPose.m_translation = node.m_localTranslation;
+                    restPose.m_rotation = node.m_localRotation;
+                    restPose.m_scale = node.m_localScale;
+                    auto trackOutcome = outTransformTracks.AddTrack(*state.m_track, restPose);
+                    if (!trackOutcome.IsSuccess())
+                    {
+                        return AZ::Failure(AZStd::string::format(
+                            "Node '%s' has an invalid 'track': %s", node.m_name.c_str(), trackOutcome.GetError().c_str()));
+                    }
+                    node.m_trackIndex = trackOutcome.GetValue();
+                }
+                const AZ::Matrix3x4 localTransform =
+                    AZ::Matrix3x4::CreateFromQuaternionAndTranslation(node.m_localRotation, node.m_localTranslation) *
+                    AZ::Matrix3x4::CreateScale(node.m_localScale);
+                if (parentIndex == SceneGraphNode::InvalidIndex)
+                {
+                    node.m_worldTransform = localTransform;
+                    node.m_worldRotation = node.m_localRotation;
+                    node.m_worldScale = node.m_localScale;
+                }
+                else
+                {
+                    const SceneGraphNode& parent = outNodes[parentIndex];
+                    node.m_worldTransform = parent.m_worldTransform * localTransform;
+                    node.m_worldRotation = parent.m_worldRotation * node.m_localRotation;
+                    node.m_worldScale = parent.m_worldScale * node.m_localScale;
+                }
+                node.m_worldTranslation = node.m_worldTransform.GetTranslation();
+
+                const AZ::u32 nodeIndex = aznumeric_cast<AZ::u32>(outNodes.size());
+                outNodes.emplace_back(AZStd::move(node));
+
+                if (state.m_children)
+                {
+                    auto outcome = ReadNodesRecursive(*state.m_children, nodeIndex, outNodes, outTransformTracks);
+                    if (!outcome.IsSuccess())
+                    {
+                        return outcome;
+                    }
+                }
+            }
+            return AZ::Success();
+        }
+    } // namespace
+
+    AZ::Outcome<SceneGraph, AZStd::string> SceneGraph::LoadFromFile(const AZStd::string& filePath)
+    {
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonFile(filePath);
+        if (!readOutcome.IsSuccess())
+        {
+            return AZ::Failure(readOutcome.TakeError());
+        }
+        auto loadOutcome = LoadFromDocument(readOutcome.GetValue());
+        if (!loadOutcome.IsSuccess())
+        {
+            return AZ::Failure(AZStd::string::format("Failed to parse SceneGraph file '%s': %s", filePath.c_str(), loadOutcome.GetError().c_str()));
+        }
+        return loadOutcome;
+    }
+
+    AZ::Outcome<SceneGraph, AZStd::string> SceneGraph::LoadFromString(AZStd::string_view jsonText)
+    {
+        auto readOutcome = AZ::JsonSerializationUtils::ReadJsonString(jsonText);
+        if (!readOutcome.IsSuccess())
+        {
+            return AZ::Failure(readOutcome.TakeError());
+        }
+        return LoadFromDocument(readOutcome.GetValue());
+    }
+
+    AZ::Outcome<SceneGraph, AZStd::string> SceneGraph::LoadFromDocument(const rapidjson::Value& document)
+    {
+        if (!document.IsObject())
+        {
+            return AZ::Failure(AZStd::string("A SceneGraph must be a JSON object"));
+        }
+
+        // The root object has the same "name" and "children" keys as the nodes.
+        NodeReadState rootState;
+        if (const AZStd::string_view invalidMember = ReadNodeMembers(document, rootState); !invalidMember.empty())
+        {
+            return AZ::Failure(AZStd::string::format("The SceneGraph has an invalid '%.*s'", AZ_STRING_ARG(invalidMember)));
+        }
+
+        SceneGraph sceneGraph;
+        sceneGraph.m_name = AZStd::move(rootState.m_node.m_name);
+        if (rootState.m_children)
+        {
+            auto outcome = ReadNodesRecursive(
+                *rootState.m_children, SceneGraphNode::InvalidIndex, sceneGraph.m_nodes, sceneGraph.m_transformTracks);
+            if (!outcome.IsSuccess())
+            {
+                return AZ::Failure(outcome.TakeError());
+            }
+        }
+        return AZ::Success(AZStd::move(sceneGraph));
+    }
+
+    const AZStd::string& SceneGraph::GetName() const
+    {
+        return m_name;
+    }
+
+    const AZStd::vector<SceneGraphNode>& SceneGraph::GetNodes() const
+    {
+        return m_nodes;
+    }
+
+    const TransformTrackSet& SceneGraph::GetTransformTracks() const
+    {
+        return m_transformTracks;
+    }
+} // namespace o3dimport
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include "TransformTrackSet.h"
+
+#include <AzCore/JSON/document.h>
+#include <AzCore/Math/Matrix3x4.h>
+#include <AzCore/Math/Quaternion.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/string/string_view.h>
+
+namespace o3dimport
+{
+    //! One node of a SceneGraph (.sgr) file, as exported by the o3dexport Blender AddOn.
+    struct SceneGraphNode
+    {
+        static constexpr AZ::u32 InvalidIndex = static_cast<AZ::u32>(-1);
+
+        AZStd::string m_name;
+        //! Index of the parent node in SceneGraph::GetNodes(), or InvalidIndex for root nodes.
+        AZ::u32 m_parentIndex = InvalidIndex;
+
+        // Local transform, as written in the .sgr file.
+        AZ::Vector3 m_localTranslation = AZ::Vector3::CreateZero();
+        AZ::Quaternion m_localRotation = AZ::Quaternion::CreateIdentity();
+        AZ::Vector3 m_localScale = AZ::Vector3::CreateOne();
+
+        //! The local matrices composed from the root, the same way the python importer (o3dimport.py) calculates
+        //! world positions. The non uniform scale of a parent also shears the basis of its children.
+        AZ::Matrix3x4 m_worldTransform = AZ::Matrix3x4::CreateIdentity();
+        // World transform. The translation is the one of m_worldTransform. Rotation and scale are
+        // composed per axis, which ignores the shear, and are only used to draw proxies.
+        AZ::Vector3 m_worldTranslation = AZ::Vector3::CreateZero();
+        AZ::Quaternion m_worldRotation = AZ::Quaternion::CreateIdentity();
+        AZ::Vector3 m_worldScale = AZ::Vector3::CreateOne();
+
+        //! Empty if the node doesn't reference a mesh.
+        AZStd::string m_mesh;
+        AZStd::vector<AZStd::string> m_materials;
+        //! Index of the animated transform in SceneGraph::GetTransformTracks(), or InvalidIndex if the node is static.
+        AZ::u32 m_trackIndex = InvalidIndex;
+    };
+
+    //! Read only model of a SceneGraph (.sgr) file.
+    //! Nodes are stored in depth first order, so parents always come before their children.
+    class SceneGraph
+    {
+    public:
+        static AZ::Outcome<SceneGraph, AZStd::string> LoadFromFile(const AZStd::string& filePath);
+        static AZ::Outcome<SceneGraph, AZStd::string> LoadFromString(AZStd::string_view jsonText);
+        //! Keys are resolved with the compile time perfect hash tables in SceneGraphKeys.h.
+        static AZ::Outcome<SceneGraph, AZStd::string> LoadFromDocument(const rapidjson::Value& document);
+
+        const AZStd::string& GetName() const;
+        const AZStd::vector<SceneGraphNode>& GetNodes() const;
+        const TransformTrackSet& GetTransformTracks() const;
+
+    private:
+        AZStd::string m_name;
+        AZStd::vector<SceneGraphNode> m_nodes;
+        TransformTrackSet m_transformTracks;
+    };
+} // namespace o3dimport
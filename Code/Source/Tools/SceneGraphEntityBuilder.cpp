@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraphEntityBuilder.h"
+#include "SceneGraph.h"
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AtomLyIntegration/CommonFeatures/Material/MaterialComponentConstants.h>
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentConstants.h>
+#include <AzCore/Asset/AssetManagerBus.h>
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/Entity.h>
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/JSON/document.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/Serialization/Json/JsonSerialization.h>
+#include <AzCore/Serialization/Json/RegistrationContext.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzToolsFramework/API/ToolsApplicationAPI.h>
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+#include <AzToolsFramework/Prefab/Instance/Instance.h>
+#include <AzToolsFramework/Prefab/Instance/InstanceEntityIdMapper.h>
+#include <AzToolsFramework/Prefab/PrefabDomUtils.h>
+#include <AzToolsFramework/Prefab/PrefabFocusInterface.h>
+#include <AzToolsFramework/Prefab/Undo/PrefabUndoHelpers.h>
+#include <AzToolsFramework/ToolsComponents/EditorNonUniformScaleComponent.h>
+#include <AzToolsFramework/ToolsComponents/TransformComponent.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        // Large subtrees are split in ranges of at most this many nodes, so the job system can balance them.
+        constexpr size_t MaxNodesPerJob = 256;
+
+        struct BuildContext
+        {
+            const SceneGraph* m_sceneGraph = nullptr;
+            //! One per SceneGraph node. Pre-generated on the main thread, so the jobs don't depend on each other.
+            AZStd::vector<AZ::EntityId> m_entityIds;
+            AZStd::vector<bool> m_isNew;
+            //! The container entity of the prefab instance, the parent of the root nodes.
+            AZ::EntityId m_rootParentId;
+            //! Filled before the jobs start, read only by the jobs.
+            AZStd::unordered_map<AZStd::string, AZ::Data::AssetId> m_modelAssetIds;
+            AZ::ComponentDescriptor* m_meshDescriptor = nullptr;
+            AZ::ComponentDescriptor* m_materialDescriptor = nullptr;
+            AZ::JsonDeserializerSettings m_jsonSettings;
+        };
+
+        rapidjson::Value MakeEntityIdJson(const AZ::EntityId& entityId, rapidjson::Document::AllocatorType& allocator)
+        {
+            rapidjson::Value entityIdJson(rapidjson::kObjectType);
+            entityIdJson.AddMember("id", rapidjson::Value(static_cast<AZ::u64>(entityId)), allocator);
+            return entityIdJson;
+        }
+
+        rapidjson::Value MakeVector3Json(const AZ::Vector3& vector, rapidjson::Document::AllocatorType& allocator)
+        {
+            rapidjson::Value vectorJson(rapidjson::kArrayType);
+            vectorJson.PushBack(vector.GetX(), allocator).PushBack(vector.GetY(), allocator).PushBack(vector.GetZ(), allocator);
+            return vectorJson;
+        }
+
+        bool LoadComponentFromJson(AZ::Component& component, const rapidjson::Value& json, const AZ::JsonDeserializerSettings& settings)
+        {
+            const AZ::TypeId componentTypeId = component.RTTI_GetType();
+            AZ::JsonSerializationResult::ResultCode result =
+                AZ::JsonSerialization::Load(AZ::RttiAddressOf(&component, componentTypeId), componentTypeId, json, settings);
+            return result.GetProcessing() != AZ::JsonSerializationResult::Processing::Halted;
+        }
+
+        // Runs on a worker thread. The entity is not activated, so nothing here touches shared systems.
+        AZStd::unique_ptr<AZ::Entity> BuildEntity(const BuildContext& context, size_t nodeIndex)
+        {
+            const SceneGraphNode& node = context.m_sceneGraph->GetNodes()[nodeIndex];
+            auto entity = AZStd::make_unique<AZ::Entity>(context.m_entityIds[nodeIndex], node.m_name);
+
+            rapidjson::Document transformJson(rapidjson::kObjectType);
+            auto& allocator = transformJson.GetAllocator();
+            const AZ::EntityId parentId =
+                node.m_parentIndex != SceneGraphNode::InvalidIndex ? context.m_entityIds[node.m_parentIndex] : context.m_rootParentId;
+            transformJson.AddMember("Parent Entity", MakeEntityIdJson(parentId, allocator), allocator);
+            rapidjson::Value transformData(rapidjson::kObjectType);
+            transformData.AddMember("Translate", MakeVector3Json(node.m_localTranslation, allocator), allocator);
+            const AZ::Vector3 eulerDegrees = AZ::ConvertTransformToEulerDegrees(AZ::Transform::CreateFromQuaternion(node.m_localRotation));
+            transformData.AddMember("Rotate", MakeVector3Json(eulerDegrees, allocator), allocator);
+            // Same tolerance as the python importer.
+            const bool isUniformScale = node.m_localScale.IsClose(AZ::Vector3(node.m_localScale.GetX()), 0.01f);
+            transformData.AddMember("UniformScale", isUniformScale ? node.m_localScale.GetX() : 1.0f, allocator);
+            transformJson.AddMember("Transform Data", transformData, allocator);
+
+            auto* transformComponent = aznew AzToolsFramework::Components::TransformComponent();
+            entity->AddComponent(transformComponent);
+            if (!LoadComponentFromJson(*transformComponent, transformJson, context.m_jsonSettings))
+            {
+                AZ_Warning("o3dimport", false, "Failed to configure the transform of entity '%s'.", node.m_name.c_str());
+            }
+
+            if (!isUniformScale)
+            {
+                rapidjson::Document scaleJson(rapidjson::kObjectType);
+                auto& scaleAllocator = scaleJson.GetAllocator();
+                scaleJson.AddMember("NonUniformScale", MakeVector3Json(node.m_localScale, scaleAllocator), scaleAllocator);
+                auto* scaleComponent = aznew AzToolsFramework::Components::EditorNonUniformScaleComponent();
+                entity->AddComponent(scaleComponent);
+                if (!LoadComponentFromJson(*scaleComponent, scaleJson, context.m_jsonSettings))
+                {
+                    AZ_Warning("o3dimport", false, "Failed to set the non uniform scale of entity '%s'.", node.m_name.c_str());
+                }
+            }
+
+            if (!node.m_mesh.empty())
+            {
+                AZ::Component* meshComponent = context.m_meshDescriptor->CreateComponent();
+                entity->AddComponent(meshComponent);
+                auto modelAssetIter = context.m_modelAssetIds.find(node.m_mesh);
+                const AZ::Data::AssetId modelAssetId =
+                    modelAssetIter != context.m_modelAssetIds.end() ? modelAssetIter->second : AZ::Data::AssetId();
+                if (modelAssetId.IsValid())
+                {
+                    rapidjson::Document meshJson(rapidjson::kObjectType);
+                    auto& meshAllocator = meshJson.GetAllocator();
+                    rapidjson::Value assetIdJson(rapidjson::kObjectType);
+                    const AZStd::string guid = modelAssetId.m_guid.ToString<AZStd::string>();
+                    assetIdJson.AddMember("guid", rapidjson::Value(guid.c_str(), meshAllocator), meshAllocator);
+                    assetIdJson.AddMember("subId", modelAssetId.m_subId, meshAllocator);
+                    rapidjson::Value modelAssetJson(rapidjson::kObjectType);
+                    modelAssetJson.AddMember("assetId", assetIdJson, meshAllocator);
+                    rapidjson::Value configurationJson(rapidjson::kObjectType);
+                    configurationJson.AddMember("ModelAsset", modelAssetJson, meshAllocator);
+                    rapidjson::Value controllerJson(rapidjson::kObjectType);
+                    controllerJson.AddMember("Configuration", configurationJson, meshAllocator);
+                    meshJson.AddMember("Controller", controllerJson, meshAllocator);
+                    if (!LoadComponentFromJson(*meshComponent, meshJson, context.m_jsonSettings))
+                    {
+                        AZ_Warning("o3dimport", false, "Failed to set the model asset of entity '%s'.", node.m_name.c_str());
+                    }
+                }
+                if (!node.m_materials.empty())
+                {
+                    entity->AddComponent(context.m_materialDescriptor->CreateComponent());
+                }
+            }
+
+            return entity;
+        }
+    } // namespace
+
+    AZ::Outcome<AZStd::vector<AZ::EntityId>, AZStd::string> SceneGraphEntityBuilder::Build(
+        const SceneGraph& sceneGraph, const AZStd::string& meshProductFolder)
+    {
+        const auto& nodes = sceneGraph.GetNodes();
+        BuildContext context;
+        context.m_sceneGraph = &sceneGraph;
+
+        AZ::ComponentApplicationBus::BroadcastResult(
+            context.m_jsonSettings.m_serializeContext, &AZ::ComponentApplicationRequests::GetSerializeContext);
+        AZ::ComponentApplicationBus::BroadcastResult(
+            context.m_jsonSettings.m_registrationContext, &AZ::ComponentApplicationRequests::GetJsonRegistrationContext);
+        AZ::ComponentApplicationBus::BroadcastResult(
+            context.m_meshDescriptor, &AZ::ComponentApplicationRequests::FindComponentDescriptor,
+            AZ::TypeId(AZ::Render::EditorMeshComponentTypeId));
+        AZ::ComponentApplicationBus::BroadcastResult(
+            context.m_materialDescriptor, &AZ::ComponentApplicationRequests::FindComponentDescriptor,
+            AZ::TypeId(AZ::Render::EditorMaterialComponentTypeId));
+        if (!context.m_jsonSettings.m_serializeContext || !context.m_jsonSettings.m_registrationContext || !context.m_meshDescriptor ||
+            !context.m_materialDescriptor)
+        {
+            return AZ::Failure(AZStd::string("The Mesh and Material editor components are not available. Is the Atom Gem enabled?"));
+        }
+
+        // Same prefab instance as the entities that the python importer creates.
+        AzFramework::EntityContextId editorEntityContextId = AzFramework::EntityContextId::CreateNull();
+        AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+            editorEntityContextId, &AzToolsFramework::EditorEntityContextRequests::GetEditorEntityContextId);
+        auto* prefabFocusInterface = AZ::Interface<AzToolsFramework::Prefab::PrefabFocusInterface>::Get();
+        AzToolsFramework::Prefab::InstanceOptionalReference focusedInstance =
+            prefabFocusInterface ? prefabFocusInterface->GetFocusedPrefabInstance(editorEntityContextId) : AZStd::nullopt;
+        if (!focusedInstance.has_value())
+        {
+            return AZ::Failure(AZStd::string("There is no prefab instance to add the entities to. Is a level open?"));
+        }
+        AzToolsFramework::Prefab::Instance& instance = focusedInstance->get();
+        context.m_rootParentId = instance.GetContainerEntityId();
+
+        AZStd::unordered_map<AZStd::string, AZ::EntityId> existingEntityIds;
+        AZ::ComponentApplicationBus::Broadcast(
+            &AZ::ComponentApplicationRequests::EnumerateEntities,
+            [&existingEntityIds](AZ::Entity* entity)
+            {
+                bool isEditorEntity = false;
+                AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+                    isEditorEntity, &AzToolsFramework::EditorEntityContextRequests::IsEditorEntity, entity->GetId());
+                if (isEditorEntity)
+                {
+                    existingEntityIds.emplace(entity->GetName(), entity->GetId());
+                }
+            });
+
+        // The ids of prefab entities are derived from their alias, so they are the same once the level is loaded again.
+        AZStd::vector<AzToolsFramework::Prefab::EntityAlias> entityAliases(nodes.size());
+        const AzToolsFramework::Prefab::AliasPath instanceAliasPath = instance.GetAbsoluteInstanceAliasPath();
+        const AZ::u32 newEntityCount = ResolveEntityIds(
+            sceneGraph, existingEntityIds,
+            [&entityAliases, &instanceAliasPath](size_t nodeIndex)
+            {
+                entityAliases[nodeIndex] = AzToolsFramework::Prefab::Instance::GenerateEntityAlias();
+                AzToolsFramework::Prefab::AliasPath entityAliasPath = instanceAliasPath;
+                entityAliasPath.Append(entityAliases[nodeIndex]);
+                return AzToolsFramework::Prefab::InstanceEntityIdMapper::GenerateEntityIdForAliasPath(entityAliasPath);
+            },
+            context.m_entityIds, context.m_isNew);
+        AZStd::vector<AZ::EntityId> builtEntityIds(nodes.size());
+        if (newEntityCount == 0)
+        {
+            return AZ::Success(AZStd::move(builtEntityIds));
+        }
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            const SceneGraphNode& node = nodes[nodeIndex];
+            if (context.m_isNew[nodeIndex] && !node.m_mesh.empty() && !context.m_modelAssetIds.contains(node.m_mesh))
+            {
+                // The AssetCatalog is queried here, once per model, instead of from the jobs.
+                const AZStd::string productPath =
+                    AZStd::string::format("%s/%s.fbx.azmodel", meshProductFolder.c_str(), node.m_mesh.c_str());
+                AZ::Data::AssetId modelAssetId;
+                AZ::Data::AssetCatalogRequestBus::BroadcastResult(
+                    modelAssetId, &AZ::Data::AssetCatalogRequests::GetAssetIdByPath, productPath.c_str(),
+                    azrtti_typeid<AZ::RPI::ModelAsset>(), false);
+                AZ_Warning("o3dimport", modelAssetId.IsValid(), "Asset '%s' not found. The mesh will be empty.", productPath.c_str());
+                context.m_modelAssetIds.emplace(node.m_mesh, modelAssetId);
+            }
+        }
+
+        // Written by the jobs, one slot per node, so no locking is needed.
+        AZStd::vector<AZStd::unique_ptr<AZ::Entity>> builtEntities(nodes.size());
+        const BuildContext& jobContext = context;
+        AZ::JobCompletion jobCompletion;
+        for (const auto& [rangeBegin, rangeEnd] : SplitIntoRanges(sceneGraph, MaxNodesPerJob))
+        {
+            AZ::Job* job = AZ::CreateJobFunction(
+                [&jobContext, &builtEntities, rangeBegin = rangeBegin, rangeEnd = rangeEnd]()
+                {
+                    for (size_t nodeIndex = rangeBegin; nodeIndex < rangeEnd; ++nodeIndex)
+                    {
+                        if (jobContext.m_isNew[nodeIndex])
+                        {
+                            builtEntities[nodeIndex] = BuildEntity(jobContext, nodeIndex);
+                        }
+                    }
+                },
+                true);
+            job->SetDependent(&jobCompletion);
+            job->Start();
+        }
+        jobCompletion.StartAndWaitForCompletion();
+
+        // Back on the main thread. The undo patch is the difference between the instance before and after the build,
+        // applying it also writes the new entities in the template of the instance, which is what the level saves.
+        AzToolsFramework::Prefab::PrefabDom instanceDomBeforeUpdate;
+        AzToolsFramework::Prefab::PrefabDomUtils::StoreInstanceInPrefabDom(instance, instanceDomBeforeUpdate);
+        AzToolsFramework::EntityList newEntities;
+        newEntities.reserve(newEntityCount);
+        // Parents come before their children.
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            if (auto& entity = builtEntities[nodeIndex])
+            {
+                builtEntityIds[nodeIndex] = entity->GetId();
+                AzToolsFramework::EditorEntityContextRequestBus::Broadcast(
+                    &AzToolsFramework::EditorEntityContextRequests::AddRequiredComponents, *entity);
+                newEntities.push_back(entity.get());
+                instance.AddEntity(*entity.release(), entityAliases[nodeIndex]);
+            }
+        }
+        AzToolsFramework::EditorEntityContextRequestBus::Broadcast(
+            &AzToolsFramework::EditorEntityContextRequests::HandleEntitiesAdded, newEntities);
+
+        AzToolsFramework::ScopedUndoBatch undoBatch("Build SceneGraph entities");
+        AzToolsFramework::Prefab::PrefabUndoHelpers::UpdatePrefabInstance(
+            instance, "Build SceneGraph entities", instanceDomBeforeUpdate, undoBatch.GetUndoBatch());
+        return AZ::Success(AZStd::move(builtEntityIds));
+    }
+
+    AZ::u32 SceneGraphEntityBuilder::ResolveEntityIds(
+        const SceneGraph& sceneGraph,
+        const AZStd::unordered_map<AZStd::string, AZ::EntityId>& existingEntityIds,
+        const GenerateEntityIdFunction& generateEntityId,
+        AZStd::vector<AZ::EntityId>& entityIds,
+        AZStd::vector<bool>& isNew)
+    {
+        const auto& nodes = sceneGraph.GetNodes();
+        entityIds.assign(nodes.size(), AZ::EntityId());
+        isNew.assign(nodes.size(), false);
+        AZ::u32 newEntityCount = 0;
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            if (auto existingIter = existingEntityIds.find(nodes[nodeIndex].m_name); existingIter != existingEntityIds.end())
+            {
+                entityIds[nodeIndex] = existingIter->second;
+                continue;
+            }
+            entityIds[nodeIndex] = generateEntityId(nodeIndex);
+            isNew[nodeIndex] = true;
+            ++newEntityCount;
+        }
+        return newEntityCount;
+    }
+
+    AZStd::vector<SceneGraphEntityBuilder::NodeRange> SceneGraphEntityBuilder::SplitIntoRanges(
+        const SceneGraph& sceneGraph, size_t maxNodesPerRange)
+    {
+        const auto& nodes = sceneGraph.GetNodes();
+        AZStd::vector<NodeRange> ranges;
+        size_t rangeBegin = 0;
+        while (rangeBegin < nodes.size())
+        {
+            size_t rangeEnd = rangeBegin + 1;
+            while (rangeEnd < nodes.size() && nodes[rangeEnd].m_parentIndex != SceneGraphNode::InvalidIndex &&
+                   (rangeEnd - rangeBegin) < maxNodesPerRange)
+            {
+                ++rangeEnd;
+            }
+            ranges.emplace_back(rangeBegin, rangeEnd);
+            rangeBegin = rangeEnd;
+        }
+        return ranges;
+    }
+} // namespace o3dimport
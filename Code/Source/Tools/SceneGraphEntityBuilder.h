@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/utility/pair.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Creates the editor entities of a SceneGraph that don't exist yet in the level.
+    //! The entities are built while they are not activated, on the job system, one job per
+    //! subtree (large subtrees are split): Transform, Mesh and Material components are created,
+    //! and the transform and model asset are written in their configuration.
+    //! Non uniform scales get a NonUniformScale component.
+    //! Only adding the required editor components, and adding the entities to the focused prefab
+    //! instance, which activates them, happen on the calling (main) thread. The whole build is a
+    //! single prefab patch of the instance, so it is saved with the level and undone in one step.
+    //! Material assets are left to the python importer, because the material slots are not
+    //! known until the model is loaded.
+    class SceneGraphEntityBuilder
+    {
+    public:
+        using NodeRange = AZStd::pair<size_t, size_t>;
+        using GenerateEntityIdFunction = AZStd::function<AZ::EntityId(size_t nodeIndex)>;
+
+        //! @param meshProductFolder Folder, relative to the project, of the .azmodel products.
+        //! @returns One id per node, in the order of SceneGraph::GetNodes(): the id of the entity that was
+        //!          created, or an invalid id if the entity already existed.
+        static AZ::Outcome<AZStd::vector<AZ::EntityId>, AZStd::string> Build(
+            const SceneGraph& sceneGraph, const AZStd::string& meshProductFolder);
+
+        //! Entities that already exist are reused, the same way the python importer finds them by name.
+        //! @param existingEntityIds key: entity name.
+        //! @param entityIds Filled with one id per node: the id of the existing entity, or the one from @generateEntityId.
+        //! @param isNew Filled with one flag per node, true when the id came from @generateEntityId.
+        //! @returns The number of new entities.
+        static AZ::u32 ResolveEntityIds(
+            const SceneGraph& sceneGraph,
+            const AZStd::unordered_map<AZStd::string, AZ::EntityId>& existingEntityIds,
+            const GenerateEntityIdFunction& generateEntityId,
+            AZStd::vector<AZ::EntityId>& entityIds,
+            AZStd::vector<bool>& isNew);
+
+        //! Nodes are stored depth first, so each root subtree is a contiguous range of nodes.
+        //! @returns [begin, end) ranges of node indices that cover all the nodes, one per root subtree, except that
+        //!          subtrees larger than @maxNodesPerRange are split.
+        static AZStd::vector<NodeRange> SplitIntoRanges(const SceneGraph& sceneGraph, size_t maxNodesPerRange);
+    };
+} // namespace o3dimport
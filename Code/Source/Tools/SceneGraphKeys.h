@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include "PerfectHash.h"
+
+namespace o3dimport
+{
+    //! Keys of a node object, and of the root object, of a SceneGraph (.sgr) file.
+    enum class SceneGraphNodeKey : AZ::u8
+    {
+        Name,
+        Transform,
+        Mesh,
+        Materials,
+        Children,
+        Track,
+        Count
+    };
+
+    //! Keys of the "transform" object of a SceneGraph node.
+    enum class SceneGraphTransformKey : AZ::u8
+    {
+        Translate,
+        Rotate,
+        Scale,
+        Count
+    };
+
+    // Same order as the enums above.
+    inline constexpr PerfectHashTable<SceneGraphNodeKey, static_cast<size_t>(SceneGraphNodeKey::Count)> SceneGraphNodeKeys(
+        { "name", "transform", "mesh", "materials", "children", "track" });
+    inline constexpr PerfectHashTable<SceneGraphTransformKey, static_cast<size_t>(SceneGraphTransformKey::Count)> SceneGraphTransformKeys(
+        { "translate", "rotate", "scale" });
+
+    static_assert(SceneGraphNodeKeys.GetTableSize() != 0, "SceneGraph node keys need a larger perfect hash table");
+    static_assert(SceneGraphTransformKeys.GetTableSize() != 0, "SceneGraph transform keys need a larger perfect hash table");
+    static_assert(SceneGraphNodeKeys.Find("children", SceneGraphNodeKey::Count) == SceneGraphNodeKey::Children);
+    static_assert(SceneGraphNodeKeys.Find("track", SceneGraphNodeKey::Count) == SceneGraphNodeKey::Track);
+    static_assert(SceneGraphNodeKeys.Find("child", SceneGraphNodeKey::Count) == SceneGraphNodeKey::Count);
+    static_assert(SceneGraphTransformKeys.Find("scale", SceneGraphTransformKey::Count) == SceneGraphTransformKey::Scale);
+} // namespace o3dimport
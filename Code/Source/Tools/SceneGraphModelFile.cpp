@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraphModelFile.h"
+#include "SceneGraph.h"
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Math/Crc.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/limits.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        class SectionWriter
+        {
+        public:
+            explicit SectionWriter(size_t byteCount)
+            {
+                m_bytes.reserve(byteCount);
+            }
+
+            template<typename T>
+            void Write(const T& value)
+            {
+                static_assert(sizeof(T) == 4, "Only 4 byte values are written, so the sections stay aligned");
+                const auto* valueBytes = reinterpret_cast<const AZ::u8*>(&value);
+                m_bytes.insert(m_bytes.end(), valueBytes, valueBytes + sizeof(T));
+            }
+
+            void WriteBytes(const char* bytes, size_t byteCount)
+            {
+                m_bytes.insert(m_bytes.end(), bytes, bytes + byteCount);
+            }
+
+            const AZStd::vector<AZ::u8>& GetBytes() const
+            {
+                return m_bytes;
+            }
+
+        private:
+            AZStd::vector<AZ::u8> m_bytes;
+        };
+
+        // Byte offset of isComplete in the header: after the signature, 3 u32, the u64 and the crc.
+        constexpr AZ::u64 IsCompleteOffset = sizeof(SceneGraphModelFile::Signature) + sizeof(AZ::u32) * 6;
+    } // namespace
+
+    AZ::Outcome<void, AZStd::string> SceneGraphModelFile::Export(
+        const AZStd::string& sceneGraphFilePath, const AZStd::string& modelFilePath)
+    {
+        // Read once, so the stamp describes exactly the bytes that were parsed.
+        AZ::IO::SystemFile sourceFile;
+        if (!sourceFile.Open(sceneGraphFilePath.c_str(), AZ::IO::SystemFile::SF_OPEN_READ_ONLY))
+        {
+            return AZ::Failure(AZStd::string::format("Failed to open SceneGraph file '%s'", sceneGraphFilePath.c_str()));
+        }
+        AZStd::string jsonText;
+        jsonText.resize_no_construct(sourceFile.Length());
+        if (sourceFile.Read(jsonText.size(), jsonText.data()) != jsonText.size())
+        {
+            return AZ::Failure(AZStd::string::format("Failed to read SceneGraph file '%s'", sceneGraphFilePath.c_str()));
+        }
+        sourceFile.Close();
+
+        auto loadOutcome = SceneGraph::LoadFromString(jsonText);
+        if (!loadOutcome.IsSuccess())
+        {
+            return AZ::Failure(AZStd::string::format(
+                "Failed to parse SceneGraph file '%s': %s", sceneGraphFilePath.c_str(), loadOutcome.GetError().c_str()));
+        }
+        SourceStamp sourceStamp;
+        sourceStamp.m_byteCount = jsonText.size();
+        sourceStamp.m_crc32 = AZ::Crc32(jsonText.data(), jsonText.size());
+        return Write(loadOutcome.GetValue(), sourceStamp, modelFilePath);
+    }
+
+    AZ::Outcome<void, AZStd::string> SceneGraphModelFile::Write(
+        const SceneGraph& sceneGraph, const SourceStamp& sourceStamp, const AZStd::string& filePath)
+    {
+        const AZStd::vector<SceneGraphNode>& nodes = sceneGraph.GetNodes();
+        const AZ::u32 nodeCount = aznumeric_cast<AZ::u32>(nodes.size());
+
+        size_t stringByteCount = 0;
+        for (const SceneGraphNode& node : nodes)
+        {
+            stringByteCount += node.m_name.size() + node.m_mesh.size();
+        }
+        if (stringByteCount > AZStd::numeric_limits<AZ::u32>::max())
+        {
+            return AZ::Failure(AZStd::string::format("The names of the SceneGraph '%s' don't fit in a model file", sceneGraph.GetName().c_str()));
+        }
+
+        // Header, parent indices, 3 + 4 + 3 floats of transform, and the two offset arrays.
+        const size_t fixedByteCount = sizeof(AZ::u32) * (8 + nodeCount + nodeCount * 10 + (nodeCount + 1) * 2);
+        SectionWriter writer(fixedByteCount + stringByteCount);
+
+        writer.WriteBytes(Signature, sizeof(Signature));
+        writer.Write(Version);
+        writer.Write(nodeCount);
+        writer.Write(aznumeric_cast<AZ::u32>(stringByteCount));
+        writer.Write(aznumeric_cast<AZ::u32>(sourceStamp.m_byteCount & 0xFFFFFFFF));
+        writer.Write(aznumeric_cast<AZ::u32>(sourceStamp.m_byteCount >> 32));
+        writer.Write(sourceStamp.m_crc32);
+        writer.Write(AZ::u32{ 0 });
+
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.Write(node.m_parentIndex);
+        }
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.Write(node.m_worldTranslation.GetX());
+            writer.Write(node.m_worldTranslation.GetY());
+            writer.Write(node.m_worldTranslation.GetZ());
+        }
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.Write(node.m_worldRotation.GetX());
+            writer.Write(node.m_worldRotation.GetY());
+            writer.Write(node.m_worldRotation.GetZ());
+            writer.Write(node.m_worldRotation.GetW());
+        }
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.Write(node.m_worldScale.GetX());
+            writer.Write(node.m_worldScale.GetY());
+            writer.Write(node.m_worldScale.GetZ());
+        }
+
+        // The names go first in the strings section, then the meshes.
+        AZ::u32 stringOffset = 0;
+        writer.Write(stringOffset);
+        for (const SceneGraphNode& node : nodes)
+        {
+            stringOffset += aznumeric_cast<AZ::u32>(node.m_name.size());
+            writer.Write(stringOffset);
+        }
+        writer.Write(stringOffset);
+        for (const SceneGraphNode& node : nodes)
+        {
+            stringOffset += aznumeric_cast<AZ::u32>(node.m_mesh.size());
+            writer.Write(stringOffset);
+        }
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.WriteBytes(node.m_name.data(), node.m_name.size());
+        }
+        for (const SceneGraphNode& node : nodes)
+        {
+            writer.WriteBytes(node.m_mesh.data(), node.m_mesh.size());
+        }
+
+        const AZStd::string tmpFilePath = filePath + ".tmp";
+        AZ::IO::SystemFile file;
+        if (!file.Open(
+                tmpFilePath.c_str(),
+                AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+        {
+            return AZ::Failure(AZStd::string::format("Failed to open '%s' for writing", tmpFilePath.c_str()));
+        }
+        const AZStd::vector<AZ::u8>& bytes = writer.GetBytes();
+        const AZ::u32 isComplete = 1;
+        bool isWritten = file.Write(bytes.data(), bytes.size()) == bytes.size();
+        if (isWritten)
+        {
+            file.Seek(IsCompleteOffset, AZ::IO::SystemFile::SF_SEEK_BEGIN);
+            isWritten = file.Write(&isComplete, sizeof(isComplete)) == sizeof(isComplete);
+        }
+        file.Close();
+        if (!isWritten)
+        {
+            AZ::IO::SystemFile::Delete(tmpFilePath.c_str());
+            return AZ::Failure(AZStd::string::format("Failed to write '%s'", tmpFilePath.c_str()));
+        }
+        if (!AZ::IO::SystemFile::Rename(tmpFilePath.c_str(), filePath.c_str(), true))
+        {
+            AZ::IO::SystemFile::Delete(tmpFilePath.c_str());
+            return AZ::Failure(AZStd::string::format("Failed to replace '%s', is it still open?", filePath.c_str()));
+        }
+        return AZ::Success();
+    }
+} // namespace o3dimport
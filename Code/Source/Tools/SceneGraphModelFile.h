@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Writes the native model of a SceneGraph as flat arrays, so python tools can map the file
+    //! in memory and read it through memoryview casts, without creating python objects per node
+    //! (see SceneGraphView in o3dimport.py).
+    //! Layout, little endian, every section starts at a multiple of 4 bytes:
+    //!     Header:              "SGRM", u32 version, u32 nodeCount, u32 stringByteCount,
+    //!                          u64 sourceByteCount, u32 sourceCrc32, u32 isComplete
+    //!     Parent indices:      u32[nodeCount], 0xFFFFFFFF for the root nodes
+    //!     World translations:  f32[nodeCount * 3]
+    //!     World rotations:     f32[nodeCount * 4], x y z w
+    //!     World scales:        f32[nodeCount * 3]
+    //!     Name offsets:        u32[nodeCount + 1], into the strings section
+    //!     Mesh offsets:        u32[nodeCount + 1], into the strings section, empty for nodes without mesh
+    //!     Strings:             u8[stringByteCount], utf-8, not null terminated
+    //! The nodes are in the same depth first order as SceneGraph::GetNodes().
+    //! sourceByteCount and sourceCrc32 (same value as python's zlib.crc32()) identify the .sgr file the model
+    //! was exported from. isComplete is only set to 1 once everything else was written.
+    class SceneGraphModelFile
+    {
+    public:
+        static constexpr char Signature[4] = { 'S', 'G', 'R', 'M' };
+        static constexpr AZ::u32 Version = 2;
+
+        struct SourceStamp
+        {
+            AZ::u64 m_byteCount = 0;
+            AZ::u32 m_crc32 = 0;
+        };
+
+        //! Parses the SceneGraph (.sgr) file and writes its model in @modelFilePath.
+        static AZ::Outcome<void, AZStd::string> Export(const AZStd::string& sceneGraphFilePath, const AZStd::string& modelFilePath);
+        //! Writes a temporary file next to @filePath, and renames it into place, so readers never see a partial file.
+        static AZ::Outcome<void, AZStd::string> Write(
+            const SceneGraph& sceneGraph, const SourceStamp& sourceStamp, const AZStd::string& filePath);
+    };
+} // namespace o3dimport
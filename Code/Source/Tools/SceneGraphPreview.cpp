@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraphPreview.h"
+#include "SceneGraph.h"
+
+#include <AzToolsFramework/Viewport/ViewportMessages.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        // The .sgr file doesn't know the bounds of the meshes, so a mesh proxy is
+        // a box of this size (in meters) scaled by the world scale of the node.
+        constexpr float MeshProxyHalfExtent = 0.5f;
+        constexpr float PointProxyHalfExtent = 0.1f;
+
+        const AZ::Color ProxyColor(1.0f, 0.6f, 0.0f, 1.0f);
+
+        // Pairs of indices into the 8 box corners, one pair per edge.
+        constexpr AZ::u8 BoxEdgeIndices[] = { 0, 1, 1, 3, 3, 2, 2, 0, 4, 5, 5, 7, 7, 6, 6, 4, 0, 4, 1, 5, 2, 6, 3, 7 };
+    } // namespace
+
+    SceneGraphPreview::~SceneGraphPreview()
+    {
+        Clear();
+    }
+
+    void SceneGraphPreview::Show(const SceneGraph& sceneGraph)
+    {
+        Clear();
+
+        const auto& nodes = sceneGraph.GetNodes();
+        m_proxies.resize(nodes.size());
+        m_proxyIndicesByPath.reserve(nodes.size());
+        AZStd::vector<AZStd::string> nodePaths(nodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            const SceneGraphNode& node = nodes[nodeIndex];
+            Proxy& proxy = m_proxies[nodeIndex];
+            proxy.m_isBox = !node.m_mesh.empty();
+            if (proxy.m_isBox)
+            {
+                const AZ::Vector3 halfExtents = node.m_worldScale.GetAbs() * MeshProxyHalfExtent;
+                proxy.m_points.reserve(8);
+                for (AZ::u8 corner = 0; corner < 8; ++corner)
+                {
+                    const AZ::Vector3 localCorner(
+                        (corner & 1) ? halfExtents.GetX() : -halfExtents.GetX(),
+                        (corner & 2) ? halfExtents.GetY() : -halfExtents.GetY(),
+                        (corner & 4) ? halfExtents.GetZ() : -halfExtents.GetZ());
+                    proxy.m_points.push_back(node.m_worldTranslation + node.m_worldRotation.TransformVector(localCorner));
+                }
+            }
+            else
+            {
+                proxy.m_points = {
+                    node.m_worldTranslation - AZ::Vector3::CreateAxisX(PointProxyHalfExtent),
+                    node.m_worldTranslation + AZ::Vector3::CreateAxisX(PointProxyHalfExtent),
+                    node.m_worldTranslation - AZ::Vector3::CreateAxisY(PointProxyHalfExtent),
+                    node.m_worldTranslation + AZ::Vector3::CreateAxisY(PointProxyHalfExtent),
+                    node.m_worldTranslation - AZ::Vector3::CreateAxisZ(PointProxyHalfExtent),
+                    node.m_worldTranslation + AZ::Vector3::CreateAxisZ(PointProxyHalfExtent),
+                };
+            }
+            // Parents always come before their children.
+            if (node.m_parentIndex != SceneGraphNode::InvalidIndex)
+            {
+                nodePaths[nodeIndex] = nodePaths[node.m_parentIndex] + "/";
+            }
+            nodePaths[nodeIndex] += node.m_name;
+            m_proxyIndicesByPath[nodePaths[nodeIndex]].push_back(nodeIndex);
+        }
+
+        m_linesNeedRebuild = true;
+        AzFramework::ViewportDebugDisplayEventBus::Handler::BusConnect(AzToolsFramework::ViewportInteraction::g_mainViewportEntityDebugDisplayId);
+    }
+
+    void SceneGraphPreview::AttachNode(const AZStd::string& nodePath, const AZ::EntityId& entityId)
+    {
+        auto proxiesIter = m_proxyIndicesByPath.find(nodePath);
+        if (proxiesIter == m_proxyIndicesByPath.end())
+        {
+            return;
+        }
+        AZ::Data::Instance<AZ::RPI::Model> model;
+        AZ::Render::MeshComponentRequestBus::EventResult(model, entityId, &AZ::Render::MeshComponentRequests::GetModel);
+        // Copied, hiding the last proxy clears the preview.
+        const AZStd::vector<size_t> proxyIndices = proxiesIter->second;
+        for (size_t proxyIndex : proxyIndices)
+        {
+            if (m_proxies.empty())
+            {
+                return;
+            }
+            if (!m_proxies[proxyIndex].m_isBox || model)
+            {
+                HideProxy(proxyIndex);
+            }
+            else if (!m_proxies[proxyIndex].m_isHidden)
+            {
+                m_pendingProxyIndicesByEntityId[entityId].push_back(proxyIndex);
+            }
+        }
+        if (m_pendingProxyIndicesByEntityId.contains(entityId))
+        {
+            AZ::Render::MeshComponentNotificationBus::MultiHandler::BusConnect(entityId);
+        }
+    }
+
+    void SceneGraphPreview::OnModelReady(
+        [[maybe_unused]] const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset,
+        [[maybe_unused]] const AZ::Data::Instance<AZ::RPI::Model>& model)
+    {
+        // Null when called by BusConnect(), but AttachNode() only connects to entities whose model is not loaded yet.
+        const AZ::EntityId* entityId = AZ::Render::MeshComponentNotificationBus::GetCurrentBusId();
+        if (!entityId)
+        {
+            return;
+        }
+        auto pendingIter = m_pendingProxyIndicesByEntityId.find(*entityId);
+        if (pendingIter == m_pendingProxyIndicesByEntityId.end())
+        {
+            return;
+        }
+        const AZStd::vector<size_t> proxyIndices = AZStd::move(pendingIter->second);
+        m_pendingProxyIndicesByEntityId.erase(pendingIter);
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect(*entityId);
+        for (size_t proxyIndex : proxyIndices)
+        {
+            if (m_proxies.empty())
+            {
+                return;
+            }
+            HideProxy(proxyIndex);
+        }
+    }
+
+    void SceneGraphPreview::HideProxy(size_t proxyIndex)
+    {
+        Proxy& proxy = m_proxies[proxyIndex];
+        if (proxy.m_isHidden)
+        {
+            return;
+        }
+        proxy.m_isHidden = true;
+        // The lines are rebuilt at most once per frame, no matter how many nodes were hidden.
+        m_linesNeedRebuild = true;
+        if (++m_hiddenCount == m_proxies.size())
+        {
+            Clear();
+        }
+    }
+
+    void SceneGraphPreview::Clear()
+    {
+        AzFramework::ViewportDebugDisplayEventBus::Handler::BusDisconnect();
+        AZ::Render::MeshComponentNotificationBus::MultiHandler::BusDisconnect();
+        m_proxies.clear();
+        m_proxyIndicesByPath.clear();
+        m_pendingProxyIndicesByEntityId.clear();
+        m_lines.clear();
+        m_linesNeedRebuild = false;
+        m_hiddenCount = 0;
+    }
+
+    size_t SceneGraphPreview::GetVisibleProxyCount() const
+    {
+        return m_proxies.size() - m_hiddenCount;
+    }
+
+    void SceneGraphPreview::RebuildLines()
+    {
+        m_lines.clear();
+        for (const Proxy& proxy : m_proxies)
+        {
+            if (proxy.m_isHidden)
+            {
+                continue;
+            }
+            if (proxy.m_isBox)
+            {
+                for (AZ::u8 edgeIndex : BoxEdgeIndices)
+                {
+                    m_lines.push_back(proxy.m_points[edgeIndex]);
+                }
+            }
+            else
+            {
+                m_lines.insert(m_lines.end(), proxy.m_points.begin(), proxy.m_points.end());
+            }
+        }
+        m_linesNeedRebuild = false;
+    }
+
+    void SceneGraphPreview::DisplayViewport(
+        [[maybe_unused]] const AzFramework::ViewportInfo& viewportInfo, AzFramework::DebugDisplayRequests& debugDisplay)
+    {
+        if (m_linesNeedRebuild)
+        {
+            RebuildLines();
+        }
+        if (!m_lines.empty())
+        {
+            debugDisplay.DrawLines(m_lines, ProxyColor);
+        }
+    }
+} // namespace o3dimport
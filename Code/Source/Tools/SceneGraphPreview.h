@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentBus.h>
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Math/Color.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <AzFramework/Entity/EntityDebugDisplayBus.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Draws a wireframe box for every node of a SceneGraph that references a mesh, and
+    //! a small axis cross for every other node, in the main viewport.
+    //! All proxies are drawn with a single DrawLines() call per frame.
+    //! Once a node is attached to its entity, the proxy is hidden when the model of the entity is ready.
+    class SceneGraphPreview
+        : private AzFramework::ViewportDebugDisplayEventBus::Handler
+        , private AZ::Render::MeshComponentNotificationBus::MultiHandler
+    {
+    public:
+        SceneGraphPreview() = default;
+        ~SceneGraphPreview();
+
+        //! Replaces the current preview, if any, with the nodes of @sceneGraph.
+        void Show(const SceneGraph& sceneGraph);
+        //! Binds the node at @nodePath, the names of its ancestors and its own name separated by '/', to @entityId.
+        //! The proxy of a node with a mesh is hidden when the model of the entity is ready, any other proxy right away.
+        void AttachNode(const AZStd::string& nodePath, const AZ::EntityId& entityId);
+        void Clear();
+
+        //! The number of proxies that are still drawn, 0 once the preview cleared itself.
+        size_t GetVisibleProxyCount() const;
+
+    private:
+        struct Proxy
+        {
+            //! The 8 corners of the box, or the 6 end points of the axis cross.
+            AZStd::vector<AZ::Vector3> m_points;
+            bool m_isBox = false;
+            bool m_isHidden = false;
+        };
+
+        // AzFramework::ViewportDebugDisplayEventBus
+        void DisplayViewport(const AzFramework::ViewportInfo& viewportInfo, AzFramework::DebugDisplayRequests& debugDisplay) override;
+
+        // AZ::Render::MeshComponentNotificationBus
+        void OnModelReady(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, const AZ::Data::Instance<AZ::RPI::Model>& model) override;
+
+        void HideProxy(size_t proxyIndex);
+        void RebuildLines();
+
+        AZStd::vector<Proxy> m_proxies;
+        //! Sibling nodes can have the same name, so a path can lead to more than one proxy.
+        AZStd::unordered_map<AZStd::string, AZStd::vector<size_t>> m_proxyIndicesByPath;
+        //! The mesh proxies waiting for the model of their entity. Several nodes can be attached to the same entity.
+        AZStd::unordered_map<AZ::EntityId, AZStd::vector<size_t>> m_pendingProxyIndicesByEntityId;
+        //! Pairs of points, one pair per line, for all the visible proxies.
+        AZStd::vector<AZ::Vector3> m_lines;
+        bool m_linesNeedRebuild = false;
+        size_t m_hiddenCount = 0;
+    };
+} // namespace o3dimport
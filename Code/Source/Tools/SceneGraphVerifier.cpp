@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraphVerifier.h"
+#include "SceneGraph.h"
+
+#include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AtomLyIntegration/CommonFeatures/Material/MaterialComponentBus.h>
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentBus.h>
+#include <AzCore/Asset/AssetManagerBus.h>
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/Entity.h>
+#include <AzCore/Component/NonUniformScaleBus.h>
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/math.h>
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        namespace MismatchFlags
+        {
+            // Same order as the counts in the first line of the report.
+            enum : AZ::u8
+            {
+                Missing = 1 << 0,
+                Parent = 1 << 1,
+                Transform = 1 << 2,
+                Model = 1 << 3,
+                Material = 1 << 4,
+                KindCount = 5
+            };
+        } // namespace MismatchFlags
+
+        AZ::Data::AssetId FindProductAssetId(const AZStd::string& productPath, const AZ::TypeId& assetType)
+        {
+            AZ::Data::AssetId assetId;
+            AZ::Data::AssetCatalogRequestBus::BroadcastResult(
+                assetId, &AZ::Data::AssetCatalogRequests::GetAssetIdByPath, productPath.c_str(), assetType, false);
+            return assetId;
+        }
+
+        void ReadEntityState(const SceneGraphNode& node, SceneGraphLevelState::Entity& state)
+        {
+            const AZ::EntityId entityId = state.m_entityId;
+            AZ::TransformBus::EventResult(state.m_parentId, entityId, &AZ::TransformBus::Events::GetParentId);
+            AZ::TransformBus::EventResult(state.m_localTM, entityId, &AZ::TransformBus::Events::GetLocalTM);
+            AZ::NonUniformScaleRequestBus::EventResult(state.m_nonUniformScale, entityId, &AZ::NonUniformScaleRequests::GetScale);
+            if (node.m_mesh.empty())
+            {
+                return;
+            }
+            AZ::Render::MeshComponentRequestBus::EventResult(
+                state.m_modelAssetId, entityId, &AZ::Render::MeshComponentRequestBus::Events::GetModelAssetId);
+            if (node.m_materials.empty())
+            {
+                return;
+            }
+            AZ::Data::Asset<const AZ::RPI::ModelAsset> modelAsset;
+            AZ::Render::MeshComponentRequestBus::EventResult(
+                modelAsset, entityId, &AZ::Render::MeshComponentRequestBus::Events::GetModelAsset);
+            if (!modelAsset.IsReady())
+            {
+                return;
+            }
+            state.m_hasMaterialSlots = true;
+            for (const auto& [stableId, materialSlot] : modelAsset->GetMaterialSlots())
+            {
+                const AZStd::string_view displayName = materialSlot.m_displayName.GetStringView();
+                if (AZStd::find(node.m_materials.begin(), node.m_materials.end(), displayName) == node.m_materials.end())
+                {
+                    continue;
+                }
+                SceneGraphLevelState::MaterialSlot& slot = state.m_materialSlots.emplace_back();
+                slot.m_label = displayName;
+                AZ::Render::MaterialComponentRequestBus::EventResult(
+                    slot.m_materialAssetId, entityId, &AZ::Render::MaterialComponentRequestBus::Events::GetMaterialAssetId,
+                    AZ::Render::MaterialAssignmentId::CreateFromStableIdOnly(stableId));
+            }
+        }
+
+        AZStd::string ToString(const AZ::Vector3& vector)
+        {
+            return AZStd::string::format("(%.3f, %.3f, %.3f)", vector.GetX(), vector.GetY(), vector.GetZ());
+        }
+
+        //! The angle, in degrees, of the rotation from @actual to @expected, in [0, 180].
+        float GetAngleDegrees(const AZ::Quaternion& actual, const AZ::Quaternion& expected)
+        {
+            const AZ::Quaternion delta = actual.GetConjugate() * expected;
+            // q and -q are the same rotation, hence the absolute w.
+            const float halfAngle = AZStd::atan2(delta.GetImaginary().GetLength(), AZStd::abs(delta.GetW()));
+            return AZ::RadToDeg(2.0f * halfAngle);
+        }
+
+        //! @returns The MismatchFlags of the node, and appends their descriptions to @details.
+        AZ::u8 CompareNode(
+            const SceneGraphNode& node,
+            const SceneGraphLevelState& levelState,
+            size_t nodeIndex,
+            const SceneGraphVerificationSettings& settings,
+            bool& isUnverified,
+            AZStd::string& details)
+        {
+            const SceneGraphLevelState::Entity& state = levelState.m_entities[nodeIndex];
+            if (!state.m_entityId.IsValid())
+            {
+                details = " missing";
+                return MismatchFlags::Missing;
+            }
+
+            AZ::u8 flags = 0;
+            const AZ::EntityId expectedParentId =
+                node.m_parentIndex == SceneGraphNode::InvalidIndex ? AZ::EntityId() : levelState.m_entities[node.m_parentIndex].m_entityId;
+            if (state.m_parentId != expectedParentId)
+            {
+                flags |= MismatchFlags::Parent;
+                details += " parent";
+            }
+
+            const AZ::Vector3 translation = state.m_localTM.GetTranslation();
+            if (!translation.IsClose(node.m_localTranslation, settings.m_tolerance))
+            {
+                flags |= MismatchFlags::Transform;
+                details += AZStd::string::format(
+                    " translation %s expected %s", ToString(translation).c_str(), ToString(node.m_localTranslation).c_str());
+            }
+            const float angleDegrees = GetAngleDegrees(state.m_localTM.GetRotation(), node.m_localRotation);
+            if (angleDegrees > settings.m_angleToleranceDegrees)
+            {
+                flags |= MismatchFlags::Transform;
+                details += AZStd::string::format(" rotation off by %.3f degrees", angleDegrees);
+            }
+            const AZ::Vector3 scale = state.m_nonUniformScale * state.m_localTM.GetUniformScale();
+            if (!scale.IsClose(node.m_localScale, settings.m_tolerance))
+            {
+                flags |= MismatchFlags::Transform;
+                details += AZStd::string::format(" scale %s expected %s", ToString(scale).c_str(), ToString(node.m_localScale).c_str());
+            }
+
+            if (!node.m_mesh.empty())
+            {
+                const AZ::Data::AssetId& expectedModelAssetId = levelState.m_modelAssetIds.at(node.m_mesh);
+                if (state.m_modelAssetId != expectedModelAssetId)
+                {
+                    flags |= MismatchFlags::Model;
+                    details += AZStd::string::format(
+                        " model %s expected %s", state.m_modelAssetId.ToString<AZStd::string>().c_str(),
+                        expectedModelAssetId.ToString<AZStd::string>().c_str());
+                }
+                else if (!node.m_materials.empty() && !state.m_hasMaterialSlots)
+                {
+                    isUnverified = true;
+                }
+            }
+            if (state.m_hasMaterialSlots)
+            {
+                for (const AZStd::string& materialName : node.m_materials)
+                {
+                    auto slotIter = AZStd::find_if(
+                        state.m_materialSlots.begin(), state.m_materialSlots.end(),
+                        [&materialName](const SceneGraphLevelState::MaterialSlot& slot)
+                        {
+                            return slot.m_label == materialName;
+                        });
+                    if (slotIter == state.m_materialSlots.end())
+                    {
+                        flags |= MismatchFlags::Material;
+                        details += AZStd::string::format(" material slot '%s' not found", materialName.c_str());
+                    }
+                    else if (slotIter->m_materialAssetId != levelState.m_materialAssetIds.at(materialName))
+                    {
+                        flags |= MismatchFlags::Material;
+                        details += AZStd::string::format(" material slot '%s'", materialName.c_str());
+                    }
+                }
+            }
+            return flags;
+        }
+    } // namespace
+
+    AZStd::string SceneGraphVerifier::Verify(const SceneGraph& sceneGraph, const SceneGraphVerificationSettings& settings)
+    {
+        return Compare(sceneGraph, ReadLevelState(sceneGraph, settings), settings);
+    }
+
+    SceneGraphLevelState SceneGraphVerifier::ReadLevelState(const SceneGraph& sceneGraph, const SceneGraphVerificationSettings& settings)
+    {
+        const auto& nodes = sceneGraph.GetNodes();
+        SceneGraphLevelState levelState;
+        levelState.m_entities.resize(nodes.size());
+
+        AZStd::unordered_map<AZStd::string, AZ::EntityId> editorEntityIds;
+        AZ::ComponentApplicationBus::Broadcast(
+            &AZ::ComponentApplicationRequests::EnumerateEntities,
+            [&editorEntityIds](AZ::Entity* entity)
+            {
+                bool isEditorEntity = false;
+                AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+                    isEditorEntity, &AzToolsFramework::EditorEntityContextRequests::IsEditorEntity, entity->GetId());
+                if (isEditorEntity)
+                {
+                    editorEntityIds.emplace(entity->GetName(), entity->GetId());
+                }
+            });
+
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            const SceneGraphNode& node = nodes[nodeIndex];
+            if (!node.m_mesh.empty() && !levelState.m_modelAssetIds.contains(node.m_mesh))
+            {
+                const AZStd::string productPath =
+                    AZStd::string::format("%s/%s.fbx.azmodel", settings.m_meshProductFolder.c_str(), node.m_mesh.c_str());
+                levelState.m_modelAssetIds.emplace(node.m_mesh, FindProductAssetId(productPath, azrtti_typeid<AZ::RPI::ModelAsset>()));
+            }
+            for (const AZStd::string& materialName : node.m_materials)
+            {
+                if (!levelState.m_materialAssetIds.contains(materialName))
+                {
+                    const AZStd::string productPath =
+                        AZStd::string::format("%s/%s.azmaterial", settings.m_materialProductFolder.c_str(), materialName.c_str());
+                    levelState.m_materialAssetIds.emplace(
+                        materialName, FindProductAssetId(productPath, azrtti_typeid<AZ::RPI::MaterialAsset>()));
+                }
+            }
+            auto entityIter = editorEntityIds.find(node.m_name);
+            if (entityIter != editorEntityIds.end())
+            {
+                levelState.m_entities[nodeIndex].m_entityId = entityIter->second;
+                ReadEntityState(node, levelState.m_entities[nodeIndex]);
+            }
+        }
+        return levelState;
+    }
+
+    AZStd::string SceneGraphVerifier::Compare(
+        const SceneGraph& sceneGraph, const SceneGraphLevelState& levelState, const SceneGraphVerificationSettings& settings)
+    {
+        const auto& nodes = sceneGraph.GetNodes();
+        AZ_Assert(levelState.m_entities.size() == nodes.size(), "The level state was read for another SceneGraph");
+
+        AZ::u32 mismatchCount = 0;
+        AZ::u32 unverifiedCount = 0;
+        AZ::u32 countsPerKind[MismatchFlags::KindCount] = {};
+        AZStd::string lines;
+        AZStd::string details;
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            bool isUnverified = false;
+            details.clear();
+            const AZ::u8 flags = CompareNode(nodes[nodeIndex], levelState, nodeIndex, settings, isUnverified, details);
+            unverifiedCount += isUnverified ? 1 : 0;
+            if (flags == 0)
+            {
+                continue;
+            }
+            for (int kind = 0; kind < MismatchFlags::KindCount; ++kind)
+            {
+                countsPerKind[kind] += (flags >> kind) & 1;
+            }
+            if (mismatchCount < settings.m_maxReportedMismatches)
+            {
+                lines += AZStd::string::format("    %s:%s\n", nodes[nodeIndex].m_name.c_str(), details.c_str());
+            }
+            ++mismatchCount;
+        }
+
+        AZStd::string report = AZStd::string::format(
+            "Verified %zu nodes of '%s': %u mismatch(es). missing: %u, parent: %u, transform: %u, model: %u, material: %u. "
+            "Materials not verified, the model is not loaded: %u\n",
+            nodes.size(), sceneGraph.GetName().c_str(), mismatchCount, countsPerKind[0], countsPerKind[1], countsPerKind[2],
+            countsPerKind[3], countsPerKind[4], unverifiedCount);
+        report += lines;
+        if (mismatchCount > settings.m_maxReportedMismatches)
+        {
+            report += AZStd::string::format("    ... and %u more\n", mismatchCount - settings.m_maxReportedMismatches);
+        }
+        return report;
+    }
+} // namespace o3dimport
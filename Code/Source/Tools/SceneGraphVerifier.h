@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    struct SceneGraphVerificationSettings
+    {
+        //! Folders, relative to the project, of the .azmodel and .azmaterial products.
+        AZStd::string m_meshProductFolder;
+        AZStd::string m_materialProductFolder;
+        //! Used for each translation and scale component.
+        float m_tolerance = 0.001f;
+        //! Maximum angle, in degrees, between the expected and the actual rotation.
+        float m_angleToleranceDegrees = 0.1f;
+        //! Only the first mismatches get a line in the report, all of them are counted.
+        AZ::u32 m_maxReportedMismatches = 100;
+    };
+
+    //! What the level has for each node of a SceneGraph.
+    struct SceneGraphLevelState
+    {
+        struct MaterialSlot
+        {
+            AZStd::string m_label;
+            AZ::Data::AssetId m_materialAssetId;
+        };
+
+        struct Entity
+        {
+            //! Invalid if there's no editor entity with the name of the node.
+            AZ::EntityId m_entityId;
+            AZ::EntityId m_parentId;
+            AZ::Transform m_localTM = AZ::Transform::CreateIdentity();
+            AZ::Vector3 m_nonUniformScale = AZ::Vector3::CreateOne();
+            AZ::Data::AssetId m_modelAssetId;
+            //! False if the model is not loaded yet, so its material slots are unknown.
+            bool m_hasMaterialSlots = false;
+            //! Only the slots labeled like one of the node materials.
+            AZStd::vector<MaterialSlot> m_materialSlots;
+        };
+
+        //! One per node, in the order of SceneGraph::GetNodes().
+        AZStd::vector<Entity> m_entities;
+        //! The expected products, by mesh name and by material name. Invalid if the product is not in the catalog.
+        AZStd::unordered_map<AZStd::string, AZ::Data::AssetId> m_modelAssetIds;
+        AZStd::unordered_map<AZStd::string, AZ::Data::AssetId> m_materialAssetIds;
+    };
+
+    //! Compares the editor entities of the level against a SceneGraph: parent, local transform,
+    //! model asset and the material asset of each model slot labeled like one of the node materials.
+    //! Reading the level goes through the component buses, one entity after the other, and costs far more
+    //! than the comparisons, so everything runs on the calling (main) thread.
+    class SceneGraphVerifier
+    {
+    public:
+        //! @returns A compact report. The first line has the number of mismatches per kind, and the number of
+        //!          nodes whose materials could not be verified because their model is not loaded yet.
+        static AZStd::string Verify(const SceneGraph& sceneGraph, const SceneGraphVerificationSettings& settings);
+
+        //! Matches the editor entities to the nodes by name, the same way the importer finds them.
+        static SceneGraphLevelState ReadLevelState(const SceneGraph& sceneGraph, const SceneGraphVerificationSettings& settings);
+        //! Same report as Verify(), doesn't use any bus.
+        static AZStd::string Compare(
+            const SceneGraph& sceneGraph, const SceneGraphLevelState& levelState, const SceneGraphVerificationSettings& settings);
+    };
+} // namespace o3dimport
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneGraphWatcher.h"
+#include "SceneGraph.h"
+
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/Entity.h>
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Settings/SettingsRegistry.h>
+#include <AzCore/Settings/SettingsRegistryMergeUtils.h>
+#include <AzCore/StringFunc/StringFunc.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzToolsFramework/API/EditorPythonRunnerRequestsBus.h>
+#include <AzToolsFramework/API/ToolsApplicationAPI.h>
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+
+#include <QObject>
+#include <QTimer>
+
+namespace o3dimport
+{
+    AZ_CVAR(bool, o3dimport_watchSceneGraphs, false, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Re-imports a scene into the open level when its Assets/Scenes/<Scene>/<Scene>.sgr file changes.");
+    AZ_CVAR(float, o3dimport_watchPollSeconds, 1.0f, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "How often, in seconds, the SceneGraph files are checked for changes.");
+    AZ_CVAR(float, o3dimport_watchDebounceSeconds, 2.0f, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Seconds a changed SceneGraph file must stay untouched before it is re-imported, so a burst of writes triggers a single import.");
+    AZ_CVAR(AZ::CVarFixedString, o3dimport_watchImportArguments, "--native_build --order camera --noverbose", nullptr,
+        AZ::ConsoleFunctorFlags::Null,
+        "Arguments of o3dimport.py, after the scene name, for the re-imports triggered by o3dimport_watchSceneGraphs. "
+        "--nosave and --frame_budget_ms are always added.");
+    AZ_CVAR(float, o3dimport_watchFrameBudgetMs, 8.0f, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Milliseconds a re-import triggered by o3dimport_watchSceneGraphs works before it yields an Editor frame.");
+
+    namespace
+    {
+        AZStd::string GetImporterScriptPath()
+        {
+            AZ::IO::FixedMaxPath gemPath;
+            if (auto* settingsRegistry = AZ::SettingsRegistry::Get(); settingsRegistry)
+            {
+                settingsRegistry->Get(
+                    gemPath.Native(),
+                    AZ::SettingsRegistryInterface::FixedValueString::format("%s/o3dimport/Path", AZ::SettingsRegistryMergeUtils::ManifestGemsRootKey));
+            }
+            if (gemPath.empty())
+            {
+                return {};
+            }
+            return (gemPath / "Editor" / "Scripts" / "o3dimport" / "o3dimport.py").String();
+        }
+
+        AZStd::unordered_set<AZStd::string> GetEditorEntityNames()
+        {
+            AZStd::unordered_set<AZStd::string> editorEntityNames;
+            AZ::ComponentApplicationBus::Broadcast(
+                &AZ::ComponentApplicationRequests::EnumerateEntities,
+                [&editorEntityNames](AZ::Entity* entity)
+                {
+                    bool isEditorEntity = false;
+                    AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+                        isEditorEntity, &AzToolsFramework::EditorEntityContextRequests::IsEditorEntity, entity->GetId());
+                    if (isEditorEntity)
+                    {
+                        editorEntityNames.insert(entity->GetName());
+                    }
+                });
+            return editorEntityNames;
+        }
+    } // namespace
+
+    bool SceneGraphWatcher::IsSceneInLevel(const SceneGraph& sceneGraph, const AZStd::unordered_set<AZStd::string>& editorEntityNames)
+    {
+        for (const SceneGraphNode& node : sceneGraph.GetNodes())
+        {
+            if (node.m_parentIndex == SceneGraphNode::InvalidIndex && editorEntityNames.contains(node.m_name))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SceneGraphWatcher::~SceneGraphWatcher()
+    {
+        Deactivate();
+    }
+
+    void SceneGraphWatcher::Activate()
+    {
+        m_importContext = AZStd::make_unique<QObject>();
+        AZ::TickBus::Handler::BusConnect();
+    }
+
+    void SceneGraphWatcher::Deactivate()
+    {
+        AZ::TickBus::Handler::BusDisconnect();
+        // Drops the queued import, if any.
+        m_importContext.reset();
+        m_isImporting = false;
+        m_watchedFiles.clear();
+        m_hasBaseline = false;
+    }
+
+    void SceneGraphWatcher::OnTick(float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    {
+        if (m_isImporting)
+        {
+            return;
+        }
+        m_secondsSincePoll += deltaTime;
+        if (m_secondsSincePoll < static_cast<float>(o3dimport_watchPollSeconds))
+        {
+            return;
+        }
+        m_secondsSincePoll = 0.0f;
+        Poll();
+    }
+
+    void SceneGraphWatcher::Poll()
+    {
+        if (!o3dimport_watchSceneGraphs)
+        {
+            // Changes made while the watcher was off are not imported when it's turned on.
+            m_watchedFiles.clear();
+            m_hasBaseline = false;
+            return;
+        }
+
+        const auto now = AZStd::chrono::steady_clock::now();
+        const AZ::IO::FixedMaxPath scenesFolder = AZ::Utils::GetProjectPath() / "Assets" / "Scenes";
+        AZStd::vector<AZStd::string> sceneNames;
+        AZ::IO::SystemFile::FindFiles(
+            (scenesFolder / "*").c_str(),
+            [&sceneNames](const char* fileName, bool isFile)
+            {
+                if (!isFile && fileName[0] != '.')
+                {
+                    sceneNames.emplace_back(fileName);
+                }
+                return true;
+            });
+
+        for (const AZStd::string& sceneName : sceneNames)
+        {
+            // The importer finds a scene by name, so only <Scene>/<Scene>.sgr is watched.
+            const AZ::IO::FixedMaxPath sceneGraphFilePath = scenesFolder / sceneName / (sceneName + ".sgr");
+            const AZ::u64 modificationTime = AZ::IO::SystemFile::ModificationTime(sceneGraphFilePath.c_str());
+            if (modificationTime == 0)
+            {
+                continue;
+            }
+            auto [fileIter, isNew] = m_watchedFiles.try_emplace(sceneName);
+            WatchedFile& watchedFile = fileIter->second;
+            if (watchedFile.m_modificationTime != modificationTime)
+            {
+                watchedFile.m_modificationTime = modificationTime;
+                watchedFile.m_lastChangeTime = now;
+                // Scenes exported for the first time after the baseline are imported too.
+                watchedFile.m_isPending = m_hasBaseline;
+            }
+        }
+        m_hasBaseline = true;
+
+        const auto debounceTime = AZStd::chrono::duration<float>(static_cast<float>(o3dimport_watchDebounceSeconds));
+        for (auto& [sceneName, watchedFile] : m_watchedFiles)
+        {
+            if (watchedFile.m_isPending && (now - watchedFile.m_lastChangeTime) >= debounceTime)
+            {
+                if (Reimport(sceneName))
+                {
+                    watchedFile.m_isPending = false;
+                }
+                // One import per poll, the importer already yields frames for a while.
+                return;
+            }
+        }
+    }
+
+    bool SceneGraphWatcher::Reimport(const AZStd::string& sceneName)
+    {
+        bool isLevelOpen = false;
+        AzToolsFramework::EditorRequestBus::BroadcastResult(isLevelOpen, &AzToolsFramework::EditorRequests::IsLevelDocumentOpen);
+        bool isRunningGame = false;
+        AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+            isRunningGame, &AzToolsFramework::EditorEntityContextRequests::IsEditorRunningGame);
+        if (!isLevelOpen || isRunningGame)
+        {
+            return false;
+        }
+
+        // A scene exported for another level, or never imported, is not added to whatever level is open.
+        const AZ::IO::FixedMaxPath sceneGraphFilePath =
+            AZ::Utils::GetProjectPath() / "Assets" / "Scenes" / sceneName / (sceneName + ".sgr");
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath.String());
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Warning("o3dimport", false, "Can't re-import scene '%s'. %s", sceneName.c_str(), loadOutcome.GetError().c_str());
+            return true;
+        }
+        if (!IsSceneInLevel(loadOutcome.GetValue(), GetEditorEntityNames()))
+        {
+            AZ_TracePrintf(
+                "o3dimport", "SceneGraph of scene '%s' changed, but the scene is not in the open level. Skipped.\n", sceneName.c_str());
+            return true;
+        }
+
+        const AZStd::string scriptPath = GetImporterScriptPath();
+        if (scriptPath.empty())
+        {
+            AZ_Warning("o3dimport", false, "Can't re-import scene '%s', the path of the o3dimport Gem is not in the Settings Registry.", sceneName.c_str());
+            return true;
+        }
+
+        const AZ::CVarFixedString importArguments = o3dimport_watchImportArguments;
+        AZStd::vector<AZStd::string> tokens;
+        tokens.push_back(sceneName);
+        AZ::StringFunc::Tokenize(AZStd::string_view(importArguments), tokens, ' ');
+        // The level is saved by the user, not by every phase of an import the user didn't start.
+        tokens.push_back("--nosave");
+        tokens.push_back("--frame_budget_ms");
+        tokens.push_back(AZStd::string::format("%.3f", static_cast<float>(o3dimport_watchFrameBudgetMs)));
+
+        AZ_TracePrintf("o3dimport", "SceneGraph of scene '%s' changed. Re-importing it.\n", sceneName.c_str());
+        m_isImporting = true;
+        // The importer pumps Editor frames, running it from OnTick would dispatch the TickBus from within itself.
+        QTimer::singleShot(
+            0,
+            m_importContext.get(),
+            [this, scriptPath, tokens = AZStd::move(tokens)]()
+            {
+                const AZStd::vector<AZStd::string_view> arguments(tokens.begin(), tokens.end());
+                AzToolsFramework::EditorPythonRunnerRequestBus::Broadcast(
+                    &AzToolsFramework::EditorPythonRunnerRequestBus::Events::ExecuteByFilenameWithArgs, scriptPath, arguments);
+                m_isImporting = false;
+            });
+        return true;
+    }
+} // namespace o3dimport
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Component/TickBus.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/string/string.h>
+
+class QObject;
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Opt-in (o3dimport_watchSceneGraphs) hot re-import. Polls the modification time of
+    //! <project>/Assets/Scenes/<Scene>/<Scene>.sgr, and once a changed file stays untouched for
+    //! o3dimport_watchDebounceSeconds, runs o3dimport.py on that scene in the open level.
+    //! Scenes that were never imported into the open level are skipped.
+    //! The importer only creates the entities and assigns the assets that changed. It runs from the
+    //! Qt event loop, not from the tick, because it yields Editor frames (o3dimport_watchFrameBudgetMs)
+    //! while it works. It never saves the level, the user saves it when ready.
+    class SceneGraphWatcher
+        : private AZ::TickBus::Handler
+    {
+    public:
+        SceneGraphWatcher() = default;
+        ~SceneGraphWatcher();
+
+        void Activate();
+        void Deactivate();
+
+        //! @returns true if an entity of the level is named after one of the root nodes of @sceneGraph,
+        //!          the same way the importer finds the entities that already exist.
+        static bool IsSceneInLevel(const SceneGraph& sceneGraph, const AZStd::unordered_set<AZStd::string>& editorEntityNames);
+
+    private:
+        struct WatchedFile
+        {
+            AZ::u64 m_modificationTime = 0;
+            AZStd::chrono::steady_clock::time_point m_lastChangeTime;
+            bool m_isPending = false;
+        };
+
+        // AZ::TickBus
+        void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
+
+        void Poll();
+        //! Queues the import of the scene, it runs once the current tick finishes.
+        //! @returns false if the scene can't be imported right now, e.g. there's no level open.
+        bool Reimport(const AZStd::string& sceneName);
+
+        //! key: scene name.
+        AZStd::unordered_map<AZStd::string, WatchedFile> m_watchedFiles;
+        //! The first scan only records the modification times, it doesn't trigger imports.
+        bool m_hasBaseline = false;
+        //! From the moment an import is queued until it finishes. The importer yields Editor frames, so this class ticks while it runs.
+        bool m_isImporting = false;
+        //! Context of the queued imports, they are dropped if the watcher is deactivated before they run.
+        AZStd::unique_ptr<QObject> m_importContext;
+        float m_secondsSincePoll = 0.0f;
+    };
+} // namespace o3dimport
@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SceneMemoryReport.h"
+#include "MaterialFile.h"
+#include "SceneGraph.h"
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/sort.h>
+#include <AzCore/std/string/conversions.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        // jpeg files can have large metadata segments before the frame header.
+        constexpr size_t MaxImageHeaderBytes = 256 * 1024;
+        constexpr AZ::u32 MaxReportedAssets = 10;
+        constexpr AZ::u32 MaxReportedChildren = 10;
+        constexpr double Mebibyte = 1024.0 * 1024.0;
+
+        const char* const CompressionNames[] = { "BC1", "BC4", "BC5", "BC7" };
+
+        AZ::u32 ReadBigEndian16(const AZ::u8* bytes)
+        {
+            return (AZ::u32(bytes[0]) << 8) | bytes[1];
+        }
+
+        AZ::u32 ReadBigEndian32(const AZ::u8* bytes)
+        {
+            return (AZ::u32(bytes[0]) << 24) | (AZ::u32(bytes[1]) << 16) | (AZ::u32(bytes[2]) << 8) | bytes[3];
+        }
+
+        AZ::u32 ReadLittleEndian16(const AZ::u8* bytes)
+        {
+            return AZ::u32(bytes[0]) | (AZ::u32(bytes[1]) << 8);
+        }
+
+        bool ParsePngHeader(const AZ::u8* bytes, size_t byteCount, ImageHeader& outHeader)
+        {
+            constexpr AZ::u8 Signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+            // Signature, then the IHDR chunk: length, "IHDR", width, height, bit depth, color type.
+            if (byteCount < 26 || memcmp(bytes, Signature, sizeof(Signature)) != 0 || memcmp(bytes + 12, "IHDR", 4) != 0)
+            {
+                return false;
+            }
+            outHeader.m_width = ReadBigEndian32(bytes + 16);
+            outHeader.m_height = ReadBigEndian32(bytes + 20);
+            switch (bytes[25])
+            {
+            case 0: // Grayscale
+                outHeader.m_channelCount = 1;
+                break;
+            case 4: // Grayscale and alpha
+                outHeader.m_channelCount = 2;
+                break;
+            case 6: // RGBA
+                outHeader.m_channelCount = 4;
+                break;
+            default: // RGB and palette
+                outHeader.m_channelCount = 3;
+                break;
+            }
+            return true;
+        }
+
+        bool ParseJpegHeader(const AZ::u8* bytes, size_t byteCount, ImageHeader& outHeader)
+        {
+            if (byteCount < 4 || bytes[0] != 0xFF || bytes[1] != 0xD8)
+            {
+                return false;
+            }
+            size_t offset = 2;
+            while (offset + 4 <= byteCount)
+            {
+                if (bytes[offset] != 0xFF)
+                {
+                    return false;
+                }
+                const AZ::u8 marker = bytes[offset + 1];
+                if (marker == 0xFF)
+                {
+                    ++offset; // Fill byte.
+                    continue;
+                }
+                if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+                {
+                    offset += 2; // Markers without a segment.
+                    continue;
+                }
+                const size_t segmentLength = ReadBigEndian16(bytes + offset + 2);
+                // SOF0 to SOF15, except DHT (C4), JPG (C8) and DAC (CC).
+                const bool isFrameHeader = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+                if (isFrameHeader)
+                {
+                    // Length, precision, height, width, component count.
+                    if (offset + 10 > byteCount)
+                    {
+                        return false;
+                    }
+                    outHeader.m_height = ReadBigEndian16(bytes + offset + 5);
+                    outHeader.m_width = ReadBigEndian16(bytes + offset + 7);
+                    outHeader.m_channelCount = bytes[offset + 9];
+                    return true;
+                }
+                offset += 2 + segmentLength;
+            }
+            return false;
+        }
+
+        bool ParseTgaHeader(const AZ::u8* bytes, size_t byteCount, ImageHeader& outHeader)
+        {
+            // tga doesn't have a signature, so the header fields are validated instead.
+            constexpr size_t HeaderSize = 18;
+            if (byteCount < HeaderSize || bytes[1] > 1)
+            {
+                return false;
+            }
+            const AZ::u8 imageType = bytes[2];
+            const AZ::u8 pixelDepth = bytes[16];
+            const bool isKnownType = (imageType >= 1 && imageType <= 3) || (imageType >= 9 && imageType <= 11);
+            if (!isKnownType || (pixelDepth != 8 && pixelDepth != 16 && pixelDepth != 24 && pixelDepth != 32))
+            {
+                return false;
+            }
+            outHeader.m_width = ReadLittleEndian16(bytes + 12);
+            outHeader.m_height = ReadLittleEndian16(bytes + 14);
+            const bool isGrayscale = imageType == 3 || imageType == 11;
+            outHeader.m_channelCount = isGrayscale ? 1 : (pixelDepth == 32 ? 4 : 3);
+            return outHeader.m_width > 0 && outHeader.m_height > 0;
+        }
+
+        bool IsImageFileName(const AZStd::string& lowerCaseFileName)
+        {
+            return lowerCaseFileName.ends_with(".png") || lowerCaseFileName.ends_with(".jpg") || lowerCaseFileName.ends_with(".jpeg") ||
+                lowerCaseFileName.ends_with(".tga");
+        }
+
+        AZStd::vector<AZStd::string> ListFiles(const AZStd::string& folder)
+        {
+            AZStd::vector<AZStd::string> fileNames;
+            AZ::IO::SystemFile::FindFiles(
+                (folder + "/*").c_str(),
+                [&fileNames](const char* fileName, bool isFile)
+                {
+                    if (isFile)
+                    {
+                        fileNames.emplace_back(fileName);
+                    }
+                    return true;
+                });
+            return fileNames;
+        }
+
+        AZStd::string ToLower(AZStd::string_view text)
+        {
+            AZStd::string lowerCaseText(text);
+            AZStd::to_lower(lowerCaseText.begin(), lowerCaseText.end());
+            return lowerCaseText;
+        }
+
+        struct AssetCost
+        {
+            AZStd::string m_label;
+            AZ::u64 m_gpuBytes = 0;
+            AZ::u64 m_diskBytes = 0;
+            AZ::u32 m_referenceCount = 0;
+            bool m_isTexture = false;
+        };
+
+        struct MaterialInfo
+        {
+            size_t m_assetIndex = 0;
+            AZStd::vector<size_t> m_textureAssetIndices;
+        };
+
+        class ReportBuilder
+        {
+        public:
+            ReportBuilder(const SceneGraph& sceneGraph, const AZStd::string& sceneFolder, const AZStd::string& meshProductFolder)
+                : m_sceneGraph(sceneGraph)
+                , m_sceneFolder(sceneFolder)
+                , m_meshProductFolder(meshProductFolder)
+            {
+            }
+
+            AZStd::string Build(AZ::u32 maxDepth)
+            {
+                ReadTextures();
+                ReadMaterials();
+                ReadMeshes();
+                AttributeCosts();
+                return WriteReport(maxDepth);
+            }
+
+        private:
+            void ReadTextures()
+            {
+                const AZStd::string texturesFolder = m_sceneFolder + "/Textures";
+                AZStd::vector<AZ::u8> headerBytes(MaxImageHeaderBytes);
+                for (const AZStd::string& fileName : ListFiles(texturesFolder))
+                {
+                    const AZStd::string lowerCaseFileName = ToLower(fileName);
+                    if (!IsImageFileName(lowerCaseFileName))
+                    {
+                        continue;
+                    }
+                    const AZStd::string filePath = texturesFolder + "/" + fileName;
+                    const AZ::IO::SystemFile::SizeType byteCount =
+                        AZ::IO::SystemFile::Read(filePath.c_str(), headerBytes.data(), headerBytes.size());
+                    ImageHeader header;
+                    if (!SceneMemoryReport::ParseImageHeader(headerBytes.data(), byteCount, header))
+                    {
+                        m_unreadableTextures.push_back(fileName);
+                        continue;
+                    }
+                    const TextureCompression compression = SceneMemoryReport::ChooseCompression(fileName, header.m_channelCount);
+                    AssetCost& cost = AddAsset(AZStd::string::format(
+                        "Textures/%s %ux%u %s", fileName.c_str(), header.m_width, header.m_height,
+                        CompressionNames[static_cast<int>(compression)]));
+                    cost.m_gpuBytes = SceneMemoryReport::EstimateTextureGpuBytes(header.m_width, header.m_height, compression);
+                    cost.m_diskBytes = AZ::IO::SystemFile::Length(filePath.c_str());
+                    cost.m_isTexture = true;
+                    m_textureAssetIndices.emplace(lowerCaseFileName, m_assets.size() - 1);
+                }
+            }
+
+            void ReadMaterials()
+            {
+                for (const SceneGraphNode& node : m_sceneGraph.GetNodes())
+                {
+                    for (const AZStd::string& materialName : node.m_materials)
+                    {
+                        if (m_materials.contains(materialName))
+                        {
+                            continue;
+                        }
+                        const AZStd::string filePath = AZStd::string::format("%s/Materials/%s.material", m_sceneFolder.c_str(), materialName.c_str());
+                        MaterialInfo& material = m_materials[materialName];
+                        AssetCost& cost = AddAsset(AZStd::string::format("Materials/%s.material", materialName.c_str()));
+                        cost.m_diskBytes = AZ::IO::SystemFile::Length(filePath.c_str());
+                        material.m_assetIndex = m_assets.size() - 1;
+                        auto readOutcome = MaterialFile::ReadTextureFileNames(filePath);
+                        if (!readOutcome.IsSuccess())
+                        {
+                            m_unreadableMaterials.push_back(materialName);
+                            continue;
+                        }
+                        // Textures are matched by file name.
+                        for (const AZStd::string& textureFileName : readOutcome.GetValue())
+                        {
+                            if (auto textureIter = m_textureAssetIndices.find(ToLower(textureFileName)); textureIter != m_textureAssetIndices.end())
+                            {
+                                material.m_textureAssetIndices.push_back(textureIter->second);
+                            }
+                        }
+                    }
+                }
+            }
+
+            void ReadMeshes()
+            {
+                // The mesh products are in lower case, e.g. "<mesh>_lod0_<stream>.azbuffer".
+                AZStd::vector<AZStd::string> bufferFileNames;
+                for (const AZStd::string& fileName : ListFiles(m_meshProductFolder))
+                {
+                    AZStd::string lowerCaseFileName = ToLower(fileName);
+                    if (lowerCaseFileName.ends_with(".azbuffer"))
+                    {
+                        bufferFileNames.emplace_back(AZStd::move(lowerCaseFileName));
+                    }
+                }
+                for (const SceneGraphNode& node : m_sceneGraph.GetNodes())
+                {
+                    if (node.m_mesh.empty() || m_meshAssetIndices.contains(node.m_mesh))
+                    {
+                        continue;
+                    }
+                    AssetCost& cost = AddAsset(AZStd::string::format("Meshes/%s.fbx", node.m_mesh.c_str()));
+                    cost.m_diskBytes =
+                        AZ::IO::SystemFile::Length(AZStd::string::format("%s/Meshes/%s.fbx", m_sceneFolder.c_str(), node.m_mesh.c_str()).c_str());
+                    const AZStd::string lowerCaseMeshName = ToLower(node.m_mesh);
+                    bool hasBuffers = false;
+                    for (const AZStd::string& bufferFileName : bufferFileNames)
+                    {
+                        if (SceneMemoryReport::IsMeshBufferFileName(bufferFileName, lowerCaseMeshName))
+                        {
+                            cost.m_gpuBytes += AZ::IO::SystemFile::Length((m_meshProductFolder + "/" + bufferFileName).c_str());
+                            hasBuffers = true;
+                        }
+                    }
+                    if (!hasBuffers)
+                    {
+                        m_unprocessedMeshes.push_back(node.m_mesh);
+                    }
+                    m_meshAssetIndices.emplace(node.m_mesh, m_assets.size() - 1);
+                }
+            }
+
+            //! Each asset is resident once, so its cost is split evenly among the nodes that reference it.
+            void AttributeCosts()
+            {
+                const auto& nodes = m_sceneGraph.GetNodes();
+                AZStd::vector<AZStd::vector<size_t>> nodeAssetIndices(nodes.size());
+                for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+                {
+                    const SceneGraphNode& node = nodes[nodeIndex];
+                    AZStd::unordered_set<size_t> assetIndices;
+                    if (!node.m_mesh.empty())
+                    {
+                        assetIndices.insert(m_meshAssetIndices[node.m_mesh]);
+                    }
+                    for (const AZStd::string& materialName : node.m_materials)
+                    {
+                        const MaterialInfo& material = m_materials[materialName];
+                        assetIndices.insert(material.m_assetIndex);
+                        assetIndices.insert(material.m_textureAssetIndices.begin(), material.m_textureAssetIndices.end());
+                    }
+                    for (size_t assetIndex : assetIndices)
+                    {
+                        ++m_assets[assetIndex].m_referenceCount;
+                    }
+                    nodeAssetIndices[nodeIndex].assign(assetIndices.begin(), assetIndices.end());
+                }
+
+                m_subtreeGpuBytes.resize(nodes.size(), 0.0);
+                m_subtreeDiskBytes.resize(nodes.size(), 0.0);
+                for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+                {
+                    for (size_t assetIndex : nodeAssetIndices[nodeIndex])
+                    {
+                        const AssetCost& cost = m_assets[assetIndex];
+                        m_subtreeGpuBytes[nodeIndex] += double(cost.m_gpuBytes) / cost.m_referenceCount;
+                        m_subtreeDiskBytes[nodeIndex] += double(cost.m_diskBytes) / cost.m_referenceCount;
+                    }
+                }
+                // Nodes are depth first, so going backwards every subtree is complete before it's added to its parent.
+                for (size_t nodeIndex = nodes.size(); nodeIndex-- > 0;)
+                {
+                    const AZ::u32 parentIndex = nodes[nodeIndex].m_parentIndex;
+                    if (parentIndex != SceneGraphNode::InvalidIndex)
+                    {
+                        m_subtreeGpuBytes[parentIndex] += m_subtreeGpuBytes[nodeIndex];
+                        m_subtreeDiskBytes[parentIndex] += m_subtreeDiskBytes[nodeIndex];
+                    }
+                }
+            }
+
+            AZStd::string WriteReport(AZ::u32 maxDepth)
+            {
+                AZ::u64 textureGpuBytes = 0;
+                AZ::u64 meshGpuBytes = 0;
+                AZ::u64 diskBytes = 0;
+                AZ::u64 unreferencedTextureGpuBytes = 0;
+                AZ::u32 unreferencedTextureCount = 0;
+                AZStd::vector<size_t> referencedAssetIndices;
+                for (size_t assetIndex = 0; assetIndex < m_assets.size(); ++assetIndex)
+                {
+                    const AssetCost& cost = m_assets[assetIndex];
+                    if (cost.m_referenceCount == 0)
+                    {
+                        unreferencedTextureGpuBytes += cost.m_gpuBytes;
+                        unreferencedTextureCount += cost.m_isTexture ? 1 : 0;
+                        continue;
+                    }
+                    (cost.m_isTexture ? textureGpuBytes : meshGpuBytes) += cost.m_gpuBytes;
+                    diskBytes += cost.m_diskBytes;
+                    referencedAssetIndices.push_back(assetIndex);
+                }
+
+                AZStd::string report = AZStd::string::format(
+                    "Scene '%s': %.2f MiB GPU (textures %.2f MiB, meshes %.2f MiB), %.2f MiB on disk. %zu textures, %zu materials, %zu meshes.\n",
+                    m_sceneGraph.GetName().c_str(), (textureGpuBytes + meshGpuBytes) / Mebibyte, textureGpuBytes / Mebibyte,
+                    meshGpuBytes / Mebibyte, diskBytes / Mebibyte, m_textureAssetIndices.size(), m_materials.size(),
+                    m_meshAssetIndices.size());
+                if (unreferencedTextureCount > 0)
+                {
+                    report += AZStd::string::format(
+                        "    Not used by any node: %u textures, %.2f MiB GPU.\n", unreferencedTextureCount, unreferencedTextureGpuBytes / Mebibyte);
+                }
+                AppendNames(report, "Unreadable textures", m_unreadableTextures);
+                AppendNames(report, "Unreadable materials", m_unreadableMaterials);
+                AppendNames(report, "Meshes without processed buffers", m_unprocessedMeshes);
+
+                AZStd::sort(
+                    referencedAssetIndices.begin(), referencedAssetIndices.end(),
+                    [this](size_t lhs, size_t rhs)
+                    {
+                        return m_assets[lhs].m_gpuBytes > m_assets[rhs].m_gpuBytes;
+                    });
+                report += "Largest assets (GPU MiB, references):\n";
+                for (size_t rank = 0; rank < referencedAssetIndices.size() && rank < MaxReportedAssets; ++rank)
+                {
+                    const AssetCost& cost = m_assets[referencedAssetIndices[rank]];
+                    report += AZStd::string::format("    %-64s %10.2f %6u\n", cost.m_label.c_str(), cost.m_gpuBytes / Mebibyte, cost.m_referenceCount);
+                }
+
+                const auto& nodes = m_sceneGraph.GetNodes();
+                m_childIndices.resize(nodes.size());
+                AZStd::vector<size_t> rootIndices;
+                for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+                {
+                    const AZ::u32 parentIndex = nodes[nodeIndex].m_parentIndex;
+                    (parentIndex == SceneGraphNode::InvalidIndex ? rootIndices : m_childIndices[parentIndex]).push_back(nodeIndex);
+                }
+                report += "Subtrees (GPU MiB, disk MiB), assets shared by several nodes are split evenly:\n";
+                AppendSubtrees(report, rootIndices, 0, maxDepth);
+                return report;
+            }
+
+            void AppendSubtrees(AZStd::string& report, AZStd::vector<size_t>& nodeIndices, AZ::u32 depth, AZ::u32 maxDepth)
+            {
+                AZStd::sort(
+                    nodeIndices.begin(), nodeIndices.end(),
+                    [this](size_t lhs, size_t rhs)
+                    {
+                        return m_subtreeGpuBytes[lhs] > m_subtreeGpuBytes[rhs];
+                    });
+                const AZStd::string indentation((depth + 1) * 4, ' ');
+                for (size_t rank = 0; rank < nodeIndices.size(); ++rank)
+                {
+                    if (rank == MaxReportedChildren)
+                    {
+                        report += AZStd::string::format("%s... and %zu more\n", indentation.c_str(), nodeIndices.size() - rank);
+                        break;
+                    }
+                    const size_t nodeIndex = nodeIndices[rank];
+                    report += AZStd::string::format(
+                        "%s%s %.2f %.2f\n", indentation.c_str(), m_sceneGraph.GetNodes()[nodeIndex].m_name.c_str(),
+                        m_subtreeGpuBytes[nodeIndex] / Mebibyte, m_subtreeDiskBytes[nodeIndex] / Mebibyte);
+                    if (depth < maxDepth)
+                    {
+                        AppendSubtrees(report, m_childIndices[nodeIndex], depth + 1, maxDepth);
+                    }
+                }
+            }
+
+            static void AppendNames(AZStd::string& report, const char* title, const AZStd::vector<AZStd::string>& names)
+            {
+                if (names.empty())
+                {
+                    return;
+                }
+                report += AZStd::string::format("    %s (%zu):", title, names.size());
+                for (size_t nameIndex = 0; nameIndex < names.size() && nameIndex < MaxReportedAssets; ++nameIndex)
+                {
+                    report += " " + names[nameIndex];
+                }
+                report += names.size() > MaxReportedAssets ? " ...\n" : "\n";
+            }
+
+            AssetCost& AddAsset(AZStd::string label)
+            {
+                AssetCost& cost = m_assets.emplace_back();
+                cost.m_label = AZStd::move(label);
+                return cost;
+            }
+
+            const SceneGraph& m_sceneGraph;
+            const AZStd::string& m_sceneFolder;
+            const AZStd::string& m_meshProductFolder;
+            AZStd::vector<AssetCost> m_assets;
+            //! key: lower case file name.
+            AZStd::unordered_map<AZStd::string, size_t> m_textureAssetIndices;
+            AZStd::unordered_map<AZStd::string, MaterialInfo> m_materials;
+            AZStd::unordered_map<AZStd::string, size_t> m_meshAssetIndices;
+            AZStd::vector<AZStd::string> m_unreadableTextures;
+            AZStd::vector<AZStd::string> m_unreadableMaterials;
+            AZStd::vector<AZStd::string> m_unprocessedMeshes;
+            AZStd::vector<double> m_subtreeGpuBytes;
+            AZStd::vector<double> m_subtreeDiskBytes;
+            AZStd::vector<AZStd::vector<size_t>> m_childIndices;
+        };
+    } // namespace
+
+    AZStd::string SceneMemoryReport::Generate(
+        const SceneGraph& sceneGraph, const AZStd::string& sceneFolder, const AZStd::string& meshProductFolder, AZ::u32 maxDepth)
+    {
+        ReportBuilder builder(sceneGraph, sceneFolder, meshProductFolder);
+        return builder.Build(maxDepth);
+    }
+
+    bool SceneMemoryReport::ParseImageHeader(const AZ::u8* bytes, size_t byteCount, ImageHeader& outHeader)
+    {
+        return ParsePngHeader(bytes, byteCount, outHeader) || ParseJpegHeader(bytes, byteCount, outHeader) ||
+            ParseTgaHeader(bytes, byteCount, outHeader);
+    }
+
+    TextureCompression SceneMemoryReport::ChooseCompression(AZStd::string_view fileName, AZ::u32 channelCount)
+    {
+        const size_t extensionIndex = fileName.find_last_of('.');
+        const AZStd::string_view stem = fileName.substr(0, extensionIndex);
+        if (ToLower(stem).ends_with("_normal"))
+        {
+            return TextureCompression::BC5;
+        }
+        if (channelCount >= 4)
+        {
+            return TextureCompression::BC7;
+        }
+        return channelCount == 1 ? TextureCompression::BC4 : TextureCompression::BC1;
+    }
+
+    AZ::u64 SceneMemoryReport::EstimateTextureGpuBytes(AZ::u32 width, AZ::u32 height, TextureCompression compression)
+    {
+        const AZ::u64 bytesPerBlock = (compression == TextureCompression::BC1 || compression == TextureCompression::BC4) ? 8 : 16;
+        AZ::u64 totalBytes = 0;
+        while (true)
+        {
+            totalBytes += AZ::u64((width + 3) / 4) * ((height + 3) / 4) * bytesPerBlock;
+            if (width <= 1 && height <= 1)
+            {
+                return totalBytes;
+            }
+            width = AZStd::max(width / 2, 1u);
+            height = AZStd::max(height / 2, 1u);
+        }
+    }
+
+    bool SceneMemoryReport::IsMeshBufferFileName(AZStd::string_view bufferFileName, AZStd::string_view meshName)
+    {
+        constexpr AZStd::string_view LodSeparator = "_lod";
+        if (!bufferFileName.starts_with(meshName) || !bufferFileName.substr(meshName.size()).starts_with(LodSeparator))
+        {
+            return false;
+        }
+        const AZStd::string_view lodSuffix = bufferFileName.substr(meshName.size() + LodSeparator.size());
+        size_t digitCount = 0;
+        while (digitCount < lodSuffix.size() && lodSuffix[digitCount] >= '0' && lodSuffix[digitCount] <= '9')
+        {
+            ++digitCount;
+        }
+        return digitCount > 0 && digitCount < lodSuffix.size() && lodSuffix[digitCount] == '_';
+    }
+} // namespace o3dimport
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/string/string_view.h>
+
+namespace o3dimport
+{
+    class SceneGraph;
+
+    //! Block compression that the O3DE Image Builder is expected to pick for a texture.
+    //! Same rules as BlenderAddOn/o3dexport/texture_budget.py.
+    enum class TextureCompression : AZ::u8
+    {
+        BC1, //!< Color without alpha.
+        BC4, //!< Single channel.
+        BC5, //!< Normal maps, the exporter names them "*_normal".
+        BC7, //!< Color with alpha.
+    };
+
+    struct ImageHeader
+    {
+        AZ::u32 m_width = 0;
+        AZ::u32 m_height = 0;
+        AZ::u32 m_channelCount = 0;
+    };
+
+    //! Projects the GPU and disk memory of an exported scene, from the files in its folder:
+    //! - Textures/: dimensions and channels from the png, jpeg or tga header, block compressed with a full mip chain.
+    //! - Materials/: the "*.textureMap" properties, to know which textures each material uses.
+    //! - Meshes/: the size of the .azbuffer products of each mesh (vertex and index buffers), the fbx size on disk.
+    //! Each asset is resident once, so its cost is split among the nodes that reference it, and the
+    //! report breaks the totals down by subtree.
+    class SceneMemoryReport
+    {
+    public:
+        //! @param meshProductFolder Absolute path of the folder, in the asset cache, with the products of the meshes.
+        //! @param maxDepth Deepest level of the SceneGraph with its own line in the subtree breakdown.
+        //! @returns The report as text.
+        static AZStd::string Generate(
+            const SceneGraph& sceneGraph, const AZStd::string& sceneFolder, const AZStd::string& meshProductFolder, AZ::u32 maxDepth);
+
+        //! @param bytes The first bytes of a png, jpeg or tga file.
+        //! @returns false if the format is not recognized, or the header is not within @byteCount.
+        static bool ParseImageHeader(const AZ::u8* bytes, size_t byteCount, ImageHeader& outHeader);
+        static TextureCompression ChooseCompression(AZStd::string_view fileName, AZ::u32 channelCount);
+        //! All the mips, down to 1x1, rounded up to 4x4 blocks.
+        static AZ::u64 EstimateTextureGpuBytes(AZ::u32 width, AZ::u32 height, TextureCompression compression);
+        //! @returns true if @bufferFileName is "<@meshName>_lod<digits>_<stream>.azbuffer", so the buffers of mesh
+        //!          "Wall" are not counted for mesh "Wall_lodge". Both names in lower case.
+        static bool IsMeshBufferFileName(AZStd::string_view bufferFileName, AZStd::string_view meshName);
+    };
+} // namespace o3dimport
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "TransformTrackSet.h"
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/math.h>
+
+namespace o3dimport
+{
+    namespace
+    {
+        float DecodeComponent(AZ::u16 value)
+        {
+            const float normalized = static_cast<float>(value & TransformTrackSet::MaxQuantizedComponent) /
+                static_cast<float>(TransformTrackSet::MaxQuantizedComponent);
+            return (normalized * 2.0f - 1.0f) * TransformTrackSet::MaxSmallestComponent;
+        }
+
+        //! Reads "times" and "values" of one channel of a track, and appends the keys.
+        //! @param readKey Reads the key that starts at the given index of the values array.
+        //! @returns The number of keys, zero if the channel is not in the track.
+        AZ::Outcome<AZ::u32, AZStd::string> ReadChannel(
+            const rapidjson::Value& trackValue,
+            const char* channelName,
+            AZ::u32 componentCount,
+            AZStd::vector<float>& outTimes,
+            const AZStd::function<bool(const rapidjson::Value& values, AZ::u32 firstValue)>& readKey)
+        {
+            const auto channelIter = trackValue.FindMember(channelName);
+            if (channelIter == trackValue.MemberEnd())
+            {
+                return AZ::Success(0u);
+            }
+            const rapidjson::Value& channel = channelIter->value;
+            if (!channel.IsObject() || !channel.HasMember("times") || !channel.HasMember("values") || !channel["times"].IsArray() ||
+                !channel["values"].IsArray())
+            {
+                return AZ::Failure(AZStd::string::format("'%s' must have a 'times' and a 'values' array", channelName));
+            }
+            const rapidjson::Value& times = channel["times"];
+            const rapidjson::Value& values = channel["values"];
+            if (times.Empty() || values.Size() != times.Size() * componentCount)
+            {
+                return AZ::Failure(AZStd::string::format(
+                    "'%s' has %u time(s) and %u value(s), expected %u values per time", channelName, times.Size(), values.Size(),
+                    componentCount));
+            }
+
+            const size_t firstTime = outTimes.size();
+            for (rapidjson::SizeType keyIndex = 0; keyIndex < times.Size(); ++keyIndex)
+            {
+                if (!times[keyIndex].IsNumber())
+                {
+                    return AZ::Failure(AZStd::string::format("'%s' has a time that is not a number", channelName));
+                }
+                const float time = times[keyIndex].GetFloat();
+                // Strictly increasing, so the interpolation never divides by zero.
+                if (outTimes.size() > firstTime && time <= outTimes.back())
+                {
+                    return AZ::Failure(AZStd::string::format("The times of '%s' must be increasing", channelName));
+                }
+                if (!readKey(values, keyIndex * componentCount))
+                {
+                    return AZ::Failure(AZStd::string::format("'%s' has an invalid value", channelName));
+                }
+                outTimes.push_back(time);
+            }
+            return AZ::Success(aznumeric_cast<AZ::u32>(times.Size()));
+        }
+
+        bool ReadVector3Key(const rapidjson::Value& values, AZ::u32 firstValue, AZStd::vector<AZ::Vector3>& outKeys)
+        {
+            for (AZ::u32 component = 0; component < 3; ++component)
+            {
+                if (!values[firstValue + component].IsNumber())
+                {
+                    return false;
+                }
+            }
+            outKeys.emplace_back(values[firstValue].GetFloat(), values[firstValue + 1].GetFloat(), values[firstValue + 2].GetFloat());
+            return true;
+        }
+
+        bool ReadQuaternionKey(const rapidjson::Value& values, AZ::u32 firstValue, AZStd::vector<AZ::Quaternion>& outKeys)
+        {
+            AZ::u16 quantized[3];
+            for (AZ::u32 component = 0; component < 3; ++component)
+            {
+                const rapidjson::Value& value = values[firstValue + component];
+                if (!value.IsUint() || value.GetUint() > 0xFFFF)
+                {
+                    return false;
+                }
+                quantized[component] = static_cast<AZ::u16>(value.GetUint());
+            }
+            outKeys.push_back(TransformTrackSet::DequantizeQuaternion(quantized[0], quantized[1], quantized[2]));
+            return true;
+        }
+
+        //! Finds the keys around @time, in a range of strictly increasing times.
+        //! @returns The index of the key before @time. @outNextKey is the same key before the first and after the last key.
+        AZ::u32 FindKeys(const float* times, AZ::u32 keyCount, float time, AZ::u32& outNextKey, float& outWeight)
+        {
+            outWeight = 0.0f;
+            if (keyCount == 1 || time <= times[0])
+            {
+                outNextKey = 0;
+                return 0;
+            }
+            if (time >= times[keyCount - 1])
+            {
+                outNextKey = keyCount - 1;
+                return keyCount - 1;
+            }
+            outNextKey = aznumeric_cast<AZ::u32>(AZStd::upper_bound(times, times + keyCount, time) - times);
+            const AZ::u32 key = outNextKey - 1;
+            outWeight = (time - times[key]) / (times[outNextKey] - times[key]);
+            return key;
+        }
+    } // namespace
+
+    AZ::Quaternion TransformTrackSet::DequantizeQuaternion(AZ::u16 first, AZ::u16 second, AZ::u16 third)
+    {
+        const AZ::u32 droppedIndex = ((first >> 15) << 1) | (second >> 15);
+        const float smallest[3] = { DecodeComponent(first), DecodeComponent(second), DecodeComponent(third) };
+        const float squaredLength = smallest[0] * smallest[0] + smallest[1] * smallest[1] + smallest[2] * smallest[2];
+
+        float components[4];
+        components[droppedIndex] = AZStd::sqrt(AZStd::max(0.0f, 1.0f - squaredLength));
+        for (AZ::u32 component = 0, smallestIndex = 0; component < 4; ++component)
+        {
+            if (component != droppedIndex)
+            {
+                components[component] = smallest[smallestIndex++];
+            }
+        }
+        return AZ::Quaternion(components[0], components[1], components[2], components[3]).GetNormalized();
+    }
+
+    AZ::Outcome<AZ::u32, AZStd::string> TransformTrackSet::AddTrack(const rapidjson::Value& trackValue, const TransformTrackPose& restPose)
+    {
+        if (!trackValue.IsObject())
+        {
+            return AZ::Failure(AZStd::string("A track must be an object"));
+        }
+
+        // Keep the arrays as they were if the track is invalid.
+        const size_t translationCount = m_translations.size();
+        const size_t rotationCount = m_rotations.size();
+        const size_t scaleCount = m_scales.size();
+        auto rollBack = [&]()
+        {
+            m_translationTimes.resize(translationCount);
+            m_translations.resize(translationCount);
+            m_rotationTimes.resize(rotationCount);
+            m_rotations.resize(rotationCount);
+            m_scaleTimes.resize(scaleCount);
+            m_scales.resize(scaleCount);
+        };
+
+        AZ::u32 keyCounts[3] = {};
+        AZ::Outcome<AZ::u32, AZStd::string> outcome = ReadChannel(
+            trackValue, "translate", 3, m_translationTimes,
+            [this](const rapidjson::Value& values, AZ::u32 firstValue)
+            {
+                return ReadVector3Key(values, firstValue, m_translations);
+            });
+        if (outcome.IsSuccess())
+        {
+            keyCounts[0] = outcome.GetValue();
+            outcome = ReadChannel(
+                trackValue, "rotate", 3, m_rotationTimes,
+                [this](const rapidjson::Value& values, AZ::u32 firstValue)
+                {
+                    return ReadQuaternionKey(values, firstValue, m_rotations);
+                });
+        }
+        if (outcome.IsSuccess())
+        {
+            keyCounts[1] = outcome.GetValue();
+            // Quantization makes the dropped component positive, which can flip the sign of consecutive keys.
+            // Keep them in the same hemisphere so the normalized lerp takes the short path.
+            for (size_t keyIndex = rotationCount + 1; keyIndex < m_rotations.size(); ++keyIndex)
+            {
+                if (m_rotations[keyIndex - 1].Dot(m_rotations[keyIndex]) < 0.0f)
+                {
+                    m_rotations[keyIndex] = -m_rotations[keyIndex];
+                }
+            }
+            outcome = ReadChannel(
+                trackValue, "scale", 3, m_scaleTimes,
+                [this](const rapidjson::Value& values, AZ::u32 firstValue)
+                {
+                    return ReadVector3Key(values, firstValue, m_scales);
+                });
+        }
+        if (!outcome.IsSuccess())
+        {
+            rollBack();
+            return AZ::Failure(outcome.TakeError());
+        }
+        keyCounts[2] = outcome.GetValue();
+
+        // A channel that is not animated gets a single key with the rest pose, so sampling doesn't need to branch.
+        Track track;
+        float lastTime = 0.0f;
+        auto addRange =
+            [&lastTime](KeyRange& range, AZ::u32 keyCount, size_t firstKey, AZStd::vector<float>& times, auto& keys, const auto& restValue)
+        {
+            range.m_firstKey = aznumeric_cast<AZ::u32>(firstKey);
+            range.m_keyCount = keyCount;
+            if (keyCount == 0)
+            {
+                range.m_keyCount = 1;
+                times.push_back(0.0f);
+                keys.push_back(restValue);
+            }
+            lastTime = AZStd::max(lastTime, times.back());
+        };
+        addRange(
+            track.m_translationKeys, keyCounts[0], translationCount, m_translationTimes, m_translations, restPose.m_translation);
+        addRange(track.m_rotationKeys, keyCounts[1], rotationCount, m_rotationTimes, m_rotations, restPose.m_rotation);
+        addRange(track.m_scaleKeys, keyCounts[2], scaleCount, m_scaleTimes, m_scales, restPose.m_scale);
+
+        track.m_duration = lastTime;
+        if (const auto durationIter = trackValue.FindMember("duration"); durationIter != trackValue.MemberEnd())
+        {
+            if (!durationIter->value.IsNumber() || durationIter->value.GetFloat() < 0.0f)
+            {
+                rollBack();
+                return AZ::Failure(AZStd::string("'duration' must be a positive number"));
+            }
+            track.m_duration = durationIter->value.GetFloat();
+        }
+
+        m_tracks.push_back(track);
+        return AZ::Success(aznumeric_cast<AZ::u32>(m_tracks.size() - 1));
+    }
+
+    AZ::u32 TransformTrackSet::GetTrackCount() const
+    {
+        return aznumeric_cast<AZ::u32>(m_tracks.size());
+    }
+
+    float TransformTrackSet::GetDuration(AZ::u32 trackIndex) const
+    {
+        return m_tracks[trackIndex].m_duration;
+    }
+
+    size_t TransformTrackSet::GetKeyCount() const
+    {
+        return m_translations.size() + m_rotations.size() + m_scales.size();
+    }
+
+    TransformTrackPose TransformTrackSet::Sample(AZ::u32 trackIndex, float time) const
+    {
+        const Track& track = m_tracks[trackIndex];
+        TransformTrackPose pose;
+        AZ::u32 nextKey = 0;
+        float weight = 0.0f;
+
+        const KeyRange& translationKeys = track.m_translationKeys;
+        AZ::u32 key = FindKeys(&m_translationTimes[translationKeys.m_firstKey], translationKeys.m_keyCount, time, nextKey, weight);
+        pose.m_translation =
+            m_translations[translationKeys.m_firstKey + key].Lerp(m_translations[translationKeys.m_firstKey + nextKey], weight);
+
+        const KeyRange& rotationKeys = track.m_rotationKeys;
+        key = FindKeys(&m_rotationTimes[rotationKeys.m_firstKey], rotationKeys.m_keyCount, time, nextKey, weight);
+        pose.m_rotation = m_rotations[rotationKeys.m_firstKey + key].NLerp(m_rotations[rotationKeys.m_firstKey + nextKey], weight);
+
+        const KeyRange& scaleKeys = track.m_scaleKeys;
+        key = FindKeys(&m_scaleTimes[scaleKeys.m_firstKey], scaleKeys.m_keyCount, time, nextKey, weight);
+        pose.m_scale = m_scales[scaleKeys.m_firstKey + key].Lerp(m_scales[scaleKeys.m_firstKey + nextKey], weight);
+        return pose;
+    }
+
+    void TransformTrackSet::SampleAll(float time, bool loop, AZStd::vector<TransformTrackPose>& outPoses) const
+    {
+        outPoses.resize(m_tracks.size());
+        for (AZ::u32 trackIndex = 0; trackIndex < m_tracks.size(); ++trackIndex)
+        {
+            const float duration = m_tracks[trackIndex].m_duration;
+            const float trackTime = (loop && duration > 0.0f) ? AZStd::fmod(AZStd::max(time, 0.0f), duration) : time;
+            outPoses[trackIndex] = Sample(trackIndex, trackTime);
+        }
+    }
+} // namespace o3dimport
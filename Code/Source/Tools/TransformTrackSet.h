@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/JSON/document.h>
+#include <AzCore/Math/Quaternion.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/Outcome/Outcome.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace o3dimport
+{
+    //! Local transform of a node at one point in time.
+    struct TransformTrackPose
+    {
+        AZ::Vector3 m_translation = AZ::Vector3::CreateZero();
+        AZ::Quaternion m_rotation = AZ::Quaternion::CreateIdentity();
+        AZ::Vector3 m_scale = AZ::Vector3::CreateOne();
+    };
+
+    //! The animated transforms of the nodes of a SceneGraph, as written by the o3dexport Blender AddOn in the
+    //! optional "track" property of a node (see BlenderAddOn/o3dexport/transform_track.py):
+    //!     "track": {
+    //!         "duration": 2.0,
+    //!         "translate": { "times": [0.0, 0.5, ...], "values": [x, y, z, ...] },
+    //!         "rotate":    { "times": [...], "values": [a, b, c, ...] },
+    //!         "scale":     { "times": [...], "values": [x, y, z, ...] }
+    //!     }
+    //! Times are in seconds. Rotations are quantized as the "smallest three" components of the quaternion.
+    //! Keys are linearly interpolated, rotations with normalized lerp.
+    //! The keys of all the tracks are stored in one contiguous array per channel, already decoded into the
+    //! SIMD math types, so sampling many tracks per frame is a search plus one lerp per channel.
+    class TransformTrackSet
+    {
+    public:
+        //! Components are stored as 15 bits in [-MaxSmallestComponent, MaxSmallestComponent]. The two bits that
+        //! say which component was dropped are the top bits of the first and second values.
+        static constexpr float MaxSmallestComponent = 0.70710678f;
+        static constexpr AZ::u32 MaxQuantizedComponent = 0x7FFF;
+
+        static AZ::Quaternion DequantizeQuaternion(AZ::u16 first, AZ::u16 second, AZ::u16 third);
+
+        //! Reads the "track" property of a node.
+        //! @param restPose Value of the channels that the track doesn't animate.
+        //! @returns The index of the new track.
+        AZ::Outcome<AZ::u32, AZStd::string> AddTrack(const rapidjson::Value& trackValue, const TransformTrackPose& restPose);
+
+        AZ::u32 GetTrackCount() const;
+        float GetDuration(AZ::u32 trackIndex) const;
+        //! Keys of all the channels of all the tracks.
+        size_t GetKeyCount() const;
+
+        TransformTrackPose Sample(AZ::u32 trackIndex, float time) const;
+        //! Samples all the tracks at the same @time.
+        //! @param loop If true, each track wraps around at its own duration. Otherwise it holds its last key.
+        //! @param outPoses Resized to GetTrackCount().
+        void SampleAll(float time, bool loop, AZStd::vector<TransformTrackPose>& outPoses) const;
+
+    private:
+        struct KeyRange
+        {
+            AZ::u32 m_firstKey = 0;
+            AZ::u32 m_keyCount = 0;
+        };
+
+        struct Track
+        {
+            KeyRange m_translationKeys;
+            KeyRange m_rotationKeys;
+            KeyRange m_scaleKeys;
+            float m_duration = 0.0f;
+        };
+
+        AZStd::vector<Track> m_tracks;
+        AZStd::vector<float> m_translationTimes;
+        AZStd::vector<AZ::Vector3> m_translations;
+        AZStd::vector<float> m_rotationTimes;
+        AZStd::vector<AZ::Quaternion> m_rotations;
+        AZStd::vector<float> m_scaleTimes;
+        AZStd::vector<AZ::Vector3> m_scales;
+    };
+} // namespace o3dimport
@@ -2,7 +2,6 @@
 #include <o3dimport/o3dimportTypeIds.h>
 #include <o3dimportModuleInterface.h>
 #include "o3dimportEditorSystemComponent.h"
-#include <AzToolsFramework/API/PythonLoader.h>
 
 #include <QtGlobal>
 
@@ -16,7 +15,6 @@ namespace o3dimport
 {
     class o3dimportEditorModule
         : public o3dimportModuleInterface
-        , public AzToolsFramework::EmbeddedPython::PythonLoader
     {
     public:
         AZ_RTTI(o3dimportEditorModule, o3dimportEditorModuleTypeId, o3dimportModuleInterface);
@@ -1,9 +1,25 @@
 
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/RTTI/BehaviorContext.h>
 #include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzCore/std/chrono/chrono.h>
 #include "o3dimportEditorSystemComponent.h"
+#include "HlodProxyBuilder.h"
+#include "MaterialGenerator.h"
+#include "OrphanedAssetCollector.h"
+#include "o3dimportPaneWidget.h"
+#include "SceneGraph.h"
+#include "SceneGraphEntityBuilder.h"
+#include "SceneGraphModelFile.h"
+#include "SceneGraphVerifier.h"
+#include "SceneMemoryReport.h"
 
 #include <o3dimport/o3dimportTypeIds.h>
 
+#include <AzToolsFramework/API/ViewPaneOptions.h>
+
 namespace o3dimport
 {
     AZ_COMPONENT_IMPL(o3dimportEditorSystemComponent, "o3dimportEditorSystemComponent",
@@ -15,6 +31,28 @@ namespace o3dimport
         {
             serializeContext->Class<o3dimportEditorSystemComponent, AZ::Component>();
         }
+
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->EBus<o3dimportRequestBus>("o3dimportRequestBus")
+                ->Attribute(AZ::Script::Attributes::Scope, AZ::Script::Attributes::ScopeFlags::Automation)
+                ->Attribute(AZ::Script::Attributes::Module, "o3dimport")
+                ->Event("ShowSceneGraphPreview", &o3dimportRequests::ShowSceneGraphPreview)
+                ->Event("AttachSceneGraphPreviewNode", &o3dimportRequests::AttachSceneGraphPreviewNode)
+                ->Event("ClearSceneGraphPreview", &o3dimportRequests::ClearSceneGraphPreview)
+                ->Event("RegisterLazyModelAsset", &o3dimportRequests::RegisterLazyModelAsset)
+                ->Event("RegisterLazyMaterialAsset", &o3dimportRequests::RegisterLazyMaterialAsset)
+                ->Event("MaterializeLazyAssets", &o3dimportRequests::MaterializeLazyAssets)
+                ->Event("GetLazyAssetCount", &o3dimportRequests::GetLazyAssetCount)
+                ->Event("BuildSceneGraphEntities", &o3dimportRequests::BuildSceneGraphEntities)
+                ->Event("ExportSceneGraphModel", &o3dimportRequests::ExportSceneGraphModel)
+                ->Event("VerifySceneGraphEntities", &o3dimportRequests::VerifySceneGraphEntities)
+                ->Event("ReportSceneMemory", &o3dimportRequests::ReportSceneMemory)
+                ->Event("FindSceneAssetReferences", &o3dimportRequests::FindSceneAssetReferences)
+                ->Event("CollectOrphanedSceneAssets", &o3dimportRequests::CollectOrphanedSceneAssets)
+                ->Event("BuildSceneHlodProxies", &o3dimportRequests::BuildSceneHlodProxies)
+                ->Event("GenerateSceneMaterials", &o3dimportRequests::GenerateSceneMaterials);
+        }
     }
 
     o3dimportEditorSystemComponent::o3dimportEditorSystemComponent()
@@ -54,11 +92,205 @@ namespace o3dimport
     void o3dimportEditorSystemComponent::Activate()
     {
         o3dimportRequestBus::Handler::BusConnect();
+        AzToolsFramework::EditorEvents::Bus::Handler::BusConnect();
+        m_lazyAssetAssigner.Activate();
+        m_sceneGraphWatcher.Activate();
     }
 
     void o3dimportEditorSystemComponent::Deactivate()
     {
+        m_sceneGraphWatcher.Deactivate();
+        m_lazyAssetAssigner.Deactivate();
+        m_sceneGraphPreview.Clear();
+        AzToolsFramework::UnregisterViewPane(o3dimportPaneWidget::PaneName);
+        AzToolsFramework::EditorEvents::Bus::Handler::BusDisconnect();
         o3dimportRequestBus::Handler::BusDisconnect();
     }
 
+    void o3dimportEditorSystemComponent::NotifyRegisterViews()
+    {
+        AzToolsFramework::ViewPaneOptions options;
+        options.showOnToolsToolbar = true;
+        options.toolbarIcon = ":/o3dimport/toolbar_icon.svg";
+        AzToolsFramework::RegisterViewPane<o3dimportPaneWidget>(o3dimportPaneWidget::PaneName, o3dimportPaneWidget::PaneCategory, options);
+    }
+
+    bool o3dimportEditorSystemComponent::ShowSceneGraphPreview(const AZStd::string& sceneGraphFilePath)
+    {
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            m_sceneGraphPreview.Clear();
+            return false;
+        }
+        m_sceneGraphPreview.Show(loadOutcome.GetValue());
+        return true;
+    }
+
+    void o3dimportEditorSystemComponent::AttachSceneGraphPreviewNode(const AZStd::string& nodePath, const AZ::EntityId& entityId)
+    {
+        m_sceneGraphPreview.AttachNode(nodePath, entityId);
+    }
+
+    void o3dimportEditorSystemComponent::ClearSceneGraphPreview()
+    {
+        m_sceneGraphPreview.Clear();
+    }
+
+    bool o3dimportEditorSystemComponent::RegisterLazyModelAsset(const AZ::EntityId& entityId, const AZ::Data::AssetId& modelAssetId)
+    {
+        return m_lazyAssetAssigner.RegisterModelAsset(entityId, modelAssetId);
+    }
+
+    void o3dimportEditorSystemComponent::RegisterLazyMaterialAsset(
+        const AZ::EntityId& entityId, const AZStd::string& slotLabel, const AZ::Data::AssetId& materialAssetId)
+    {
+        m_lazyAssetAssigner.RegisterMaterialAsset(entityId, slotLabel, materialAssetId);
+    }
+
+    AZ::u32 o3dimportEditorSystemComponent::MaterializeLazyAssets()
+    {
+        return m_lazyAssetAssigner.MaterializeAll();
+    }
+
+    AZ::u32 o3dimportEditorSystemComponent::GetLazyAssetCount()
+    {
+        return m_lazyAssetAssigner.GetRegisteredCount();
+    }
+
+    AZStd::vector<AZ::EntityId> o3dimportEditorSystemComponent::BuildSceneGraphEntities(
+        const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder)
+    {
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            return {};
+        }
+        auto buildOutcome = SceneGraphEntityBuilder::Build(loadOutcome.GetValue(), meshProductFolder);
+        if (!buildOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", buildOutcome.GetError().c_str());
+            return {};
+        }
+        return buildOutcome.TakeValue();
+    }
+
+    bool o3dimportEditorSystemComponent::ExportSceneGraphModel(const AZStd::string& sceneGraphFilePath, const AZStd::string& modelFilePath)
+    {
+        auto exportOutcome = SceneGraphModelFile::Export(sceneGraphFilePath, modelFilePath);
+        if (!exportOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", exportOutcome.GetError().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::VerifySceneGraphEntities(
+        const AZStd::string& sceneGraphFilePath,
+        const AZStd::string& meshProductFolder,
+        const AZStd::string& materialProductFolder,
+        float tolerance,
+        float angleToleranceDegrees)
+    {
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            return {};
+        }
+        SceneGraphVerificationSettings settings;
+        settings.m_meshProductFolder = meshProductFolder;
+        settings.m_materialProductFolder = materialProductFolder;
+        settings.m_tolerance = tolerance;
+        settings.m_angleToleranceDegrees = angleToleranceDegrees;
+        return SceneGraphVerifier::Verify(loadOutcome.GetValue(), settings);
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::ReportSceneMemory(
+        const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, AZ::u32 maxDepth)
+    {
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            return {};
+        }
+        // The asset cache stores the products in lower case.
+        AZStd::string productFolder = meshProductFolder;
+        AZStd::to_lower(productFolder.begin(), productFolder.end());
+        AZ::IO::FixedMaxPath absoluteProductFolder;
+        AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (!fileIO || !fileIO->ResolvePath(absoluteProductFolder, AZ::IO::FixedMaxPath("@products@") / productFolder))
+        {
+            AZ_Error("o3dimport", false, "Failed to resolve the mesh product folder '%s' in the asset cache", meshProductFolder.c_str());
+            return {};
+        }
+        const AZ::IO::Path sceneFolder = AZ::IO::Path(sceneGraphFilePath).ParentPath();
+        return SceneMemoryReport::Generate(loadOutcome.GetValue(), sceneFolder.Native(), absoluteProductFolder.String(), maxDepth);
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::FindSceneAssetReferences(
+        const AZStd::string& scenesFolder, const AZStd::string& indexFilePath, const AZStd::string& productPath)
+    {
+        const auto startTime = AZStd::chrono::steady_clock::now();
+        const AZ::u32 parsedCount = m_sceneAssetIndex.Update(scenesFolder, AZ::Utils::GetProjectPath(), indexFilePath);
+        const auto references = m_sceneAssetIndex.FindReferences(productPath);
+        const auto elapsedTime = AZStd::chrono::duration<double, AZStd::milli>(AZStd::chrono::steady_clock::now() - startTime);
+
+        size_t sceneCount = 0;
+        AZStd::string lines;
+        for (size_t referenceIndex = 0; referenceIndex < references.size(); ++referenceIndex)
+        {
+            const auto& [sceneName, nodePath] = references[referenceIndex];
+            if (referenceIndex == 0 || references[referenceIndex - 1].first != sceneName)
+            {
+                ++sceneCount;
+            }
+            lines += AZStd::string::format("    %s: %s\n", sceneName.c_str(), nodePath.c_str());
+        }
+        return AZStd::string::format(
+            "'%s' is referenced by %zu node(s) in %zu scene(s). Indexed %zu scene(s), parsed %u, in %.1f ms.\n",
+            SceneAssetIndex::NormalizeProductPath(productPath).c_str(), references.size(), sceneCount,
+            m_sceneAssetIndex.GetSceneCount(), parsedCount, elapsedTime.count()) + lines;
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::CollectOrphanedSceneAssets(const AZStd::string& sceneGraphFilePath, bool removeFiles)
+    {
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            return {};
+        }
+        const AZ::IO::Path sceneFolder = AZ::IO::Path(sceneGraphFilePath).ParentPath();
+        return OrphanedAssetCollector::Collect(loadOutcome.GetValue(), sceneFolder.Native(), removeFiles);
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::BuildSceneHlodProxies(
+        const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, float cellSize, float maxError)
+    {
+        if (cellSize <= 0.0f)
+        {
+            AZ_Error("o3dimport", false, "The HLOD cell size must be positive, got %f", cellSize);
+            return {};
+        }
+        auto loadOutcome = SceneGraph::LoadFromFile(sceneGraphFilePath);
+        if (!loadOutcome.IsSuccess())
+        {
+            AZ_Error("o3dimport", false, "%s", loadOutcome.GetError().c_str());
+            return {};
+        }
+        const AZ::IO::Path sceneFolder = AZ::IO::Path(sceneGraphFilePath).ParentPath();
+        return HlodProxyBuilder::Build(loadOutcome.GetValue(), sceneFolder.Native(), meshProductFolder, cellSize, maxError);
+    }
+
+    AZStd::string o3dimportEditorSystemComponent::GenerateSceneMaterials(
+        const AZStd::string& materialDescriptionsFilePath, const AZStd::string& materialsFolder)
+    {
+        return MaterialGenerator::Generate(materialDescriptionsFilePath, materialsFolder);
+    }
+
 } // namespace o3dimport
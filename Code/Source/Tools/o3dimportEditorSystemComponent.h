@@ -1,14 +1,21 @@
 
 #pragma once
 #include <AzCore/Component/Component.h>
+#include <AzToolsFramework/API/ToolsApplicationAPI.h>
 #include <o3dimport/o3dimportBus.h>
 
+#include "LazyAssetAssigner.h"
+#include "SceneAssetIndex.h"
+#include "SceneGraphPreview.h"
+#include "SceneGraphWatcher.h"
+
 
 namespace o3dimport
 {
     /// System component for o3dimport editor
     class o3dimportEditorSystemComponent
         : public o3dimportRequestBus::Handler
+        , public AzToolsFramework::EditorEvents::Bus::Handler
         , public AZ::Component
     {
     public:
@@ -28,5 +35,41 @@ namespace o3dimport
         // AZ::Component
         void Activate() override;
         void Deactivate() override;
+
+        // AzToolsFramework::EditorEvents
+        void NotifyRegisterViews() override;
+
+        // o3dimportRequestBus
+        bool ShowSceneGraphPreview(const AZStd::string& sceneGraphFilePath) override;
+        void AttachSceneGraphPreviewNode(const AZStd::string& nodePath, const AZ::EntityId& entityId) override;
+        void ClearSceneGraphPreview() override;
+        bool RegisterLazyModelAsset(const AZ::EntityId& entityId, const AZ::Data::AssetId& modelAssetId) override;
+        void RegisterLazyMaterialAsset(
+            const AZ::EntityId& entityId, const AZStd::string& slotLabel, const AZ::Data::AssetId& materialAssetId) override;
+        AZ::u32 MaterializeLazyAssets() override;
+        AZ::u32 GetLazyAssetCount() override;
+        AZStd::vector<AZ::EntityId> BuildSceneGraphEntities(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder) override;
+        bool ExportSceneGraphModel(const AZStd::string& sceneGraphFilePath, const AZStd::string& modelFilePath) override;
+        AZStd::string VerifySceneGraphEntities(
+            const AZStd::string& sceneGraphFilePath,
+            const AZStd::string& meshProductFolder,
+            const AZStd::string& materialProductFolder,
+            float tolerance,
+            float angleToleranceDegrees) override;
+        AZStd::string ReportSceneMemory(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, AZ::u32 maxDepth) override;
+        AZStd::string FindSceneAssetReferences(
+            const AZStd::string& scenesFolder, const AZStd::string& indexFilePath, const AZStd::string& productPath) override;
+        AZStd::string CollectOrphanedSceneAssets(const AZStd::string& sceneGraphFilePath, bool removeFiles) override;
+        AZStd::string BuildSceneHlodProxies(
+            const AZStd::string& sceneGraphFilePath, const AZStd::string& meshProductFolder, float cellSize, float maxError) override;
+        AZStd::string GenerateSceneMaterials(
+            const AZStd::string& materialDescriptionsFilePath, const AZStd::string& materialsFolder) override;
+
+        SceneGraphPreview m_sceneGraphPreview;
+        LazyAssetAssigner m_lazyAssetAssigner;
+        SceneGraphWatcher m_sceneGraphWatcher;
+        SceneAssetIndex m_sceneAssetIndex;
     };
 } // namespace o3dimport
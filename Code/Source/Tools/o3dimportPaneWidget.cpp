@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "o3dimportPaneWidget.h"
+
+#include <AzCore/std/string/string.h>
+#include <AzToolsFramework/API/EditorPythonRunnerRequestsBus.h>
+
+#include <QLabel>
+#include <QShowEvent>
+#include <QVBoxLayout>
+
+namespace o3dimport
+{
+    o3dimportPaneWidget::o3dimportPaneWidget(QWidget* parent)
+        : QWidget(parent)
+    {
+        auto* layout = new QVBoxLayout(this);
+        layout->setContentsMargins(0, 0, 0, 0);
+    }
+
+    void o3dimportPaneWidget::showEvent(QShowEvent* event)
+    {
+        QWidget::showEvent(event);
+        if (!m_isPythonToolLoaded)
+        {
+            m_isPythonToolLoaded = true;
+            LoadPythonTool();
+        }
+    }
+
+    void o3dimportPaneWidget::LoadPythonTool()
+    {
+        if (!AzToolsFramework::EditorPythonRunnerRequestBus::HasHandlers())
+        {
+            layout()->addWidget(new QLabel("The o3dimport tool requires the EditorPythonBindings Gem.", this));
+            return;
+        }
+        // The python side wraps this widget by address, and adds the tool to its layout.
+        const AZStd::string script = AZStd::string::format(
+            "import o3dimport_dialog\no3dimport_dialog.AttachToPane(%llu)\n", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(this)));
+        AzToolsFramework::EditorPythonRunnerRequestBus::Broadcast(
+            &AzToolsFramework::EditorPythonRunnerRequestBus::Events::ExecuteByString, script, false);
+    }
+} // namespace o3dimport
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <QWidget>
+
+class QShowEvent;
+
+namespace o3dimport
+{
+    //! The view pane of the o3dimport tool, registered natively so the Editor doesn't import python or PySide at startup.
+    //! It's an empty placeholder until it's shown for the first time, then Editor/Scripts/o3dimport_dialog.py
+    //! is imported and fills it with the tool.
+    class o3dimportPaneWidget
+        : public QWidget
+    {
+    public:
+        static constexpr const char* PaneName = "o3dimport";
+        static constexpr const char* PaneCategory = "Examples";
+
+        explicit o3dimportPaneWidget(QWidget* parent = nullptr);
+
+    protected:
+        void showEvent(QShowEvent* event) override;
+
+    private:
+        void LoadPythonTool();
+
+        bool m_isPythonToolLoaded = false;
+    };
+} // namespace o3dimport
@@ -0,0 +1,710 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# In-process stand-ins for the parts of the Editor that o3dimport.py talks to:
+# the azlmbr buses (entity creation, transform, asset catalog, mesh/material components,
+# undo batches, level save, o3dimport SceneGraph preview, lazy assets and native entity building) and editor_python_test_tools.editor_entity_utils.
+# They allow running the importer with plain python, outside of the Editor.
+#
+# Every call is recorded by name, and each one advances a virtual clock by a configurable
+# simulated latency. Because nothing really sleeps, measured durations and call counts are
+# deterministic and independent of the machine running the tests.
+
+import hashlib
+import itertools
+import json
+import math
+import os
+import struct
+import sys
+import types
+import zlib
+from collections import Counter
+
+# Simulated cost of each call, in seconds. Calls not listed here cost DEFAULT_LATENCY.
+DEFAULT_LATENCY = 0.00005
+DEFAULT_LATENCIES = {
+    "AssetCatalogRequestBus.GetAssetIdByPath": 0.0002,
+    "EditorEntity.find_editor_entities": 0.002,
+    "EditorEntity.create_editor_entity": 0.001,
+    "EditorEntity.add_component": 0.0005,
+    "EditorComponent.set_component_property_value": 0.0005,
+    "MaterialComponentRequestBus.FindMaterialAssignmentId": 0.0001,
+    "TransformBus.SetLocalTM": 0.00005,
+    "general.save_level": 0.05,
+}
+FRAME_TIME = 1.0 / 60.0
+
+MODEL_ASSET_PROPERTY = "Controller|Configuration|Model Asset"
+
+
+class HeadlessEditor:
+    """
+    Owns the state of the simulated Editor and the call recorder.
+    Call Install() before importing o3dimport.py.
+    """
+
+    def __init__(self, projectRoot: str, productsRoot: str, latencies: dict = None):
+        self.projectRoot = projectRoot
+        self.productsRoot = productsRoot
+        self.latencies = dict(DEFAULT_LATENCIES)
+        if latencies:
+            self.latencies.update(latencies)
+        self.calls = Counter()
+        self.callLog = []
+        self.isCallLogEnabled = False
+        self.virtualTime = 0.0
+        # key: entity id (int), value: _EntityState
+        self.entities = {}
+        self._nextEntityId = 1
+        # key: normalized product path, value: AssetId
+        self._products = {}
+        # key: AssetId string, value: list of material slot labels.
+        self._modelSlotLabels = {}
+        self.levelName = "HeadlessLevel"
+        self.levelPath = os.path.join(projectRoot, "Levels", self.levelName)
+        self.viewPosition = (0.0, 0.0, 0.0)
+        self.saveCount = 0
+        # SceneGraph file path of each ShowSceneGraphPreview request.
+        self.previewRequests = []
+        # Arguments of each AttachSceneGraphPreviewNode request: (node path, EntityId).
+        self.previewNodeRequests = []
+        # Number of ClearSceneGraphPreview requests.
+        self.previewClearCount = 0
+        # Arguments of each RegisterLazyModelAsset request: (EntityId, model AssetId).
+        self.lazyModelRequests = []
+        # Arguments of each RegisterLazyMaterialAsset request: (EntityId, slot label, material AssetId).
+        self.lazyMaterialRequests = []
+        # Number of MaterializeLazyAssets requests.
+        self.materializeCount = 0
+        # Arguments of each ExportSceneGraphModel request: (SceneGraph file path, model file path).
+        self.modelExportRequests = []
+        # Arguments of each VerifySceneGraphEntities request:
+        # (SceneGraph file path, mesh product folder, material product folder, tolerance, angle tolerance in degrees).
+        self.verifyRequests = []
+        # Arguments of each ReportSceneMemory request: (SceneGraph file path, mesh product folder, max depth).
+        self.memoryReportRequests = []
+        # Arguments of each BuildSceneHlodProxies request: (SceneGraph file path, mesh product folder, cell size, max error).
+        self.hlodRequests = []
+        # Arguments of each CollectOrphanedSceneAssets request: (SceneGraph file path, remove files).
+        self.orphanRequests = []
+        # Arguments of each FindSceneAssetReferences request: (scenes folder, index file path, product path).
+        self.sceneAssetReferenceRequests = []
+        # Arguments of each GenerateSceneMaterials request: (material descriptions file path, materials folder).
+        self.materialGenerationRequests = []
+        # Names of the .material files that GenerateSceneMaterials writes, empty ones.
+        self.generatedMaterialNames = []
+        # Arguments of each BuildSceneGraphEntities request: (SceneGraph file path, mesh product folder).
+        self.nativeBuildRequests = []
+        # What BuildSceneGraphEntities returns: one EntityId per node, invalid for the entities that already existed.
+        self.builtEntityIds = []
+
+    ###########################################################################
+    # Test setup helpers
+    ###########################################################################
+    @staticmethod
+    def _NormalizeProductPath(productPath: str) -> str:
+        return productPath.replace("\\", "/").lower()
+
+    def RegisterProduct(self, productPath: str, slotLabels: list = None) -> "AssetId":
+        """
+        Adds a product to the simulated asset catalog, and creates its product file in the cache.
+        @param slotLabels For models, the labels of its material slots.
+        """
+        normalizedPath = HeadlessEditor._NormalizeProductPath(productPath)
+        digest = hashlib.md5(normalizedPath.encode("utf-8")).hexdigest().upper()
+        guid = f"{{{digest[0:8]}-{digest[8:12]}-{digest[12:16]}-{digest[16:20]}-{digest[20:32]}}}"
+        assetId = AssetId(guid, 0)
+        self._products[normalizedPath] = assetId
+        if slotLabels is not None:
+            self._modelSlotLabels[assetId.to_string()] = list(slotLabels)
+        productFilePath = os.path.join(self.productsRoot, normalizedPath)
+        os.makedirs(os.path.dirname(productFilePath), exist_ok=True)
+        with open(productFilePath, "w") as f:
+            f.write(normalizedPath)
+        return assetId
+
+    def CreateEntity(self, name: str, parentId: "EntityId" = None, componentNames: tuple = ()) -> "EntityId":
+        """
+        Adds an entity to the level without recording any call, e.g. the entities that BuildSceneGraphEntities would build.
+        @returns The id of the entity. Its components are empty, the test sets their properties.
+        """
+        entityId = EntityId(self._nextEntityId)
+        self._nextEntityId += 1
+        state = _EntityState(entityId, name, parentId if parentId else EntityId())
+        for componentName in componentNames:
+            state.components[componentName] = EditorComponent(entityId, componentName)
+        self.entities[entityId.value] = state
+        return entityId
+
+    def FindEntitiesByName(self, name: str) -> list:
+        return [entity for entity in self.entities.values() if entity.name == name]
+
+    def GetLevelFilePath(self) -> str:
+        return os.path.join(self.levelPath, f"{self.levelName}.prefab")
+
+    def ResetRecorder(self):
+        self.calls.clear()
+        self.callLog.clear()
+        self.virtualTime = 0.0
+
+    ###########################################################################
+    # Recorder
+    ###########################################################################
+    def Record(self, callName: str, *args):
+        self.calls[callName] += 1
+        self.virtualTime += self.latencies.get(callName, DEFAULT_LATENCY)
+        if self.isCallLogEnabled:
+            self.callLog.append((callName, args))
+
+    def Report(self, top: int = 10) -> str:
+        lines = [f"Virtual time: {self.virtualTime:.3f} seconds. Total calls: {sum(self.calls.values())}"]
+        for callName, count in self.calls.most_common(top):
+            lines.append(f"    {callName}: {count}")
+        return "\n".join(lines)
+
+    ###########################################################################
+    # Module installation
+    ###########################################################################
+    def Install(self):
+        """
+        Registers the stand-in modules in sys.modules, replacing any previously installed HeadlessEditor.
+        """
+        global _activeEditor
+        _activeEditor = self
+        modules = _BuildModules(self)
+        for moduleName, module in modules.items():
+            sys.modules[moduleName] = module
+
+
+# The HeadlessEditor that the stand-in modules forward to.
+_activeEditor: HeadlessEditor = None
+
+
+###############################################################################
+# azlmbr.entity / azlmbr.asset / azlmbr.math value types
+###############################################################################
+class EntityId:
+    def __init__(self, value: int = 0):
+        self.value = value
+
+    def is_valid(self) -> bool:
+        return self.value != 0
+
+    def __eq__(self, other) -> bool:
+        return isinstance(other, EntityId) and other.value == self.value
+
+    def __hash__(self) -> int:
+        return hash(self.value)
+
+    def __repr__(self) -> str:
+        return f"[{self.value}]"
+
+
+class AssetId:
+    def __init__(self, guid: str = "", subId: int = 0):
+        self.guid = guid
+        self.subId = subId
+
+    def is_valid(self) -> bool:
+        return self.guid != ""
+
+    def is_equal(self, other) -> bool:
+        return self.guid == other.guid and self.subId == other.subId
+
+    def to_string(self) -> str:
+        return f"{self.guid}:{self.subId:x}"
+
+    def __repr__(self) -> str:
+        return self.to_string()
+
+
+def AssetId_CreateString(assetIdStr: str) -> AssetId:
+    guid, subId = assetIdStr.split(":")
+    return AssetId(guid, int(subId, 16))
+
+
+class Uuid:
+    pass
+
+
+class Vector3:
+    def __init__(self, x: float = 0.0, y: float = 0.0, z: float = 0.0):
+        self.x = x
+        self.y = y
+        self.z = z
+
+    def IsClose(self, other, tolerance: float = 0.001) -> bool:
+        return (
+            abs(self.x - other.x) <= tolerance
+            and abs(self.y - other.y) <= tolerance
+            and abs(self.z - other.z) <= tolerance
+        )
+
+
+class Quaternion:
+    def __init__(self, x: float = 0.0, y: float = 0.0, z: float = 0.0, w: float = 1.0):
+        self.x = x
+        self.y = y
+        self.z = z
+        self.w = w
+
+    def MultiplyQuaternion(self, rhs):
+        return Quaternion(
+            self.w * rhs.x + self.x * rhs.w + self.y * rhs.z - self.z * rhs.y,
+            self.w * rhs.y - self.x * rhs.z + self.y * rhs.w + self.z * rhs.x,
+            self.w * rhs.z + self.x * rhs.y - self.y * rhs.x + self.z * rhs.w,
+            self.w * rhs.w - self.x * rhs.x - self.y * rhs.y - self.z * rhs.z,
+        )
+
+
+def _QuaternionFromAxisAngle(axisIndex: int, radians: float) -> Quaternion:
+    components = [0.0, 0.0, 0.0]
+    components[axisIndex] = math.sin(radians * 0.5)
+    return Quaternion(components[0], components[1], components[2], math.cos(radians * 0.5))
+
+
+class Transform:
+    def __init__(self, rotation: Quaternion, translation: Vector3):
+        self.rotation = rotation
+        self.translation = translation
+        self.uniformScale = 1.0
+
+    def SetUniformScale(self, scale: float):
+        self.uniformScale = scale
+
+
+class MaterialAssignmentId:
+    def __init__(self, materialSlotStableId: int):
+        self.materialSlotStableId = materialSlotStableId
+
+
+def _GetSlotStableId(label: str) -> int:
+    return zlib.crc32(label.encode("utf-8"))
+
+
+###############################################################################
+# Editor entities and components
+###############################################################################
+class _EntityState:
+    def __init__(self, entityId: EntityId, name: str, parentId: EntityId):
+        self.id = entityId
+        self.name = name
+        self.parentId = parentId
+        self.localTM = None
+        self.nonUniformScale = None
+        # key: component name, value: EditorComponent
+        self.components = {}
+
+
+class _ComponentId:
+    def __init__(self, entityId: EntityId):
+        self._entityId = entityId
+
+    def get_entity_id(self) -> EntityId:
+        return self._entityId
+
+
+class EditorComponent:
+    def __init__(self, entityId: EntityId, componentName: str):
+        self.id = _ComponentId(entityId)
+        self.componentName = componentName
+        # key: property path, value: property value.
+        self.properties = {}
+
+    def _GetSlotLabels(self) -> list:
+        meshComponent = _activeEditor.entities[self.id.get_entity_id().value].components.get("Mesh", None)
+        if meshComponent is None:
+            return []
+        modelAssetId = meshComponent.properties.get(MODEL_ASSET_PROPERTY, None)
+        if modelAssetId is None:
+            return []
+        return _activeEditor._modelSlotLabels.get(modelAssetId.to_string(), [])
+
+    def _HasProperty(self, propertyPath: str) -> bool:
+        if self.componentName == "Mesh":
+            return propertyPath == MODEL_ASSET_PROPERTY
+        if self.componentName == "Material" and propertyPath.startswith("Model Materials|["):
+            slotIndex = int(propertyPath[len("Model Materials|["):].split("]", 1)[0])
+            return slotIndex < len(self._GetSlotLabels())
+        return False
+
+    def get_property_type_visibility(self) -> dict:
+        _activeEditor.Record("EditorComponent.get_property_type_visibility")
+        return {}
+
+    def check_component_property_value(self, propertyPath: str):
+        _activeEditor.Record("EditorComponent.check_component_property_value", propertyPath)
+        return (self._HasProperty(propertyPath), None)
+
+    def get_component_property_value(self, propertyPath: str):
+        _activeEditor.Record("EditorComponent.get_component_property_value", propertyPath)
+        if not self._HasProperty(propertyPath):
+            raise Exception(f"Property '{propertyPath}' doesn't exist in component '{self.componentName}'")
+        if propertyPath.endswith("|Material Slot Stable Id"):
+            slotIndex = int(propertyPath[len("Model Materials|["):].split("]", 1)[0])
+            return _GetSlotStableId(self._GetSlotLabels()[slotIndex])
+        return self.properties.get(propertyPath, AssetId())
+
+    def set_component_property_value(self, propertyPath: str, value):
+        _activeEditor.Record("EditorComponent.set_component_property_value", self.id.get_entity_id(), propertyPath)
+        if not self._HasProperty(propertyPath):
+            raise Exception(f"Property '{propertyPath}' doesn't exist in component '{self.componentName}'")
+        self.properties[propertyPath] = value
+
+
+class EditorEntity:
+    def __init__(self, entityId: EntityId):
+        self.id = entityId
+
+    def _GetState(self) -> _EntityState:
+        return _activeEditor.entities[self.id.value]
+
+    @classmethod
+    def find_editor_entities(cls, entityNames: list) -> list:
+        _activeEditor.Record("EditorEntity.find_editor_entities", entityNames)
+        return [
+            EditorEntity(entity.id)
+            for entity in _activeEditor.entities.values()
+            if entity.name in entityNames
+        ]
+
+    @classmethod
+    def create_editor_entity(cls, name: str, parentId: EntityId = None):
+        _activeEditor.Record("EditorEntity.create_editor_entity", name)
+        entityId = EntityId(_activeEditor._nextEntityId)
+        _activeEditor._nextEntityId += 1
+        _activeEditor.entities[entityId.value] = _EntityState(entityId, name, parentId if parentId else EntityId())
+        return EditorEntity(entityId)
+
+    def has_component(self, componentName: str) -> bool:
+        _activeEditor.Record("EditorEntity.has_component", componentName)
+        return componentName in self._GetState().components
+
+    def add_component(self, componentName: str) -> EditorComponent:
+        _activeEditor.Record("EditorEntity.add_component", componentName)
+        component = EditorComponent(self.id, componentName)
+        self._GetState().components[componentName] = component
+        return component
+
+    def get_components_of_type(self, componentNames: list) -> list:
+        _activeEditor.Record("EditorEntity.get_components_of_type", componentNames)
+        components = self._GetState().components
+        return [components[name] for name in componentNames if name in components]
+
+
+###############################################################################
+# Buses
+###############################################################################
+def _MakeBus(busName: str, handlers: dict):
+    """
+    Returns a callable with the same calling convention as the azlmbr buses:
+        bus(azbus.Broadcast or azbus.Event, "EventName", *args)
+    """
+
+    def Bus(busType, eventName: str, *args):
+        callName = f"{busName}.{eventName}"
+        _activeEditor.Record(callName, *args)
+        if eventName not in handlers:
+            raise Exception(f"The headless editor doesn't implement '{callName}'")
+        return handlers[eventName](*args)
+
+    Bus.__name__ = busName
+    return Bus
+
+
+def _GetAssetIdByPath(productPath: str, *args) -> AssetId:
+    return _activeEditor._products.get(HeadlessEditor._NormalizeProductPath(productPath), AssetId())
+
+
+def _SetLocalTM(entityId: EntityId, localTM: Transform):
+    _activeEditor.entities[entityId.value].localTM = localTM
+
+
+def _FindMaterialAssignmentId(entityId: EntityId, lod: int, label: str) -> MaterialAssignmentId:
+    return MaterialAssignmentId(_GetSlotStableId(label))
+
+
+def _AddNonUniformScaleComponent(entityId: EntityId, scale: Vector3):
+    _activeEditor.Record("editor.AddNonUniformScaleComponent", entityId)
+    _activeEditor.entities[entityId.value].nonUniformScale = scale
+
+
+def _IdleWait(seconds: float):
+    _activeEditor.Record("general.idle_wait", seconds)
+    _activeEditor.virtualTime += seconds
+
+
+def _IdleWaitFrames(frameCount: int):
+    _activeEditor.Record("general.idle_wait_frames", frameCount)
+    _activeEditor.virtualTime += frameCount * FRAME_TIME
+
+
+def _SaveLevel():
+    _activeEditor.Record("general.save_level")
+    _activeEditor.saveCount += 1
+    levelFilePath = _activeEditor.GetLevelFilePath()
+    os.makedirs(os.path.dirname(levelFilePath), exist_ok=True)
+    with open(levelFilePath, "a") as f:
+        f.write(f"save {_activeEditor.saveCount}: {len(_activeEditor.entities)} entities\n")
+
+
+def _GetCurrentViewPosition() -> Vector3:
+    _activeEditor.Record("general.get_current_view_position")
+    return Vector3(*_activeEditor.viewPosition)
+
+
+def _ShowSceneGraphPreview(sceneGraphFilePath: str) -> bool:
+    # The proxies, and hiding them as the models get ready, are covered by SceneGraphPreviewTest.cpp.
+    if not os.path.exists(sceneGraphFilePath):
+        return False
+    _activeEditor.previewRequests.append(sceneGraphFilePath)
+    return True
+
+
+def _AttachSceneGraphPreviewNode(nodePath: str, entityId: EntityId):
+    _activeEditor.previewNodeRequests.append((nodePath, entityId))
+
+
+def _ClearSceneGraphPreview():
+    _activeEditor.previewClearCount += 1
+
+
+def _RegisterLazyModelAsset(entityId: EntityId, modelAssetId: AssetId) -> bool:
+    # The frustum driven assignments are covered by LazyAssetAssignerTest.cpp.
+    _activeEditor.lazyModelRequests.append((entityId, modelAssetId))
+    return True
+
+
+def _RegisterLazyMaterialAsset(entityId: EntityId, slotLabel: str, materialAssetId: AssetId):
+    _activeEditor.lazyMaterialRequests.append((entityId, slotLabel, materialAssetId))
+
+
+def _BuildSceneGraphEntities(sceneGraphFilePath: str, meshProductFolder: str) -> list:
+    # The build is covered by SceneGraphEntityBuilderTest.cpp, the test creates the entities (see CreateEntity).
+    _activeEditor.nativeBuildRequests.append((sceneGraphFilePath, meshProductFolder))
+    return list(_activeEditor.builtEntityIds)
+
+
+def _ExportSceneGraphModel(sceneGraphFilePath: str, modelFilePath: str) -> bool:
+    """
+    Writes a model file for SceneGraphView with the nodes, names and meshes of the SceneGraph. The world
+    transforms are placeholders, node i is at (i, 0, 0); SceneGraphModelFileTest.cpp covers the native writer.
+    """
+    try:
+        with open(sceneGraphFilePath, "rb") as f:
+            sceneGraphBytes = f.read()
+        sceneGraph = json.loads(sceneGraphBytes)
+    except Exception:
+        return False
+    # Depth first, like the native SceneGraph. Each entry: (name, mesh, parent index)
+    nodes = []
+    pendingNodes = [(0xFFFFFFFF, child) for child in reversed(sceneGraph.get("children", []))]
+    while pendingNodes:
+        parentIndex, node = pendingNodes.pop()
+        nodes.append((node["name"].encode("utf-8"), node.get("mesh", "").encode("utf-8"), parentIndex))
+        pendingNodes.extend((len(nodes) - 1, child) for child in reversed(node.get("children", [])))
+    count = len(nodes)
+    nameOffsets = list(itertools.accumulate((len(name) for name, _, _ in nodes), initial=0))
+    meshOffsets = list(itertools.accumulate((len(mesh) for _, mesh, _ in nodes), initial=nameOffsets[-1]))
+    data = struct.pack("<4sIIIQII", b"SGRM", 2, count, meshOffsets[-1], len(sceneGraphBytes), zlib.crc32(sceneGraphBytes), 1)
+    data += struct.pack(f"<{count}I", *[parentIndex for _, _, parentIndex in nodes])
+    data += struct.pack(f"<{count * 3}f", *[value for nodeIndex in range(count) for value in (nodeIndex, 0.0, 0.0)])
+    data += struct.pack(f"<{count * 4}f", *((0.0, 0.0, 0.0, 1.0) * count))
+    data += struct.pack(f"<{count * 3}f", *((1.0, 1.0, 1.0) * count))
+    data += struct.pack(f"<{count + 1}I", *nameOffsets)
+    data += struct.pack(f"<{count + 1}I", *meshOffsets)
+    data += b"".join(name for name, _, _ in nodes) + b"".join(mesh for _, mesh, _ in nodes)
+    os.makedirs(os.path.dirname(modelFilePath), exist_ok=True)
+    _activeEditor.modelExportRequests.append((sceneGraphFilePath, modelFilePath))
+    with open(modelFilePath, "wb") as f:
+        f.write(data)
+    return True
+
+
+def _VerifySceneGraphEntities(
+    sceneGraphFilePath: str, meshProductFolder: str, materialProductFolder: str, tolerance: float, angleToleranceDegrees: float
+) -> str:
+    # The comparisons are covered by SceneGraphVerifierTest.cpp.
+    if not os.path.exists(sceneGraphFilePath):
+        return ""
+    _activeEditor.verifyRequests.append((sceneGraphFilePath, meshProductFolder, materialProductFolder, tolerance, angleToleranceDegrees))
+    sceneName = os.path.splitext(os.path.basename(sceneGraphFilePath))[0]
+    return (
+        f"Verified 0 nodes of '{sceneName}': 0 mismatch(es). missing: 0, parent: 0, transform: 0, model: 0, material: 0. "
+        "Materials not verified, the model is not loaded: 0\n"
+    )
+
+
+def _ReportSceneMemory(sceneGraphFilePath: str, meshProductFolder: str, maxDepth: int) -> str:
+    # The native report reads image headers and .azbuffer products, which the headless scene doesn't have.
+    if not os.path.exists(sceneGraphFilePath):
+        return ""
+    _activeEditor.memoryReportRequests.append((sceneGraphFilePath, meshProductFolder, maxDepth))
+    return f"Scene '{os.path.splitext(os.path.basename(sceneGraphFilePath))[0]}': 0.00 MiB GPU\n"
+
+
+def _BuildSceneHlodProxies(sceneGraphFilePath: str, meshProductFolder: str, cellSize: float, maxError: float) -> str:
+    # The native builder merges the .azmodel products, which the headless scene doesn't have.
+    if not os.path.exists(sceneGraphFilePath):
+        return ""
+    _activeEditor.hlodRequests.append((sceneGraphFilePath, meshProductFolder, cellSize, maxError))
+    sceneName = os.path.splitext(os.path.basename(sceneGraphFilePath))[0]
+    return f"Scene '{sceneName}': 0 HLOD cell(s) of {cellSize:.1f} m from 0 mesh node(s), 0 -> 0 triangle(s), 0 failed, in 0.0 ms.\n"
+
+
+def _CollectOrphanedSceneAssets(sceneGraphFilePath: str, removeFiles: bool) -> str:
+    # The reachability rules are covered by OrphanedAssetCollectorTest.cpp.
+    if not os.path.exists(sceneGraphFilePath):
+        return ""
+    _activeEditor.orphanRequests.append((sceneGraphFilePath, removeFiles))
+    sceneName = os.path.splitext(os.path.basename(sceneGraphFilePath))[0]
+    footer = " Removed 0.\n" if removeFiles else " Dry run, nothing was removed.\n"
+    return f"Scene '{sceneName}': 0 orphaned file(s), 0.00 MiB.{footer}"
+
+
+def _FindSceneAssetReferences(scenesFolder: str, indexFilePath: str, productPath: str) -> str:
+    # The index is covered by SceneAssetIndexTest.cpp.
+    _activeEditor.sceneAssetReferenceRequests.append((scenesFolder, indexFilePath, productPath))
+    return f"'{HeadlessEditor._NormalizeProductPath(productPath)}' is referenced by 0 node(s) in 0 scene(s). Indexed 0 scene(s).\n"
+
+
+def _GenerateSceneMaterials(materialDescriptionsFilePath: str, materialsFolder: str) -> str:
+    # The conversion is covered by MaterialGeneratorTest.cpp.
+    if not os.path.exists(materialDescriptionsFilePath):
+        return ""
+    _activeEditor.materialGenerationRequests.append((materialDescriptionsFilePath, materialsFolder))
+    os.makedirs(materialsFolder, exist_ok=True)
+    for materialName in _activeEditor.generatedMaterialNames:
+        with open(os.path.join(materialsFolder, f"{materialName}.material"), "w") as f:
+            f.write("{}")
+    sceneName = os.path.splitext(os.path.basename(materialDescriptionsFilePath))[0]
+    materialCount = len(_activeEditor.generatedMaterialNames)
+    return f"Materials of '{sceneName}': {materialCount} written, 0 unchanged, 0 kept, 0 failed, in 0.0 ms.\n"
+
+
+def _MaterializeLazyAssets() -> int:
+    _activeEditor.materializeCount += 1
+    return len({entityId.value for entityId, _ in _activeEditor.lazyModelRequests})
+
+
+def _BuildModules(editor: HeadlessEditor) -> dict:
+    def NewModule(name: str, **attributes) -> types.ModuleType:
+        module = types.ModuleType(name)
+        for attributeName, value in attributes.items():
+            setattr(module, attributeName, value)
+        return module
+
+    bus = NewModule("azlmbr.bus", Broadcast=0, Event=1)
+    asset = NewModule(
+        "azlmbr.asset",
+        AssetId=AssetId,
+        AssetId_CreateString=AssetId_CreateString,
+        AssetCatalogRequestBus=_MakeBus("AssetCatalogRequestBus", {"GetAssetIdByPath": _GetAssetIdByPath}),
+    )
+    components = NewModule(
+        "azlmbr.components",
+        TransformBus=_MakeBus("TransformBus", {"SetLocalTM": _SetLocalTM}),
+    )
+    editorModule = NewModule(
+        "azlmbr.editor",
+        ToolsApplicationRequestBus=_MakeBus(
+            "ToolsApplicationRequestBus",
+            {"BeginUndoBatch": lambda *args: None, "EndUndoBatch": lambda *args: None},
+        ),
+        EditorToolsApplicationRequestBus=_MakeBus(
+            "EditorToolsApplicationRequestBus",
+            {"GetGameFolder": lambda: editor.projectRoot},
+        ),
+        AddNonUniformScaleComponent=_AddNonUniformScaleComponent,
+    )
+    entity = NewModule("azlmbr.entity", EntityId=EntityId)
+    general = NewModule(
+        "azlmbr.legacy.general",
+        idle_wait=_IdleWait,
+        idle_wait_frames=_IdleWaitFrames,
+        save_level=_SaveLevel,
+        get_current_level_name=lambda: editor.levelName,
+        get_current_level_path=lambda: editor.levelPath,
+        get_current_view_position=_GetCurrentViewPosition,
+    )
+    legacy = NewModule("azlmbr.legacy", general=general)
+    mathModule = NewModule(
+        "azlmbr.math",
+        Uuid=Uuid,
+        Vector3=Vector3,
+        Quaternion_CreateIdentity=lambda: Quaternion(),
+        Quaternion_CreateRotationX=lambda radians: _QuaternionFromAxisAngle(0, radians),
+        Quaternion_CreateRotationY=lambda radians: _QuaternionFromAxisAngle(1, radians),
+        Quaternion_CreateRotationZ=lambda radians: _QuaternionFromAxisAngle(2, radians),
+        Transform_CreateFromQuaternionAndTranslation=lambda rotation, translation: Transform(rotation, translation),
+    )
+    o3dimportModule = NewModule(
+        "azlmbr.o3dimport",
+        o3dimportRequestBus=_MakeBus(
+            "o3dimportRequestBus",
+            {
+                "ShowSceneGraphPreview": _ShowSceneGraphPreview,
+                "AttachSceneGraphPreviewNode": _AttachSceneGraphPreviewNode,
+                "ClearSceneGraphPreview": _ClearSceneGraphPreview,
+                "RegisterLazyModelAsset": _RegisterLazyModelAsset,
+                "RegisterLazyMaterialAsset": _RegisterLazyMaterialAsset,
+                "MaterializeLazyAssets": _MaterializeLazyAssets,
+                "GetLazyAssetCount": lambda: 0,
+                "BuildSceneGraphEntities": _BuildSceneGraphEntities,
+                "ExportSceneGraphModel": _ExportSceneGraphModel,
+                "VerifySceneGraphEntities": _VerifySceneGraphEntities,
+                "ReportSceneMemory": _ReportSceneMemory,
+                "FindSceneAssetReferences": _FindSceneAssetReferences,
+                "CollectOrphanedSceneAssets": _CollectOrphanedSceneAssets,
+                "BuildSceneHlodProxies": _BuildSceneHlodProxies,
+                "GenerateSceneMaterials": _GenerateSceneMaterials,
+            },
+        ),
+    )
+    paths = NewModule("azlmbr.paths", projectroot=editor.projectRoot, products=editor.productsRoot)
+    render = NewModule(
+        "azlmbr.render",
+        MaterialComponentRequestBus=_MakeBus(
+            "MaterialComponentRequestBus", {"FindMaterialAssignmentId": _FindMaterialAssignmentId}
+        ),
+    )
+    azlmbr = NewModule(
+        "azlmbr",
+        asset=asset,
+        bus=bus,
+        components=components,
+        editor=editorModule,
+        entity=entity,
+        legacy=legacy,
+        math=mathModule,
+        o3dimport=o3dimportModule,
+        paths=paths,
+        render=render,
+    )
+    entityUtils = NewModule(
+        "editor_python_test_tools.editor_entity_utils",
+        EditorComponent=EditorComponent,
+        EditorEntity=EditorEntity,
+    )
+    testTools = NewModule("editor_python_test_tools", editor_entity_utils=entityUtils)
+    return {
+        "azlmbr": azlmbr,
+        "azlmbr.asset": asset,
+        "azlmbr.bus": bus,
+        "azlmbr.components": components,
+        "azlmbr.editor": editorModule,
+        "azlmbr.entity": entity,
+        "azlmbr.legacy": legacy,
+        "azlmbr.legacy.general": general,
+        "azlmbr.math": mathModule,
+        "azlmbr.o3dimport": o3dimportModule,
+        "azlmbr.paths": paths,
+        "azlmbr.render": render,
+        "editor_python_test_tools": testTools,
+        "editor_python_test_tools.editor_entity_utils": entityUtils,
+    }
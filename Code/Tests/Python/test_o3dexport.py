@@ -0,0 +1,263 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Runs the modules of BlenderAddOn/o3dexport that don't need a running Blender.
+# bpy and mathutils are replaced by empty stand-ins, enough for the modules to be imported:
+#     python -m pytest -s Code/Tests/Python
+
+import json
+import math
+import os
+import random
+import sys
+import types
+
+import pytest
+
+ADDON_DIR_PATH = os.path.join(os.path.dirname(__file__), "..", "..", "..", "BlenderAddOn", "o3dexport")
+
+
+class _StandInTypes(types.ModuleType):
+    """
+    bpy.types: each attribute is an empty class, created the first time it is read.
+    """
+
+    def __getattr__(self, name: str) -> type:
+        if name.startswith("__"):
+            raise AttributeError(name)
+        dataBlockType = type(name, (), {})
+        setattr(self, name, dataBlockType)
+        return dataBlockType
+
+
+def _InstallBlenderStandIns():
+    if "bpy" in sys.modules:
+        return
+    handlers = types.ModuleType("bpy.app.handlers")
+    handlers.persistent = lambda function: function
+    for handlerListName in ("depsgraph_update_post", "load_post", "undo_post", "redo_post"):
+        setattr(handlers, handlerListName, [])
+    app = types.ModuleType("bpy.app")
+    app.handlers = handlers
+    bpy = types.ModuleType("bpy")
+    bpy.app = app
+    bpy.types = _StandInTypes("bpy.types")
+    sys.modules.update({"bpy": bpy, "bpy.app": app, "bpy.app.handlers": handlers, "mathutils": types.ModuleType("mathutils")})
+
+
+_InstallBlenderStandIns()
+sys.path.insert(0, ADDON_DIR_PATH)
+import dirtytracker  # noqa: E402
+import o3material  # noqa: E402
+import transform_track  # noqa: E402
+
+import bpy  # noqa: E402
+
+FINGERPRINT = ("Scene", "Y", "Z")
+
+
+def _NewDataBlock(typeName: str, name: str):
+    dataBlock = getattr(bpy.types, typeName)()
+    dataBlock.name = name
+    dataBlock.original = dataBlock
+    return dataBlock
+
+
+def _NotifyDepsgraphUpdate(*dataBlocks):
+    updates = [types.SimpleNamespace(id=dataBlock, is_updated_geometry=True) for dataBlock in dataBlocks]
+    dirtytracker._OnDepsgraphUpdatePost(None, types.SimpleNamespace(updates=updates))
+
+
+@pytest.fixture
+def exportedTracker(tmp_path):
+    """
+    The module tracker, after an export that wrote the mesh 'Rock' and the material 'Stone'.
+    """
+    tracker = dirtytracker.GetTracker()
+    tracker.Reset()
+    meshFilePath = str(tmp_path / "Rock.fbx")
+    materialFilePath = str(tmp_path / "Stone.material")
+    for filePath in (meshFilePath, materialFilePath):
+        with open(filePath, "w") as f:
+            f.write("exported")
+    tracker.BeginExport(FINGERPRINT)
+    tracker.MarkExported(dirtytracker.Kind.MESH, "Rock", ("Rock",))
+    tracker.MarkExported(dirtytracker.Kind.MATERIAL, "Stone", ("Stone",))
+    tracker.EndExport(succeeded=True)
+    yield tracker, meshFilePath, materialFilePath
+    tracker.Reset()
+
+
+def test_DirtyTracker_Unchanged_CanSkip(exportedTracker):
+    tracker, meshFilePath, _ = exportedTracker
+
+    tracker.BeginExport(FINGERPRINT)
+    assert tracker.CanSkip(dirtytracker.Kind.MESH, "Rock", ("Rock",), [meshFilePath])
+    assert not tracker.CanSkip(dirtytracker.Kind.MESH, "Rock", ("Renamed",), [meshFilePath])
+    tracker.EndExport(succeeded=True)
+
+
+def test_DirtyTracker_EditDuringExport_IsNotSkippedByTheNextExport(exportedTracker):
+    tracker, meshFilePath, materialFilePath = exportedTracker
+
+    tracker.BeginExport(FINGERPRINT)
+    assert tracker.CanSkip(dirtytracker.Kind.MESH, "Rock", ("Rock",), [meshFilePath])
+    tracker.MarkExported(dirtytracker.Kind.MESH, "Rock", ("Rock",))
+    # The modal export passes the events through, the user edits the mesh after it was written.
+    _NotifyDepsgraphUpdate(_NewDataBlock("Mesh", "Rock"), _NewDataBlock("Material", "Stone"))
+    assert tracker.CanSkip(dirtytracker.Kind.MATERIAL, "Stone", ("Stone",), [materialFilePath])
+    tracker.MarkExported(dirtytracker.Kind.MATERIAL, "Stone", ("Stone",))
+    tracker.EndExport(succeeded=True)
+
+    assert tracker.GetDirtyCountsString() == "0 object(s), 1 mesh(s), 1 material(s), 0 image(s)"
+    tracker.BeginExport(FINGERPRINT)
+    assert not tracker.CanSkip(dirtytracker.Kind.MESH, "Rock", ("Rock",), [meshFilePath])
+    assert not tracker.CanSkip(dirtytracker.Kind.MATERIAL, "Stone", ("Stone",), [materialFilePath])
+    tracker.EndExport(succeeded=True)
+
+
+def test_DirtyTracker_NodeGroupEditDuringExport_DirtiesAllMaterials(exportedTracker):
+    tracker, _, materialFilePath = exportedTracker
+
+    tracker.BeginExport(FINGERPRINT)
+    _NotifyDepsgraphUpdate(_NewDataBlock("ShaderNodeTree", "SharedGroup"))
+    tracker.EndExport(succeeded=True)
+
+    tracker.BeginExport(FINGERPRINT)
+    assert not tracker.CanSkip(dirtytracker.Kind.MATERIAL, "Stone", ("Stone",), [materialFilePath])
+    tracker.EndExport(succeeded=True)
+
+
+def test_DirtyTracker_UndoDuringExport_DirtiesEverything(exportedTracker):
+    tracker, meshFilePath, _ = exportedTracker
+
+    tracker.BeginExport(FINGERPRINT)
+    dirtytracker._OnFileLoadedOrUndone()
+    tracker.MarkExported(dirtytracker.Kind.MESH, "Rock", ("Rock",))
+    tracker.EndExport(succeeded=True)
+
+    assert tracker.GetDirtyCountsString() == "everything"
+    tracker.BeginExport(FINGERPRINT)
+    assert not tracker.CanSkip(dirtytracker.Kind.MESH, "Rock", ("Rock",), [meshFilePath])
+    tracker.EndExport(succeeded=True)
+
+
+def _InterpolateKeptKeys(times: list[float], values: list[tuple], keyIndices: list[int], normalize: bool) -> list[tuple]:
+    """
+    The value of each sample, as the importer rebuilds it from the kept keys.
+    """
+    result = []
+    for first, last in zip(keyIndices, keyIndices[1:]):
+        for index in range(first, last):
+            weight = (times[index] - times[first]) / (times[last] - times[first])
+            result.append(transform_track._Lerp(values[first], values[last], weight, normalize))
+    result.append(values[keyIndices[-1]])
+    return result
+
+
+def _MaxComponentError(values: list[tuple], expectedValues: list[tuple]) -> float:
+    return max(abs(x - y) for value, expected in zip(values, expectedValues) for x, y in zip(value, expected))
+
+
+def test_TransformTrack_ReduceKeys_StaysWithinTolerance():
+    times = [frame / 24.0 for frame in range(241)]
+    translations = [(math.sin(time * 0.5), time * 0.5, 2.0 if time < 5.0 else 3.0) for time in times]
+
+    keyIndices = transform_track.ReduceKeys(times, translations, transform_track.TRANSLATION_TOLERANCE)
+
+    assert keyIndices[0] == 0 and keyIndices[-1] == len(times) - 1
+    assert len(keyIndices) < len(times) // 2
+    rebuilt = _InterpolateKeptKeys(times, translations, keyIndices, normalize=False)
+    assert _MaxComponentError(rebuilt, translations) <= transform_track.TRANSLATION_TOLERANCE
+
+
+def test_TransformTrack_ReduceKeys_ConstantChannel_KeepsOneKey():
+    times = [frame / 24.0 for frame in range(48)]
+    scales = [(1.0, 1.0 + 0.0001 * (frame % 2), 1.0) for frame in range(48)]
+
+    assert transform_track.ReduceKeys(times, scales, transform_track.SCALE_TOLERANCE) == [0]
+
+
+def test_TransformTrack_QuantizedRotations_RoundTrip():
+    randomGenerator = random.Random(7)
+    # One quaternion where each component is the largest, and random ones.
+    quats = [tuple(0.9 if index == largest else 0.25 for index in range(4)) for largest in range(4)]
+    quats += [tuple(randomGenerator.gauss(0.0, 1.0) for _ in range(4)) for _ in range(1000)]
+    for quat in quats:
+        length = math.sqrt(sum(component * component for component in quat))
+        quat = tuple(component / length for component in quat)
+
+        values = transform_track.QuantizeQuaternion(quat)
+        assert all(0 <= value <= 0xFFFF for value in values)
+        decoded = transform_track.DequantizeQuaternion(values)
+        # q and -q are the same rotation.
+        sign = 1.0 if sum(a * b for a, b in zip(decoded, quat)) >= 0.0 else -1.0
+        assert _MaxComponentError([decoded], [tuple(sign * component for component in quat)]) < 1e-4
+
+
+def test_TransformTrack_BuildTrackDictionary_DecodedRotationsStayWithinTolerance():
+    framesPerSecond = 24.0
+    times = [frame / framesPerSecond for frame in range(121)]
+    # Half a turn around Z, then a turn around X, so the track goes through every largest component.
+    rotations = []
+    for time in times:
+        if time <= 2.5:
+            halfAngle = math.pi * time / 5.0
+            rotations.append((0.0, 0.0, math.sin(halfAngle), math.cos(halfAngle)))
+        else:
+            halfAngle = math.pi * (time - 2.5) / 2.5
+            rotations.append((math.sin(halfAngle), 0.0, math.cos(halfAngle), 0.0))
+    translations = [(0.0, 0.0, 0.0)] * len(times)
+    scales = [(1.0, 1.0, 1.0)] * len(times)
+
+    track = transform_track.BuildTrackDictionary(times, translations, rotations, scales)
+
+    assert track["translate"]["times"] == [0.0] and track["scale"]["times"] == [0.0]
+    keyIndices = [round(time * framesPerSecond) for time in track["rotate"]["times"]]
+    packedValues = track["rotate"]["values"]
+    assert len(packedValues) == 3 * len(keyIndices) and len(keyIndices) < len(times) // 2
+    # What the importer decodes: only the kept keys, the other samples are never read.
+    decodedRotations = [
+        transform_track.DequantizeQuaternion(tuple(packedValues[index:index + 3])) for index in range(0, len(packedValues), 3)
+    ]
+    decodedRotationsBySample = [None] * len(times)
+    for keyIndex, decodedRotation in zip(keyIndices, transform_track.MakeHemisphereContinuous(decodedRotations)):
+        decodedRotationsBySample[keyIndex] = decodedRotation
+    rebuilt = _InterpolateKeptKeys(times, decodedRotationsBySample, keyIndices, normalize=True)
+    # Keys are reduced on the decoded values, so only the quantization error adds to the tolerance.
+    assert _MaxComponentError(rebuilt, transform_track.MakeHemisphereContinuous(rotations)) <= (
+        transform_track.ROTATION_TOLERANCE + 1e-4
+    )
+
+
+def test_MaterialDescriptions_ResolveTexturePathsAndMergeSelectedExports(tmp_path):
+    texture = types.SimpleNamespace(GetSanitizedName=lambda: "Rust.png")
+    texturePaths = o3material.TexturePathResolver(os.path.join("Assets", "Scenes", "Town", "Textures"), {"Rust": texture})
+    material = o3material.O3Material.__new__(o3material.O3Material)
+    material._data = {
+        "Metallic": {"type": "VALUE", "value": 1.0, "textureName": "Rust", "textureChannel": "Red"},
+        "Roughness": {"type": "VALUE", "value": 0.5, "textureName": ""},
+    }
+
+    description = material.GetDescription(texturePaths)
+    assert description["Metallic"]["texturePath"] == "@projectroot@/Assets/Scenes/Town/Textures/Rust_Red.png"
+    assert "texturePath" not in description["Roughness"]
+    assert "texturePath" not in material._data["Metallic"]
+
+    filePath = str(tmp_path / "Town.o3mat")
+    assert o3material.SaveMaterialDescriptions(filePath, {"Iron": description, "Wood": {}}, True, False, True, merge=False)
+    # Exporting the selected objects only keeps the other materials, a full export drops them.
+    assert o3material.SaveMaterialDescriptions(filePath, {"Iron": {}}, False, False, True, merge=True)
+    with open(filePath) as f:
+        data = json.load(f)
+    assert data["version"] == o3material.MATERIAL_DESCRIPTIONS_VERSION
+    assert (data["overwrite"], data["normalFlipX"], data["normalFlipY"]) == (False, False, True)
+    assert data["materials"] == {"Iron": {}, "Wood": {}}
+    assert o3material.SaveMaterialDescriptions(filePath, {"Iron": {}}, True, False, True, merge=False)
+    with open(filePath) as f:
+        assert json.load(f)["materials"] == {"Iron": {}}
+    assert not os.path.exists(f"{filePath}.tmp")
@@ -0,0 +1,596 @@
+"""
+Copyright (c) Contributors to the Open 3D Engine Project.
+For complete copyright and license terms please see the LICENSE at the root of this distribution.
+
+SPDX-License-Identifier: Apache-2.0 OR MIT
+"""
+
+# Runs Editor/Scripts/o3dimport/o3dimport.py against the stand-in Editor buses
+# in headless_editor.py. Doesn't require the Editor, plain python + pytest is enough:
+#     python -m pytest -s Code/Tests/Python
+
+import importlib.util
+import json
+import os
+import struct
+import sys
+
+import pytest
+
+sys.path.insert(0, os.path.dirname(__file__))
+import headless_editor  # noqa: E402
+
+IMPORTER_SCRIPT_PATH = os.path.join(
+    os.path.dirname(__file__), "..", "..", "..", "Editor", "Scripts", "o3dimport", "o3dimport.py"
+)
+SCENE_NAME = "HeadlessScene"
+
+
+def _LoadImporterModule():
+    spec = importlib.util.spec_from_file_location("o3dimport_under_test", IMPORTER_SCRIPT_PATH)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def _BuildSceneGraph(rootCount: int, childrenPerRoot: int) -> dict:
+    """
+    A scene with @rootCount root nodes laid out along the X axis, each one with @childrenPerRoot
+    children that reference a mesh and one or two materials.
+    """
+    roots = []
+    for rootIndex in range(rootCount):
+        children = []
+        for childIndex in range(childrenPerRoot):
+            meshIndex = (rootIndex + childIndex) % 5
+            children.append(
+                {
+                    "name": f"Prop_{rootIndex:03}_{childIndex:02}",
+                    "transform": {
+                        "translate": (0.0, float(childIndex), 0.0),
+                        "rotate": (0.0, 0.0, 90.0),
+                        "scale": (1.0, 1.0, 1.0) if childIndex % 4 else (1.0, 2.0, 1.0),
+                    },
+                    "mesh": f"Mesh_{meshIndex}",
+                    "materials": [f"Material_{meshIndex}"] + ([f"Trim_{meshIndex}"] if meshIndex % 2 else []),
+                }
+            )
+        roots.append(
+            {
+                "name": f"Group_{rootIndex:03}",
+                "transform": {"translate": (rootIndex * 10.0, 0.0, 0.0), "rotate": (0.0, 0.0, 0.0), "scale": (1.0, 1.0, 1.0)},
+                "children": children,
+            }
+        )
+    return {"name": SCENE_NAME, "children": roots}
+
+
+@pytest.fixture
+def headlessScene(tmp_path):
+    """
+    Installs a fresh HeadlessEditor with the products of a small scene
+    registered in the asset catalog, and writes the .sgr file in the project.
+    """
+    projectRoot = str(tmp_path / "Project")
+    productsRoot = str(tmp_path / "Project" / "Cache" / "linux")
+    editor = headless_editor.HeadlessEditor(projectRoot, productsRoot)
+    sceneGraph = _BuildSceneGraph(rootCount=8, childrenPerRoot=6)
+    sceneDir = os.path.join(projectRoot, "Assets", "Scenes", SCENE_NAME)
+    os.makedirs(sceneDir)
+    with open(os.path.join(sceneDir, f"{SCENE_NAME}.sgr"), "w") as f:
+        json.dump(sceneGraph, f, indent=4)
+    for meshIndex in range(5):
+        slotLabels = [f"Material_{meshIndex}"] + ([f"Trim_{meshIndex}"] if meshIndex % 2 else [])
+        editor.RegisterProduct(os.path.join("Assets", "Scenes", SCENE_NAME, "Meshes", f"Mesh_{meshIndex}.fbx.azmodel"), slotLabels)
+        for label in slotLabels:
+            editor.RegisterProduct(os.path.join("Assets", "Scenes", SCENE_NAME, "Materials", f"{label}.azmaterial"))
+    with open(os.path.join(productsRoot, "assetcatalog.xml"), "w") as f:
+        f.write("<catalog/>")
+    editor.Install()
+    return editor, sceneGraph
+
+
+def _RunMain(importerModule, *args):
+    sys.argv = ["o3dimport.py", SCENE_NAME, "--noverbose"] + list(args)
+    importerModule.Main()
+
+
+def test_ImportScene_NewLevel_CreatesEntitiesAndAssignsAssets(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer)
+    print(f"\nFirst import:\n{editor.Report()}")
+
+    nodeCount = sum(1 + len(root["children"]) for root in sceneGraph["children"])
+    assert len(editor.entities) == nodeCount
+    assert editor.calls["EditorEntity.create_editor_entity"] == nodeCount
+    assert editor.calls["TransformBus.SetLocalTM"] == nodeCount
+    for root in sceneGraph["children"]:
+        for child in root["children"]:
+            entities = editor.FindEntitiesByName(child["name"])
+            assert len(entities) == 1
+            entity = entities[0]
+            assert editor.entities[entity.parentId.value].name == root["name"]
+            meshComponent = entity.components["Mesh"]
+            modelAssetId = meshComponent.properties[headless_editor.MODEL_ASSET_PROPERTY]
+            assert modelAssetId.is_valid()
+            materialComponent = entity.components["Material"]
+            for slotIndex in range(len(child["materials"])):
+                assert materialComponent.properties[f"Model Materials|[{slotIndex}]|Material Asset"].is_valid()
+            expectsNonUniformScale = child["transform"]["scale"][1] != 1.0
+            assert (entity.nonUniformScale is not None) == expectsNonUniformScale
+
+
+def test_ImportScene_ReimportWithAssetIdCache_SkipsCatalogLookups(headlessScene):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    _RunMain(importer)
+    firstRunLookups = editor.calls["AssetCatalogRequestBus.GetAssetIdByPath"]
+    assert firstRunLookups > 0
+
+    editor.ResetRecorder()
+    _RunMain(importer, "--force")
+    print(f"\nForced re-import:\n{editor.Report()}")
+
+    assert editor.calls["AssetCatalogRequestBus.GetAssetIdByPath"] == 0
+    assert editor.calls["EditorEntity.create_editor_entity"] == 0
+    assert editor.calls["EditorComponent.set_component_property_value"] == 0
+
+
+def test_ImportScene_UnchangedInputsAndLevel_SkipsImport(headlessScene):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    _RunMain(importer)
+
+    editor.ResetRecorder()
+    _RunMain(importer)
+
+    assert editor.calls["EditorEntity.find_editor_entities"] == 0
+    assert editor.calls["TransformBus.SetLocalTM"] == 0
+    assert editor.calls["general.save_level"] == 0
+
+
+def test_ImportScene_NoSaveWithFrameBudget_YieldsPerEntityAndNeverSaves(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    nodeCount = sum(1 + len(root["children"]) for root in sceneGraph["children"])
+
+    editor.isCallLogEnabled = True
+    # A budget this small is always exceeded, so every entity of every phase yields a frame.
+    _RunMain(importer, "--nosave", "--frame_budget_ms", "0.000001")
+
+    assert len(editor.entities) == nodeCount
+    assert editor.calls["general.save_level"] == 0
+    assert editor.callLog.count(("general.idle_wait_frames", (1,))) >= 5 * nodeCount
+    # The level was not saved, so the import is not up to date yet.
+    editor.ResetRecorder()
+    _RunMain(importer, "--nosave")
+    assert editor.calls["EditorEntity.find_editor_entities"] > 0
+    assert editor.calls["general.save_level"] == 0
+
+
+def test_ImportScene_PartialFailure_IsNotSkippedNextTime(headlessScene):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    # Same AssetId, so the same import key, but the model lost its Trim_1 slot.
+    meshProductPath = os.path.join("Assets", "Scenes", SCENE_NAME, "Meshes", "Mesh_1.fbx.azmodel")
+    editor.RegisterProduct(meshProductPath, ["Material_1"])
+    _RunMain(importer)
+
+    editor.ResetRecorder()
+    _RunMain(importer)
+    assert editor.calls["EditorEntity.find_editor_entities"] > 0
+
+    editor.RegisterProduct(meshProductPath, ["Material_1", "Trim_1"])
+    _RunMain(importer)
+    editor.ResetRecorder()
+    _RunMain(importer)
+    assert editor.calls["EditorEntity.find_editor_entities"] == 0
+
+
+def test_ImportScene_OrderByPoint_AssignsClosestMeshesFirst(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    editor.isCallLogEnabled = True
+    orderPoint = (70.0, 0.0, 0.0)
+
+    _RunMain(importer, "--order", "point", "--point", *[str(value) for value in orderPoint])
+
+    worldPositions = importer.CalculateWorldPositions(sceneGraph)
+    distances = []
+    for callName, args in editor.callLog:
+        if callName == "EditorComponent.set_component_property_value" and args[1] == headless_editor.MODEL_ASSET_PROPERTY:
+            position = worldPositions[editor.entities[args[0].value].name]
+            distances.append(sum([(position[axis] - orderPoint[axis]) ** 2 for axis in range(3)]))
+    assert len(distances) == sum(len(root["children"]) for root in sceneGraph["children"])
+    assert distances == sorted(distances)
+    assert distances[0] == 0.0
+
+
+def test_CalculateWorldPositions_NonUniformScaleOfParentShearsChildren(headlessScene):
+    importer = _LoadImporterModule()
+    sceneGraph = {
+        "children": [
+            {
+                "name": "Stretched",
+                "transform": {"scale": (2.0, 1.0, 1.0)},
+                "children": [
+                    {
+                        "name": "Turned",
+                        "transform": {"translate": (1.0, 0.0, 0.0), "rotate": (0.0, 0.0, 90.0)},
+                        "children": [{"name": "Leaf", "transform": {"translate": (1.0, 0.0, 0.0)}}],
+                    }
+                ],
+            }
+        ]
+    }
+
+    worldPositions = importer.CalculateWorldPositions(sceneGraph)
+
+    assert worldPositions["Turned"] == pytest.approx((2.0, 0.0, 0.0))
+    # Turned points its X axis along the world Y axis, which the X scale of Stretched doesn't stretch.
+    assert worldPositions["Leaf"] == pytest.approx((2.0, 1.0, 0.0))
+
+
+def test_ImportScene_Preview_AttachesEachNodeToItsEntity(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    editor.isCallLogEnabled = True
+
+    _RunMain(importer, "--preview")
+
+    callNames = [callName for callName, _ in editor.callLog]
+    assert editor.previewRequests == [os.path.join(editor.projectRoot, "Assets", "Scenes", SCENE_NAME, f"{SCENE_NAME}.sgr")]
+    assert callNames.index("o3dimportRequestBus.ShowSceneGraphPreview") < callNames.index("EditorEntity.create_editor_entity")
+    attachedEntityNamesByPath = {nodePath: editor.entities[entityId.value].name for nodePath, entityId in editor.previewNodeRequests}
+    expectedPaths = {root["name"] for root in sceneGraph["children"]}
+    expectedPaths.update(f"{root['name']}/{child['name']}" for root in sceneGraph["children"] for child in root["children"])
+    assert len(editor.previewNodeRequests) == len(expectedPaths)
+    assert set(attachedEntityNamesByPath.keys()) == expectedPaths
+    assert all(nodePath.endswith(entityName) for nodePath, entityName in attachedEntityNamesByPath.items())
+    # On success the Gem hides the remaining proxies itself, as the models get ready.
+    assert editor.previewClearCount == 0
+
+
+def test_ImportScene_PreviewFailure_ClearsThePreview(headlessScene, monkeypatch):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+
+    def FailToAddEntity(*args):
+        raise RuntimeError("Entity creation failed")
+
+    monkeypatch.setattr(importer.SceneImporter, "_AddEntity", FailToAddEntity)
+    with pytest.raises(RuntimeError):
+        _RunMain(importer, "--preview")
+
+    assert len(editor.previewRequests) == 1
+    assert editor.previewClearCount == 1
+
+
+def test_ImportScene_PreviewLazy_AttachesEveryNodeAndLeavesTheProxiesToTheGem(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--preview", "--lazy")
+
+    nodeCount = sum(1 + len(root["children"]) for root in sceneGraph["children"])
+    assert len(editor.previewNodeRequests) == nodeCount
+
+    _RunMain(importer, "--materialize")
+
+    # The mesh proxies stay until their models are assigned by the Gem, which then hides them.
+    assert editor.previewClearCount == 0
+
+
+def test_ImportScene_Lazy_RegistersAssetsWithoutSavingAndMaterializesThemInALaterSession(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--lazy")
+
+    children = [child for root in sceneGraph["children"] for child in root["children"]]
+    assert editor.calls["EditorComponent.set_component_property_value"] == 0
+    assert len(editor.lazyModelRequests) == len(children)
+    assert len(editor.lazyMaterialRequests) == sum(len(child["materials"]) for child in children)
+    # The transient assignments of the Gem must not be saved with the level.
+    assert editor.saveCount == 0
+    lazyAssetFilePath = os.path.join(editor.projectRoot, "user", "o3dimport", "LazyAssets", f"{editor.levelName}.json")
+    assert os.path.exists(lazyAssetFilePath)
+
+    # A later Editor session, the Gem no longer knows about the registered assets.
+    registeredModels = {(entityId.value, assetId.to_string()) for entityId, assetId in editor.lazyModelRequests}
+    registeredMaterials = {(entityId.value, label, assetId.to_string()) for entityId, label, assetId in editor.lazyMaterialRequests}
+    editor.lazyModelRequests.clear()
+    editor.lazyMaterialRequests.clear()
+    importer = _LoadImporterModule()
+    _RunMain(importer, "--materialize")
+
+    assert {(entityId.value, assetId.to_string()) for entityId, assetId in editor.lazyModelRequests} == registeredModels
+    assert {
+        (entityId.value, label, assetId.to_string()) for entityId, label, assetId in editor.lazyMaterialRequests
+    } == registeredMaterials
+    assert editor.materializeCount == 1
+    assert editor.saveCount == 1
+    assert not os.path.exists(lazyAssetFilePath)
+
+
+def test_ImportScene_NativeBuild_CreatesNoEntitiesFromPython(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    # What the Gem builds, depth first: the roots, and the children with their model already set.
+    for root in sceneGraph["children"]:
+        rootId = editor.CreateEntity(root["name"])
+        editor.builtEntityIds.append(rootId)
+        for child in root["children"]:
+            childId = editor.CreateEntity(child["name"], rootId, ("Mesh", "Material"))
+            meshProductPath = os.path.join("Assets", "Scenes", SCENE_NAME, "Meshes", f"{child['mesh']}.fbx.azmodel")
+            meshComponent = editor.entities[childId.value].components["Mesh"]
+            meshComponent.properties[headless_editor.MODEL_ASSET_PROPERTY] = editor.RegisterProduct(meshProductPath)
+            editor.builtEntityIds.append(childId)
+
+    _RunMain(importer, "--native_build")
+
+    nodeCount = sum(1 + len(root["children"]) for root in sceneGraph["children"])
+    assert len(editor.nativeBuildRequests) == 1
+    sceneGraphFilePath, meshProductFolder = editor.nativeBuildRequests[0]
+    assert sceneGraphFilePath.endswith(f"{SCENE_NAME}.sgr")
+    assert meshProductFolder == f"Assets/Scenes/{SCENE_NAME}/Meshes"
+    assert len(editor.entities) == nodeCount
+    assert editor.calls["EditorEntity.create_editor_entity"] == 0
+    assert editor.calls["EditorEntity.add_component"] == 0
+    # The entities built natively are complete, the phases don't look them up nor check them again.
+    assert editor.calls["EditorEntity.find_editor_entities"] == 0
+    assert editor.calls["EditorEntity.has_component"] == 0
+    assert editor.calls["TransformBus.SetLocalTM"] == 0
+    assert editor.calls["editor.AddNonUniformScaleComponent"] == 0
+    # Only the materials are left to python.
+    assert editor.calls["EditorComponent.set_component_property_value"] == sum(
+        len(child["materials"]) for root in sceneGraph["children"] for child in root["children"]
+    )
+    for root in sceneGraph["children"]:
+        for child in root["children"]:
+            materialComponent = editor.FindEntitiesByName(child["name"])[0].components["Material"]
+            for slotIndex in range(len(child["materials"])):
+                assert materialComponent.properties[f"Model Materials|[{slotIndex}]|Material Asset"].is_valid()
+
+
+def test_ImportScene_NativeBuildLazy_IsRejected(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+
+    # The Gem builds the entities with their model assets, there would be nothing left to assign lazily.
+    with pytest.raises(SystemExit):
+        _RunMain(importer, "--native_build", "--lazy")
+
+    assert editor.nativeBuildRequests == []
+    assert editor.entities == {}
+    assert editor.saveCount == 0
+
+
+def test_OpenSceneGraphView_ReadsNodesWithoutReexporting(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    sceneGraphFilePath = os.path.join(editor.projectRoot, "Assets", "Scenes", SCENE_NAME, f"{SCENE_NAME}.sgr")
+
+    with importer.OpenSceneGraphView(sceneGraphFilePath) as view:
+        nodeCount = sum(1 + len(root["children"]) for root in sceneGraph["children"])
+        assert view.nodeCount == nodeCount
+        assert len(view.parentIndices) == nodeCount
+        assert len(view.worldTranslations) == nodeCount * 3
+        # Depth first: each group is followed by its children.
+        assert view.GetName(0) == "Group_000"
+        assert view.GetMesh(0) == ""
+        assert view.parentIndices[0] == importer.SceneGraphView.INVALID_INDEX
+        childIndex = view.FindNodeIndex("Prop_002_03")
+        groupIndex = view.FindNodeIndex("Group_002")
+        assert view.parentIndices[childIndex] == groupIndex
+        assert view.GetMesh(childIndex) == "Mesh_0"
+        # The headless export places node i at (i, 0, 0), with identity rotation and scale.
+        assert list(view.worldTranslations[childIndex * 3 : childIndex * 3 + 3]) == [float(childIndex), 0.0, 0.0]
+        assert list(view.worldRotations[childIndex * 4 : childIndex * 4 + 4]) == [0.0, 0.0, 0.0, 1.0]
+        assert list(view.worldScales[childIndex * 3 : childIndex * 3 + 3]) == [1.0, 1.0, 1.0]
+        assert view.FindNodeIndex("Missing") == -1
+    assert editor.calls["o3dimportRequestBus.ExportSceneGraphModel"] == 1
+    exportedSceneGraphFilePath, modelFilePath = editor.modelExportRequests[0]
+    assert exportedSceneGraphFilePath == sceneGraphFilePath
+    assert os.path.dirname(modelFilePath) == importer.GetDefaultSceneGraphModelDirPath()
+
+    with importer.OpenSceneGraphView(sceneGraphFilePath) as view:
+        assert view.nodeCount == nodeCount
+    assert editor.calls["o3dimportRequestBus.ExportSceneGraphModel"] == 1
+
+
+def test_OpenSceneGraphView_ReexportsWhenTheContentChangesOrTheModelIsIncomplete(headlessScene):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    sceneGraphFilePath = os.path.join(editor.projectRoot, "Assets", "Scenes", SCENE_NAME, f"{SCENE_NAME}.sgr")
+    with importer.OpenSceneGraphView(sceneGraphFilePath) as view:
+        assert view.FindNodeIndex("Group_001") != -1
+    modelFilePath = [entry.path for entry in os.scandir(importer.GetDefaultSceneGraphModelDirPath())][0]
+
+    # Same size and same modification time, different content.
+    sourceStat = os.stat(sceneGraphFilePath)
+    with open(sceneGraphFilePath, "r") as f:
+        sceneGraphText = f.read()
+    with open(sceneGraphFilePath, "w") as f:
+        f.write(sceneGraphText.replace("Group_001", "Group_XYZ"))
+    os.utime(sceneGraphFilePath, ns=(sourceStat.st_atime_ns, sourceStat.st_mtime_ns))
+    with importer.OpenSceneGraphView(sceneGraphFilePath) as view:
+        assert view.FindNodeIndex("Group_001") == -1
+        assert view.FindNodeIndex("Group_XYZ") != -1
+    assert editor.calls["o3dimportRequestBus.ExportSceneGraphModel"] == 2
+
+    # A model file that was not completely written, newer than the SceneGraph.
+    with open(modelFilePath, "r+b") as f:
+        f.seek(struct.calcsize("<4sIIIQI"))
+        f.write(struct.pack("<I", 0))
+    with importer.OpenSceneGraphView(sceneGraphFilePath) as view:
+        assert view.FindNodeIndex("Group_XYZ") != -1
+    assert editor.calls["o3dimportRequestBus.ExportSceneGraphModel"] == 3
+
+
+def test_ImportScene_ProfileBuses_ReportsSlowestCallsAndRestoresBuses(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    originalBus = sys.modules["azlmbr.asset"].AssetCatalogRequestBus
+    originalMethod = headless_editor.EditorComponent.set_component_property_value
+
+    _RunMain(importer, "--profile_buses", "50")
+    output = capsys.readouterr().out
+
+    assert "Bus calls:" in output
+    assert "AssetCatalogRequestBus.GetAssetIdByPath" in output
+    assert "TransformBus.SetLocalTM" in output
+    assert "EditorComponent.set_component_property_value" in output
+    assert sys.modules["azlmbr.asset"].AssetCatalogRequestBus is originalBus
+    assert headless_editor.EditorComponent.set_component_property_value is originalMethod
+
+
+def test_BusCallProfiler_NestedCalls_AreNotCountedTwice(headlessScene, monkeypatch):
+    importer = _LoadImporterModule()
+    # Outer starts at 0, inner runs from 10 to 30, outer ends at 100.
+    clockNs = iter([0, 10, 30, 100])
+    monkeypatch.setattr(importer.time, "perf_counter_ns", lambda: next(clockNs))
+    profiler = importer.BusCallProfiler()
+    inner = profiler._WrapFunction("Inner", lambda: None)
+    outer = profiler._WrapFunction("Outer", lambda: inner())
+
+    outer()
+
+    assert profiler._samples == {"Outer": [80], "Inner": [20]}
+    assert profiler.GetReport().startswith("Bus calls: 2 in 0.0 ms")
+    assert sum(sum(samples) for samples in profiler._samples.values()) == 100
+
+
+def test_Verify_PassesTolerancesAndDoesNotImport(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--verify")
+    _RunMain(importer, "--verify", "0.01", "--verify_angle_tolerance", "0.5")
+    output = capsys.readouterr().out
+
+    assert "0 mismatch(es)" in output
+    assert len(editor.entities) == 0
+    sceneGraphFilePath, meshProductFolder, materialProductFolder, _, _ = editor.verifyRequests[0]
+    assert sceneGraphFilePath.endswith(f"{SCENE_NAME}.sgr")
+    assert meshProductFolder == f"Assets/Scenes/{SCENE_NAME}/Meshes"
+    assert materialProductFolder == f"Assets/Scenes/{SCENE_NAME}/Materials"
+    assert [request[3:] for request in editor.verifyRequests] == [(0.001, 0.1), (0.01, 0.5)]
+
+
+def test_MemoryReport_DoesNotImport(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--memory_report", "2")
+    output = capsys.readouterr().out
+
+    assert f"Scene '{SCENE_NAME}'" in output
+    assert len(editor.entities) == 0
+    sceneGraphFilePath, meshProductFolder, maxDepth = editor.memoryReportRequests[0]
+    assert sceneGraphFilePath.endswith(f"{SCENE_NAME}.sgr")
+    assert meshProductFolder == f"Assets/Scenes/{SCENE_NAME}/Meshes"
+    assert maxDepth == 2
+
+
+def test_Hlod_DoesNotImport(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--hlod", "50", "--hlod_max_error", "0.5")
+    output = capsys.readouterr().out
+
+    assert f"Scene '{SCENE_NAME}': 0 HLOD cell(s) of 50.0 m" in output
+    assert len(editor.entities) == 0
+    sceneGraphFilePath, meshProductFolder, cellSize, maxError = editor.hlodRequests[0]
+    assert sceneGraphFilePath.endswith(f"{SCENE_NAME}.sgr")
+    assert meshProductFolder == f"Assets/Scenes/{SCENE_NAME}/Meshes"
+    assert (cellSize, maxError) == (50.0, 0.5)
+
+
+def test_WhereUsed_AsksTheProjectIndexAndDoesNotImport(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    productPath = f"Assets/Scenes/{SCENE_NAME}/Materials/Trim_1.material"
+
+    sys.argv = ["o3dimport.py", "--where_used", productPath]
+    importer.Main()
+    output = capsys.readouterr().out
+
+    assert f"'assets/scenes/{SCENE_NAME.lower()}/materials/trim_1.material' is referenced by" in output
+    assert len(editor.entities) == 0
+    scenesFolder, indexFilePath, requestedProductPath = editor.sceneAssetReferenceRequests[0]
+    assert os.path.normpath(scenesFolder) == os.path.join(editor.projectRoot, "Assets", "Scenes")
+    assert indexFilePath == importer.GetDefaultSceneAssetIndexFilePath()
+    assert requestedProductPath == productPath
+
+
+def test_Orphans_DryRunByDefaultAndDoesNotImport(headlessScene, capsys):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+
+    _RunMain(importer, "--orphans")
+    assert "0 orphaned file(s), 0.00 MiB. Dry run" in capsys.readouterr().out
+    _RunMain(importer, "--orphans", "remove")
+    assert "Removed 0." in capsys.readouterr().out
+
+    assert len(editor.entities) == 0
+    assert [removeFiles for _, removeFiles in editor.orphanRequests] == [False, True]
+    assert all(sceneGraphFilePath.endswith(f"{SCENE_NAME}.sgr") for sceneGraphFilePath, _ in editor.orphanRequests)
+
+
+def test_ImportScene_MaterialDescriptions_GeneratesMaterialsAndWaitsForNewOnes(headlessScene, capsys, monkeypatch):
+    editor, _ = headlessScene
+    importer = _LoadImporterModule()
+    monkeypatch.setattr(importer, "MATERIAL_PRODUCTS_TIMEOUT_SECONDS", 0.0)
+    sceneDir = os.path.join(editor.projectRoot, "Assets", "Scenes", SCENE_NAME)
+    with open(os.path.join(sceneDir, f"{SCENE_NAME}.o3mat"), "w") as f:
+        json.dump({"version": 1, "materials": {}}, f)
+    # Material_0 was processed by a previous import, Fresh is new and its product doesn't exist yet.
+    editor.generatedMaterialNames = ["Material_0", "Fresh"]
+    os.makedirs(os.path.join(sceneDir, "Materials"))
+    with open(os.path.join(sceneDir, "Materials", "Material_0.material"), "w") as f:
+        f.write("{}")
+
+    _RunMain(importer, "--verify")
+    assert editor.materialGenerationRequests == []
+    _RunMain(importer)
+    output = capsys.readouterr().out
+
+    assert f"Materials of '{SCENE_NAME}': 2 written" in output
+    assert "Some of the 1 new materials are still being processed" in output
+    assert len(editor.entities) > 0
+    descriptionsFilePath, materialsFolder = editor.materialGenerationRequests[0]
+    assert descriptionsFilePath == os.path.join(sceneDir, f"{SCENE_NAME}.o3mat")
+    assert materialsFolder == os.path.join(sceneDir, "Materials")
+
+    # Fresh is not new anymore, the next import doesn't wait for it.
+    _RunMain(importer, "--force")
+    assert "still being processed" not in capsys.readouterr().out
+    assert len(editor.materialGenerationRequests) == 2
+
+
+def test_ImportScene_OrderByPoint_AssignsMaterialsOfClosestChunkBeforeFarModels(headlessScene):
+    editor, sceneGraph = headlessScene
+    importer = _LoadImporterModule()
+    editor.isCallLogEnabled = True
+    orderPoint = (0.0, 0.0, 0.0)
+
+    _RunMain(importer, "--order", "point", "--point", *[str(value) for value in orderPoint])
+
+    nearestEntity = editor.FindEntitiesByName("Prop_000_00")[0]
+    farthestEntity = editor.FindEntitiesByName("Prop_007_05")[0]
+    nearestMaterialCallIndex = None
+    farthestModelCallIndex = None
+    for callIndex, (callName, args) in enumerate(editor.callLog):
+        if callName != "EditorComponent.set_component_property_value":
+            continue
+        entityId, propertyPath = args[0].value, args[1]
+        if entityId == nearestEntity.id.value and propertyPath.endswith("Material Asset") and nearestMaterialCallIndex is None:
+            nearestMaterialCallIndex = callIndex
+        elif entityId == farthestEntity.id.value and propertyPath == headless_editor.MODEL_ASSET_PROPERTY:
+            farthestModelCallIndex = callIndex
+    assert nearestMaterialCallIndex is not None and farthestModelCallIndex is not None
+    assert nearestMaterialCallIndex < farthestModelCallIndex
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzTest/AzTest.h>
+#include <AzTest/Utils.h>
+
+#include <Tools/HlodProxyBuilder.h>
+#include <Tools/SceneGraph.h>
+
+namespace UnitTest
+{
+    using HlodProxyBuilderTest = LeakDetectionFixture;
+
+    TEST_F(HlodProxyBuilderTest, GroupIntoCells_KeepsSmallSubtreesWhole)
+    {
+        // "House" fits in a 100m cell, so its mesh nodes stay together even though "Chimney" crosses the cell border.
+        // "District" spans two cells, so its children are grouped one by one.
+        constexpr const char* Json = R"({
+            "name": "Town",
+            "children": [
+                {
+                    "name": "House",
+                    "mesh": "Walls",
+                    "transform": { "translate": [90, 10, 0] },
+                    "children": [ { "name": "Chimney", "mesh": "Chimney", "transform": { "translate": [15, 0, 0] } } ]
+                },
+                {
+                    "name": "District",
+                    "children": [
+                        { "name": "West", "mesh": "Block", "transform": { "translate": [10, 250, 0] } },
+                        { "name": "East", "mesh": "Block", "transform": { "translate": [310, 250, 0] } },
+                        { "name": "Empty" }
+                    ]
+                }
+            ]
+        })";
+        auto outcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+
+        const auto cells = o3dimport::HlodProxyBuilder::GroupIntoCells(outcome.GetValue(), 100.0f);
+        ASSERT_EQ(cells.size(), 3);
+        EXPECT_EQ(o3dimport::HlodProxyBuilder::GetCellName(cells[0]), "Cell_0_0");
+        EXPECT_EQ(cells[0].m_nodeIndices, AZStd::vector<AZ::u32>({ 0, 1 }));
+        EXPECT_EQ(o3dimport::HlodProxyBuilder::GetCellName(cells[1]), "Cell_0_2");
+        EXPECT_EQ(cells[1].m_nodeIndices, AZStd::vector<AZ::u32>({ 3 }));
+        EXPECT_EQ(o3dimport::HlodProxyBuilder::GetCellName(cells[2]), "Cell_3_2");
+        EXPECT_EQ(cells[2].m_nodeIndices, AZStd::vector<AZ::u32>({ 4 }));
+    }
+
+    TEST_F(HlodProxyBuilderTest, MergeCell_TransformsToWorldSpace)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(R"({"children": [
+            { "name": "A", "mesh": "Quad", "transform": { "translate": [10, 0, 0], "scale": [2, 2, 2] } },
+            { "name": "B", "mesh": "Missing" }
+        ]})");
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+
+        AZStd::unordered_map<AZStd::string, o3dimport::HlodMeshGeometry> geometryByMesh;
+        o3dimport::HlodMeshGeometry::SubMesh& subMesh = geometryByMesh["Quad"].m_subMeshes.emplace_back();
+        subMesh.m_materialName = "Brick";
+        subMesh.m_positions = { AZ::Vector3(0.0f), AZ::Vector3(1.0f, 0.0f, 0.0f), AZ::Vector3(1.0f, 1.0f, 0.0f),
+                                AZ::Vector3(0.0f, 1.0f, 0.0f) };
+        subMesh.m_indices = { 0, 1, 2, 0, 2, 3 };
+
+        o3dimport::HlodCell cell;
+        cell.m_nodeIndices = { 0, 1 };
+        const o3dimport::HlodProxyMesh merged = o3dimport::HlodProxyBuilder::MergeCell(outcome.GetValue(), cell, geometryByMesh);
+        EXPECT_EQ(merged.GetTriangleCount(), 2);
+        EXPECT_EQ(merged.m_materialNames, AZStd::vector<AZStd::string>({ "Brick" }));
+        ASSERT_EQ(merged.m_positions.size(), 4);
+        EXPECT_TRUE(merged.m_positions[2].IsClose(AZ::Vector3(12.0f, 2.0f, 0.0f)));
+    }
+
+    TEST_F(HlodProxyBuilderTest, Simplify_WeldsVerticesWithinTheTargetError)
+    {
+        // Two quads, the second one a 1cm thin sliver next to the first.
+        o3dimport::HlodProxyMesh mesh;
+        mesh.m_materialNames = { "Brick", "Roof" };
+        mesh.m_positions = { AZ::Vector3(0.0f, 0.0f, 0.0f), AZ::Vector3(4.0f, 0.0f, 0.0f), AZ::Vector3(4.0f, 4.0f, 0.0f),
+                             AZ::Vector3(0.0f, 4.0f, 0.0f), AZ::Vector3(4.01f, 0.0f, 0.0f), AZ::Vector3(4.01f, 4.0f, 0.0f) };
+        mesh.m_indices = { 0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2 };
+        mesh.m_triangleMaterials = { 0, 0, 1, 1 };
+
+        const o3dimport::HlodProxyMesh unchanged = o3dimport::HlodProxyBuilder::Simplify(mesh, 0.0f);
+        EXPECT_EQ(unchanged.GetTriangleCount(), 4);
+
+        const o3dimport::HlodProxyMesh simplified = o3dimport::HlodProxyBuilder::Simplify(mesh, 0.5f);
+        EXPECT_EQ(simplified.GetTriangleCount(), 2);
+        EXPECT_EQ(simplified.m_triangleMaterials, AZStd::vector<AZ::u32>({ 0, 0 }));
+        EXPECT_EQ(simplified.m_positions.size(), 4);
+        for (const AZ::Vector3& position : simplified.m_positions)
+        {
+            bool isWithinError = false;
+            for (const AZ::Vector3& original : mesh.m_positions)
+            {
+                isWithinError = isWithinError || position.GetDistance(original) <= 0.5f;
+            }
+            EXPECT_TRUE(isWithinError);
+        }
+    }
+
+    TEST_F(HlodProxyBuilderTest, RemoveStaleProxies_KeepsOnlyTheListedCells)
+    {
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string outputFolder(tempDirectory.GetDirectory());
+        // Cell_1_0 was written by a previous build with a larger cell size.
+        for (const char* fileName : { "Cell_0_0.obj", "Cell_0_0.material", "Cell_0_0_basecolor.png", "Cell_1_0.obj",
+                                      "Cell_1_0.material", "Cell_1_0_basecolor.png", "Cell_-1_10.obj", "HLOD.json", "Notes.txt" })
+        {
+            ASSERT_TRUE(AZ::Utils::WriteFile("written", outputFolder + "/" + fileName).IsSuccess());
+        }
+
+        const AZ::u32 removedCount = o3dimport::HlodProxyBuilder::RemoveStaleProxies(outputFolder, { "Cell_0_0", "Cell_-1_10" });
+
+        EXPECT_EQ(removedCount, 3);
+        for (const char* fileName : { "Cell_0_0.obj", "Cell_0_0.material", "Cell_0_0_basecolor.png", "Cell_-1_10.obj", "HLOD.json",
+                                      "Notes.txt" })
+        {
+            EXPECT_TRUE(AZ::IO::SystemFile::Exists((outputFolder + "/" + fileName).c_str())) << fileName;
+        }
+        for (const char* fileName : { "Cell_1_0.obj", "Cell_1_0.material", "Cell_1_0_basecolor.png" })
+        {
+            EXPECT_FALSE(AZ::IO::SystemFile::Exists((outputFolder + "/" + fileName).c_str())) << fileName;
+        }
+    }
+} // namespace UnitTest
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Math/Quaternion.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/LazyAssetAssigner.h>
+
+namespace UnitTest
+{
+    using LazyAssetAssignerTest = LeakDetectionFixture;
+
+    TEST_F(LazyAssetAssignerTest, CalculateBoundingSphere_EnclosesTheTransformedModelBounds)
+    {
+        const AZ::Aabb unitBox = AZ::Aabb::CreateFromMinMax(AZ::Vector3(-1.0f), AZ::Vector3(1.0f));
+        AZ::Transform worldTM = AZ::Transform::CreateTranslation(AZ::Vector3(10.0f, 0.0f, 0.0f));
+        worldTM.SetUniformScale(2.0f);
+
+        AZ::Sphere sphere = o3dimport::LazyAssetAssigner::CalculateBoundingSphere(unitBox, worldTM, AZ::Vector3::CreateOne());
+        EXPECT_TRUE(sphere.GetCenter().IsClose(AZ::Vector3(10.0f, 0.0f, 0.0f)));
+        EXPECT_NEAR(sphere.GetRadius(), 2.0f * AZStd::sqrt(3.0f), 0.001f);
+
+        // A long model, stretched again by the non uniform scale.
+        sphere = o3dimport::LazyAssetAssigner::CalculateBoundingSphere(unitBox, worldTM, AZ::Vector3(1.0f, 3.0f, 1.0f));
+        EXPECT_NEAR(sphere.GetRadius(), 2.0f * AZStd::sqrt(11.0f), 0.001f);
+
+        // Models are rarely centered on their origin, e.g. a wall that starts at it.
+        const AZ::Aabb wallBox = AZ::Aabb::CreateFromMinMax(AZ::Vector3(0.0f, -0.5f, 0.0f), AZ::Vector3(4.0f, 0.5f, 3.0f));
+        worldTM = AZ::Transform::CreateFromQuaternionAndTranslation(
+            AZ::Quaternion::CreateRotationZ(AZ::Constants::HalfPi), AZ::Vector3(10.0f, 0.0f, 0.0f));
+        sphere = o3dimport::LazyAssetAssigner::CalculateBoundingSphere(wallBox, worldTM, AZ::Vector3(2.0f, 1.0f, 1.0f));
+        EXPECT_TRUE(sphere.GetCenter().IsClose(AZ::Vector3(10.0f, 4.0f, 1.5f)));
+        EXPECT_NEAR(sphere.GetRadius(), AZ::Vector3(4.0f, 0.5f, 1.5f).GetLength(), 0.001f);
+    }
+} // namespace UnitTest
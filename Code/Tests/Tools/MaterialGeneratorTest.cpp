@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzTest/AzTest.h>
+#include <AzTest/Utils.h>
+
+#include <Tools/MaterialGenerator.h>
+
+namespace UnitTest
+{
+    using MaterialGeneratorTest = LeakDetectionFixture;
+
+    //! Generate() writes the materials on the job system.
+    class MaterialGeneratorGenerateTest : public LeakDetectionFixture
+    {
+    public:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZ::JobManagerDesc jobManagerDesc;
+            jobManagerDesc.m_workerThreads.resize(2);
+            m_jobManager = AZStd::make_unique<AZ::JobManager>(jobManagerDesc);
+            m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+            AZ::JobContext::SetGlobalContext(m_jobContext.get());
+            m_descriptionsFilePath = AZStd::string::format("%s/Town/Town.o3mat", m_tempDirectory.GetDirectory());
+            m_materialsFolder = AZStd::string::format("%s/Town/Materials", m_tempDirectory.GetDirectory());
+        }
+
+        void TearDown() override
+        {
+            AZ::JobContext::SetGlobalContext(nullptr);
+            m_jobContext.reset();
+            m_jobManager.reset();
+            m_descriptionsFilePath = {};
+            m_materialsFolder = {};
+            LeakDetectionFixture::TearDown();
+        }
+
+        void WriteDescriptions(const char* jsonText) const
+        {
+            ASSERT_TRUE(AZ::Utils::WriteFile(jsonText, m_descriptionsFilePath).IsSuccess());
+        }
+
+        AZStd::string ReadMaterial(const char* materialName) const
+        {
+            auto readOutcome =
+                AZ::Utils::ReadFile<AZStd::string>(AZStd::string::format("%s/%s.material", m_materialsFolder.c_str(), materialName));
+            return readOutcome.IsSuccess() ? readOutcome.TakeValue() : AZStd::string();
+        }
+
+    protected:
+        AZ::Test::ScopedAutoTempDirectory m_tempDirectory;
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+        AZStd::string m_descriptionsFilePath;
+        AZStd::string m_materialsFolder;
+    };
+
+    TEST_F(MaterialGeneratorTest, GenerateMaterial_MapsPrincipledBsdfSockets)
+    {
+        rapidjson::Document description;
+        description.Parse(R"({
+            "Base Color": { "type": "RGBA", "value": [1.0, 0.5, 0.25, 1.0], "textureName": "Brick",
+                            "texturePath": "@projectroot@/Assets/Scenes/Town/Textures/Brick.png" },
+            "Metallic": { "type": "VALUE", "value": 0.0, "textureName": "" },
+            "Roughness": { "type": "VALUE", "value": 0.5, "textureName": "Rough", "textureChannel": "Green",
+                           "texturePath": "@projectroot@/Assets/Scenes/Town/Textures/Rough_Green.png" },
+            "Alpha": { "type": "VALUE", "value": 0.5 },
+            "Normal": { "type": "VECTOR", "strength": 2.0, "textureName": "Bumps",
+                        "texturePath": "@projectroot@/Assets/Scenes/Town/Textures/Bumps_normal.png" },
+            "Specular MultiScatter Compensation": { "value": 1.0 }
+        })");
+        ASSERT_FALSE(description.HasParseError());
+
+        const rapidjson::Document material = o3dimport::MaterialGenerator::GenerateMaterial(description, false, true);
+        ASSERT_TRUE(material.HasMember("propertyValues"));
+        EXPECT_EQ(material["materialTypeVersion"].GetInt(), 5);
+        const rapidjson::Value& properties = material["propertyValues"];
+        EXPECT_STREQ(properties["baseColor.textureMap"].GetString(), "@projectroot@/Assets/Scenes/Town/Textures/Brick.png");
+        EXPECT_EQ(properties["baseColor.color"].Size(), 4);
+        EXPECT_FALSE(properties.HasMember("baseColor.useTexture"));
+        EXPECT_FALSE(properties["metallic.useTexture"].GetBool());
+        EXPECT_FALSE(properties.HasMember("metallic.textureMap"));
+        EXPECT_TRUE(properties["roughness.useTexture"].GetBool());
+        EXPECT_STREQ(properties["roughness.textureMap"].GetString(), "@projectroot@/Assets/Scenes/Town/Textures/Rough_Green.png");
+        EXPECT_STREQ(properties["opacity.mode"].GetString(), "Blended");
+        EXPECT_DOUBLE_EQ(properties["normal.factor"].GetDouble(), 2.0);
+        EXPECT_FALSE(properties["normal.flipX"].GetBool());
+        EXPECT_TRUE(properties["normal.flipY"].GetBool());
+        EXPECT_TRUE(properties["specularF0.enableMultiScatterCompensation"].GetBool());
+    }
+
+    TEST_F(MaterialGeneratorGenerateTest, Generate_WritesOnlyChangedMaterials)
+    {
+        WriteDescriptions(R"({ "version": 1, "overwrite": true, "materials": {
+            "Brick": { "Roughness": { "value": 0.75 } },
+            "Glass": { "Alpha": { "value": 0.25 } },
+            "Bad/Name": { "Roughness": { "value": 0.5 } }
+        } })");
+
+        AZStd::string report = o3dimport::MaterialGenerator::Generate(m_descriptionsFilePath, m_materialsFolder);
+        EXPECT_TRUE(report.starts_with("Materials of 'Town': 2 written, 0 unchanged, 0 kept, 1 failed")) << report.c_str();
+        EXPECT_NE(report.find("    Bad/Name: "), AZStd::string::npos) << report.c_str();
+        EXPECT_NE(ReadMaterial("Brick").find("\"roughness.factor\": 0.75"), AZStd::string::npos);
+        EXPECT_NE(ReadMaterial("Glass").find("\"opacity.mode\": \"Blended\""), AZStd::string::npos);
+
+        WriteDescriptions(R"({ "version": 1, "overwrite": true, "materials": {
+            "Brick": { "Roughness": { "value": 0.75 } },
+            "Glass": { "Alpha": { "value": 1.0 } }
+        } })");
+        report = o3dimport::MaterialGenerator::Generate(m_descriptionsFilePath, m_materialsFolder);
+        EXPECT_TRUE(report.starts_with("Materials of 'Town': 1 written, 1 unchanged, 0 kept, 0 failed")) << report.c_str();
+        EXPECT_NE(ReadMaterial("Glass").find("\"opacity.mode\": \"Opaque\""), AZStd::string::npos);
+
+        // The artist tweaked the materials in O3DE, and exported without overwriting them.
+        WriteDescriptions(R"({ "version": 1, "overwrite": false, "materials": {
+            "Brick": { "Roughness": { "value": 0.25 } },
+            "Tiles": { "Roughness": { "value": 0.25 } }
+        } })");
+        report = o3dimport::MaterialGenerator::Generate(m_descriptionsFilePath, m_materialsFolder);
+        EXPECT_TRUE(report.starts_with("Materials of 'Town': 1 written, 0 unchanged, 1 kept, 0 failed")) << report.c_str();
+        EXPECT_NE(ReadMaterial("Brick").find("\"roughness.factor\": 0.75"), AZStd::string::npos);
+        EXPECT_FALSE(ReadMaterial("Tiles").empty());
+    }
+
+    TEST_F(MaterialGeneratorGenerateTest, Generate_RejectsOtherVersions)
+    {
+        WriteDescriptions(R"({ "version": 2, "materials": { "Brick": {} } })");
+        AZ_TEST_START_TRACE_SUPPRESSION;
+        EXPECT_TRUE(o3dimport::MaterialGenerator::Generate(m_descriptionsFilePath, m_materialsFolder).empty());
+        AZ_TEST_STOP_TRACE_SUPPRESSION(1);
+        EXPECT_FALSE(AZ::IO::SystemFile::Exists(m_materialsFolder.c_str()));
+    }
+} // namespace UnitTest
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzTest/AzTest.h>
+#include <AzTest/Utils.h>
+
+#include <Tools/OrphanedAssetCollector.h>
+#include <Tools/SceneGraph.h>
+
+namespace UnitTest
+{
+    using OrphanedAssetCollectorTest = LeakDetectionFixture;
+
+    namespace
+    {
+        constexpr const char* SceneGraphJson = R"({
+            "name": "Town",
+            "children": [
+                { "name": "Wall", "mesh": "Wall", "materials": [ "Brick" ] },
+                { "name": "Lamp", "mesh": "Lamp", "materials": [ "Brick", "Glass" ] }
+            ]
+        })";
+
+        constexpr const char* BrickMaterialJson = R"({
+            "propertyValues": {
+                "baseColor.textureMap": "@projectroot@/Assets/Scenes/Town/Textures/Wood002.png",
+                "normal.textureMap": "@projectroot@/Assets/Scenes/Town/Textures/Wood002_normal.png"
+            }
+        })";
+
+        //! An exported scene with a few files that the SceneGraph no longer reaches. Glass.material was never exported.
+        void WriteSceneFiles(const AZStd::string& sceneFolder, const char* brickMaterialJson)
+        {
+            for (const char* relativePath : { "Meshes/Wall.fbx", "Meshes/Wall.fbx.assetinfo", "Meshes/Lamp.fbx", "Meshes/Removed.fbx",
+                                              "Materials/Stale.material", "Textures/Wood002.png", "Textures/Wood001.png",
+                                              "Textures/Wood_normal.png", "Textures/Wood002_normal.png", "Textures/Unused.png" })
+            {
+                ASSERT_TRUE(AZ::Utils::WriteFile("exported", sceneFolder + "/" + relativePath).IsSuccess());
+            }
+            ASSERT_TRUE(AZ::Utils::WriteFile(brickMaterialJson, sceneFolder + "/Materials/Brick.material").IsSuccess());
+        }
+
+        bool Exists(const AZStd::string& sceneFolder, const char* relativePath)
+        {
+            return AZ::IO::SystemFile::Exists((sceneFolder + "/" + relativePath).c_str());
+        }
+    } // namespace
+
+    TEST_F(OrphanedAssetCollectorTest, GetVersionlessName_RemovesTheExporterVersion)
+    {
+        // The exporter renames 'Image.png' -> 'Image111.png', and 'Image001.png' -> 'Image002.png'.
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Image.png"), "image.png");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Image111.png"), "image.png");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Image002.png"), "image.png");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Image001_normal.jpg"), "image_normal.jpg");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Image_normal.jpg"), "image_normal.jpg");
+    }
+
+    TEST_F(OrphanedAssetCollectorTest, GetVersionlessName_KeepsNamesWithoutVersion)
+    {
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("1024.png"), "1024.png");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Wall_2k.png"), "wall_2k.png");
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::GetVersionlessName("Wall"), "wall");
+    }
+
+    TEST_F(OrphanedAssetCollectorTest, Collect_DryRun_ListsUnreachableFilesWithoutRemovingThem)
+    {
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string sceneFolder = AZStd::string::format("%s/Town", tempDirectory.GetDirectory());
+        WriteSceneFiles(sceneFolder, BrickMaterialJson);
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+
+        EXPECT_EQ(o3dimport::OrphanedAssetCollector::Collect(loadOutcome.GetValue(), sceneFolder, false),
+            "Scene 'Town': 5 orphaned file(s), 0.00 MiB. Dry run, nothing was removed.\n"
+            "    Materials/Stale.material 0.00 MiB\n"
+            "    Meshes/Removed.fbx 0.00 MiB\n"
+            "    Textures/Unused.png 0.00 MiB\n"
+            "    Textures/Wood001.png 0.00 MiB, older version of Wood002.png\n"
+            "    Textures/Wood_normal.png 0.00 MiB, older version of Wood002_normal.png\n");
+        EXPECT_TRUE(Exists(sceneFolder, "Meshes/Removed.fbx"));
+        EXPECT_TRUE(Exists(sceneFolder, "Textures/Wood001.png"));
+    }
+
+    TEST_F(OrphanedAssetCollectorTest, Collect_Remove_DeletesOnlyUnreachableFiles)
+    {
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string sceneFolder = AZStd::string::format("%s/Town", tempDirectory.GetDirectory());
+        WriteSceneFiles(sceneFolder, BrickMaterialJson);
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+
+        const AZStd::string report = o3dimport::OrphanedAssetCollector::Collect(loadOutcome.GetValue(), sceneFolder, true);
+        EXPECT_TRUE(report.starts_with("Scene 'Town': 5 orphaned file(s), 0.00 MiB. Removed 5.\n"));
+        EXPECT_FALSE(report.contains("FAILED"));
+        for (const char* relativePath : { "Materials/Stale.material", "Meshes/Removed.fbx", "Textures/Unused.png",
+                                          "Textures/Wood001.png", "Textures/Wood_normal.png" })
+        {
+            EXPECT_FALSE(Exists(sceneFolder, relativePath)) << relativePath;
+        }
+        for (const char* relativePath : { "Meshes/Wall.fbx", "Meshes/Wall.fbx.assetinfo", "Meshes/Lamp.fbx", "Materials/Brick.material",
+                                          "Textures/Wood002.png", "Textures/Wood002_normal.png" })
+        {
+            EXPECT_TRUE(Exists(sceneFolder, relativePath)) << relativePath;
+        }
+    }
+
+    TEST_F(OrphanedAssetCollectorTest, Collect_UnreadableMaterial_KeepsAllTextures)
+    {
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string sceneFolder = AZStd::string::format("%s/Town", tempDirectory.GetDirectory());
+        WriteSceneFiles(sceneFolder, "{ not json");
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+
+        const AZStd::string report = o3dimport::OrphanedAssetCollector::Collect(loadOutcome.GetValue(), sceneFolder, true);
+        EXPECT_TRUE(report.starts_with("Scene 'Town': 2 orphaned file(s), 0.00 MiB. Removed 2.\n"));
+        EXPECT_TRUE(report.ends_with("    Textures were not collected, Materials/Brick.material can't be read.\n"));
+        EXPECT_TRUE(Exists(sceneFolder, "Textures/Unused.png"));
+    }
+} // namespace UnitTest
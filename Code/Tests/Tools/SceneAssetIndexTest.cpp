@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzTest/AzTest.h>
+#include <AzTest/Utils.h>
+
+#include <Tools/SceneAssetIndex.h>
+#include <Tools/SceneGraph.h>
+
+namespace UnitTest
+{
+    using SceneAssetIndexTest = LeakDetectionFixture;
+
+    //! Update() parses the SceneGraph files on the job system.
+    class SceneAssetIndexUpdateTest : public LeakDetectionFixture
+    {
+    public:
+        using References = AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>>;
+
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZ::JobManagerDesc jobManagerDesc;
+            jobManagerDesc.m_workerThreads.resize(2);
+            m_jobManager = AZStd::make_unique<AZ::JobManager>(jobManagerDesc);
+            m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+            AZ::JobContext::SetGlobalContext(m_jobContext.get());
+            m_projectFolder = m_tempDirectory.GetDirectory();
+            m_scenesFolder = AZStd::string::format("%s/Assets/Scenes", m_tempDirectory.GetDirectory());
+            m_indexFilePath = AZStd::string::format("%s/user/SceneAssetIndex.json", m_tempDirectory.GetDirectory());
+        }
+
+        void TearDown() override
+        {
+            AZ::JobContext::SetGlobalContext(nullptr);
+            m_jobContext.reset();
+            m_jobManager.reset();
+            m_projectFolder = {};
+            m_scenesFolder = {};
+            m_indexFilePath = {};
+            LeakDetectionFixture::TearDown();
+        }
+
+        void WriteSceneGraph(const char* sceneName, const char* jsonText) const
+        {
+            const AZStd::string filePath = AZStd::string::format("%s/%s/%s.sgr", m_scenesFolder.c_str(), sceneName, sceneName);
+            ASSERT_TRUE(AZ::Utils::WriteFile(jsonText, filePath).IsSuccess());
+        }
+
+    protected:
+        AZ::Test::ScopedAutoTempDirectory m_tempDirectory;
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+        AZStd::string m_projectFolder;
+        AZStd::string m_scenesFolder;
+        AZStd::string m_indexFilePath;
+    };
+
+    TEST_F(SceneAssetIndexTest, NormalizeProductPath_AcceptsSourcePaths)
+    {
+        EXPECT_EQ(o3dimport::SceneAssetIndex::NormalizeProductPath("Assets\\Scenes\\Town\\Meshes\\Wall.fbx"),
+            "assets/scenes/town/meshes/wall.fbx.azmodel");
+        EXPECT_EQ(o3dimport::SceneAssetIndex::NormalizeProductPath("Assets/Scenes/Town/Materials/Brick.material"),
+            "assets/scenes/town/materials/brick.azmaterial");
+        EXPECT_EQ(o3dimport::SceneAssetIndex::NormalizeProductPath("Assets/Scenes/Town/Materials/Brick.azmaterial"),
+            "assets/scenes/town/materials/brick.azmaterial");
+    }
+
+    TEST_F(SceneAssetIndexTest, CollectReferences_MapsProductsToNodePaths)
+    {
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(R"({
+            "name": "Town",
+            "children": [
+                { "name": "Block", "children": [
+                    { "name": "Wall_A", "mesh": "Wall", "materials": [ "Brick", "Brick" ] },
+                    { "name": "Wall_B", "mesh": "Wall", "materials": [ "Brick", "Trim" ] } ] },
+                { "name": "Lamp", "mesh": "Lamp", "materials": [ "Trim" ] } ]
+        })");
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+
+        const o3dimport::SceneAssetReferences references =
+            o3dimport::SceneAssetIndex::CollectReferences(loadOutcome.GetValue(), "Assets/Scenes/Town");
+        EXPECT_EQ(references.size(), 4);
+        const AZStd::vector<AZStd::string> wallPaths = { "Block/Wall_A", "Block/Wall_B" };
+        const AZStd::vector<AZStd::string> trimPaths = { "Block/Wall_B", "Lamp" };
+        EXPECT_EQ(references.at("assets/scenes/town/meshes/wall.fbx.azmodel"), wallPaths);
+        // A node that uses the same material in two slots is listed once.
+        EXPECT_EQ(references.at("assets/scenes/town/materials/brick.azmaterial"), wallPaths);
+        EXPECT_EQ(references.at("assets/scenes/town/materials/trim.azmaterial"), trimPaths);
+        EXPECT_EQ(references.at("assets/scenes/town/meshes/lamp.fbx.azmodel"), AZStd::vector<AZStd::string>{ "Lamp" });
+    }
+
+    TEST_F(SceneAssetIndexUpdateTest, Update_ParsesOnlyChangedSceneGraphs)
+    {
+        WriteSceneGraph("Town", R"({ "name": "Town", "children": [ { "name": "Wall", "mesh": "Wall", "materials": [ "Brick" ] } ] })");
+        WriteSceneGraph("Farm", R"({ "name": "Farm", "children": [ { "name": "Barn", "mesh": "Barn" } ] })");
+        // Not a scene, the SceneGraph is not named after its folder.
+        ASSERT_TRUE(AZ::Utils::WriteFile("{}", m_scenesFolder + "/Empty/Other.sgr").IsSuccess());
+
+        o3dimport::SceneAssetIndex index;
+        EXPECT_EQ(index.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 2);
+        EXPECT_EQ(index.GetSceneCount(), 2);
+        EXPECT_EQ(index.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 0);
+        EXPECT_EQ(index.FindReferences("Assets/Scenes/Town/Meshes/Wall.fbx"), (References{ { "Town", "Wall" } }));
+        EXPECT_EQ(index.FindReferences("Assets/Scenes/Town/Materials/Brick.material"), (References{ { "Town", "Wall" } }));
+
+        // One SceneGraph changes, the other one is removed.
+        WriteSceneGraph("Town", R"({ "name": "Town", "children": [ { "name": "Wall_Renamed", "mesh": "Wall" } ] })");
+        ASSERT_TRUE(AZ::IO::SystemFile::Delete((m_scenesFolder + "/Farm/Farm.sgr").c_str()));
+        EXPECT_EQ(index.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 1);
+        EXPECT_EQ(index.GetSceneCount(), 1);
+        EXPECT_EQ(index.FindReferences("Assets/Scenes/Town/Meshes/Wall.fbx"), (References{ { "Town", "Wall_Renamed" } }));
+        EXPECT_TRUE(index.FindReferences("Assets/Scenes/Town/Materials/Brick.material").empty());
+        EXPECT_TRUE(index.FindReferences("Assets/Scenes/Farm/Meshes/Barn.fbx").empty());
+    }
+
+    TEST_F(SceneAssetIndexUpdateTest, Update_LoadsTheSavedIndexInsteadOfParsing)
+    {
+        WriteSceneGraph(
+            "Town", R"({ "name": "Town", "children": [ { "name": "Block", "children": [ { "name": "Wall", "mesh": "Wall" } ] } ] })");
+        {
+            o3dimport::SceneAssetIndex index;
+            EXPECT_EQ(index.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 1);
+        }
+        ASSERT_TRUE(AZ::IO::SystemFile::Exists(m_indexFilePath.c_str()));
+
+        o3dimport::SceneAssetIndex reloadedIndex;
+        EXPECT_EQ(reloadedIndex.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 0);
+        EXPECT_EQ(reloadedIndex.GetSceneCount(), 1);
+        EXPECT_EQ(reloadedIndex.FindReferences("assets/scenes/town/meshes/wall.fbx.azmodel"), (References{ { "Town", "Block/Wall" } }));
+
+        // An index of another version is ignored, and every SceneGraph is parsed again.
+        ASSERT_TRUE(AZ::Utils::WriteFile(R"({ "version": 0, "scenes": {} })", m_indexFilePath).IsSuccess());
+        o3dimport::SceneAssetIndex outdatedIndex;
+        EXPECT_EQ(outdatedIndex.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 1);
+        EXPECT_EQ(outdatedIndex.FindReferences("Assets/Scenes/Town/Meshes/Wall.fbx"), (References{ { "Town", "Block/Wall" } }));
+    }
+
+    TEST_F(SceneAssetIndexUpdateTest, Update_MapsProductsWithinTheScenesFolder)
+    {
+        m_scenesFolder = AZStd::string::format("%s/Levels/Scenes", m_tempDirectory.GetDirectory());
+        WriteSceneGraph("Town", R"({ "name": "Town", "children": [ { "name": "Wall", "mesh": "Wall" } ] })");
+        {
+            o3dimport::SceneAssetIndex index;
+            EXPECT_EQ(index.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 1);
+            EXPECT_EQ(index.FindReferences("Levels/Scenes/Town/Meshes/Wall.fbx"), (References{ { "Town", "Wall" } }));
+            EXPECT_TRUE(index.FindReferences("Assets/Scenes/Town/Meshes/Wall.fbx").empty());
+        }
+
+        // The saved index was made for another scenes folder, its product paths don't match.
+        m_scenesFolder = AZStd::string::format("%s/Assets/Scenes", m_tempDirectory.GetDirectory());
+        WriteSceneGraph("Town", R"({ "name": "Town", "children": [ { "name": "Wall", "mesh": "Wall" } ] })");
+        o3dimport::SceneAssetIndex otherIndex;
+        EXPECT_EQ(otherIndex.Update(m_scenesFolder, m_projectFolder, m_indexFilePath), 1);
+        EXPECT_EQ(otherIndex.FindReferences("Assets/Scenes/Town/Meshes/Wall.fbx"), (References{ { "Town", "Wall" } }));
+
+        // Outside of the project there are no product paths.
+        AZ_TEST_START_TRACE_SUPPRESSION;
+        EXPECT_EQ(otherIndex.Update(m_scenesFolder, m_projectFolder + "/Other", m_indexFilePath), 0);
+        AZ_TEST_STOP_TRACE_SUPPRESSION(1);
+        EXPECT_EQ(otherIndex.GetSceneCount(), 0);
+    }
+} // namespace UnitTest
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <benchmark/benchmark.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphKeys.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // The keys in the order they appear in the .sgr files written by the Blender exporter,
+        // plus one key that the importer doesn't know about.
+        constexpr AZStd::string_view MemberNames[] = { "name", "transform", "mesh", "materials", "children", "track", "custom_properties" };
+
+        o3dimport::SceneGraphNodeKey FindNodeKeyWithCompares(AZStd::string_view memberName)
+        {
+            if (memberName == "name")
+            {
+                return o3dimport::SceneGraphNodeKey::Name;
+            }
+            if (memberName == "transform")
+            {
+                return o3dimport::SceneGraphNodeKey::Transform;
+            }
+            if (memberName == "mesh")
+            {
+                return o3dimport::SceneGraphNodeKey::Mesh;
+            }
+            if (memberName == "materials")
+            {
+                return o3dimport::SceneGraphNodeKey::Materials;
+            }
+            if (memberName == "children")
+            {
+                return o3dimport::SceneGraphNodeKey::Children;
+            }
+            if (memberName == "track")
+            {
+                return o3dimport::SceneGraphNodeKey::Track;
+            }
+            return o3dimport::SceneGraphNodeKey::Count;
+        }
+
+        //! A flat scene of @nodeCount nodes, each one with a mesh, two materials and a transform.
+        AZStd::string MakeSceneGraphJson(int nodeCount)
+        {
+            AZStd::string json = R"({"name":"Benchmark","children":[)";
+            for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+            {
+                json += AZStd::string::format(
+                    R"(%s{"name":"Node%d","transform":{"translate":[%d,0,0],"rotate":[0,0,45],"scale":[1,1,1]},)"
+                    R"("mesh":"Mesh%d","materials":["A","B"],"children":[]})",
+                    nodeIndex ? "," : "", nodeIndex, nodeIndex, nodeIndex % 64);
+            }
+            json += "]}";
+            return json;
+        }
+
+        //! A flat scene of @nodeCount animated nodes. Each track has @keyCount keys per channel, one every 1/30 of a second.
+        AZStd::string MakeAnimatedSceneGraphJson(int nodeCount, int keyCount)
+        {
+            AZStd::string times;
+            AZStd::string vectors;
+            AZStd::string rotations;
+            for (int keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+            {
+                const char* separator = keyIndex ? "," : "";
+                times += AZStd::string::format("%s%f", separator, keyIndex / 30.0f);
+                vectors += AZStd::string::format("%s%d,1,1", separator, keyIndex);
+                // Identity rotation, with the dropped component w: index 3 sets the top bit of the first two values.
+                rotations += AZStd::string::format("%s49151,49151,16383", separator);
+            }
+            const AZStd::string track = AZStd::string::format(
+                R"({"translate":{"times":[%s],"values":[%s]},"rotate":{"times":[%s],"values":[%s]},"scale":{"times":[%s],"values":[%s]}})",
+                times.c_str(), vectors.c_str(), times.c_str(), rotations.c_str(), times.c_str(), vectors.c_str());
+
+            AZStd::string json = R"({"name":"Benchmark","children":[)";
+            for (int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+            {
+                json += AZStd::string::format(R"(%s{"name":"Node%d","track":%s})", nodeIndex ? "," : "", nodeIndex, track.c_str());
+            }
+            json += "]}";
+            return json;
+        }
+    } // namespace
+
+    class SceneGraphBenchmarkFixture : public UnitTest::AllocatorsBenchmarkFixture
+    {
+    };
+
+    BENCHMARK_F(SceneGraphBenchmarkFixture, BM_FindNodeKey_PerfectHash)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (AZStd::string_view memberName : MemberNames)
+            {
+                benchmark::DoNotOptimize(o3dimport::SceneGraphNodeKeys.Find(memberName, o3dimport::SceneGraphNodeKey::Count));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * AZStd::size(MemberNames));
+    }
+
+    BENCHMARK_F(SceneGraphBenchmarkFixture, BM_FindNodeKey_StringCompares)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (AZStd::string_view memberName : MemberNames)
+            {
+                benchmark::DoNotOptimize(FindNodeKeyWithCompares(memberName));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * AZStd::size(MemberNames));
+    }
+
+    BENCHMARK_DEFINE_F(SceneGraphBenchmarkFixture, BM_LoadFromString)(benchmark::State& state)
+    {
+        const AZStd::string json = MakeSceneGraphJson(aznumeric_cast<int>(state.range(0)));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            auto outcome = o3dimport::SceneGraph::LoadFromString(json);
+            benchmark::DoNotOptimize(outcome);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * json.size());
+    }
+    BENCHMARK_REGISTER_F(SceneGraphBenchmarkFixture, BM_LoadFromString)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+    BENCHMARK_DEFINE_F(SceneGraphBenchmarkFixture, BM_SampleTransformTracks)(benchmark::State& state)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(MakeAnimatedSceneGraphJson(aznumeric_cast<int>(state.range(0)), 30));
+        if (!outcome.IsSuccess())
+        {
+            state.SkipWithError(outcome.GetError().c_str());
+            return;
+        }
+        const o3dimport::TransformTrackSet& tracks = outcome.GetValue().GetTransformTracks();
+        AZStd::vector<o3dimport::TransformTrackPose> poses;
+        float time = 0.0f;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            tracks.SampleAll(time, true, poses);
+            benchmark::DoNotOptimize(poses.data());
+            time += 1.0f / 60.0f;
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK_REGISTER_F(SceneGraphBenchmarkFixture, BM_SampleTransformTracks)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphEntityBuilder.h>
+
+namespace UnitTest
+{
+    using SceneGraphEntityBuilderTest = LeakDetectionFixture;
+
+    namespace
+    {
+        // Depth first: A(0) { A1(1) { A11(2) } A2(3) } B(4) C(5) { C1(6) C2(7) C3(8) C4(9) C5(10) }
+        constexpr const char* SceneGraphJson = R"({
+            "name": "Town",
+            "version": 2,
+            "children": [
+                { "name": "A", "children": [ { "name": "A1", "children": [ { "name": "A11" } ] }, { "name": "A2" } ] },
+                { "name": "B" },
+                { "name": "C", "children": [ { "name": "C1" }, { "name": "C2" }, { "name": "C3" }, { "name": "C4" }, { "name": "C5" } ] }
+            ]
+        })";
+    } // namespace
+
+    TEST_F(SceneGraphEntityBuilderTest, ResolveEntityIds_ReusesExistingEntitiesAndGeneratesTheOthers)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const o3dimport::SceneGraph& sceneGraph = outcome.GetValue();
+
+        // A child of an existing entity can be new, and a new entity can have existing children.
+        const AZStd::unordered_map<AZStd::string, AZ::EntityId> existingEntityIds = {
+            { "A", AZ::EntityId(1000) }, { "A11", AZ::EntityId(1002) }, { "C3", AZ::EntityId(1008) }, { "Tower", AZ::EntityId(2000) }
+        };
+        AZStd::vector<size_t> generatedNodeIndices;
+        AZStd::vector<AZ::EntityId> entityIds;
+        AZStd::vector<bool> isNew;
+        const AZ::u32 newEntityCount = o3dimport::SceneGraphEntityBuilder::ResolveEntityIds(
+            sceneGraph, existingEntityIds,
+            [&generatedNodeIndices](size_t nodeIndex)
+            {
+                generatedNodeIndices.push_back(nodeIndex);
+                return AZ::EntityId(nodeIndex);
+            },
+            entityIds, isNew);
+
+        EXPECT_EQ(newEntityCount, 8);
+        EXPECT_EQ(generatedNodeIndices, AZStd::vector<size_t>({ 1, 3, 4, 5, 6, 7, 9, 10 }));
+        ASSERT_EQ(entityIds.size(), 11);
+        ASSERT_EQ(isNew.size(), 11);
+        EXPECT_EQ(entityIds[0], AZ::EntityId(1000));
+        EXPECT_FALSE(isNew[0]);
+        EXPECT_EQ(entityIds[1], AZ::EntityId(1));
+        EXPECT_TRUE(isNew[1]);
+        EXPECT_EQ(entityIds[2], AZ::EntityId(1002));
+        EXPECT_FALSE(isNew[2]);
+        EXPECT_EQ(entityIds[8], AZ::EntityId(1008));
+        EXPECT_FALSE(isNew[8]);
+        EXPECT_EQ(entityIds[10], AZ::EntityId(10));
+        EXPECT_TRUE(isNew[10]);
+    }
+
+    TEST_F(SceneGraphEntityBuilderTest, ResolveEntityIds_GeneratesNothingWhenEverythingExists)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(R"({ "name": "Town", "version": 2, "children": [ { "name": "A" } ] })");
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+
+        AZStd::vector<AZ::EntityId> entityIds;
+        AZStd::vector<bool> isNew;
+        const AZ::u32 newEntityCount = o3dimport::SceneGraphEntityBuilder::ResolveEntityIds(
+            outcome.GetValue(), { { "A", AZ::EntityId(1000) } },
+            [](size_t)
+            {
+                ADD_FAILURE() << "No id should be generated";
+                return AZ::EntityId();
+            },
+            entityIds, isNew);
+        EXPECT_EQ(newEntityCount, 0);
+        EXPECT_EQ(entityIds, AZStd::vector<AZ::EntityId>({ AZ::EntityId(1000) }));
+        EXPECT_EQ(isNew, AZStd::vector<bool>({ false }));
+    }
+
+    TEST_F(SceneGraphEntityBuilderTest, SplitIntoRanges_OneRangePerRootSubtree)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+
+        using NodeRange = o3dimport::SceneGraphEntityBuilder::NodeRange;
+        EXPECT_EQ(
+            o3dimport::SceneGraphEntityBuilder::SplitIntoRanges(outcome.GetValue(), 256),
+            AZStd::vector<NodeRange>({ NodeRange(0, 4), NodeRange(4, 5), NodeRange(5, 11) }));
+    }
+
+    TEST_F(SceneGraphEntityBuilderTest, SplitIntoRanges_SplitsLargeSubtrees)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(SceneGraphJson);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+
+        // A range that ends in the middle of a subtree is followed by the rest of that subtree, never by the next root.
+        using NodeRange = o3dimport::SceneGraphEntityBuilder::NodeRange;
+        EXPECT_EQ(
+            o3dimport::SceneGraphEntityBuilder::SplitIntoRanges(outcome.GetValue(), 3),
+            AZStd::vector<NodeRange>({ NodeRange(0, 3), NodeRange(3, 4), NodeRange(4, 5), NodeRange(5, 8), NodeRange(8, 11) }));
+        EXPECT_TRUE(o3dimport::SceneGraphEntityBuilder::SplitIntoRanges(o3dimport::SceneGraph(), 3).empty());
+    }
+} // namespace UnitTest
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Math/Crc.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzTest/AzTest.h>
+#include <AzTest/Utils.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphModelFile.h>
+
+namespace UnitTest
+{
+    using SceneGraphModelFileTest = LeakDetectionFixture;
+
+    namespace
+    {
+        constexpr const char* Json = R"({
+            "name": "Town",
+            "children": [
+                {
+                    "name": "Block",
+                    "transform": { "translate": [1, 0, 0], "rotate": [0, 0, 90], "scale": [2, 2, 2] },
+                    "children": [ { "name": "Wall", "mesh": "Wall", "transform": { "translate": [1, 0, 0] } } ]
+                }
+            ]
+        })";
+
+        AZ::u32 ReadU32(const AZStd::vector<AZ::u8>& bytes, size_t offset)
+        {
+            AZ::u32 value = 0;
+            memcpy(&value, bytes.data() + offset, sizeof(value));
+            return value;
+        }
+
+        float ReadF32(const AZStd::vector<AZ::u8>& bytes, size_t offset)
+        {
+            float value = 0.0f;
+            memcpy(&value, bytes.data() + offset, sizeof(value));
+            return value;
+        }
+    } // namespace
+
+    TEST_F(SceneGraphModelFileTest, Write_LaysOutTheSectionsAfterTheHeader)
+    {
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string filePath = AZStd::string::format("%s/Models/Town.sgrm", tempDirectory.GetDirectory());
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+        o3dimport::SceneGraphModelFile::SourceStamp sourceStamp;
+        sourceStamp.m_byteCount = 0x100000002ull;
+        sourceStamp.m_crc32 = 0xDEADBEEF;
+
+        ASSERT_TRUE(o3dimport::SceneGraphModelFile::Write(loadOutcome.GetValue(), sourceStamp, filePath).IsSuccess());
+        EXPECT_FALSE(AZ::IO::SystemFile::Exists((filePath + ".tmp").c_str()));
+        auto readOutcome = AZ::Utils::ReadFile<AZStd::vector<AZ::u8>>(filePath);
+        ASSERT_TRUE(readOutcome.IsSuccess());
+        const AZStd::vector<AZ::u8>& bytes = readOutcome.GetValue();
+
+        // 2 nodes, "BlockWall" + "Wall" in the strings section.
+        constexpr size_t NodeCount = 2;
+        constexpr size_t HeaderByteCount = 32;
+        ASSERT_EQ(bytes.size(), HeaderByteCount + NodeCount * (1 + 3 + 4 + 3) * 4 + (NodeCount + 1) * 2 * 4 + 13);
+        EXPECT_EQ(memcmp(bytes.data(), o3dimport::SceneGraphModelFile::Signature, 4), 0);
+        EXPECT_EQ(ReadU32(bytes, 4), o3dimport::SceneGraphModelFile::Version);
+        EXPECT_EQ(ReadU32(bytes, 8), NodeCount);
+        EXPECT_EQ(ReadU32(bytes, 12), 13);
+        EXPECT_EQ(ReadU32(bytes, 16), 2);
+        EXPECT_EQ(ReadU32(bytes, 20), 1);
+        EXPECT_EQ(ReadU32(bytes, 24), 0xDEADBEEF);
+        // isComplete
+        EXPECT_EQ(ReadU32(bytes, 28), 1);
+
+        size_t offset = HeaderByteCount;
+        EXPECT_EQ(ReadU32(bytes, offset), o3dimport::SceneGraphNode::InvalidIndex);
+        EXPECT_EQ(ReadU32(bytes, offset + 4), 0);
+        offset += NodeCount * 4;
+        // World translation of Wall.
+        EXPECT_NEAR(ReadF32(bytes, offset + 12), 1.0f, 1e-5f);
+        EXPECT_NEAR(ReadF32(bytes, offset + 16), 2.0f, 1e-5f);
+        EXPECT_NEAR(ReadF32(bytes, offset + 20), 0.0f, 1e-5f);
+        offset += NodeCount * 3 * 4;
+        // World rotation of Block, x y z w.
+        EXPECT_NEAR(ReadF32(bytes, offset + 8), sqrtf(0.5f), 1e-5f);
+        EXPECT_NEAR(ReadF32(bytes, offset + 12), sqrtf(0.5f), 1e-5f);
+        offset += NodeCount * 4 * 4;
+        // World scale of Wall.
+        EXPECT_NEAR(ReadF32(bytes, offset + 12), 2.0f, 1e-5f);
+        offset += NodeCount * 3 * 4;
+
+        const AZ::u32 expectedOffsets[] = { 0, 5, 9, 9, 9, 13 };
+        for (AZ::u32 expectedOffset : expectedOffsets)
+        {
+            EXPECT_EQ(ReadU32(bytes, offset), expectedOffset);
+            offset += 4;
+        }
+        EXPECT_EQ(AZStd::string_view(reinterpret_cast<const char*>(bytes.data() + offset), 13), "BlockWallWall");
+    }
+
+    TEST_F(SceneGraphModelFileTest, Export_StampsTheSourceBytesLikeZlib)
+    {
+        // python's zlib.crc32(b"123456789"), the value SceneGraphView.GetSourceStamp() compares against.
+        EXPECT_EQ(AZ::u32(AZ::Crc32("123456789", 9)), 0xCBF43926);
+
+        AZ::Test::ScopedAutoTempDirectory tempDirectory;
+        const AZStd::string sceneGraphFilePath = AZStd::string::format("%s/Town.sgr", tempDirectory.GetDirectory());
+        const AZStd::string modelFilePath = AZStd::string::format("%s/Town.sgrm", tempDirectory.GetDirectory());
+        const AZStd::string_view jsonText(Json);
+        ASSERT_TRUE(AZ::Utils::WriteFile(jsonText, sceneGraphFilePath).IsSuccess());
+
+        ASSERT_TRUE(o3dimport::SceneGraphModelFile::Export(sceneGraphFilePath, modelFilePath).IsSuccess());
+        auto readOutcome = AZ::Utils::ReadFile<AZStd::vector<AZ::u8>>(modelFilePath);
+        ASSERT_TRUE(readOutcome.IsSuccess());
+        const AZStd::vector<AZ::u8>& bytes = readOutcome.GetValue();
+        ASSERT_GE(bytes.size(), 32);
+        EXPECT_EQ(ReadU32(bytes, 16), jsonText.size());
+        EXPECT_EQ(ReadU32(bytes, 20), 0);
+        EXPECT_EQ(ReadU32(bytes, 24), AZ::u32(AZ::Crc32(jsonText.data(), jsonText.size())));
+
+        EXPECT_FALSE(o3dimport::SceneGraphModelFile::Export(sceneGraphFilePath + ".missing", modelFilePath).IsSuccess());
+    }
+} // namespace UnitTest
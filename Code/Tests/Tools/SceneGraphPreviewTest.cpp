@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphPreview.h>
+
+namespace UnitTest
+{
+    using SceneGraphPreviewTest = LeakDetectionFixture;
+
+    namespace
+    {
+        // No Mesh component answers the buses in the test, so a model is only ready when this is sent.
+        void NotifyModelReady(const AZ::EntityId& entityId)
+        {
+            AZ::Render::MeshComponentNotificationBus::Event(
+                entityId, &AZ::Render::MeshComponentNotificationBus::Events::OnModelReady, AZ::Data::Asset<AZ::RPI::ModelAsset>(),
+                AZ::Data::Instance<AZ::RPI::Model>());
+        }
+    } // namespace
+
+    TEST_F(SceneGraphPreviewTest, AttachNode_HidesMeshProxiesOnlyWhenTheirModelIsReady)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(R"({ "name": "Town", "children": [
+            { "name": "Block", "children": [ { "name": "Wall_A", "mesh": "Wall" }, { "name": "Wall_B", "mesh": "Wall" } ] },
+            { "name": "Lamp", "mesh": "Lamp" }
+        ]})");
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const AZ::EntityId blockId(1);
+        const AZ::EntityId wallId(2);
+        const AZ::EntityId lampId(3);
+
+        o3dimport::SceneGraphPreview preview;
+        preview.Show(outcome.GetValue());
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 4);
+
+        // A node without mesh has nothing to wait for.
+        preview.AttachNode("Block", blockId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 3);
+        preview.AttachNode("Block/Wall_A", wallId);
+        // Only the full path of a node matches it.
+        preview.AttachNode("Wall_A", lampId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 3);
+        // Another entity's model doesn't hide it.
+        NotifyModelReady(lampId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 3);
+        NotifyModelReady(wallId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 2);
+
+        // Several nodes attached to the same entity are hidden together, and the preview clears itself with the last one.
+        preview.AttachNode("Block/Wall_B", lampId);
+        preview.AttachNode("Lamp", lampId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 2);
+        NotifyModelReady(lampId);
+        EXPECT_EQ(preview.GetVisibleProxyCount(), 0);
+    }
+} // namespace UnitTest
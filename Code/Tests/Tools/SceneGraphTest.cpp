@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphKeys.h>
+
+namespace UnitTest
+{
+    using SceneGraphTest = LeakDetectionFixture;
+
+    TEST_F(SceneGraphTest, PerfectHash_FindsEveryKey)
+    {
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("name", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Name);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("transform", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Transform);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("mesh", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Mesh);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("materials", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Materials);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("children", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Children);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("track", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Track);
+        EXPECT_EQ(o3dimport::SceneGraphTransformKeys.Find("translate", o3dimport::SceneGraphTransformKey::Count), o3dimport::SceneGraphTransformKey::Translate);
+        EXPECT_EQ(o3dimport::SceneGraphTransformKeys.Find("rotate", o3dimport::SceneGraphTransformKey::Count), o3dimport::SceneGraphTransformKey::Rotate);
+        EXPECT_EQ(o3dimport::SceneGraphTransformKeys.Find("scale", o3dimport::SceneGraphTransformKey::Count), o3dimport::SceneGraphTransformKey::Scale);
+    }
+
+    TEST_F(SceneGraphTest, PerfectHash_RejectsUnknownKeys)
+    {
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Count);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("Name", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Count);
+        EXPECT_EQ(o3dimport::SceneGraphNodeKeys.Find("scale", o3dimport::SceneGraphNodeKey::Count), o3dimport::SceneGraphNodeKey::Count);
+        EXPECT_EQ(o3dimport::SceneGraphTransformKeys.Find("mesh", o3dimport::SceneGraphTransformKey::Count), o3dimport::SceneGraphTransformKey::Count);
+    }
+
+    TEST_F(SceneGraphTest, LoadFromString_ComputesWorldTransformsDepthFirst)
+    {
+        constexpr const char* Json = R"({
+            "name": "Level",
+            "version": 2,
+            "children": [
+                {
+                    "name": "Parent",
+                    "transform": { "translate": [1, 0, 0], "rotate": [0, 0, 90], "scale": [2, 2, 2] },
+                    "children": [
+                        { "name": "Child", "mesh": "Cube", "materials": ["Red", "Blue"], "transform": { "translate": [1, 0, 0] } }
+                    ]
+                },
+                { "name": "Sibling" }
+            ]
+        })";
+
+        auto outcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const o3dimport::SceneGraph& sceneGraph = outcome.GetValue();
+        EXPECT_EQ(sceneGraph.GetName(), "Level");
+
+        const auto& nodes = sceneGraph.GetNodes();
+        ASSERT_EQ(nodes.size(), 3);
+        EXPECT_EQ(nodes[0].m_name, "Parent");
+        EXPECT_EQ(nodes[0].m_parentIndex, o3dimport::SceneGraphNode::InvalidIndex);
+        EXPECT_EQ(nodes[1].m_name, "Child");
+        EXPECT_EQ(nodes[1].m_parentIndex, 0);
+        EXPECT_EQ(nodes[1].m_mesh, "Cube");
+        ASSERT_EQ(nodes[1].m_materials.size(), 2);
+        EXPECT_EQ(nodes[1].m_materials[1], "Blue");
+        EXPECT_TRUE(nodes[1].m_worldTranslation.IsClose(AZ::Vector3(1.0f, 2.0f, 0.0f)));
+        EXPECT_TRUE(nodes[1].m_worldScale.IsClose(AZ::Vector3(2.0f)));
+        EXPECT_EQ(nodes[2].m_name, "Sibling");
+        EXPECT_EQ(nodes[2].m_parentIndex, o3dimport::SceneGraphNode::InvalidIndex);
+    }
+
+    TEST_F(SceneGraphTest, LoadFromString_NonUniformScaleOfParentShearsChildren)
+    {
+        constexpr const char* Json = R"({
+            "name": "Level",
+            "children": [
+                {
+                    "name": "Stretched",
+                    "transform": { "scale": [2, 1, 1] },
+                    "children": [
+                        {
+                            "name": "Turned",
+                            "transform": { "translate": [1, 0, 0], "rotate": [0, 0, 90] },
+                            "children": [ { "name": "Leaf", "transform": { "translate": [1, 0, 0] } } ]
+                        }
+                    ]
+                }
+            ]
+        })";
+
+        auto outcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const auto& nodes = outcome.GetValue().GetNodes();
+        ASSERT_EQ(nodes.size(), 3);
+        EXPECT_TRUE(nodes[1].m_worldTranslation.IsClose(AZ::Vector3(2.0f, 0.0f, 0.0f)));
+        // Turned points its X axis along the world Y axis, which the X scale of Stretched doesn't stretch.
+        EXPECT_TRUE(nodes[2].m_worldTranslation.IsClose(AZ::Vector3(2.0f, 1.0f, 0.0f)));
+        EXPECT_TRUE(nodes[2].m_worldTransform.GetTranslation().IsClose(nodes[2].m_worldTranslation));
+    }
+
+    TEST_F(SceneGraphTest, LoadFromString_FailsOnInvalidValues)
+    {
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(R"({ "children": [ { "mesh": "Cube" } ] })").IsSuccess());
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(R"({ "children": [ { "name": 1 } ] })").IsSuccess());
+        EXPECT_FALSE(
+            o3dimport::SceneGraph::LoadFromString(R"({ "children": [ { "name": "A", "transform": { "scale": [1, 1] } } ] })").IsSuccess());
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(R"({ "children": {} })").IsSuccess());
+    }
+} // namespace UnitTest
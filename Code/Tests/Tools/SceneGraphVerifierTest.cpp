@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphVerifier.h>
+
+namespace UnitTest
+{
+    using SceneGraphVerifierTest = LeakDetectionFixture;
+
+    namespace
+    {
+        constexpr const char* Json = R"({
+            "name": "Town",
+            "children": [
+                {
+                    "name": "Block",
+                    "transform": { "translate": [1, 0, 0], "rotate": [0, 0, 90] },
+                    "children": [ { "name": "Wall", "mesh": "Wall", "materials": [ "Brick", "Trim" ], "transform": { "scale": [1, 2, 1] } } ]
+                },
+                { "name": "Lamp", "mesh": "Lamp", "materials": [ "Trim" ] }
+            ]
+        })";
+
+        //! The state of a level where the importer created every node as expected, with entity ids 1, 2, 3...
+        o3dimport::SceneGraphLevelState CreateMatchingLevelState(const o3dimport::SceneGraph& sceneGraph)
+        {
+            o3dimport::SceneGraphLevelState levelState;
+            for (const o3dimport::SceneGraphNode& node : sceneGraph.GetNodes())
+            {
+                o3dimport::SceneGraphLevelState::Entity& entity = levelState.m_entities.emplace_back();
+                entity.m_entityId = AZ::EntityId(levelState.m_entities.size());
+                if (node.m_parentIndex != o3dimport::SceneGraphNode::InvalidIndex)
+                {
+                    entity.m_parentId = AZ::EntityId(node.m_parentIndex + 1);
+                }
+                entity.m_localTM = AZ::Transform::CreateFromQuaternionAndTranslation(node.m_localRotation, node.m_localTranslation);
+                entity.m_nonUniformScale = node.m_localScale;
+                if (node.m_mesh.empty())
+                {
+                    continue;
+                }
+                const AZ::Data::AssetId modelAssetId(AZ::Uuid::CreateName(node.m_mesh.c_str()), 0);
+                entity.m_modelAssetId = modelAssetId;
+                levelState.m_modelAssetIds[node.m_mesh] = modelAssetId;
+                entity.m_hasMaterialSlots = true;
+                for (const AZStd::string& materialName : node.m_materials)
+                {
+                    const AZ::Data::AssetId materialAssetId(AZ::Uuid::CreateName(materialName.c_str()), 0);
+                    entity.m_materialSlots.push_back({ materialName, materialAssetId });
+                    levelState.m_materialAssetIds[materialName] = materialAssetId;
+                }
+            }
+            return levelState;
+        }
+
+        void Rotate(o3dimport::SceneGraphLevelState::Entity& entity, float angleDegrees)
+        {
+            entity.m_localTM.SetRotation(
+                entity.m_localTM.GetRotation() * AZ::Quaternion::CreateRotationX(AZ::DegToRad(angleDegrees)));
+        }
+    } // namespace
+
+    TEST_F(SceneGraphVerifierTest, Compare_MatchingLevel_HasNoMismatch)
+    {
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+        const o3dimport::SceneGraph& sceneGraph = loadOutcome.GetValue();
+        o3dimport::SceneGraphLevelState levelState = CreateMatchingLevelState(sceneGraph);
+        // q and -q are the same rotation.
+        levelState.m_entities[0].m_localTM.SetRotation(-levelState.m_entities[0].m_localTM.GetRotation());
+
+        const AZStd::string report = o3dimport::SceneGraphVerifier::Compare(sceneGraph, levelState, {});
+        EXPECT_EQ(report,
+            "Verified 3 nodes of 'Town': 0 mismatch(es). missing: 0, parent: 0, transform: 0, model: 0, material: 0. "
+            "Materials not verified, the model is not loaded: 0\n");
+    }
+
+    TEST_F(SceneGraphVerifierTest, Compare_RotationsAreComparedByAngle)
+    {
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+        const o3dimport::SceneGraph& sceneGraph = loadOutcome.GetValue();
+        o3dimport::SceneGraphVerificationSettings settings;
+        settings.m_angleToleranceDegrees = 0.1f;
+
+        // 0.08 degrees is 1 - |dot| = 2.4e-7, far below the translation tolerance, and still within the angle tolerance.
+        o3dimport::SceneGraphLevelState levelState = CreateMatchingLevelState(sceneGraph);
+        Rotate(levelState.m_entities[1], 0.08f);
+        EXPECT_TRUE(o3dimport::SceneGraphVerifier::Compare(sceneGraph, levelState, settings).contains(" 0 mismatch(es)."));
+
+        // 5 degrees is only 1 - |dot| = 9.5e-4, which the translation tolerance (0.001) would have accepted.
+        Rotate(levelState.m_entities[1], 4.92f);
+        const AZStd::string report = o3dimport::SceneGraphVerifier::Compare(sceneGraph, levelState, settings);
+        EXPECT_TRUE(report.contains(" 1 mismatch(es). missing: 0, parent: 0, transform: 1, model: 0, material: 0."));
+        EXPECT_TRUE(report.contains("    Wall: rotation off by 5.000 degrees\n"));
+    }
+
+    TEST_F(SceneGraphVerifierTest, Compare_ModelNotLoaded_CountsMaterialsAsUnverified)
+    {
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+        const o3dimport::SceneGraph& sceneGraph = loadOutcome.GetValue();
+        o3dimport::SceneGraphLevelState levelState = CreateMatchingLevelState(sceneGraph);
+        levelState.m_entities[2].m_hasMaterialSlots = false;
+        levelState.m_entities[2].m_materialSlots.clear();
+
+        const AZStd::string report = o3dimport::SceneGraphVerifier::Compare(sceneGraph, levelState, {});
+        EXPECT_TRUE(report.contains(" 0 mismatch(es). missing: 0, parent: 0, transform: 0, model: 0, material: 0. "
+                                    "Materials not verified, the model is not loaded: 1\n"));
+    }
+
+    TEST_F(SceneGraphVerifierTest, Compare_ReportsEachKindOfMismatch)
+    {
+        auto loadOutcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(loadOutcome.IsSuccess());
+        const o3dimport::SceneGraph& sceneGraph = loadOutcome.GetValue();
+        o3dimport::SceneGraphLevelState levelState = CreateMatchingLevelState(sceneGraph);
+        // Wall: detached from Block, not stretched anymore, and its second slot has another material.
+        levelState.m_entities[1].m_parentId = AZ::EntityId();
+        levelState.m_entities[1].m_nonUniformScale = AZ::Vector3::CreateOne();
+        levelState.m_entities[1].m_materialSlots[1].m_materialAssetId = levelState.m_materialAssetIds["Brick"];
+        // Lamp: deleted.
+        levelState.m_entities[2].m_entityId = AZ::EntityId();
+
+        o3dimport::SceneGraphVerificationSettings settings;
+        settings.m_maxReportedMismatches = 1;
+        const AZStd::string report = o3dimport::SceneGraphVerifier::Compare(sceneGraph, levelState, settings);
+        EXPECT_TRUE(report.starts_with(
+            "Verified 3 nodes of 'Town': 2 mismatch(es). missing: 1, parent: 1, transform: 1, model: 0, material: 1."));
+        EXPECT_TRUE(report.contains(
+            "    Wall: parent scale (1.000, 1.000, 1.000) expected (1.000, 2.000, 1.000) material slot 'Trim'\n"));
+        EXPECT_TRUE(report.ends_with("    ... and 1 more\n"));
+    }
+} // namespace UnitTest
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/SceneGraphWatcher.h>
+
+namespace UnitTest
+{
+    using SceneGraphWatcherTest = LeakDetectionFixture;
+
+    TEST_F(SceneGraphWatcherTest, IsSceneInLevel_SkipsScenesWithoutRootEntities)
+    {
+        auto outcome = o3dimport::SceneGraph::LoadFromString(R"({ "name": "Town", "children": [
+            { "name": "Houses", "children": [ { "name": "House" } ] },
+            { "name": "Streets" }
+        ]})");
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const o3dimport::SceneGraph& sceneGraph = outcome.GetValue();
+
+        EXPECT_TRUE(o3dimport::SceneGraphWatcher::IsSceneInLevel(sceneGraph, { "Camera", "Streets" }));
+        // Another scene, or a level where the scene was never imported.
+        EXPECT_FALSE(o3dimport::SceneGraphWatcher::IsSceneInLevel(sceneGraph, { "Camera", "Farm" }));
+        EXPECT_FALSE(o3dimport::SceneGraphWatcher::IsSceneInLevel(sceneGraph, {}));
+        // Only the root nodes count, a child name alone can belong to any other scene.
+        EXPECT_FALSE(o3dimport::SceneGraphWatcher::IsSceneInLevel(sceneGraph, { "House" }));
+    }
+} // namespace UnitTest
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneMemoryReport.h>
+
+namespace UnitTest
+{
+    using SceneMemoryReportTest = LeakDetectionFixture;
+
+    TEST_F(SceneMemoryReportTest, ParseImageHeader_Png_ReadsSizeAndChannels)
+    {
+        const AZ::u8 bytes[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 13, 'I', 'H', 'D', 'R',
+                                 0, 0, 0x08, 0, 0, 0, 0x02, 0, 8, 6 };
+        o3dimport::ImageHeader header;
+        ASSERT_TRUE(o3dimport::SceneMemoryReport::ParseImageHeader(bytes, sizeof(bytes), header));
+        EXPECT_EQ(header.m_width, 2048);
+        EXPECT_EQ(header.m_height, 512);
+        EXPECT_EQ(header.m_channelCount, 4);
+    }
+
+    TEST_F(SceneMemoryReportTest, ParseImageHeader_Jpeg_SkipsSegmentsUntilTheFrameHeader)
+    {
+        const AZ::u8 bytes[] = { 0xFF, 0xD8,
+                                 0xFF, 0xE0, 0, 4, 'J', 'F',                  // APP0
+                                 0xFF, 0xC4, 0, 2,                            // DHT, not a frame header
+                                 0xFF, 0xC0, 0, 11, 8, 0x01, 0x00, 0x02, 0x00, 3 }; // SOF0: 512x256, 3 components
+        o3dimport::ImageHeader header;
+        ASSERT_TRUE(o3dimport::SceneMemoryReport::ParseImageHeader(bytes, sizeof(bytes), header));
+        EXPECT_EQ(header.m_width, 512);
+        EXPECT_EQ(header.m_height, 256);
+        EXPECT_EQ(header.m_channelCount, 3);
+    }
+
+    TEST_F(SceneMemoryReportTest, ParseImageHeader_TruncatedOrUnknown_Fails)
+    {
+        const AZ::u8 truncatedJpeg[] = { 0xFF, 0xD8, 0xFF, 0xE0, 0, 16, 'J', 'F' };
+        const AZ::u8 unknown[] = { 'G', 'I', 'F', '8', '9', 'a', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        o3dimport::ImageHeader header;
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::ParseImageHeader(truncatedJpeg, sizeof(truncatedJpeg), header));
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::ParseImageHeader(unknown, sizeof(unknown), header));
+    }
+
+    TEST_F(SceneMemoryReportTest, ChooseCompression_FollowsTheExporterRules)
+    {
+        EXPECT_EQ(o3dimport::SceneMemoryReport::ChooseCompression("wall_normal.png", 3), o3dimport::TextureCompression::BC5);
+        EXPECT_EQ(o3dimport::SceneMemoryReport::ChooseCompression("wall.png", 4), o3dimport::TextureCompression::BC7);
+        EXPECT_EQ(o3dimport::SceneMemoryReport::ChooseCompression("wall.png", 3), o3dimport::TextureCompression::BC1);
+        EXPECT_EQ(o3dimport::SceneMemoryReport::ChooseCompression("wall_r.png", 1), o3dimport::TextureCompression::BC4);
+    }
+
+    TEST_F(SceneMemoryReportTest, EstimateTextureGpuBytes_IncludesTheMipChainInBlocks)
+    {
+        // 4x4: one block. 2x2 and 1x1 mips still take one block each.
+        EXPECT_EQ(o3dimport::SceneMemoryReport::EstimateTextureGpuBytes(4, 4, o3dimport::TextureCompression::BC1), 3 * 8);
+        // 1024x1024 BC7 is 1 MiB for the top mip, about 4/3 of it with the mips.
+        const AZ::u64 bytes = o3dimport::SceneMemoryReport::EstimateTextureGpuBytes(1024, 1024, o3dimport::TextureCompression::BC7);
+        EXPECT_GT(bytes, 1024u * 1024u * 4 / 3);
+        EXPECT_LT(bytes, 1024u * 1024u * 4 / 3 + 256);
+    }
+
+    TEST_F(SceneMemoryReportTest, IsMeshBufferFileName_MatchesOnlyTheLodsOfTheMesh)
+    {
+        EXPECT_TRUE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wall_lod0_index.azbuffer", "wall"));
+        EXPECT_TRUE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wall_lod12_position.azbuffer", "wall"));
+        // Other meshes whose name starts with "<mesh>_lod".
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wall_lodge_lod0_index.azbuffer", "wall"));
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wall_lod_lod0_index.azbuffer", "wall"));
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wall_lod0", "wall"));
+        EXPECT_FALSE(o3dimport::SceneMemoryReport::IsMeshBufferFileName("wallpaper_lod0_index.azbuffer", "wall"));
+    }
+} // namespace UnitTest
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Tools/SceneGraph.h>
+#include <Tools/TransformTrackSet.h>
+
+namespace UnitTest
+{
+    using TransformTrackSetTest = LeakDetectionFixture;
+
+    TEST_F(TransformTrackSetTest, DequantizeQuaternion_RestoresTheDroppedComponent)
+    {
+        // Identity: x, y and z at the middle of the range, w dropped (index 3).
+        const AZ::Quaternion identity = o3dimport::TransformTrackSet::DequantizeQuaternion(0x8000 | 16384, 0x8000 | 16384, 16384);
+        EXPECT_TRUE(identity.IsClose(AZ::Quaternion::CreateIdentity(), 1e-3f));
+
+        // 90 degrees around Z is (0, 0, 0.7071, 0.7071). The exporter drops the first largest component, z (index 2).
+        const AZ::Quaternion rotation = o3dimport::TransformTrackSet::DequantizeQuaternion(0x8000 | 16384, 16384, 32767);
+        EXPECT_TRUE(rotation.IsClose(AZ::Quaternion::CreateRotationZ(AZ::Constants::HalfPi), 1e-3f));
+    }
+
+    TEST_F(TransformTrackSetTest, LoadFromString_SamplesTracksBetweenKeys)
+    {
+        constexpr const char* Json = R"({
+            "name": "Level",
+            "children": [
+                {
+                    "name": "Door",
+                    "transform": { "translate": [0, 0, 5], "scale": [2, 2, 2] },
+                    "track": {
+                        "duration": 2.0,
+                        "translate": { "times": [0.0, 1.0], "values": [0, 0, 0, 10, 0, 0] }
+                    }
+                },
+                { "name": "Static" }
+            ]
+        })";
+
+        auto outcome = o3dimport::SceneGraph::LoadFromString(Json);
+        ASSERT_TRUE(outcome.IsSuccess()) << outcome.GetError().c_str();
+        const o3dimport::SceneGraph& sceneGraph = outcome.GetValue();
+        ASSERT_EQ(sceneGraph.GetNodes().size(), 2);
+        EXPECT_EQ(sceneGraph.GetNodes()[0].m_trackIndex, 0);
+        EXPECT_EQ(sceneGraph.GetNodes()[1].m_trackIndex, o3dimport::SceneGraphNode::InvalidIndex);
+
+        const o3dimport::TransformTrackSet& tracks = sceneGraph.GetTransformTracks();
+        ASSERT_EQ(tracks.GetTrackCount(), 1);
+        EXPECT_FLOAT_EQ(tracks.GetDuration(0), 2.0f);
+        // Two translation keys, plus one rest pose key for the rotation and the scale.
+        EXPECT_EQ(tracks.GetKeyCount(), 4);
+
+        const o3dimport::TransformTrackPose halfway = tracks.Sample(0, 0.5f);
+        EXPECT_TRUE(halfway.m_translation.IsClose(AZ::Vector3(5.0f, 0.0f, 0.0f)));
+        EXPECT_TRUE(halfway.m_rotation.IsClose(AZ::Quaternion::CreateIdentity()));
+        EXPECT_TRUE(halfway.m_scale.IsClose(AZ::Vector3(2.0f)));
+
+        // After the last key the track holds it, unless it loops.
+        EXPECT_TRUE(tracks.Sample(0, 1.5f).m_translation.IsClose(AZ::Vector3(10.0f, 0.0f, 0.0f)));
+        AZStd::vector<o3dimport::TransformTrackPose> poses;
+        tracks.SampleAll(2.5f, true, poses);
+        ASSERT_EQ(poses.size(), 1);
+        EXPECT_TRUE(poses[0].m_translation.IsClose(AZ::Vector3(5.0f, 0.0f, 0.0f)));
+    }
+
+    TEST_F(TransformTrackSetTest, LoadFromString_RejectsInvalidTracks)
+    {
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(
+            R"({"children": [{"name": "A", "track": {"translate": {"times": [0, 1], "values": [0, 0, 0]}}}]})").IsSuccess());
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(
+            R"({"children": [{"name": "A", "track": {"scale": {"times": [1, 0], "values": [1, 1, 1, 2, 2, 2]}}}]})").IsSuccess());
+        EXPECT_FALSE(o3dimport::SceneGraph::LoadFromString(
+            R"({"children": [{"name": "A", "track": {"rotate": {"times": [0], "values": [70000, 0, 0]}}}]})").IsSuccess());
+    }
+} // namespace UnitTest
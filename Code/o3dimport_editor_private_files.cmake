@@ -4,5 +4,37 @@ set(FILES
     Source/o3dimportModuleInterface.h
     Source/Tools/o3dimportEditorSystemComponent.cpp
     Source/Tools/o3dimportEditorSystemComponent.h
+    Source/Tools/o3dimportPaneWidget.cpp
+    Source/Tools/o3dimportPaneWidget.h
+    Source/Tools/HlodProxyBuilder.cpp
+    Source/Tools/HlodProxyBuilder.h
+    Source/Tools/LazyAssetAssigner.cpp
+    Source/Tools/LazyAssetAssigner.h
+    Source/Tools/MaterialFile.cpp
+    Source/Tools/MaterialFile.h
+    Source/Tools/MaterialGenerator.cpp
+    Source/Tools/MaterialGenerator.h
+    Source/Tools/OrphanedAssetCollector.cpp
+    Source/Tools/OrphanedAssetCollector.h
+    Source/Tools/PerfectHash.h
+    Source/Tools/SceneAssetIndex.cpp
+    Source/Tools/SceneAssetIndex.h
+    Source/Tools/SceneGraph.cpp
+    Source/Tools/SceneGraph.h
+    Source/Tools/SceneGraphKeys.h
+    Source/Tools/SceneGraphModelFile.cpp
+    Source/Tools/SceneGraphModelFile.h
+    Source/Tools/SceneGraphEntityBuilder.cpp
+    Source/Tools/SceneGraphEntityBuilder.h
+    Source/Tools/SceneGraphPreview.cpp
+    Source/Tools/SceneGraphPreview.h
+    Source/Tools/SceneGraphVerifier.cpp
+    Source/Tools/SceneGraphVerifier.h
+    Source/Tools/SceneGraphWatcher.cpp
+    Source/Tools/SceneGraphWatcher.h
+    Source/Tools/SceneMemoryReport.cpp
+    Source/Tools/SceneMemoryReport.h
+    Source/Tools/TransformTrackSet.cpp
+    Source/Tools/TransformTrackSet.h
     Source/Tools/o3dimport.qrc
 )
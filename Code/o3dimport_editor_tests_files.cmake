@@ -1,4 +1,18 @@
 
 set(FILES
     Tests/Tools/o3dimportEditorTest.cpp
+    Tests/Tools/HlodProxyBuilderTest.cpp
+    Tests/Tools/LazyAssetAssignerTest.cpp
+    Tests/Tools/MaterialGeneratorTest.cpp
+    Tests/Tools/OrphanedAssetCollectorTest.cpp
+    Tests/Tools/SceneAssetIndexTest.cpp
+    Tests/Tools/SceneGraphTest.cpp
+    Tests/Tools/SceneGraphBenchmarks.cpp
+    Tests/Tools/SceneGraphEntityBuilderTest.cpp
+    Tests/Tools/SceneGraphModelFileTest.cpp
+    Tests/Tools/SceneGraphPreviewTest.cpp
+    Tests/Tools/SceneGraphVerifierTest.cpp
+    Tests/Tools/SceneGraphWatcherTest.cpp
+    Tests/Tools/SceneMemoryReportTest.cpp
+    Tests/Tools/TransformTrackSetTest.cpp
 )
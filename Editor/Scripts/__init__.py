@@ -6,4 +6,4 @@ SPDX-License-Identifier: Apache-2.0 OR MIT
 """
 # -------------------------------------------------------------------------
 
-__ALL__ = ['bootstrap','o3dimport_dialog']
\ No newline at end of file
+__ALL__ = ['o3dimport_dialog']
\ No newline at end of file
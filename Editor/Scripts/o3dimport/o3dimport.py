@@ -10,10 +10,14 @@ SPDX-License-Identifier: Apache-2.0 OR MIT
 # Donated by Meta Platforms, Inc as an open source project.
 
 import argparse
+import hashlib
 import json
 import math
+import mmap
 import os
+import struct
 import time
+import zlib
 import ctypes
 
 import azlmbr.asset as azasset
@@ -24,6 +28,8 @@ import azlmbr.editor as azeditor
 import azlmbr.entity as azentity
 import azlmbr.legacy.general as azgeneral
 import azlmbr.math as azmath
+import azlmbr.o3dimport as azo3dimport
+import azlmbr.paths as azpaths
 import azlmbr.render as azrender
 
 # C:\GIT\o3de\AutomatedTesting\Gem\PythonTests\EditorPythonTestTools\editor_python_test_tools\editor_entity_utils.py
@@ -31,6 +37,16 @@ from editor_python_test_tools.editor_entity_utils import EditorComponent, Editor
 
 VERBOSE = False
 
+# Part of the key of the ImportResultCache. Bump it whenever the importer changes
+# what it produces in the level.
+IMPORTER_VERSION = "1.0.1"
+
+# How long the import waits for the Asset Processor to process the materials generated for the first time.
+MATERIAL_PRODUCTS_TIMEOUT_SECONDS = 30.0
+
+# With --order camera or point, the entities get their transforms, components, meshes and materials in chunks of this size.
+ORDERED_CHUNK_SIZE = 16
+
 # standard name for some components.
 # CN_ stands for Component Name
 CN_MESH = "Mesh"
@@ -95,24 +111,849 @@ class AssetPaths:
             azbus.Broadcast, "GetGameFolder"
         )
         self._relSceneDirectory = os.path.join("Assets", "Scenes", sceneName)
+        self._absSceneDirectory = os.path.join(gamePath, self._relSceneDirectory)
         self._absSceneGraphPath = os.path.join(
-            gamePath, self._relSceneDirectory, f"{sceneName}.sgr"
+            self._absSceneDirectory, f"{sceneName}.sgr"
         )
+        self._absMaterialDescriptionsPath = os.path.join(self._absSceneDirectory, f"{sceneName}.o3mat")
 
     def GetSceneGraphAbsolutePath(self) -> str:
         return self._absSceneGraphPath
 
+    def GetMaterialDescriptionsAbsolutePath(self) -> str:
+        return self._absMaterialDescriptionsPath
+
+    def GetMaterialSourceAbsoluteFolder(self) -> str:
+        return os.path.join(self._absSceneDirectory, "Materials")
+
+    def GetMeshProductFolder(self) -> str:
+        return os.path.join(self._relSceneDirectory, "Meshes")
+
     def GetMeshAssetProductPath(self, meshName: str) -> str:
-        product_folder = os.path.join(self._relSceneDirectory, "Meshes")
-        product_path = os.path.join(product_folder, f"{meshName}.fbx.azmodel")
+        product_path = os.path.join(self.GetMeshProductFolder(), f"{meshName}.fbx.azmodel")
         return product_path
 
+    def GetMaterialProductFolder(self) -> str:
+        return os.path.join(self._relSceneDirectory, "Materials")
+
     def GetMaterialAssetProductPath(self, materialName: str) -> str:
-        product_folder = os.path.join(self._relSceneDirectory, "Materials")
-        product_path = os.path.join(product_folder, f"{materialName}.azmaterial")
+        product_path = os.path.join(self.GetMaterialProductFolder(), f"{materialName}.azmaterial")
         return product_path
 
 
+class AssetIdCache:
+    """
+    A persistent, on disk, map of product path -> AssetId that survives across Editor sessions.
+    Resolving an AssetId through the AssetCatalogRequestBus for each mesh and each material slot
+    is one of the most repeated operations during an import, and most of the time the answer
+    is the same as in the previous import session.
+
+    The whole cache is stamped with the modification time of the asset catalog file. While the catalog
+    is unchanged, cached entries are returned as-is. When the catalog changes, entries are not discarded,
+    instead each entry is revalidated, the first time it is requested, against the modification
+    time of its product file. Only the entries whose product changed are resolved again with the AssetCatalogRequestBus.
+    """
+    # Bump this number when the format of the cache file changes.
+    VERSION = 1
+    CATALOG_FILENAME = "assetcatalog.xml"
+
+    def __init__(self, cacheFilePath: str, productsRootPath: str):
+        self._cacheFilePath = cacheFilePath
+        self._productsRootPath = productsRootPath
+        # key: normalized product path, value: [assetIdString, productModificationStamp]
+        self._entries = {}
+        # Entries that were validated against the current catalog during this session.
+        self._validatedPaths = set()
+        self._catalogStamp = self._GetFileStamp(os.path.join(productsRootPath, AssetIdCache.CATALOG_FILENAME))
+        self._isCatalogUnchanged = False
+        self._isDirty = False
+        self.hitCount = 0
+        self.missCount = 0
+
+    @staticmethod
+    def _GetFileStamp(filePath: str) -> int:
+        try:
+            return os.stat(filePath).st_mtime_ns
+        except OSError:
+            return 0
+
+    @staticmethod
+    def _NormalizeProductPath(productPath: str) -> str:
+        # The AssetCatalog is case insensitive, and product paths are stored in lower case in the Cache folder.
+        return productPath.replace("\\", "/").lower()
+
+    def Load(self):
+        if not os.path.exists(self._cacheFilePath):
+            return
+        try:
+            with open(self._cacheFilePath) as f:
+                cacheDictionary = json.load(f)
+        except Exception as e:
+            print(f"WARNING: Failed to load the AssetId cache '{self._cacheFilePath}'. A new one will be created.\n{e}")
+            return
+        if cacheDictionary.get("version", 0) != AssetIdCache.VERSION:
+            return
+        self._entries = cacheDictionary.get("entries", {})
+        self._isCatalogUnchanged = (self._catalogStamp != 0) and (cacheDictionary.get("catalogStamp", 0) == self._catalogStamp)
+
+    def Save(self):
+        if not self._isDirty and self._isCatalogUnchanged:
+            return
+        if not self._isCatalogUnchanged:
+            # The file is about to be stamped with the current catalog, so the entries that were not
+            # requested during this session must be revalidated now, otherwise they would be trusted blindly
+            # in the next session.
+            for normalizedPath in list(self._entries.keys()):
+                if normalizedPath in self._validatedPaths:
+                    continue
+                productStamp = self._GetFileStamp(os.path.join(self._productsRootPath, normalizedPath))
+                if productStamp == 0 or productStamp != self._entries[normalizedPath][1]:
+                    del self._entries[normalizedPath]
+        cacheDictionary = {
+            "version": AssetIdCache.VERSION,
+            "catalogStamp": self._catalogStamp,
+            "entries": self._entries,
+        }
+        try:
+            os.makedirs(os.path.dirname(self._cacheFilePath), exist_ok=True)
+            tmpFilePath = f"{self._cacheFilePath}.tmp"
+            with open(tmpFilePath, "w") as f:
+                json.dump(cacheDictionary, f)
+            os.replace(tmpFilePath, self._cacheFilePath)
+        except Exception as e:
+            print(f"WARNING: Failed to save the AssetId cache '{self._cacheFilePath}'.\n{e}")
+            return
+        self._isDirty = False
+        self._isCatalogUnchanged = True
+
+    def GetAssetIdByPath(self, productAssetPath: str) -> azasset.AssetId:
+        """
+        Same as AssetCatalogRequestBus.GetAssetIdByPath, but only calls the bus when the product path
+        is not in the cache, or the product file changed since the entry was cached.
+        """
+        normalizedPath = AssetIdCache._NormalizeProductPath(productAssetPath)
+        entry = self._entries.get(normalizedPath, None)
+        if entry is not None:
+            if self._isCatalogUnchanged or (normalizedPath in self._validatedPaths):
+                self.hitCount += 1
+                return azasset.AssetId_CreateString(entry[0])
+            productStamp = self._GetFileStamp(os.path.join(self._productsRootPath, normalizedPath))
+            if productStamp != 0 and productStamp == entry[1]:
+                self._validatedPaths.add(normalizedPath)
+                self.hitCount += 1
+                return azasset.AssetId_CreateString(entry[0])
+        self.missCount += 1
+        assetId = azasset.AssetCatalogRequestBus(
+            azbus.Broadcast, "GetAssetIdByPath", productAssetPath, azmath.Uuid(), False
+        )
+        if not assetId.is_valid():
+            # Invalid results are never cached, the product may show up later.
+            if entry is not None:
+                del self._entries[normalizedPath]
+                self._isDirty = True
+            return assetId
+        productStamp = self._GetFileStamp(os.path.join(self._productsRootPath, normalizedPath))
+        self._entries[normalizedPath] = [assetId.to_string(), productStamp]
+        self._validatedPaths.add(normalizedPath)
+        self._isDirty = True
+        return assetId
+
+
+def GetDefaultAssetIdCacheFilePath() -> str:
+    return os.path.join(azpaths.projectroot, "user", "o3dimport", "AssetIdCache.json")
+
+
+class ImportResultCache:
+    """
+    A local, content addressed, cache of import results.
+    The key of an import is the hash of the SceneGraph file content, the importer version and the AssetIds
+    of all the referenced meshes and materials. Each record remembers which level was produced with that
+    key, and the modification stamp of the level file right after the import was saved.
+    If the same inputs are imported again into a level that was not modified since, the whole import
+    is skipped.
+    Records are stored as '<cacheDir>/<first two hex digits>/<key>.json'. Each hit refreshes the
+    modification time of the record, which is used to evict the least recently used records.
+    """
+    MAX_RECORDS = 512
+
+    def __init__(self, cacheDirPath: str):
+        self._cacheDirPath = cacheDirPath
+
+    @staticmethod
+    def _GetLevelStamp(levelFilePath: str) -> list:
+        try:
+            stat = os.stat(levelFilePath)
+            return [stat.st_mtime_ns, stat.st_size]
+        except OSError:
+            return [0, 0]
+
+    @staticmethod
+    def CalculateKey(sceneGraphFileBytes: bytes, referencedAssetIds: list[tuple[str, str]]) -> str:
+        """
+        @param referencedAssetIds List of (product path, AssetId string).
+        """
+        hasher = hashlib.sha256()
+        hasher.update(IMPORTER_VERSION.encode("utf-8"))
+        hasher.update(b"\0")
+        hasher.update(sceneGraphFileBytes)
+        for productPath, assetIdStr in sorted(referencedAssetIds):
+            hasher.update(b"\0")
+            hasher.update(productPath.replace("\\", "/").lower().encode("utf-8"))
+            hasher.update(b"=")
+            hasher.update(assetIdStr.encode("utf-8"))
+        return hasher.hexdigest()
+
+    def _GetRecordPath(self, key: str) -> str:
+        return os.path.join(self._cacheDirPath, key[:2], f"{key}.json")
+
+    def IsUpToDate(self, key: str, levelFilePath: str) -> bool:
+        recordPath = self._GetRecordPath(key)
+        try:
+            with open(recordPath) as f:
+                record = json.load(f)
+        except Exception:
+            return False
+        levelStamp = ImportResultCache._GetLevelStamp(levelFilePath)
+        if (levelStamp[0] == 0) or (record.get("levelFilePath", "") != levelFilePath) or (record.get("levelStamp", None) != levelStamp):
+            return False
+        try:
+            os.utime(recordPath)  # Refresh the LRU order.
+        except OSError:
+            pass
+        return True
+
+    def Store(self, key: str, levelFilePath: str):
+        recordPath = self._GetRecordPath(key)
+        record = {
+            "importerVersion": IMPORTER_VERSION,
+            "levelFilePath": levelFilePath,
+            "levelStamp": ImportResultCache._GetLevelStamp(levelFilePath),
+        }
+        try:
+            os.makedirs(os.path.dirname(recordPath), exist_ok=True)
+            with open(recordPath, "w") as f:
+                json.dump(record, f)
+        except Exception as e:
+            print(f"WARNING: Failed to store import cache record '{recordPath}'.\n{e}")
+            return
+        self._EvictLeastRecentlyUsed()
+
+    def _EvictLeastRecentlyUsed(self):
+        records = []
+        for dirPath, _, fileNames in os.walk(self._cacheDirPath):
+            for fileName in fileNames:
+                if not fileName.endswith(".json"):
+                    continue
+                filePath = os.path.join(dirPath, fileName)
+                try:
+                    records.append((os.stat(filePath).st_mtime_ns, filePath))
+                except OSError:
+                    pass
+        if len(records) <= ImportResultCache.MAX_RECORDS:
+            return
+        records.sort()
+        for _, filePath in records[: len(records) - ImportResultCache.MAX_RECORDS]:
+            try:
+                os.remove(filePath)
+            except OSError:
+                pass
+
+
+def GetDefaultImportResultCacheDirPath() -> str:
+    return os.path.join(azpaths.projectroot, "user", "o3dimport", "ImportCache")
+
+
+def GetCurrentLevelFilePath() -> str:
+    levelName = azgeneral.get_current_level_name()
+    levelPath = azgeneral.get_current_level_path()
+    if not levelName or not levelPath:
+        return ""
+    return os.path.join(levelPath, f"{levelName}.prefab")
+
+
+class BusCallProfiler:
+    """
+    Counts and times every call that the importer makes into the Editor: the buses and global functions
+    of the azlmbr modules used by this script, and the methods of EditorEntity and EditorComponent.
+    While started, those attributes are replaced by timing wrappers; Stop() restores them.
+    Bus calls are reported per bus and event, e.g. 'AssetCatalogRequestBus.GetAssetIdByPath'.
+    Times are exclusive: the time of the profiled calls made by an EditorComponent method is only counted
+    for those calls, so the total is the real time spent in the Editor.
+    """
+
+    def __init__(self):
+        # key: call name, value: list of exclusive durations in nanoseconds.
+        self._samples = {}
+        # (owner, attribute name, original value)
+        self._patches = []
+        # One entry per profiled call in progress: the inclusive time of the profiled calls it made so far.
+        self._childNsStack = []
+
+    def _Record(self, callName: str, durationNs: int):
+        samples = self._samples.get(callName, None)
+        if samples is None:
+            samples = []
+            self._samples[callName] = samples
+        samples.append(durationNs)
+
+    def _Call(self, callName: str, function, args, kwargs):
+        self._childNsStack.append(0)
+        startNs = time.perf_counter_ns()
+        try:
+            return function(*args, **kwargs)
+        finally:
+            durationNs = time.perf_counter_ns() - startNs
+            childNs = self._childNsStack.pop()
+            if self._childNsStack:
+                self._childNsStack[-1] += durationNs
+            self._Record(callName, durationNs - childNs)
+
+    def _WrapBus(self, busName: str, bus):
+        def ProfiledBus(*args):
+            eventName = args[1] if (len(args) > 1) and isinstance(args[1], str) else ""
+            return self._Call(f"{busName}.{eventName}", bus, args, {})
+
+        return ProfiledBus
+
+    def _WrapFunction(self, callName: str, function):
+        def ProfiledFunction(*args, **kwargs):
+            return self._Call(callName, function, args, kwargs)
+
+        return ProfiledFunction
+
+    def Start(self):
+        for module in (azasset, azcomponents, azeditor, azgeneral, azo3dimport, azrender):
+            moduleName = module.__name__.split(".")[-1]
+            for attributeName, value in list(vars(module).items()):
+                if attributeName.startswith("_") or isinstance(value, (type, type(module))) or not callable(value):
+                    continue
+                if attributeName.endswith("Bus"):
+                    wrapper = self._WrapBus(attributeName, value)
+                else:
+                    wrapper = self._WrapFunction(f"{moduleName}.{attributeName}", value)
+                self._patches.append((module, attributeName, value))
+                setattr(module, attributeName, wrapper)
+        for cls in (EditorEntity, EditorComponent):
+            for attributeName, value in list(vars(cls).items()):
+                if attributeName.startswith("_"):
+                    continue
+                callName = f"{cls.__name__}.{attributeName}"
+                if isinstance(value, (staticmethod, classmethod)):
+                    wrapper = staticmethod(self._WrapFunction(callName, getattr(cls, attributeName)))
+                elif callable(value):
+                    wrapper = self._WrapFunction(callName, value)
+                else:
+                    continue
+                self._patches.append((cls, attributeName, value))
+                setattr(cls, attributeName, wrapper)
+
+    def Stop(self):
+        for owner, attributeName, value in reversed(self._patches):
+            setattr(owner, attributeName, value)
+        self._patches.clear()
+
+    @staticmethod
+    def _Percentile(sortedSamples: list, percent: float) -> int:
+        # Nearest rank.
+        rank = max(1, math.ceil(percent / 100.0 * len(sortedSamples)))
+        return sortedSamples[rank - 1]
+
+    def GetReport(self, top: int = 10) -> str:
+        """
+        @returns The @top calls with the largest total exclusive time, with their call count, total, p50 and p99 latencies.
+        """
+        rows = []
+        for callName, samples in self._samples.items():
+            rows.append((sum(samples), callName, sorted(samples)))
+        rows.sort(reverse=True)
+        totalCount = sum(len(samples) for _, _, samples in rows)
+        totalNs = sum(rowTotalNs for rowTotalNs, _, _ in rows)
+        lines = [
+            f"Bus calls: {totalCount} in {totalNs / 1e6:.1f} ms, {len(rows)} distinct.",
+            f"    {'Call':<56} {'Count':>8} {'Total ms':>10} {'p50 us':>10} {'p99 us':>10}",
+        ]
+        for rowTotalNs, callName, sortedSamples in rows[:top]:
+            p50 = BusCallProfiler._Percentile(sortedSamples, 50.0)
+            p99 = BusCallProfiler._Percentile(sortedSamples, 99.0)
+            lines.append(
+                f"    {callName:<56} {len(sortedSamples):>8} {rowTotalNs / 1e6:>10.2f} {p50 / 1e3:>10.1f} {p99 / 1e3:>10.1f}"
+            )
+        return "\n".join(lines)
+
+
+def ShowSceneGraphPreview(sceneGraphFilePath: str) -> bool:
+    """
+    Asks the o3dimport Gem to draw a box for each mesh node, and a cross for each other node, of the
+    SceneGraph file in the viewport, so the layout of the scene is visible while the importer runs.
+    All proxies are drawn in a single batched debug draw call.
+    @returns False if the SceneGraph file could not be parsed by the Gem.
+    """
+    return azo3dimport.o3dimportRequestBus(azbus.Broadcast, "ShowSceneGraphPreview", sceneGraphFilePath)
+
+
+def ClearSceneGraphPreview():
+    azo3dimport.o3dimportRequestBus(azbus.Broadcast, "ClearSceneGraphPreview")
+
+
+class LazyAssetFile:
+    """
+    The assets that the imports with --lazy registered with the o3dimport Gem for the entities of a level.
+    The Gem forgets them when the Editor closes, so they are also kept on disk, by entity name, the same way
+    the importer finds the entities, for --materialize to register them again in a later Editor session.
+    """
+    # Bump this number when the format of the file changes.
+    VERSION = 1
+
+    def __init__(self, filePath: str):
+        self._filePath = filePath
+        # key: entity name, value: {"model": assetIdString, "materials": {slotLabel: assetIdString}}
+        self._entities = {}
+
+    def Load(self):
+        if not os.path.exists(self._filePath):
+            return
+        try:
+            with open(self._filePath) as f:
+                fileDictionary = json.load(f)
+        except Exception as e:
+            print(f"WARNING: Failed to load the lazy assets '{self._filePath}'.\n{e}")
+            return
+        if fileDictionary.get("version", 0) != LazyAssetFile.VERSION:
+            return
+        self._entities = fileDictionary.get("entities", {})
+
+    def Save(self):
+        if not self._entities:
+            self.Remove()
+            return
+        fileDictionary = {
+            "version": LazyAssetFile.VERSION,
+            "entities": self._entities,
+        }
+        try:
+            os.makedirs(os.path.dirname(self._filePath), exist_ok=True)
+            tmpFilePath = f"{self._filePath}.tmp"
+            with open(tmpFilePath, "w") as f:
+                json.dump(fileDictionary, f)
+            os.replace(tmpFilePath, self._filePath)
+        except Exception as e:
+            print(f"WARNING: Failed to save the lazy assets '{self._filePath}'.\n{e}")
+
+    def Remove(self):
+        self._entities = {}
+        if os.path.exists(self._filePath):
+            os.remove(self._filePath)
+
+    def AddModel(self, entityName: str, modelAssetId: azasset.AssetId):
+        # Same as the Gem, another model forgets the materials of the previous one.
+        self._entities[entityName] = {"model": modelAssetId.to_string(), "materials": {}}
+
+    def AddMaterial(self, entityName: str, slotLabel: str, materialAssetId: azasset.AssetId):
+        if entityName in self._entities:
+            self._entities[entityName]["materials"][slotLabel] = materialAssetId.to_string()
+
+    def RegisterAll(self) -> int:
+        """
+        Registers again all the assets of the file with the o3dimport Gem. The assets of an entity that is already
+        registered, because it was imported during this Editor session, are registered with the same values.
+        @returns The number of entities that were not found in the level.
+        """
+        missingCount = 0
+        for entityName, assets in self._entities.items():
+            foundEntities = EditorEntity.find_editor_entities([entityName])
+            if len(foundEntities) != 1:
+                print(f"WARNING: Found {len(foundEntities)} entities named '{entityName}'. Its lazy assets are not materialized.")
+                missingCount += 1
+                continue
+            entityId = foundEntities[0].id
+            modelAssetId = azasset.AssetId_CreateString(assets["model"])
+            if not azo3dimport.o3dimportRequestBus(azbus.Broadcast, "RegisterLazyModelAsset", entityId, modelAssetId):
+                # The entity already uses the model.
+                continue
+            for slotLabel, materialAssetIdString in assets["materials"].items():
+                materialAssetId = azasset.AssetId_CreateString(materialAssetIdString)
+                azo3dimport.o3dimportRequestBus(azbus.Broadcast, "RegisterLazyMaterialAsset", entityId, slotLabel, materialAssetId)
+        return missingCount
+
+
+def GetDefaultLazyAssetFilePath() -> str:
+    levelName = azgeneral.get_current_level_name()
+    return os.path.join(azpaths.projectroot, "user", "o3dimport", "LazyAssets", f"{levelName}.json")
+
+
+def MaterializeLazyAssets(lazyAssetFilePath: str) -> int:
+    """
+    Assigns, for real, all the assets that were registered by an import with --lazy, so they
+    are saved with the level. The o3dimport Gem also does it before exporting the level and
+    before entering game mode. The assets registered during a previous Editor session are
+    first registered again from @lazyAssetFilePath.
+    @returns The number of entities that got their assets assigned.
+    """
+    lazyAssetFile = LazyAssetFile(lazyAssetFilePath)
+    lazyAssetFile.Load()
+    lazyAssetFile.RegisterAll()
+    materializedCount = azo3dimport.o3dimportRequestBus(azbus.Broadcast, "MaterializeLazyAssets")
+    lazyAssetFile.Remove()
+    return materializedCount
+
+
+class SceneGraphView:
+    """
+    Read only view of the native model of a SceneGraph, as written by the o3dimport Gem with
+    ExportSceneGraphModel (see Code/Source/Tools/SceneGraphModelFile.h for the layout).
+    The file is mapped in memory and each array is a memoryview cast over it, so no python object is
+    created per node until it is read. The nodes are in depth first order, the same order of the .sgr.
+    The arrays are flat: the translation of node i is worldTranslations[i * 3 : i * 3 + 3], its
+    rotation (x, y, z, w) is worldRotations[i * 4 : i * 4 + 4].
+    Use it as a context manager, or call Close(), to unmap the file.
+    sourceByteCount and sourceCrc32 identify the .sgr file the model was exported from, see IsExportedFrom().
+    """
+    SIGNATURE = b"SGRM"
+    VERSION = 2
+    # signature, version, nodeCount, stringByteCount, sourceByteCount, sourceCrc32, isComplete
+    HEADER_FORMAT = "<4sIIIQII"
+    INVALID_INDEX = 0xFFFFFFFF
+
+    def __init__(self, modelFilePath: str):
+        with open(modelFilePath, "rb") as f:
+            self._mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        self._buffer = memoryview(self._mmap)
+        if len(self._buffer) < struct.calcsize(SceneGraphView.HEADER_FORMAT):
+            self.Close()
+            raise ValueError(f"'{modelFilePath}' is too small to be a SceneGraph model file")
+        signature, version, self.nodeCount, stringByteCount, self.sourceByteCount, self.sourceCrc32, isComplete = struct.unpack_from(
+            SceneGraphView.HEADER_FORMAT, self._buffer
+        )
+        if (signature != SceneGraphView.SIGNATURE) or (version != SceneGraphView.VERSION) or not isComplete:
+            self.Close()
+            raise ValueError(f"'{modelFilePath}' is not a complete version {SceneGraphView.VERSION} SceneGraph model file")
+        self._offset = struct.calcsize(SceneGraphView.HEADER_FORMAT)
+        self.parentIndices = self._NextSection("I", self.nodeCount)
+        self.worldTranslations = self._NextSection("f", self.nodeCount * 3)
+        self.worldRotations = self._NextSection("f", self.nodeCount * 4)
+        self.worldScales = self._NextSection("f", self.nodeCount * 3)
+        self._nameOffsets = self._NextSection("I", self.nodeCount + 1)
+        self._meshOffsets = self._NextSection("I", self.nodeCount + 1)
+        self._strings = self._NextSection("B", stringByteCount)
+
+    def _NextSection(self, itemFormat: str, itemCount: int) -> memoryview:
+        # The Gem writes little endian, the same byte order of all the Editor host platforms.
+        byteCount = struct.calcsize(itemFormat) * itemCount
+        section = self._buffer[self._offset : self._offset + byteCount].cast(itemFormat)
+        self._offset += byteCount
+        return section
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.Close()
+
+    def Close(self):
+        # The memory map can't be closed while there are views over it.
+        for attributeName in ("parentIndices", "worldTranslations", "worldRotations", "worldScales", "_nameOffsets", "_meshOffsets", "_strings"):
+            view = getattr(self, attributeName, None)
+            if view is not None:
+                view.release()
+                setattr(self, attributeName, None)
+        self._buffer.release()
+        self._mmap.close()
+
+    @staticmethod
+    def GetSourceStamp(sceneGraphFilePath: str) -> tuple[int, int]:
+        """
+        @returns (byte count, CRC32) of the file, the same values the Gem writes in the header.
+        """
+        crc32 = 0
+        byteCount = 0
+        with open(sceneGraphFilePath, "rb") as f:
+            while chunk := f.read(1 << 20):
+                crc32 = zlib.crc32(chunk, crc32)
+                byteCount += len(chunk)
+        return byteCount, crc32
+
+    def IsExportedFrom(self, sourceStamp: tuple[int, int]) -> bool:
+        return (self.sourceByteCount, self.sourceCrc32) == sourceStamp
+
+    def GetName(self, nodeIndex: int) -> str:
+        return bytes(self._strings[self._nameOffsets[nodeIndex] : self._nameOffsets[nodeIndex + 1]]).decode("utf-8")
+
+    def GetMesh(self, nodeIndex: int) -> str:
+        """
+        @returns An empty string if the node doesn't have a mesh.
+        """
+        return bytes(self._strings[self._meshOffsets[nodeIndex] : self._meshOffsets[nodeIndex + 1]]).decode("utf-8")
+
+    def FindNodeIndex(self, name: str) -> int:
+        """
+        @returns -1 if there's no node named @name. It's a linear search.
+        """
+        nameBytes = name.encode("utf-8")
+        nameLength = len(nameBytes)
+        for nodeIndex in range(self.nodeCount):
+            start = self._nameOffsets[nodeIndex]
+            if (self._nameOffsets[nodeIndex + 1] - start == nameLength) and (self._strings[start : start + nameLength] == nameBytes):
+                return nodeIndex
+        return -1
+
+
+def VerifySceneGraphEntities(assetPaths: AssetPaths, tolerance: float, angleToleranceDegrees: float) -> str:
+    """
+    Asks the o3dimport Gem to compare the entities of the current level against the SceneGraph: parents, local
+    translations and scales within @tolerance, local rotations within @angleToleranceDegrees, model assets and
+    the material asset of each labeled slot.
+    @returns A compact mismatch report, its first line has the counts per kind of mismatch, and the number of
+        nodes whose materials could not be verified because their model is not loaded yet.
+        Empty if the Gem failed to parse the SceneGraph file.
+    """
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast,
+        "VerifySceneGraphEntities",
+        assetPaths.GetSceneGraphAbsolutePath(),
+        assetPaths.GetMeshProductFolder().replace("\\", "/"),
+        assetPaths.GetMaterialProductFolder().replace("\\", "/"),
+        tolerance,
+        angleToleranceDegrees,
+    )
+
+
+def ReportSceneMemory(assetPaths: AssetPaths, maxDepth: int) -> str:
+    """
+    Asks the o3dimport Gem to project the GPU and disk memory of the scene, from the texture headers, the textures
+    referenced by each material, and the processed mesh buffers. Assets shared by several nodes are split evenly.
+    @param maxDepth Deepest level of the SceneGraph with its own line in the subtree breakdown.
+    @returns The report. Empty if the Gem failed to parse the SceneGraph file.
+    """
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast,
+        "ReportSceneMemory",
+        assetPaths.GetSceneGraphAbsolutePath(),
+        assetPaths.GetMeshProductFolder().replace("\\", "/"),
+        maxDepth,
+    )
+
+
+def CollectOrphanedSceneAssets(assetPaths: AssetPaths, removeFiles: bool) -> str:
+    """
+    Asks the o3dimport Gem for the exported meshes, materials and textures of the scene that the SceneGraph
+    no longer references, directly or through its materials. The Asset Processor keeps processing them otherwise.
+    @param removeFiles False for a dry run that only reports the orphaned files.
+    @returns The report. Empty if the Gem failed to parse the SceneGraph file.
+    """
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast, "CollectOrphanedSceneAssets", assetPaths.GetSceneGraphAbsolutePath(), removeFiles
+    )
+
+
+def BuildSceneHlodProxies(assetPaths: AssetPaths, cellSize: float, maxError: float) -> str:
+    """
+    Asks the o3dimport Gem to build the hierarchical LOD proxies of the scene: the subtrees of the SceneGraph are grouped
+    into square cells of @cellSize meters, and the processed models of each cell are merged, simplified within @maxError
+    meters, and written to the HLOD/ folder of the scene as one model with one packed material, listed in HLOD/HLOD.json.
+    The files of the cells of previous builds that are not listed anymore are removed.
+    @returns The report. Empty if the Gem failed to parse the SceneGraph file.
+    """
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast,
+        "BuildSceneHlodProxies",
+        assetPaths.GetSceneGraphAbsolutePath(),
+        assetPaths.GetMeshProductFolder().replace("\\", "/"),
+        cellSize,
+        maxError,
+    )
+
+
+def GenerateSceneMaterials(assetPaths: AssetPaths) -> str:
+    """
+    Asks the o3dimport Gem to write, in parallel, the .material files of the scene from the <Scene>.o3mat file dumped by
+    the o3dexport Blender AddOn. Only the files whose content changed are written, so the Asset Processor only processes those.
+    @returns The report. Empty if the Gem failed to read the material descriptions.
+    """
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast,
+        "GenerateSceneMaterials",
+        assetPaths.GetMaterialDescriptionsAbsolutePath(),
+        assetPaths.GetMaterialSourceAbsoluteFolder(),
+    )
+
+
+def _ListMaterialSourceNames(assetPaths: AssetPaths) -> set[str]:
+    materialsFolder = assetPaths.GetMaterialSourceAbsoluteFolder()
+    if not os.path.isdir(materialsFolder):
+        return set()
+    return {os.path.splitext(fileName)[0] for fileName in os.listdir(materialsFolder) if fileName.endswith(".material")}
+
+
+def WaitForMaterialProducts(assetPaths: AssetPaths, materialNames: set[str], timeoutInSeconds: float) -> bool:
+    """
+    Waits until the Asset Processor has processed the materials that were just generated for the first time,
+    so the import can assign them.
+    @returns False if some of them were not in the AssetCatalog yet after @timeoutInSeconds.
+    """
+    pendingProductPaths = [assetPaths.GetMaterialAssetProductPath(materialName) for materialName in sorted(materialNames)]
+
+    def ArePending() -> bool:
+        while pendingProductPaths:
+            assetId = azasset.AssetCatalogRequestBus(
+                azbus.Broadcast, "GetAssetIdByPath", pendingProductPaths[-1], azmath.Uuid(), False
+            )
+            if not assetId.is_valid():
+                return True
+            pendingProductPaths.pop()
+        return False
+
+    return WaitUntilTrue(lambda: not ArePending(), timeoutInSeconds, frameCountPolling=10)
+
+
+def GetDefaultSceneAssetIndexFilePath() -> str:
+    return os.path.join(azpaths.projectroot, "user", "o3dimport", "SceneAssetIndex.json")
+
+
+def FindSceneAssetReferences(productPath: str) -> str:
+    """
+    Asks the o3dimport Gem which scenes, and which nodes within them, reference a mesh or material product.
+    The Gem keeps a persistent reverse index of all the SceneGraph files of the project, and only parses
+    again the ones that changed since it was last updated.
+    @param productPath Relative to the project, e.g. Assets/Scenes/Town/Materials/Brick.azmaterial, or the source .fbx or .material.
+    @returns The report.
+    """
+    gamePath = azeditor.EditorToolsApplicationRequestBus(azbus.Broadcast, "GetGameFolder")
+    scenesFolder = os.path.join(gamePath, "Assets", "Scenes")
+    return azo3dimport.o3dimportRequestBus(
+        azbus.Broadcast, "FindSceneAssetReferences", scenesFolder, GetDefaultSceneAssetIndexFilePath(), productPath
+    )
+
+
+def GetDefaultSceneGraphModelDirPath() -> str:
+    return os.path.join(azpaths.projectroot, "user", "o3dimport", "SceneModels")
+
+
+def OpenSceneGraphView(sceneGraphFilePath: str) -> SceneGraphView:
+    """
+    Opens a SceneGraphView of the SceneGraph file. The native model is exported by the o3dimport Gem
+    into GetDefaultSceneGraphModelDirPath(), and exported again only when it was not exported from
+    the current content of the SceneGraph file.
+    @returns None if the Gem failed to parse the SceneGraph file.
+    """
+    pathHash = hashlib.sha1(os.path.normcase(os.path.abspath(sceneGraphFilePath)).encode("utf-8")).hexdigest()[:12]
+    modelFileName = f"{os.path.splitext(os.path.basename(sceneGraphFilePath))[0]}-{pathHash}.sgrm"
+    modelFilePath = os.path.join(GetDefaultSceneGraphModelDirPath(), modelFileName)
+    try:
+        # Hashing the file is much cheaper than parsing it, and unlike the modification time it can't be fooled
+        # by copies that preserve timestamps or by edits within the timestamp resolution.
+        sourceStamp = SceneGraphView.GetSourceStamp(sceneGraphFilePath)
+    except OSError as e:
+        print(f"ERROR: Failed to read SceneGraph file '{sceneGraphFilePath}'.\n{e}")
+        return None
+    try:
+        view = SceneGraphView(modelFilePath)
+    except (OSError, ValueError):
+        view = None
+    if view is not None:
+        if view.IsExportedFrom(sourceStamp):
+            return view
+        # The Gem replaces the file, which can't be done while it is mapped on some platforms.
+        view.Close()
+    if not azo3dimport.o3dimportRequestBus(azbus.Broadcast, "ExportSceneGraphModel", sceneGraphFilePath, modelFilePath):
+        return None
+    return SceneGraphView(modelFilePath)
+
+
+def CollectReferencedProductPaths(assetPaths: AssetPaths, sceneGraphDictionary: dict) -> set[str]:
+    """
+    @returns The set of mesh and material product paths referenced by all the nodes in the SceneGraph.
+    """
+    productPaths = set()
+    nodesToVisit = list(sceneGraphDictionary.get("children", []))
+    while nodesToVisit:
+        node = nodesToVisit.pop()
+        if "mesh" in node:
+            productPaths.add(assetPaths.GetMeshAssetProductPath(node["mesh"]))
+        for materialName in node.get("materials", []):
+            productPaths.add(assetPaths.GetMaterialAssetProductPath(materialName))
+        nodesToVisit.extend(node.get("children", []))
+    return productPaths
+
+
+def _QuaternionFromEulerDegrees(eulerDegrees) -> tuple[float, float, float, float]:
+    """
+    Same rotation as _UpdateEditorEntityTransform() builds with azlmbr.math: Z * Y * X.
+    @returns (x, y, z, w)
+    """
+    halfX, halfY, halfZ = [math.radians(angle) * 0.5 for angle in eulerDegrees]
+    quatX = (math.sin(halfX), 0.0, 0.0, math.cos(halfX))
+    quatY = (0.0, math.sin(halfY), 0.0, math.cos(halfY))
+    quatZ = (0.0, 0.0, math.sin(halfZ), math.cos(halfZ))
+    return _MultiplyQuaternions(_MultiplyQuaternions(quatZ, quatY), quatX)
+
+
+def _MultiplyQuaternions(lhs, rhs) -> tuple[float, float, float, float]:
+    lx, ly, lz, lw = lhs
+    rx, ry, rz, rw = rhs
+    return (
+        lw * rx + lx * rw + ly * rz - lz * ry,
+        lw * ry - lx * rz + ly * rw + lz * rx,
+        lw * rz + lx * ry - ly * rx + lz * rw,
+        lw * rw - lx * rx - ly * ry - lz * rz,
+    )
+
+
+def _MatrixFromTransform(translation, rotation, scale) -> tuple:
+    """
+    @param rotation (x, y, z, w)
+    @returns The 3x4 matrix translation * rotation * scale, as a tuple of three rows.
+    """
+    x, y, z, w = rotation
+    rotationRows = (
+        (1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - z * w), 2.0 * (x * z + y * w)),
+        (2.0 * (x * y + z * w), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - x * w)),
+        (2.0 * (x * z - y * w), 2.0 * (y * z + x * w), 1.0 - 2.0 * (x * x + y * y)),
+    )
+    return tuple(
+        (row[0] * scale[0], row[1] * scale[1], row[2] * scale[2], translation[rowIndex])
+        for rowIndex, row in enumerate(rotationRows)
+    )
+
+
+def _MultiplyMatrices(lhs, rhs) -> tuple:
+    """
+    Product of two 3x4 matrices, each one with an implicit (0, 0, 0, 1) fourth row.
+    """
+    return tuple(
+        tuple(
+            sum(lhsRow[index] * rhs[index][column] for index in range(3)) + (lhsRow[3] if column == 3 else 0.0)
+            for column in range(4)
+        )
+        for lhsRow in lhs
+    )
+
+
+def CalculateWorldPositions(sceneGraphDictionary: dict) -> dict[str, tuple[float, float, float]]:
+    """
+    Calculates the world position of every node in the SceneGraph from the local
+    transforms, without asking the Editor. The local matrices are composed in full, so the
+    non uniform scale of a parent also shears its children, same as Code/Source/Tools/SceneGraph.cpp.
+    @returns A dictionary of world positions, organized by entity name.
+    """
+    worldPositions = {}
+    identity = ((1.0, 0.0, 0.0, 0.0), (0.0, 1.0, 0.0, 0.0), (0.0, 0.0, 1.0, 0.0))
+    # Each item: (node dictionary, parent world matrix)
+    stack = [(child, identity) for child in sceneGraphDictionary.get("children", [])]
+    while stack:
+        node, parentMatrix = stack.pop()
+        transform = node.get("transform", {})
+        localMatrix = _MatrixFromTransform(
+            transform.get("translate", (0.0, 0.0, 0.0)),
+            _QuaternionFromEulerDegrees(transform.get("rotate", (0.0, 0.0, 0.0))),
+            transform.get("scale", (1.0, 1.0, 1.0)),
+        )
+        worldMatrix = _MultiplyMatrices(parentMatrix, localMatrix)
+        worldPositions[node["name"]] = tuple(row[3] for row in worldMatrix)
+        for child in node.get("children", []):
+            stack.append((child, worldMatrix))
+    return worldPositions
+
+
 class EntityData:
     def __init__(self, name: str, editorEntity: EditorEntity, parentName: str, sceneGraphData: dict):
         self.name : str = name
@@ -121,17 +962,64 @@ class EntityData:
         self.sceneGraphData : dict = sceneGraphData
         self.meshComponent : EditorComponent = None # Optional. Will be filled later if the entity requires a Mesh component.
         self.materialComponent : EditorComponent = None # Optional. Will be filled later if the entity requires a Material component.
+        self.isBuiltNatively : bool = False # True when Phase 0 created the entity with its transform, components and model asset.
 
 
 class SceneImporter:
     def __init__(
-        self, assetPaths: AssetPaths, saveRate: int, sceneGraphDictionary: dict
+        self,
+        assetPaths: AssetPaths,
+        saveRate: int,
+        sceneGraphDictionary: dict,
+        assetIdCache: AssetIdCache = None,
+        orderPoint: tuple[float, float, float] = None,
+        hasPreview: bool = False,
+        isLazy: bool = False,
+        buildNatively: bool = False,
+        lazyAssetFile: LazyAssetFile = None,
+        saveLevel: bool = True,
+        frameBudgetMs: float = 0.0,
     ):
+        """
+        @param orderPoint Optional. When provided, Phase 2 to Phase 5 run on chunks of ORDERED_CHUNK_SIZE entities,
+               from the closest to the farthest from this point (world space), so the region
+               around it is completely imported, up to its materials, first.
+        @param hasPreview When True, the SceneGraph preview is being shown (see ShowSceneGraphPreview()).
+               Phase 1 attaches each node to its entity, and the o3dimport Gem hides the proxy once the
+               model of the entity is ready.
+        @param isLazy When True, Phase 4 and Phase 5 only register the assets with the o3dimport Gem, which
+               assigns them while the entities are visible by the Editor camera. See MaterializeLazyAssets().
+               The level is never saved, the transient assignments of the Gem must not end up in it.
+        @param buildNatively When True, the o3dimport Gem creates the missing entities, with their components and
+               model assets, on worker threads before Phase 1. Phase 2 to Phase 4 skip the entities it created.
+        @param lazyAssetFile Optional. With isLazy, where the registered assets are also kept for a later Editor session.
+        @param saveLevel When False, the level is never saved, the user saves it when ready.
+        @param frameBudgetMs When greater than 0, each phase yields an Editor frame whenever it has worked
+               for this many milliseconds without yielding, so the Editor stays responsive.
+        """
         self._assetPaths = assetPaths
+        self._orderPoint = orderPoint
+        self._hasPreview = hasPreview
+        self._isLazy = isLazy
+        self._buildNatively = buildNatively
+        self._lazyAssetFile = lazyAssetFile
+        self._saveLevel = saveLevel and not isLazy
+        self._frameBudgetNs = int(frameBudgetMs * 1000000)
+        self._sliceStartNs = time.perf_counter_ns()
+        # Names of the entities whose assets were registered with the o3dimport Gem in lazy mode.
+        self._lazyEntityNames = set()
+        # Optional. When None, every AssetId is resolved with the AssetCatalogRequestBus.
+        self._assetIdCache = assetIdCache
         self._saveRate = saveRate
         self._sceneGraph = sceneGraphDictionary
         self._addedEntities = 0
         self._processedEntities = 0
+        # Assets that could not be assigned or registered, see ImportScene().
+        self._failureCount = 0
+        # Phase 0 (see buildNatively) result, one EntityId per node, invalid for the entities that already existed.
+        self._builtEntityIds = []
+        # Depth first index of the next node visited by Phase 1.
+        self._nextNodeIndex = 0
         # As we add or find entities in the scene, they are added here with key
         # being their name, and the value is an EntityData object
         # CAVEAT: Although O3DE accepts entities with the same name, most DCC tools, Blender
@@ -161,9 +1049,20 @@ class SceneImporter:
         total = self._processedEntities + self._addedEntities
         if (self._saveRate > 0) and (total % self._saveRate) == 0:
             self._EndBatch()
-            azgeneral.save_level()
+            self._SaveLevel()
             self._BeginBatch()
 
+    def _SaveLevel(self):
+        if self._saveLevel:
+            azgeneral.save_level()
+
+    def _YieldIfOverBudget(self):
+        if self._frameBudgetNs <= 0:
+            return
+        if time.perf_counter_ns() - self._sliceStartNs >= self._frameBudgetNs:
+            azgeneral.idle_wait_frames(1)
+            self._sliceStartNs = time.perf_counter_ns()
+
     def _ResetCounters(self):
         self._processedEntities = 0
         self._addedEntities = 0
@@ -171,11 +1070,13 @@ class SceneImporter:
     def ImportScene(self):
         """
         Imports the whole scene in several recursive phases.
+        Phase 0: Optional (see buildNatively). The o3dimport Gem builds the missing entities in parallel.
         Phase 1: Adds the entities and their children entities.
         Phase 2: Adds the NonUniformScale component, and sets the value of the transform componentes on all added entities.
         Phase 3: Adds the Mesh and the Material components to all entities that need it.
         Phase 4: Sets the mesh asset to all entities with Mesh component. Waits at least 2 frames after each asset is set.
         Phase 5: Sets the Material Asset to all MaterialSlots. For each entities waits at least 2 frames after all material slots have been set.
+        @returns False if any asset could not be assigned, or registered in lazy mode, so the level is not a complete import.
         """
         measured_times = [] # Will help get a total time spent.
         start_time = time.time()
@@ -183,89 +1084,124 @@ class SceneImporter:
         sceneName = self._sceneGraph["name"]
         if len(entitiesToAdd) < 1:
             print(f"The SceneGraph '{sceneName}' is empty. Nothing to do.")
-            return
-        
+            return True
+
+        if self._buildNatively:
+            self._builtEntityIds = azo3dimport.o3dimportRequestBus(
+                azbus.Broadcast,
+                "BuildSceneGraphEntities",
+                self._assetPaths.GetSceneGraphAbsolutePath(),
+                self._assetPaths.GetMeshProductFolder().replace("\\", "/"),
+            )
+            builtCount = sum(1 for entityId in self._builtEntityIds if entityId.is_valid())
+            elapsed_time = time.time() - start_time
+            print(f"Phase 0. Duration: {elapsed_time} seconds.\nBuilt {builtCount} new entities natively.")
+            start_time = time.time()
+
         # Phase 1: Adds the entities and their children entities.
         self._BeginBatch()
         countOfNewEntities = self._AddEntitiesRecursive(
-            parentEntityName="", parentEditorEntity=EditorEntity(azentity.EntityId()) , entities=entitiesToAdd
+            parentEntityName="", parentEditorEntity=EditorEntity(azentity.EntityId()), parentNodePath="", entities=entitiesToAdd
         )
         # Let's wait one second to let the UI refresh.
         azgeneral.idle_wait(1.0)
         self._EndBatch()
-        azgeneral.save_level()
+        self._SaveLevel()
         elapsed_time = time.time() - start_time
         measured_times.append(elapsed_time)
         print(f"Phase 1. Duration: {elapsed_time} seconds.\nAdded {countOfNewEntities} new entities.\nTotal entities in the scene={len(self._entitiesByName)}.")
-
-        # Phase 2: Sets the value of the transform componentes on all entities. Adds the NonUniformScale component for those who need it.
-        self._BeginBatch()
-        start_time = time.time()
-        self._UpdateTransformComponentForAllEntities()
-        azgeneral.idle_wait(1.0)
-        self._EndBatch()
-        azgeneral.save_level()
-        elapsed_time = time.time() - start_time
-        measured_times.append(elapsed_time)
-        print(f"Phase 2. Updated Transform components. Duration: {elapsed_time} seconds.")
-
-        #Phase 3: Adds the Mesh and the Material components to all entities that need it.
-        self._BeginBatch()
-        start_time = time.time()
-        self._AddComponentsToAllEntities()
-        azgeneral.idle_wait(1.0)
-        self._EndBatch()
-        azgeneral.save_level()
-        elapsed_time = time.time() - start_time
-        measured_times.append(elapsed_time)
-        print(f"Phase 3. Added components. Duration: {elapsed_time} seconds.")
-
-        # Phase 4: Sets the mesh asset to all entities with Mesh component. Waits at least 2 frames after each asset is set.
-        self._BeginBatch()
-        start_time = time.time()
-        self._SetMeshAssetToAllEntities()
-        azgeneral.idle_wait(1.0)
-        self._EndBatch()
-        azgeneral.save_level()
-        elapsed_time = time.time() - start_time
-        measured_times.append(elapsed_time)
-        print(f"Phase 4. Set mesh assets on all Mesh components. Duration: {elapsed_time} seconds.")
-
-        # Phase 5: Sets the material assets to all entities with Material component. Waits at least 2 frames after each asset is set.
-        self._BeginBatch()
-        start_time = time.time()
-        self._SetMaterialAssetToAllEntities()
-        azgeneral.idle_wait(1.0)
-        self._EndBatch()
-        azgeneral.save_level()
-        elapsed_time = time.time() - start_time
-        measured_times.append(elapsed_time)
-        print(f"Phase 5. Set material assets on all Material components. Duration: {elapsed_time} seconds.")
+        # Phase 1 must go parents first, but the remaining phases can visit the entities in any order.
+        entityNames = list(self._entitiesByName.keys())
+        chunkSize = len(entityNames)
+        if self._orderPoint is not None:
+            entityNames = self._SortEntityNamesByDistance(self._orderPoint)
+            # Each chunk of the closest entities gets its materials before the next chunk gets its transforms.
+            chunkSize = ORDERED_CHUNK_SIZE
+        phases = [
+            # Phase 2: Sets the value of the transform componentes on all entities. Adds the NonUniformScale component for those who need it.
+            ("Phase 2. Updated Transform components.", self._UpdateTransformComponents),
+            # Phase 3: Adds the Mesh and the Material components to all entities that need it.
+            ("Phase 3. Added components.", self._AddComponents),
+            # Phase 4: Sets the mesh asset to all entities with Mesh component. Waits at least 2 frames after each asset is set.
+            ("Phase 4. Set mesh assets on all Mesh components.", self._RegisterLazyMeshAssets if self._isLazy else self._SetMeshAssets),
+            # Phase 5: Sets the material assets to all entities with Material component. Waits at least 2 frames after each asset is set.
+            ("Phase 5. Set material assets on all Material components.", self._SetMaterialAssets),
+        ]
+        phaseDurations = [0.0] * len(phases)
+        for chunkStart in range(0, len(entityNames), chunkSize):
+            chunkNames = entityNames[chunkStart : chunkStart + chunkSize]
+            isLastChunk = chunkStart + chunkSize >= len(entityNames)
+            for phaseIndex, (_, phaseFunction) in enumerate(phases):
+                self._BeginBatch()
+                start_time = time.time()
+                phaseFunction(chunkNames)
+                # The level is saved, and the UI refreshed for a second, once per phase, after the last chunk.
+                if isLastChunk:
+                    azgeneral.idle_wait(1.0)
+                else:
+                    azgeneral.idle_wait_frames(1)
+                self._EndBatch()
+                if isLastChunk:
+                    self._SaveLevel()
+                phaseDurations[phaseIndex] += time.time() - start_time
+        if self._isLazy:
+            print(f"Registered {len(self._lazyEntityNames)} lazy mesh assets.")
+        for (phaseDescription, _), phaseDuration in zip(phases, phaseDurations):
+            measured_times.append(phaseDuration)
+            print(f"{phaseDescription} Duration: {phaseDuration} seconds.")
 
         totalTime = 0.0
         for idx, measured_time in enumerate(measured_times):
             totalTime += measured_time
             print(f"PHASE[{idx+1}]. Duration={measured_time} seconds.")
         print(f"Total Duration={totalTime} seconds.")
+        if self._failureCount > 0:
+            print(f"WARNING: {self._failureCount} asset(s) could not be assigned. The import is incomplete.")
+        return self._failureCount == 0
+
 
+    def _SortEntityNamesByDistance(self, point: tuple[float, float, float]) -> list[str]:
+        worldPositions = CalculateWorldPositions(self._sceneGraph)
 
-    def _AddEntitiesRecursive(self, parentEntityName: str, parentEditorEntity: EditorEntity, entities: list) -> int:
+        def DistanceSquared(entityName: str) -> float:
+            position = worldPositions.get(entityName, point)
+            return sum([(position[axis] - point[axis]) ** 2 for axis in range(3)])
+
+        print(f"Entities will be processed from the closest to the farthest from ({point[0]:.2f}, {point[1]:.2f}, {point[2]:.2f}).")
+        # sorted() is stable, entities at the same distance keep the SceneGraph order.
+        return sorted(self._entitiesByName.keys(), key=DistanceSquared)
+
+
+    def _AddEntitiesRecursive(self, parentEntityName: str, parentEditorEntity: EditorEntity, parentNodePath: str, entities: list) -> int:
         """
         Returns the number of new entities that were added.
         """
         newCount = 0
         for entityDictionary in entities:
+            self._YieldIfOverBudget()
             name, editorEntity, isNew = self._AddEntity(parentEntityName, parentEditorEntity, entityDictionary)
             newCount += 1 if isNew else 0
+            nodePath = f"{parentNodePath}/{name}" if parentNodePath else name
+            if self._hasPreview:
+                azo3dimport.o3dimportRequestBus(azbus.Broadcast, "AttachSceneGraphPreviewNode", nodePath, editorEntity.id)
             if ("children" in entityDictionary) and (len(entityDictionary["children"]) > 0):
-                newCount += self._AddEntitiesRecursive(name, editorEntity, entityDictionary["children"])
+                newCount += self._AddEntitiesRecursive(name, editorEntity, nodePath, entityDictionary["children"])
         return newCount
 
 
     def _AddEntity(self, parentEntityName: str, parentEditorEntity: EditorEntity, entityDictionary: dict) -> tuple[str, EditorEntity, bool]:
         entityName = entityDictionary["name"]
-        editorEntityObj, isNew = self._GetOrCreateEntity(parentEditorEntity, entityName)
-        self._entitiesByName[entityName] = EntityData(entityName, editorEntityObj, parentEntityName, entityDictionary)
+        # Phase 0 returns one id per node, in the same depth first order as this recursion.
+        nodeIndex = self._nextNodeIndex
+        self._nextNodeIndex += 1
+        isBuiltNatively = nodeIndex < len(self._builtEntityIds) and self._builtEntityIds[nodeIndex].is_valid()
+        if isBuiltNatively:
+            editorEntityObj, isNew = EditorEntity(self._builtEntityIds[nodeIndex]), False
+        else:
+            editorEntityObj, isNew = self._GetOrCreateEntity(parentEditorEntity, entityName)
+        entityData = EntityData(entityName, editorEntityObj, parentEntityName, entityDictionary)
+        entityData.isBuiltNatively = isBuiltNatively
+        self._entitiesByName[entityName] = entityData
         return entityName, editorEntityObj, isNew
 
 
@@ -283,12 +1219,16 @@ class SceneImporter:
         return entityObj, isNew
     
 
-    def _UpdateTransformComponentForAllEntities(self):
+    def _UpdateTransformComponents(self, entityNames: list[str]):
         """
-        Visits all entities in self._entitiesByName, and updates the transform components.
+        Visits the entities named @entityNames, and updates the transform components.
         Some entities may need a NonUniformScale component too. it will be added here.
         """
-        for name, entityData in self._entitiesByName.items():
+        for name in entityNames:
+            entityData = self._entitiesByName[name]
+            self._YieldIfOverBudget()
+            if entityData.isBuiltNatively:
+                continue
             transformDictionary = {}
             if "transform" in entityData.sceneGraphData:
                 transformDictionary = entityData.sceneGraphData["transform"]
@@ -348,18 +1288,25 @@ class SceneImporter:
         azeditor.AddNonUniformScaleComponent(editorEntityObj.id, scaleV)
 
 
-    def _AddComponentsToAllEntities(self):
+    def _AddComponents(self, entityNames: list[str]):
         """
-        Visits all entities in self._entitiesByName, and adds the missing components (Mesh, Material, etc).
+        Visits the entities named @entityNames, and adds the missing components (Mesh, Material, etc).
         Components that already exist are captured by reference on each object.
         """
-        for name, entityData in self._entitiesByName.items():
+        for name in entityNames:
+            entityData = self._entitiesByName[name]
+            self._YieldIfOverBudget()
             # entityData.sceneGraphData
             # entityData.editorEntity
             if "mesh" not in entityData.sceneGraphData:
                 if VERBOSE:
                     print(f"Entity with name '{name}' doesn't need a Mesh component")
                 continue
+            if entityData.isBuiltNatively:
+                # Phase 0 created the Mesh component with its model asset. Only the Material component is needed, by Phase 5.
+                if entityData.sceneGraphData.get("materials", []):
+                    entityData.materialComponent = entityData.editorEntity.get_components_of_type([CN_MATERIAL])[0]
+                continue
             entityData.meshComponent, wasAdded = self._AddOrGetComponent(entityData.editorEntity, CN_MESH)
             if wasAdded:
                 # Let's wait one frame.
@@ -389,11 +1336,16 @@ class SceneImporter:
         return component, wasAdded
 
 
-    def _SetMeshAssetToAllEntities(self):
-        for name, entityData in self._entitiesByName.items():
+    def _SetMeshAssets(self, entityNames: list[str]):
+        for name in entityNames:
+            entityData = self._entitiesByName[name]
+            self._YieldIfOverBudget()
             # entityData.sceneGraphData
             # entityData.editorEntity
             # entityData.meshComponent
+            if entityData.isBuiltNatively:
+                self._CountNativeMeshFailure(name, entityData)
+                continue
             if entityData.meshComponent is None:
                 if VERBOSE:
                     print(f"Entity with name '{name}' doesn't have a Mesh Component.")
@@ -406,6 +1358,44 @@ class SceneImporter:
                 azgeneral.idle_wait_frames(1)
 
 
+    def _RegisterLazyMeshAssets(self, entityNames: list[str]):
+        for name in entityNames:
+            entityData = self._entitiesByName[name]
+            self._YieldIfOverBudget()
+            if entityData.isBuiltNatively:
+                self._CountNativeMeshFailure(name, entityData)
+            elif entityData.meshComponent is not None:
+                assetProductPath = self._assetPaths.GetMeshAssetProductPath(entityData.sceneGraphData["mesh"])
+                assetId = self.GetAssetIdByPath(assetProductPath)
+                if not assetId.is_valid():
+                    print(f"Skipping mesh of entity '{name}' because the asset at '{assetProductPath}' is invalid")
+                    self._failureCount += 1
+                elif azo3dimport.o3dimportRequestBus(azbus.Broadcast, "RegisterLazyModelAsset", entityData.editorEntity.id, assetId):
+                    self._lazyEntityNames.add(name)
+                    if self._lazyAssetFile is not None:
+                        self._lazyAssetFile.AddModel(name, assetId)
+
+
+    def _CountNativeMeshFailure(self, entityName: str, entityData: EntityData):
+        """
+        Phase 0 assigned the model asset without any bus call from python. This only checks that it found the asset.
+        """
+        if "mesh" not in entityData.sceneGraphData:
+            return
+        assetProductPath = self._assetPaths.GetMeshAssetProductPath(entityData.sceneGraphData["mesh"])
+        if not self.GetAssetIdByPath(assetProductPath).is_valid():
+            print(f"Entity '{entityName}' was built without mesh because the asset at '{assetProductPath}' is invalid")
+            self._failureCount += 1
+
+
+    def GetAssetIdByPath(self, productAssetPath: str) -> azasset.AssetId:
+        if self._assetIdCache is not None:
+            return self._assetIdCache.GetAssetIdByPath(productAssetPath)
+        return azasset.AssetCatalogRequestBus(
+            azbus.Broadcast, "GetAssetIdByPath", productAssetPath, azmath.Uuid(), False
+        )
+
+
     def _SetComponentAssetProperty(
         self, component: EditorComponent, propertyPath: str, productAssetPath: str
     ) -> bool:
@@ -416,15 +1406,14 @@ class SceneImporter:
         2. A Mesh component accepts: Controller|Configuration|Model Asset: ('Asset<ModelAsset>', 'Visible')
         Returns True if the AssetId was updated in the component. 
         """
-        assetId = azasset.AssetCatalogRequestBus(
-            azbus.Broadcast, "GetAssetIdByPath", productAssetPath, azmath.Uuid(), False
-        )
+        assetId = self.GetAssetIdByPath(productAssetPath)
         if VERBOSE:
             print(f"Got assetId='{assetId}' for '{productAssetPath}'")
         if not assetId.is_valid():
             print(
                 f"Skipping property '{propertyPath}' because the asset at '{productAssetPath}' is invalid"
             )
+            self._failureCount += 1
             return False
         # When a Component has been recently created, it takes a while for the properties to show up
         # in the DPE (Document Property Editor), We need to wait and check until the property exists before
@@ -441,6 +1430,7 @@ class SceneImporter:
             print(
                 f"ERROR: Component Property '{propertyPath}' never activated after waiting '{timeoutInSeconds}' seconds at '{frameCountWaitInterval}' frames interval."
             )
+            self._failureCount += 1
             return False
         currentAssetId = component.get_component_property_value(propertyPath)
         if currentAssetId.is_valid():
@@ -452,8 +1442,10 @@ class SceneImporter:
         return True
 
 
-    def _SetMaterialAssetToAllEntities(self):
-        for name, entityData in self._entitiesByName.items():
+    def _SetMaterialAssets(self, entityNames: list[str]):
+        for name in entityNames:
+            entityData = self._entitiesByName[name]
+            self._YieldIfOverBudget()
             # entityData.sceneGraphData
             # entityData.editorEntity
             # entityData.materialComponent
@@ -462,6 +1454,9 @@ class SceneImporter:
                     print(f"Entity with name '{name}' doesn't have a Material Component.")
                 continue
             materialList = entityData.sceneGraphData["materials"]
+            if name in self._lazyEntityNames:
+                self._RegisterLazyMaterialAssets(name, entityData.editorEntity.id, materialList)
+                continue
             materialChangedCount = 0
             for slotIndex, materialName in enumerate(materialList):
                 materialChangedCount += self._SetMaterialSlotAsset(entityData.materialComponent, materialName, len(materialList))
@@ -471,6 +1466,19 @@ class SceneImporter:
                 azgeneral.idle_wait_frames(3 * materialChangedCount)
 
     
+    def _RegisterLazyMaterialAssets(self, entityName: str, entityId: azentity.EntityId, materialList: list[str]):
+        for materialName in materialList:
+            azmaterialPath = self._assetPaths.GetMaterialAssetProductPath(materialName)
+            assetId = self.GetAssetIdByPath(azmaterialPath)
+            if not assetId.is_valid():
+                print(f"Skipping material '{materialName}' because the asset at '{azmaterialPath}' is invalid")
+                self._failureCount += 1
+                continue
+            azo3dimport.o3dimportRequestBus(azbus.Broadcast, "RegisterLazyMaterialAsset", entityId, materialName, assetId)
+            if self._lazyAssetFile is not None:
+                self._lazyAssetFile.AddMaterial(entityName, materialName, assetId)
+
+
     def _FindMaterialSlotIndexFromMaterialSlotLabel(self, materialComponent: EditorComponent, materialName: str, maxMaterialSlots: int) -> int:
         entityId = materialComponent.id.get_entity_id()
         noLod = ctypes.c_uint(-1)
@@ -495,6 +1503,7 @@ class SceneImporter:
         """
         materialSlotIndex = self._FindMaterialSlotIndexFromMaterialSlotLabel(materialComponent, materialName, maxMaterialSlots)
         if materialSlotIndex < 0:
+            self._failureCount += 1
             return False
         azmaterialPath = self._assetPaths.GetMaterialAssetProductPath(materialName)
         propertyPath = f"Model Materials|[{materialSlotIndex}]|Material Asset"
@@ -508,9 +1517,9 @@ def Main():
     parser = argparse.ArgumentParser(
         description="Automatically Adds entities and componentes from a SceneGraph file and asset layout as produced by O3DEXPORT."
     )
-    parser.add_argument("SCENE_NAME", help="Name of the scene to import")
+    parser.add_argument("SCENE_NAME", nargs="?", default=None, help="Name of the scene to import")
     
-    parser.add_argument('-v', '--version', action='version', version='%(prog)s 1.0.1')
+    parser.add_argument('-v', '--version', action='version', version=f'%(prog)s {IMPORTER_VERSION}')
 
     parser.add_argument(
         "--noverbose",
@@ -526,24 +1535,276 @@ def Main():
         default=0,
         help="Save rate. Will save the level for each batch of N entities added.",
     )
+
+    parser.add_argument(
+        "--nosave",
+        action="store_true",
+        default=False,
+        help="Never saves the level, not even with --save_rate or --materialize. The user saves it when ready.",
+    )
+
+    parser.add_argument(
+        "--frame_budget_ms",
+        type=float,
+        default=0.0,
+        metavar="MS",
+        help="Yields an Editor frame whenever the import has worked for MS milliseconds without yielding, so the Editor stays responsive. 0 (default) disables it.",
+    )
+
+    parser.add_argument(
+        "--no_asset_id_cache",
+        action="store_true",
+        default=False,
+        help="Resolves all AssetIds with the AssetCatalog instead of using the persistent AssetId cache.",
+    )
+
+    parser.add_argument(
+        "-f",
+        "--force",
+        action="store_true",
+        default=False,
+        help="Imports the scene even if the same SceneGraph and assets were already imported into the current level.",
+    )
+
+    parser.add_argument(
+        "--order",
+        choices=["scene", "camera", "point"],
+        default="scene",
+        help="Order in which entities get their transforms, components and assets. 'scene': SceneGraph order. 'camera': closest to the Editor camera first. 'point': closest to --point first.",
+    )
+
+    parser.add_argument(
+        "--point",
+        type=float,
+        nargs=3,
+        metavar=("X", "Y", "Z"),
+        default=None,
+        help="World position used by --order point.",
+    )
+
+    parser.add_argument(
+        "--preview",
+        action="store_true",
+        default=False,
+        help="Draws proxies of all the SceneGraph nodes in the viewport right after parsing. Each proxy disappears once the model of its entity is loaded.",
+    )
+
+    parser.add_argument(
+        "--lazy",
+        action="store_true",
+        default=False,
+        help="Mesh and material assets are only assigned while the entities are visible by the Editor camera. The level is not saved. Run again with --materialize, in this or a later Editor session, to assign them for real.",
+    )
+
+    parser.add_argument(
+        "--materialize",
+        action="store_true",
+        default=False,
+        help="Assigns all the assets pending from previous imports with --lazy, saves the level, and exits. SCENE_NAME is not required.",
+    )
+
+    parser.add_argument(
+        "--native_build",
+        action="store_true",
+        default=False,
+        help="New entities, with their components and mesh assets, are built in parallel by the o3dimport Gem instead of one by one. Can't be combined with --lazy.",
+    )
+
+    parser.add_argument(
+        "--profile_buses",
+        type=int,
+        nargs="?",
+        const=10,
+        default=0,
+        metavar="TOP",
+        help="Counts and times every bus call made by the importer, and prints the TOP (default 10) most expensive ones, with p50 and p99 latencies, at the end.",
+    )
+
+    parser.add_argument(
+        "--verify",
+        type=float,
+        nargs="?",
+        const=0.001,
+        default=None,
+        metavar="TOLERANCE",
+        help="Doesn't import. Compares the entities of the current level against the SceneGraph, with translations and scales within TOLERANCE (default 0.001), and prints the mismatches.",
+    )
+
+    parser.add_argument(
+        "--verify_angle_tolerance",
+        type=float,
+        default=0.1,
+        metavar="DEGREES",
+        help="With --verify, the maximum angle between the expected and the actual local rotation of an entity (default 0.1).",
+    )
+
+    parser.add_argument(
+        "--memory_report",
+        type=int,
+        nargs="?",
+        const=1,
+        default=None,
+        metavar="DEPTH",
+        help="Doesn't import. Prints the projected GPU and disk memory of the scene, broken down by subtree down to DEPTH (default 1).",
+    )
+
+    parser.add_argument(
+        "--orphans",
+        choices=["list", "remove"],
+        nargs="?",
+        const="list",
+        default=None,
+        help="Doesn't import. Lists (default), or removes, the exported meshes, materials and textures of the scene that the SceneGraph no longer references.",
+    )
+
+    parser.add_argument(
+        "--hlod",
+        type=float,
+        nargs="?",
+        const=100.0,
+        default=None,
+        metavar="CELL_SIZE",
+        help="Doesn't import. Merges the meshes of the scene into one simplified proxy model, with one packed material, per square cell of CELL_SIZE (default 100) meters, written to the HLOD/ folder of the scene.",
+    )
+
+    parser.add_argument(
+        "--hlod_max_error",
+        type=float,
+        default=0.25,
+        metavar="METERS",
+        help="With --hlod, the largest distance that simplification may move a vertex of the proxies. Default is 0.25.",
+    )
+
+    parser.add_argument(
+        "--where_used",
+        default=None,
+        metavar="PRODUCT_PATH",
+        help="Doesn't import. Prints the scenes, and their nodes, that reference the mesh or material PRODUCT_PATH, e.g. Assets/Scenes/Town/Materials/Brick.azmaterial. SCENE_NAME is not required.",
+    )
     args = parser.parse_args()
+    if args.native_build and args.lazy:
+        parser.error("--native_build sets the model assets of the entities it builds, it can't be combined with --lazy")
+
+    if args.materialize:
+        materializedCount = MaterializeLazyAssets(GetDefaultLazyAssetFilePath())
+        print(f"Materialized the assets of {materializedCount} entities.")
+        if materializedCount > 0 and not args.nosave:
+            azgeneral.save_level()
+        return
+    if args.where_used is not None:
+        print(FindSceneAssetReferences(args.where_used))
+        return
+    if args.SCENE_NAME is None:
+        parser.error("SCENE_NAME is required")
 
     assetPathsObj = AssetPaths(args.SCENE_NAME)
     sceneGraphFilePath = assetPathsObj.GetSceneGraphAbsolutePath()
     global VERBOSE
     VERBOSE = not args.noverbose
-    saveRate = args.save_rate
     if not os.path.exists(sceneGraphFilePath):
         print(f"File '{sceneGraphFilePath}' doesn't exist!")
         return
+    newMaterialNames = set()
+    if args.verify is None and os.path.exists(assetPathsObj.GetMaterialDescriptionsAbsolutePath()):
+        previousMaterialNames = _ListMaterialSourceNames(assetPathsObj)
+        report = GenerateSceneMaterials(assetPathsObj)
+        print(report if report else "ERROR: Failed to generate the materials of the scene.")
+        newMaterialNames = _ListMaterialSourceNames(assetPathsObj) - previousMaterialNames
+    if args.orphans is not None:
+        report = CollectOrphanedSceneAssets(assetPathsObj, args.orphans == "remove")
+        print(report if report else f"ERROR: Failed to collect the orphaned assets of SceneGraph file '{sceneGraphFilePath}'.")
+        return
+    if args.hlod is not None:
+        report = BuildSceneHlodProxies(assetPathsObj, args.hlod, args.hlod_max_error)
+        print(report if report else f"ERROR: Failed to build the HLOD proxies of SceneGraph file '{sceneGraphFilePath}'.")
+        return
+    if args.memory_report is not None:
+        report = ReportSceneMemory(assetPathsObj, args.memory_report)
+        print(report if report else f"ERROR: Failed to report the memory of SceneGraph file '{sceneGraphFilePath}'.")
+        return
+    if args.verify is not None:
+        report = VerifySceneGraphEntities(assetPathsObj, args.verify, args.verify_angle_tolerance)
+        print(report if report else f"ERROR: Failed to verify SceneGraph file '{sceneGraphFilePath}'.")
+        return
     try:
-        with open(sceneGraphFilePath) as f:
-            sceneDictionary = json.load(f)
+        with open(sceneGraphFilePath, "rb") as f:
+            sceneGraphFileBytes = f.read()
+        sceneDictionary = json.loads(sceneGraphFileBytes)
     except Exception as e:
         print(f"ERROR: Failed to parse SceneGraph file '{sceneGraphFilePath}'.\n{e}")
         return
-    importer = SceneImporter(assetPathsObj, saveRate, sceneDictionary)
-    importer.ImportScene()
+    busCallProfiler = None
+    if args.profile_buses > 0:
+        busCallProfiler = BusCallProfiler()
+        busCallProfiler.Start()
+    if newMaterialNames and not WaitForMaterialProducts(assetPathsObj, newMaterialNames, MATERIAL_PRODUCTS_TIMEOUT_SECONDS):
+        print(f"WARNING: Some of the {len(newMaterialNames)} new materials are still being processed, they won't be assigned.")
+    hasPreview = args.preview and ShowSceneGraphPreview(sceneGraphFilePath)
+    try:
+        # On success the preview is not cleared, the o3dimport Gem hides the remaining proxies as their models finish loading.
+        _ImportSceneGraph(args, assetPathsObj, sceneGraphFileBytes, sceneDictionary, hasPreview)
+    except BaseException:
+        if hasPreview:
+            ClearSceneGraphPreview()
+        raise
+    finally:
+        if busCallProfiler is not None:
+            busCallProfiler.Stop()
+            print(busCallProfiler.GetReport(args.profile_buses))
+
+
+def _ImportSceneGraph(args, assetPathsObj: AssetPaths, sceneGraphFileBytes: bytes, sceneDictionary: dict, hasPreview: bool):
+    saveRate = args.save_rate
+    assetIdCache = None
+    if not args.no_asset_id_cache:
+        assetIdCache = AssetIdCache(GetDefaultAssetIdCacheFilePath(), azpaths.products)
+        assetIdCache.Load()
+    orderPoint = None
+    if args.order == "camera":
+        viewPosition = azgeneral.get_current_view_position()
+        orderPoint = (viewPosition.x, viewPosition.y, viewPosition.z)
+    elif args.order == "point":
+        if args.point is None:
+            print("ERROR: --order point requires --point X Y Z")
+            return
+        orderPoint = tuple(args.point)
+    lazyAssetFile = None
+    if args.lazy:
+        lazyAssetFile = LazyAssetFile(GetDefaultLazyAssetFilePath())
+        lazyAssetFile.Load()
+    importer = SceneImporter(
+        assetPathsObj,
+        saveRate,
+        sceneDictionary,
+        assetIdCache,
+        orderPoint,
+        hasPreview,
+        args.lazy,
+        args.native_build,
+        lazyAssetFile,
+        saveLevel=not args.nosave,
+        frameBudgetMs=args.frame_budget_ms,
+    )
+    importResultCache = ImportResultCache(GetDefaultImportResultCacheDirPath())
+    levelFilePath = GetCurrentLevelFilePath()
+    referencedAssetIds = []
+    for productPath in CollectReferencedProductPaths(assetPathsObj, sceneDictionary):
+        assetId = importer.GetAssetIdByPath(productPath)
+        referencedAssetIds.append((productPath, assetId.to_string() if assetId.is_valid() else ""))
+    importKey = ImportResultCache.CalculateKey(sceneGraphFileBytes, referencedAssetIds)
+    if (not args.force) and levelFilePath and importResultCache.IsUpToDate(importKey, levelFilePath):
+        print(f"Scene '{args.SCENE_NAME}' is already up to date in level '{levelFilePath}'. Nothing to do. Use --force to import anyways.")
+    else:
+        isComplete = importer.ImportScene()
+        if lazyAssetFile is not None:
+            lazyAssetFile.Save()
+        # Lazy assets are not in the level until they are materialized, so a lazy import is never up to date.
+        # Neither is an incomplete one, the next run must retry the assets that failed, nor an unsaved one.
+        if isComplete and levelFilePath and not args.lazy and not args.nosave:
+            importResultCache.Store(importKey, levelFilePath)
+    if assetIdCache is not None:
+        assetIdCache.Save()
+        print(f"AssetId cache: {assetIdCache.hitCount} hit(s), {assetIdCache.missCount} catalog lookup(s).")
     # azgeneral.idle_wait(3.0)
     # importer.ImportScene()
 
@@ -35,6 +35,22 @@ class o3dimportDialog(QDialog):
         self.setLayout(self.mainLayout)
 
 
+def AttachToPane(paneWidgetAddress: int):
+    """
+    Called by the o3dimport Gem the first time its view pane is shown, so PySide and this tool
+    are not loaded during Editor startup.
+    @param paneWidgetAddress Address of the native, empty, pane widget that receives the tool.
+    """
+    from PySide2.QtWidgets import QWidget
+    from shiboken2 import wrapInstance
+
+    paneWidget = wrapInstance(paneWidgetAddress, QWidget)
+    dialog = o3dimportDialog(paneWidget)
+    # Embedded in the pane instead of being a window of its own.
+    dialog.setWindowFlags(Qt.Widget)
+    paneWidget.layout().addWidget(dialog)
+
+
 if __name__ == "__main__":
     # Create a new instance of the tool if launched from the Python Scripts window,
     # which allows for quick iteration without having to close/re-launch the Editor